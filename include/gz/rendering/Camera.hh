@@ -17,6 +17,8 @@
 #ifndef GZ_RENDERING_CAMERA_HH_
 #define GZ_RENDERING_CAMERA_HH_
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 
 #include <gz/common/Event.hh>
@@ -361,6 +363,67 @@ namespace gz
       public: virtual RenderPassPtr RenderPassByIndex(unsigned int _index)
           const = 0;
 
+      /// \brief Set the number of frames by which delivery of sensor data is
+      /// allowed to lag behind rendering. With a latency of 0 (the default)
+      /// the rendered frame is read back from the GPU during PostRender,
+      /// which stalls the CPU until the GPU has finished rendering it. With a
+      /// latency of N the readback is queued asynchronously and the data of
+      /// frame K is delivered during the PostRender of frame K + N, letting
+      /// the GPU work on new frames while older ones are being consumed.
+      /// Use ReadbackFrameId() and ReadbackFrameTime() from within new frame
+      /// callbacks to find out which frame the data belongs to.
+      /// Changing the latency discards any readbacks still in flight.
+      /// Cameras that do not support asynchronous readback ignore this value.
+      /// \param[in] _frames Number of frames of readback latency
+      public: virtual void SetReadbackLatency(unsigned int _frames) = 0;
+
+      /// \brief Get the number of frames by which delivery of sensor data is
+      /// allowed to lag behind rendering.
+      /// \return Number of frames of readback latency
+      /// \sa SetReadbackLatency
+      public: virtual unsigned int ReadbackLatency() const = 0;
+
+      /// \brief Get the id of the frame whose data was delivered by the most
+      /// recent new frame event. Frame ids start at 1 and increase by one for
+      /// every frame that is read back.
+      /// \return Id of the last delivered frame, or 0 if no frame has been
+      /// delivered or the camera does not track frame ids
+      public: virtual uint64_t ReadbackFrameId() const = 0;
+
+      /// \brief Get the time at which the frame delivered by the most recent
+      /// new frame event was queued for readback.
+      /// \return Time the last delivered frame was rendered
+      public: virtual std::chrono::steady_clock::time_point
+          ReadbackFrameTime() const = 0;
+
+      /// \brief Set the number of most recent calls to Update() that the
+      /// update time statistics are computed over. Changing it discards the
+      /// times recorded so far. The default is 100.
+      /// \param[in] _size Number of calls, values less than 1 are clamped
+      /// to 1
+      public: virtual void SetUpdateTimeWindowSize(unsigned int _size) = 0;
+
+      /// \brief Get the number of most recent calls to Update() that the
+      /// update time statistics are computed over.
+      /// \return Number of calls
+      /// \sa SetUpdateTimeWindowSize
+      public: virtual unsigned int UpdateTimeWindowSize() const = 0;
+
+      /// \brief Get the mean wall clock time taken by the most recent calls
+      /// to Update(). This covers preparing the scene, rendering and, with a
+      /// readback latency of 0, waiting for the GPU and reading back the
+      /// image.
+      /// \return Mean duration, zero if Update() has not been called
+      public: virtual std::chrono::steady_clock::duration
+          UpdateTimeMean() const = 0;
+
+      /// \brief Get the longest wall clock time taken by one of the most
+      /// recent calls to Update().
+      /// \return Max duration, zero if Update() has not been called
+      /// \sa UpdateTimeMean
+      public: virtual std::chrono::steady_clock::duration
+          UpdateTimeMax() const = 0;
+
       /// \internal
       /// \brief Notify that shadows are dirty and need to be regenerated
       public: virtual void SetShadowsDirty() = 0;
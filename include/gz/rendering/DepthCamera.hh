@@ -21,6 +21,7 @@
 
 #include <gz/common/Event.hh>
 #include "gz/rendering/Camera.hh"
+#include "gz/rendering/SensorFrameView.hh"
 
 namespace gz
 {
@@ -75,6 +76,58 @@ namespace gz
           std::function<void(const float *_pointCloud, unsigned int _width,
           unsigned int _height, unsigned int _depth,
           const std::string &_format)> _subscriber) = 0;
+
+      /// \brief Connect to the new depth frame view signal. The view points
+      /// directly into the memory the frame was read back into and avoids
+      /// copying the data into the packed buffers used by
+      /// ConnectNewDepthFrame and ConnectNewRgbPointCloud. By default each
+      /// pixel holds four 32 bit floating point values in the same layout
+      /// as the rgb point cloud [X, Y, Z, RGBA], where X is the depth value.
+      /// The RGBA value is only computed while there are rgb point cloud
+      /// subscribers. Depth only formats deliver a single channel instead,
+      /// see SetDepthFormat and SensorFrameView::format.
+      /// Rows may be padded, see SensorFrameView::rowPitch.
+      /// If only view subscribers are connected, the packed buffers and
+      /// DepthData() are not updated.
+      /// \param[in] _subscriber Subscriber callback function. The view is
+      /// only valid during the call.
+      /// \return Pointer to the new Connection. This must be kept in scope.
+      /// Null if the render engine does not support frame views.
+      public: virtual gz::common::ConnectionPtr ConnectNewDepthFrameView(
+          std::function<void(const SensorFrameView &_view)> _subscriber) = 0;
+
+      /// \brief Set the format of the depth data read back from the GPU.
+      /// Supported formats are:
+      ///   PF_FLOAT32_RGBA The default. Each pixel holds the rgb point cloud
+      ///                   data [X, Y, Z, RGBA], 16 bytes per pixel.
+      ///   PF_FLOAT32_R    Depth in meters, 4 bytes per pixel.
+      ///   PF_FLOAT16_R    Depth in meters in half precision, 2 bytes per
+      ///                   pixel. The precision drops with the distance,
+      ///                   e.g. to about 2 mm at 4 m and 2 cm at 32 m.
+      ///   PF_L16          Depth in millimeters, 2 bytes per pixel, like the
+      ///                   depth images of RGB-D sensors. Values are
+      ///                   rounded and saturate at 65535. Pixels without a
+      ///                   valid depth, closer than the near clip plane or
+      ///                   beyond the far clip plane, are 0.
+      /// With the depth only formats the GPU writes the depth into a single
+      /// channel texture and only that texture is read back, unless rgb
+      /// point cloud subscribers are connected, in which case the full
+      /// point cloud data is read back as with PF_FLOAT32_RGBA.
+      /// Depth frame view subscribers receive the data in the format that
+      /// was read back, see SensorFrameView::format. New depth frame
+      /// subscribers always receive depth in meters as 32 bit floats. Unless
+      /// clamped, the float formats give -inf for pixels closer than the near
+      /// clip plane and +inf for pixels beyond the far clip plane, while
+      /// PF_L16 cannot tell them apart and both become NaN. DepthData() is only
+      /// updated while the full point cloud data is read back.
+      /// The format should be set before the camera is first rendered.
+      /// \param[in] _format Depth data format
+      public: virtual void SetDepthFormat(PixelFormat _format) = 0;
+
+      /// \brief Get the format of the depth data read back from the GPU
+      /// \return Depth data format
+      /// \sa SetDepthFormat
+      public: virtual PixelFormat DepthFormat() const = 0;
     };
   }
   }
@@ -22,6 +22,7 @@
 #include <gz/common/Event.hh>
 
 #include "gz/rendering/Image.hh"
+#include "gz/rendering/SensorFrameView.hh"
 #include "gz/rendering/Sensor.hh"
 #include "gz/rendering/Scene.hh"
 #include "gz/rendering/Camera.hh"
@@ -80,6 +81,23 @@ namespace gz
                   unsigned int _height, unsigned int _depth,
                   const std::string &)> _subscriber) = 0;
 
+      /// \brief Connect to a gpu rays frame view signal. The view points
+      /// into memory owned by the sensor and avoids filling the 3 channel
+      /// buffer used by ConnectNewGpuRaysFrame. Each reading occupies 4
+      /// floats of which the first 3 hold data (see
+      /// ConnectNewGpuRaysFrame), i.e. SensorFrameView::channels is 3 and
+      /// the pixel format is PF_FLOAT32_RGBA. Rows may be padded, see
+      /// SensorFrameView::rowPitch.
+      /// If only view subscribers are connected, the packed buffer and Data()
+      /// are not updated.
+      /// \param[in] _subscriber Callback that is called when a new frame is
+      /// generated. The view is only valid during the call.
+      /// \return A pointer to the connection. This must be kept in scope.
+      /// Null if the render engine does not support frame views.
+      public: virtual common::ConnectionPtr ConnectNewGpuRaysFrameView(
+                  std::function<void(const SensorFrameView &_view)>
+                  _subscriber) = 0;
+
       /// \brief Set sensor horizontal or vertical
       /// \param[in] _horizontal True if horizontal, false if not
       public: virtual void SetIsHorizontal(const bool _horizontal) = 0;
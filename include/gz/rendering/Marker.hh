@@ -17,6 +17,9 @@
 #ifndef GZ_RENDERING_MARKER_HH_
 #define GZ_RENDERING_MARKER_HH_
 
+#include <cstddef>
+#include <cstdint>
+
 #include <gz/math/Color.hh>
 #include <gz/math/Vector3.hh>
 #include "gz/rendering/config.hh"
@@ -143,6 +146,26 @@ namespace gz
       /// \param[in] _value The new positional vector of the point
       public: virtual void SetPoint(unsigned int _index,
                   const gz::math::Vector3d &_value) = 0;
+
+      /// \brief Set the positions and colors of a range of points in a
+      /// single call. Points at or past the current number of points are
+      /// added, so this can also be used to fill an empty marker or to
+      /// append to it. Engines only update the modified range on the GPU.
+      /// \param[in] _offset Index of the first point to set. It must not be
+      /// greater than the number of points of the marker.
+      /// \param[in] _count Number of points to set
+      /// \param[in] _xyz Positions, 3 * _count floats holding the x, y and z
+      /// coordinates of each point. If null, the positions of the points are
+      /// left unchanged, in which case no point can be added.
+      /// \param[in] _rgba Colors, _count values packed as returned by
+      /// math::Color::AsRGBA. If null, the colors of existing points are
+      /// left unchanged and added points are white.
+      public: virtual void SetPoints(std::size_t _offset, std::size_t _count,
+                  const float *_xyz, const uint32_t *_rgba = nullptr) = 0;
+
+      /// \brief Get the number of points of the marker
+      /// \return Number of points
+      public: virtual unsigned int PointCount() const = 0;
     };
     }
   }
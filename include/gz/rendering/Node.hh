@@ -337,6 +337,18 @@ namespace gz
       /// \param[in] _key Unique key
       /// \return True if node has custom data with the specified key
       public: virtual bool HasUserData(const std::string &_key) const = 0;
+
+      /// \internal
+      /// \brief Notify that this node changed and must be visited by the
+      /// next Scene::PreRender call. The flag is propagated to all ancestors.
+      public: virtual void SetPreRenderDirty() = 0;
+
+      /// \internal
+      /// \brief Check whether the next PreRender call needs to visit this
+      /// node, either because it changed or because it or one of its
+      /// descendants needs to be updated every frame.
+      /// \return True if this node must be visited by PreRender
+      public: virtual bool PreRenderRequired() const = 0;
     };
     }
   }
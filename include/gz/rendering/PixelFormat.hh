@@ -57,8 +57,20 @@ namespace gz
       PF_L16          = 11,
       /// < RGBA, 1-byte per channel
       PF_R8G8B8A8     = 12,
+      /// < YUV 4:2:0, full resolution Y plane followed by a half resolution
+      /// plane of interleaved U and V samples
+      PF_NV12         = 13,
+      /// < YUV 4:2:0, full resolution Y plane followed by half resolution
+      /// U and V planes
+      PF_I420         = 14,
+      /// < YUV 4:2:2, Y0 U Y1 V for each pair of pixels of a row
+      PF_YUYV         = 15,
+      /// < Float16 (half precision) format one channel
+      PF_FLOAT16_R    = 16,
+      /// < Float32 format two channels
+      PF_FLOAT32_RG   = 17,
       /// < Number of pixel format types
-      PF_COUNT        = 13
+      PF_COUNT        = 18
     };
 
     /// \class PixelUtil PixelFormat.hh gz/rendering/PixelFormat.hh
@@ -82,7 +94,8 @@ namespace gz
       public: static std::string Name(PixelFormat _format);
 
       /// \brief Get number of channels for given format. If an invalid format
-      /// is given, 0 will be returned.
+      /// is given, 0 will be returned. For the YUV formats, this is the
+      /// number of samples stored per pixel of the first plane.
       /// \param[in] _format Image pixel format
       /// \return The channel count
       public: static unsigned int ChannelCount(PixelFormat _format);
@@ -95,14 +108,17 @@ namespace gz
 
       /// \brief Get number of bytes per pixel for given format. If an invalid
       /// format is given, 0 will be returned. This is simply the product of
-      /// GetChannelCount and GetBytesPerChannel.
+      /// GetChannelCount and GetBytesPerChannel. For the YUV formats, this is
+      /// the size of a pixel in the first plane, so that it can be used to
+      /// compute its row size.
       /// \return The number of bytes per pixel
       public: static unsigned int BytesPerPixel(PixelFormat _format);
 
       /// \brief Get total memory size in bytes for an image with the given
       /// format and dimensions. If an invalid format is given, 0 will be
       /// returned. This is simply the product of GetBytesPerPixel, _width,
-      /// and, _height.
+      /// and, _height, except for the YUV formats, which also account for
+      /// their subsampled chroma samples.
       /// \param[in] _format Image pixel format
       /// \param[in] _width Image width in pixels
       /// \param[in] _height Image height in pixels
@@ -117,6 +133,40 @@ namespace gz
       /// \return The specified PixelFormat enum value
       public: static PixelFormat Enum(const std::string &_name);
 
+      /// \brief Check if pixel data can be converted between the given
+      /// formats with Convert.
+      /// \param[in] _srcFormat Format of the source data
+      /// \param[in] _dstFormat Format of the destination data
+      /// \return True if the conversion is supported
+      public: static bool CanConvert(PixelFormat _srcFormat,
+                  PixelFormat _dstFormat);
+
+      /// \brief Convert pixel data from one format to another, e.g. to drop
+      /// the padding channel of data read back from the GPU. Supported
+      /// conversions are copies between identical formats, R8G8B8A8 to
+      /// R8G8B8, FLOAT32_RGBA to FLOAT32_RGB, FLOAT32_RGBA to FLOAT32_R
+      /// (first channel), FLOAT32_RG to FLOAT32_RGB (third channel set to
+      /// 0), FLOAT16_R to FLOAT32_R and L8 to L16 (values are preserved, not
+      /// scaled).
+      /// YUV formats are not supported, see convertRGBToYUV instead. Rows
+      /// of both the source and destination may be padded. The conversion
+      /// uses SIMD instructions where available.
+      /// \param[in] _src Source data
+      /// \param[in] _srcFormat Format of the source data
+      /// \param[in] _srcRowPitch Number of bytes between two rows of the
+      /// source data, or 0 if the rows are tightly packed
+      /// \param[out] _dst Destination data, which must not overlap _src
+      /// \param[in] _dstFormat Format of the destination data
+      /// \param[in] _dstRowPitch Number of bytes between two rows of the
+      /// destination data, or 0 if the rows are tightly packed
+      /// \param[in] _width Image width in pixels
+      /// \param[in] _height Image height in pixels
+      /// \return True if the conversion is supported and was performed
+      public: static bool Convert(const void *_src, PixelFormat _srcFormat,
+                  unsigned int _srcRowPitch, void *_dst,
+                  PixelFormat _dstFormat, unsigned int _dstRowPitch,
+                  unsigned int _width, unsigned int _height);
+
       /// \brief Array of human-readable names for each PixelFormat
       private: static const char *names[PF_COUNT];
 
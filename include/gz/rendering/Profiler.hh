@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_PROFILER_HH_
+#define GZ_RENDERING_PROFILER_HH_
+
+/// \def GZ_RENDERING_PROFILE(name)
+/// \brief Time the rest of the enclosing scope as a zone of the given name.
+/// Zones are reported to the gz-common profiler when both
+/// GZ_RENDERING_PROFILER_ENABLE and GZ_PROFILER_ENABLE are defined, which the
+/// ENABLE_PROFILER cmake option does for gz-rendering's own sources only.
+/// Including this header does not turn the profiler on, the macros compile
+/// to nothing otherwise.
+///
+/// \def GZ_RENDERING_PROFILE_THREAD_NAME(name)
+/// \brief Name the calling thread in the profiler
+
+#ifdef GZ_RENDERING_PROFILER_ENABLE
+  #include <gz/common/Profiler.hh>
+
+  #define GZ_RENDERING_PROFILE(name) GZ_PROFILE(name)
+  #define GZ_RENDERING_PROFILE_THREAD_NAME(name) GZ_PROFILE_THREAD_NAME(name)
+#else
+  #define GZ_RENDERING_PROFILE(name) ((void) 0)
+  #define GZ_RENDERING_PROFILE_THREAD_NAME(name) ((void) 0)
+#endif
+
+#endif
@@ -17,6 +17,8 @@
 #ifndef GZ_RENDERING_RAYQUERY_HH_
 #define GZ_RENDERING_RAYQUERY_HH_
 
+#include <vector>
+
 #include <gz/utils/SuppressWarning.hh>
 #include <gz/math/Vector3.hh>
 
@@ -136,6 +138,25 @@ namespace gz
       /// \return A vector of intersection results
       public: virtual RayQueryResult ClosestPoint(
             bool _forceSceneUpdate = true) = 0;
+
+      /// \brief Compute the closest intersection of each ray of a batch.
+      /// This is equivalent to, but much faster than, calling SetOrigin,
+      /// SetDirection and ClosestPoint once per ray: the scene is only
+      /// updated and searched for candidate objects once for the whole
+      /// batch, and the rays are spread across worker threads.
+      /// The ray set with SetOrigin and SetDirection is left untouched.
+      /// In ogre2 the intersections are always computed on the CPU.
+      /// \param[in] _origins Ray origins
+      /// \param[in] _directions Ray directions, one per origin
+      /// \param[out] _results Closest intersection of each ray, in the order
+      /// of the rays. Rays that hit nothing have an invalid result. Empty if
+      /// the number of origins and directions do not match.
+      /// \param[in] _forceSceneUpdate See ClosestPoint()
+      public: virtual void ClosestPoints(
+            const std::vector<math::Vector3d> &_origins,
+            const std::vector<math::Vector3d> &_directions,
+            std::vector<RayQueryResult> &_results,
+            bool _forceSceneUpdate = true) = 0;
     };
     }
   }
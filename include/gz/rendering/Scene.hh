@@ -1282,6 +1282,42 @@ namespace gz
       public: virtual unsigned int ShadowTextureSize(LightType _lightType)
                   const = 0;
 
+      /// \brief Set whether the shadow maps of spot and point lights are
+      /// cached. A cached shadow map is only rendered again when its light
+      /// moves or changes, or when a shadow casting visual within the range
+      /// of the light moves, is added, removed or hidden. Visuals that don't
+      /// move, such as the ones marked with Visual::SetStatic, never cause a
+      /// cached shadow map to be rendered again, so in a scene whose lights
+      /// don't move only the shadow maps reached by dynamic visuals are
+      /// rendered. The shadows of directional lights follow the view of
+      /// each camera and are rendered every frame. Disabled by default.
+      /// \param[in] _enabled True to cache shadow maps
+      /// \sa SetShadowMapRefreshBudget
+      public: virtual void SetShadowCachingEnabled(bool _enabled) = 0;
+
+      /// \brief Get whether the shadow maps of spot and point lights are
+      /// cached.
+      /// \return True if shadow maps are cached
+      /// \sa SetShadowCachingEnabled
+      public: virtual bool ShadowCachingEnabled() const = 0;
+
+      /// \brief Set the max number of cached shadow maps rendered again in
+      /// a frame. Shadow maps over the budget keep their previous shadows
+      /// and are rendered in the next frames, the ones waiting the longest
+      /// first. This spreads the cost of many lights changing at once,
+      /// e.g. when loading a scene, over several frames.
+      /// \param[in] _budget Max number of shadow maps rendered again in a
+      /// frame, 0 for no limit, which is the default
+      /// \sa SetShadowCachingEnabled
+      public: virtual void SetShadowMapRefreshBudget(unsigned int _budget)
+                  = 0;
+
+      /// \brief Get the max number of cached shadow maps rendered again in
+      /// a frame.
+      /// \return Max number of shadow maps, 0 for no limit
+      /// \sa SetShadowMapRefreshBudget
+      public: virtual unsigned int ShadowMapRefreshBudget() const = 0;
+
       /// \brief Sets the given GI as the current new active GI solution
       /// \param[in] _gi GI solution that should be active. Nullptr to disable
       public: virtual void SetActiveGlobalIllumination(
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_SENSORFRAMEVIEW_HH_
+#define GZ_RENDERING_SENSORFRAMEVIEW_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/Export.hh"
+#include "gz/rendering/PixelFormat.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    /// \brief Read-only view of a sensor frame that points straight into the
+    /// memory the frame was read back into, usually a mapped GPU staging
+    /// buffer. Rows may be padded (rowPitch can be larger than
+    /// width * pixelStride) and pixels may hold more channels than the
+    /// sensor actually fills (e.g. RGB data stored in RGBA pixels).
+    ///
+    /// The memory is only valid for the duration of the callback the view
+    /// is passed to. Subscribers that need the data afterwards must copy it.
+    /// Valid() can be used to check that a view has not outlived its frame.
+    struct GZ_RENDERING_VISIBLE SensorFrameView
+    {
+      /// \brief Check whether the memory pointed to by this view can still
+      /// be read
+      /// \return True if the frame is still mapped
+      public: bool Valid() const
+      {
+        return this->data != nullptr && !this->token.expired();
+      }
+
+      /// \brief Get a pointer to the first pixel of a row
+      /// \param[in] _row Row index
+      /// \return Pointer to the row, interpreted as the given channel type
+      public: template <typename T>
+              const T *Row(unsigned int _row) const
+      {
+        return reinterpret_cast<const T *>(
+            static_cast<const uint8_t *>(this->data) +
+            static_cast<std::size_t>(_row) * this->rowPitch);
+      }
+
+      /// \brief Get a pointer to the first channel of a pixel
+      /// \param[in] _row Row index
+      /// \param[in] _column Column index
+      /// \return Pointer to the pixel, interpreted as the given channel type
+      public: template <typename T>
+              const T *Pixel(unsigned int _row, unsigned int _column) const
+      {
+        return reinterpret_cast<const T *>(
+            static_cast<const uint8_t *>(this->data) +
+            static_cast<std::size_t>(_row) * this->rowPitch +
+            static_cast<std::size_t>(_column) * this->pixelStride);
+      }
+
+      /// \brief Pointer to the first pixel of the frame
+      public: const void *data = nullptr;
+
+      /// \brief Frame width in pixels
+      public: unsigned int width = 0u;
+
+      /// \brief Frame height in pixels
+      public: unsigned int height = 0u;
+
+      /// \brief Number of bytes between the start of two consecutive rows
+      public: unsigned int rowPitch = 0u;
+
+      /// \brief Number of bytes between the start of two consecutive pixels
+      public: unsigned int pixelStride = 0u;
+
+      /// \brief Number of channels per pixel that hold sensor data. This can
+      /// be less than the number of channels of the pixel format.
+      public: unsigned int channels = 0u;
+
+      /// \brief Pixel format of the memory, including padding channels
+      public: PixelFormat format = PF_UNKNOWN;
+
+      /// \brief Id of the frame, see Camera::ReadbackFrameId
+      public: uint64_t frameId = 0u;
+
+      /// \brief Lifetime token. It expires as soon as the memory is unmapped.
+      public: std::weak_ptr<const void> token;
+    };
+    }
+  }
+}
+#endif
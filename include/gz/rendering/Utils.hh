@@ -122,6 +122,61 @@ namespace gz
     GZ_RENDERING_VISIBLE
     Image convertRGBToBayer(const Image &_image, PixelFormat _bayerFormat);
 
+    /// \brief Convert RGB image data into bayer image data, writing into an
+    /// existing image so that no memory is allocated. The image is processed
+    /// row by row, using SIMD instructions where available.
+    /// \param[in] _image Input image in PF_R8G8B8 format
+    /// \param[in,out] _bayerImage Output image. It must have the same
+    /// dimensions as the input image and its format selects the bayer
+    /// pattern to convert to.
+    /// \param[in] _threadCount Number of threads to split the rows over.
+    /// Use 0 to use one thread per hardware core.
+    /// \return True if the conversion succeeded, false if the formats or
+    /// dimensions are not supported
+    GZ_RENDERING_VISIBLE
+    bool convertRGBToBayer(const Image &_image, Image &_bayerImage,
+        unsigned int _threadCount = 1u);
+
+    /// \brief Convert bayer image data into RGB image data using bilinear
+    /// interpolation (demosaicing). This is the inverse of
+    /// convertRGBToBayer, up to the detail lost by sampling.
+    /// \param[in] _bayerImage Input image in one of the bayer formats
+    /// \param[in,out] _image Output image in PF_R8G8B8 format, with the same
+    /// dimensions as the input image
+    /// \param[in] _threadCount Number of threads to split the rows over.
+    /// Use 0 to use one thread per hardware core.
+    /// \return True if the conversion succeeded, false if the formats or
+    /// dimensions are not supported
+    GZ_RENDERING_VISIBLE
+    bool convertBayerToRGB(const Image &_bayerImage, Image &_image,
+        unsigned int _threadCount = 1u);
+
+    /// \brief Convert RGB image data into YUV image data, writing into an
+    /// existing image so that no memory is allocated. Colors are encoded
+    /// with the BT.601 limited range matrix, and each chroma sample is
+    /// computed from the average color of the pixels sharing it. This is
+    /// the reference for the YUV images produced on the GPU.
+    /// \param[in] _image Input image in PF_R8G8B8 format
+    /// \param[in,out] _yuvImage Output image with the same dimensions as
+    /// the input image. Its format, PF_NV12, PF_I420 or PF_YUYV, selects the
+    /// layout to convert to.
+    /// \return True if the conversion succeeded, false if the formats or
+    /// dimensions are not supported
+    GZ_RENDERING_VISIBLE
+    bool convertRGBToYUV(const Image &_image, Image &_yuvImage);
+
+    /// \brief Convert YUV image data into RGB image data. This is the
+    /// inverse of convertRGBToYUV, up to the detail lost by chroma
+    /// subsampling and quantization.
+    /// \param[in] _yuvImage Input image in PF_NV12, PF_I420 or PF_YUYV
+    /// format
+    /// \param[in,out] _image Output image in PF_R8G8B8 format, with the same
+    /// dimensions as the input image
+    /// \return True if the conversion succeeded, false if the formats or
+    /// dimensions are not supported
+    GZ_RENDERING_VISIBLE
+    bool convertYUVToRGB(const Image &_yuvImage, Image &_image);
+
     /// \brief Convenience function to get the default graphics API based on
     /// current platform
     /// \return Graphics API, i.e. METAL, OPENGL, VULKAN
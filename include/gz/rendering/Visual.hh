@@ -155,6 +155,10 @@ namespace gz
       /// Thus if an object is static, make sure you don't keep moving around
       /// because it negates the performance of *all* static objects.
       ///
+      /// The meshes and heightmaps attached to a static visual are made
+      /// static too, while animated meshes, particles and texts stay
+      /// dynamic. Child visuals keep their own setting.
+      ///
       /// \remark (INTERNAL) For implementations:
       ///   Dynamic Scene Node + Dynamic MovableObject = Valid
       ///   Static Scene Node  + Static MovableObject  = Valid
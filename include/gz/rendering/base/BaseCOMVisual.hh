@@ -50,6 +50,10 @@ namespace gz
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited.
       public: virtual void SetInertial(
                   const gz::math::Inertiald &_inertial) override;
@@ -177,6 +181,13 @@ namespace gz
 
       return sphereRadius;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseCOMVisual<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
@@ -17,8 +17,12 @@
 #ifndef GZ_RENDERING_BASE_BASECAMERA_HH_
 #define GZ_RENDERING_BASE_BASECAMERA_HH_
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <gz/math/Matrix3.hh>
 #include <gz/math/Pose3.hh>
@@ -206,6 +210,34 @@ namespace gz
       public: virtual RenderPassPtr RenderPassByIndex(unsigned int _index)
           const override;
 
+      // Documentation inherited.
+      public: virtual void SetReadbackLatency(unsigned int _frames) override;
+
+      // Documentation inherited.
+      public: virtual unsigned int ReadbackLatency() const override;
+
+      // Documentation inherited.
+      public: virtual uint64_t ReadbackFrameId() const override;
+
+      // Documentation inherited.
+      public: virtual std::chrono::steady_clock::time_point
+          ReadbackFrameTime() const override;
+
+      // Documentation inherited.
+      public: virtual void SetUpdateTimeWindowSize(unsigned int _size)
+          override;
+
+      // Documentation inherited.
+      public: virtual unsigned int UpdateTimeWindowSize() const override;
+
+      // Documentation inherited.
+      public: virtual std::chrono::steady_clock::duration
+          UpdateTimeMean() const override;
+
+      // Documentation inherited.
+      public: virtual std::chrono::steady_clock::duration
+          UpdateTimeMax() const override;
+
       // Documentation inherited.
       public: virtual void SetShadowsDirty() override;
 
@@ -272,6 +304,28 @@ namespace gz
       /// \brief Camera projection type
       protected: CameraProjectionType projectionType = CPT_PERSPECTIVE;
 
+      /// \brief Number of frames of readback latency
+      protected: unsigned int readbackLatency = 0u;
+
+      /// \brief Id of the last frame delivered to new frame listeners
+      protected: uint64_t readbackFrameId = 0u;
+
+      /// \brief Time at which the last delivered frame was queued for
+      /// readback
+      protected: std::chrono::steady_clock::time_point readbackFrameTime;
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Durations of the most recent calls to Update(), used as a
+      /// ring buffer of at most updateTimeWindowSize entries
+      protected: std::vector<std::chrono::steady_clock::duration> updateTimes;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+      /// \brief Index in updateTimes of the next duration to record
+      protected: std::size_t updateTimeIndex = 0u;
+
+      /// \brief Number of calls to Update() the statistics are computed over
+      protected: unsigned int updateTimeWindowSize = 100u;
+
       friend class BaseDepthCamera<T>;
     };
 
@@ -431,6 +485,8 @@ namespace gz
     template <class T>
     void BaseCamera<T>::Update()
     {
+      auto start = std::chrono::steady_clock::now();
+
       this->Scene()->PreRender();
       this->Render();
       this->PostRender();
@@ -438,6 +494,18 @@ namespace gz
       {
         this->Scene()->PostRender();
       }
+
+      auto duration = std::chrono::steady_clock::now() - start;
+      if (this->updateTimes.size() < this->updateTimeWindowSize)
+      {
+        this->updateTimes.push_back(duration);
+      }
+      else
+      {
+        this->updateTimes[this->updateTimeIndex] = duration;
+      }
+      this->updateTimeIndex =
+          (this->updateTimeIndex + 1u) % this->updateTimeWindowSize;
     }
 
     //////////////////////////////////////////////////
@@ -901,6 +969,77 @@ namespace gz
       return this->RenderTarget()->RenderPassByIndex(_index);
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseCamera<T>::SetReadbackLatency(unsigned int _frames)
+    {
+      this->readbackLatency = _frames;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    unsigned int BaseCamera<T>::ReadbackLatency() const
+    {
+      return this->readbackLatency;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    uint64_t BaseCamera<T>::ReadbackFrameId() const
+    {
+      return this->readbackFrameId;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    std::chrono::steady_clock::time_point
+        BaseCamera<T>::ReadbackFrameTime() const
+    {
+      return this->readbackFrameTime;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseCamera<T>::SetUpdateTimeWindowSize(unsigned int _size)
+    {
+      this->updateTimeWindowSize = std::max(_size, 1u);
+      this->updateTimes.clear();
+      this->updateTimeIndex = 0u;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    unsigned int BaseCamera<T>::UpdateTimeWindowSize() const
+    {
+      return this->updateTimeWindowSize;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    std::chrono::steady_clock::duration BaseCamera<T>::UpdateTimeMean() const
+    {
+      if (this->updateTimes.empty())
+        return std::chrono::steady_clock::duration::zero();
+
+      std::chrono::steady_clock::duration sum =
+          std::chrono::steady_clock::duration::zero();
+      for (const auto &duration : this->updateTimes)
+        sum += duration;
+      return sum / static_cast<std::chrono::steady_clock::rep>(
+          this->updateTimes.size());
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    std::chrono::steady_clock::duration BaseCamera<T>::UpdateTimeMax() const
+    {
+      std::chrono::steady_clock::duration max =
+          std::chrono::steady_clock::duration::zero();
+      for (const auto &duration : this->updateTimes)
+        max = std::max(max, duration);
+      return max;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseCamera<T>::SetShadowsDirty()
@@ -19,6 +19,7 @@
 
 #include <string>
 
+#include <gz/common/Console.hh>
 #include <gz/common/Event.hh>
 
 #include "gz/rendering/base/BaseCamera.hh"
@@ -50,6 +51,19 @@ namespace gz
       public: virtual gz::common::ConnectionPtr ConnectNewRGBPointCloud(
           std::function<void(const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber);
+
+      // Documentation inherited.
+      public: virtual gz::common::ConnectionPtr ConnectNewDepthFrameView(
+          std::function<void(const SensorFrameView &)> _subscriber) override;
+
+      // Documentation inherited.
+      public: virtual void SetDepthFormat(PixelFormat _format) override;
+
+      // Documentation inherited.
+      public: virtual PixelFormat DepthFormat() const override;
+
+      /// \brief Format of the depth data read back from the GPU
+      protected: PixelFormat depthFormat = PF_FLOAT32_RGBA;
     };
 
     //////////////////////////////////////////////////
@@ -94,6 +108,40 @@ namespace gz
     {
       return nullptr;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    gz::common::ConnectionPtr BaseDepthCamera<T>::ConnectNewDepthFrameView(
+          std::function<void(const SensorFrameView &)>)
+    {
+      return nullptr;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseDepthCamera<T>::SetDepthFormat(PixelFormat _format)
+    {
+      switch (_format)
+      {
+        case PF_FLOAT32_RGBA:
+        case PF_FLOAT32_R:
+        case PF_FLOAT16_R:
+        case PF_L16:
+          this->depthFormat = _format;
+          break;
+        default:
+          gzerr << "Unsupported depth format ["
+                << PixelUtil::Name(_format) << "]" << std::endl;
+          break;
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    PixelFormat BaseDepthCamera<T>::DepthFormat() const
+    {
+      return this->depthFormat;
+    }
   }
   }
 }
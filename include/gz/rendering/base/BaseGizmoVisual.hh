@@ -56,6 +56,10 @@ namespace gz
       // Documentation inherited
       public: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited
       public: virtual void SetTransformMode(TransformMode _mode) override;
 
@@ -754,6 +758,13 @@ namespace gz
       this->visuals[TransformAxis::TA_ROTATION_Z << 1]->SetWorldRotation(
           lookAt.Rotation() * math::Quaterniond(circleRotOffset));
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseGizmoVisual<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
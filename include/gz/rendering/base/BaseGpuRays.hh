@@ -68,6 +68,11 @@ namespace gz
                   unsigned int _height, unsigned int _depth,
                   const std::string &_format)> _subscriber) override;
 
+      // Documentation inherited.
+      public: virtual common::ConnectionPtr ConnectNewGpuRaysFrameView(
+                  std::function<void(const SensorFrameView &)> _subscriber)
+                  override;
+
       /// \brief Pointer to the render target
       public: virtual RenderTargetPtr RenderTarget() const override = 0;
 
@@ -265,6 +270,14 @@ namespace gz
       return nullptr;
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    gz::common::ConnectionPtr BaseGpuRays<T>::ConnectNewGpuRaysFrameView(
+          std::function<void(const SensorFrameView &)>)
+    {
+      return nullptr;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseGpuRays<T>::SetIsHorizontal(const bool _horizontal)
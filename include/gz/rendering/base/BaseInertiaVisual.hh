@@ -48,6 +48,10 @@ namespace gz
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited.
       public: virtual void SetInertial(
                   const gz::math::Inertiald &_inertial) override;
@@ -126,6 +130,13 @@ namespace gz
     {
       return nullptr;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseInertiaVisual<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
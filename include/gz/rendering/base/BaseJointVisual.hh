@@ -53,6 +53,10 @@ namespace gz
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited.
       protected: virtual void Destroy() override;
 
@@ -543,6 +547,13 @@ namespace gz
       if (this->axisVisual)
         this->axisVisual->SetVisible(_visible);
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseJointVisual<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
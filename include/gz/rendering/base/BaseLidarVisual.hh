@@ -44,6 +44,10 @@ namespace gz
       // Documentation inherited
       public: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited
       public: virtual void Destroy() override;
 
@@ -533,6 +537,13 @@ namespace gz
       }
       return;
     }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseLidarVisual<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
@@ -48,6 +48,10 @@ namespace gz
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited
       public: virtual void SetType(LightVisualType _type) override;
 
@@ -269,6 +273,13 @@ namespace gz
       }
       return positions;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseLightVisual<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
@@ -88,6 +88,13 @@ namespace gz
       public: virtual void SetPoint(unsigned int _index,
                   const gz::math::Vector3d &_value) override;
 
+      // Documentation inherited
+      public: virtual void SetPoints(std::size_t _offset, std::size_t _count,
+                  const float *_xyz, const uint32_t *_rgba = nullptr) override;
+
+      // Documentation inherited
+      public: virtual unsigned int PointCount() const override;
+
       /// \brief Life time of a marker
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
       protected: std::chrono::steady_clock::duration lifetime =
@@ -227,6 +234,21 @@ namespace gz
     {
       // no op
     }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseMarker<T>::SetPoints(std::size_t, std::size_t, const float *,
+                  const uint32_t *)
+    {
+      // no op
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    unsigned int BaseMarker<T>::PointCount() const
+    {
+      return 0u;
+    }
     }
   }
 }
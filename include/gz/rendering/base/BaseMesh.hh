@@ -18,12 +18,15 @@
 #define GZ_RENDERING_BASE_BASEMESH_HH_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include "gz/rendering/Mesh.hh"
 #include "gz/rendering/RenderEngine.hh"
 #include "gz/rendering/Storage.hh"
+#include "gz/rendering/Visual.hh"
 #include "gz/rendering/base/BaseObject.hh"
+#include "gz/rendering/base/BaseScene.hh"
 
 namespace gz
 {
@@ -310,6 +313,11 @@ namespace gz
 
       this->ownsMaterial = _unique;
       this->material = _material;
+
+      // the parent visual may need to update shader params every frame
+      VisualPtr parent = this->Parent();
+      if (parent)
+        parent->SetPreRenderDirty();
     }
 
     //////////////////////////////////////////////////
@@ -443,6 +451,16 @@ namespace gz
 
       this->material = _material;
       this->ownsMaterial = _unique;
+
+      // sub-meshes do not know the visual they belong to. The visual needs
+      // to be pre-rendered every frame if the material uses shaders.
+      if (_material && (!_material->VertexShader().empty() ||
+          !_material->FragmentShader().empty()))
+      {
+        auto baseScene = std::dynamic_pointer_cast<BaseScene>(this->Scene());
+        if (baseScene)
+          baseScene->SetShaderMaterialsDirty();
+      }
     }
 
     //////////////////////////////////////////////////
@@ -183,8 +183,21 @@ namespace gz
       // Documentation inherited
       public: virtual bool HasUserData(const std::string &_key) const override;
 
+      // Documentation inherited
+      public: virtual void SetPreRenderDirty() override;
+
+      // Documentation inherited
+      public: virtual bool PreRenderRequired() const override;
+
       protected: virtual void PreRenderChildren();
 
+      /// \brief Whether this node needs to be visited by PreRender every
+      /// frame even if it has not changed. Nodes that only need updating
+      /// when modified should return false and call SetPreRenderDirty when
+      /// changed.
+      /// \return True if this node must be visited every frame
+      protected: virtual bool PreRenderEveryFrame() const;
+
       protected: virtual math::Pose3d RawLocalPose() const = 0;
 
       protected: virtual void SetRawLocalPose(const math::Pose3d &_pose) = 0;
@@ -212,6 +225,14 @@ namespace gz
 
       /// \brief A map of custom key value data
       protected: std::map<std::string, Variant> userData;
+
+      /// \brief True if this node or one of its descendants changed since
+      /// the last PreRender call
+      protected: bool preRenderDirty = true;
+
+      /// \brief True if this node or one of its descendants needs to be
+      /// visited by PreRender every frame
+      protected: bool preRenderActive = true;
     };
 
     //////////////////////////////////////////////////
@@ -254,6 +275,7 @@ namespace gz
       if (this->AttachChild(_child))
       {
         this->Children()->Add(_child);
+        this->SetPreRenderDirty();
       }
     }
 
@@ -262,7 +284,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChild(NodePtr _child)
     {
       NodePtr child = this->Children()->Remove(_child);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->SetPreRenderDirty();
+      }
       return child;
     }
 
@@ -271,7 +297,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildById(unsigned int _id)
     {
       NodePtr child = this->Children()->RemoveById(_id);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->SetPreRenderDirty();
+      }
       return child;
     }
 
@@ -280,7 +310,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildByName(const std::string &_name)
     {
       NodePtr child = this->Children()->RemoveByName(_name);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->SetPreRenderDirty();
+      }
       return child;
     }
 
@@ -289,7 +323,11 @@ namespace gz
     NodePtr BaseNode<T>::RemoveChildByIndex(unsigned int _index)
     {
       NodePtr child = this->Children()->RemoveByIndex(_index);
-      if (child) this->DetachChild(child);
+      if (child)
+      {
+        this->DetachChild(child);
+        this->SetPreRenderDirty();
+      }
       return child;
     }
 
@@ -307,6 +345,13 @@ namespace gz
     template <class T>
     void BaseNode<T>::PreRender()
     {
+      // skip subtrees that have not changed and have nothing to update
+      if (!this->PreRenderRequired())
+        return;
+
+      this->preRenderDirty = false;
+      this->preRenderActive = this->PreRenderEveryFrame();
+
       T::PreRender();
       this->PreRenderChildren();
     }
@@ -319,10 +364,41 @@ namespace gz
 
       for (unsigned int i = 0; i < count; ++i)
       {
-        this->ChildByIndex(i)->PreRender();
+        NodePtr child = this->ChildByIndex(i);
+        child->PreRender();
+        if (child->PreRenderRequired())
+          this->preRenderActive = true;
       }
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::SetPreRenderDirty()
+    {
+      // ancestors of a dirty node are already dirty
+      if (this->preRenderDirty)
+        return;
+
+      this->preRenderDirty = true;
+      NodePtr parent = this->Parent();
+      if (parent)
+        parent->SetPreRenderDirty();
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseNode<T>::PreRenderRequired() const
+    {
+      return this->preRenderDirty || this->preRenderActive;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseNode<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     math::Pose3d BaseNode<T>::LocalPose() const
@@ -50,6 +50,10 @@ namespace gz
       // Documentation inherited
       public: virtual void PreRender() override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       /// \brief Reset the particle emitter visual state
       public: virtual void Reset();
 
@@ -437,6 +441,13 @@ namespace gz
       if (_ratio > 0.0f)
         this->particleScatterRatio = _ratio;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseParticleEmitter<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
@@ -74,6 +74,10 @@ namespace gz
       // Documentation inherited
       public: void SetEnabled(bool _enabled) override;
 
+      /// \brief Always visited by PreRender so that its own updates run
+      /// \return True
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       /// \brief Projector's near clip plane
       protected: double nearClip = 0.1;
 
@@ -174,6 +178,13 @@ namespace gz
     {
       this->enabled = _enabled;
     }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseProjector<T>::PreRenderEveryFrame() const
+    {
+      return true;
+    }
     }
   }
 }
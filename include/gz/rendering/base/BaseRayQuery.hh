@@ -17,6 +17,9 @@
 #ifndef GZ_RENDERING_BASE_BASERAYQUERY_HH_
 #define GZ_RENDERING_BASE_BASERAYQUERY_HH_
 
+#include <vector>
+
+#include <gz/common/Console.hh>
 #include <gz/math/Matrix4.hh>
 #include <gz/math/Vector3.hh>
 
@@ -69,6 +72,13 @@ namespace gz
       public: virtual RayQueryResult ClosestPoint(
             bool _forceSceneUpdate = true) override;
 
+      // Documentation inherited
+      public: virtual void ClosestPoints(
+            const std::vector<math::Vector3d> &_origins,
+            const std::vector<math::Vector3d> &_directions,
+            std::vector<RayQueryResult> &_results,
+            bool _forceSceneUpdate = true) override;
+
       /// \brief Ray origin
       protected: math::Vector3d origin;
 
@@ -170,6 +180,37 @@ namespace gz
       result.distance = -1;
       return result;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseRayQuery<T>::ClosestPoints(
+        const std::vector<math::Vector3d> &_origins,
+        const std::vector<math::Vector3d> &_directions,
+        std::vector<RayQueryResult> &_results, bool _forceSceneUpdate)
+    {
+      _results.clear();
+      if (_origins.size() != _directions.size())
+      {
+        gzerr << "Number of ray origins [" << _origins.size() << "] and "
+              << "directions [" << _directions.size() << "] do not match"
+              << std::endl;
+        return;
+      }
+
+      // generic fallback: one query per ray, restoring the user's ray
+      // afterwards
+      math::Vector3d userOrigin = this->origin;
+      math::Vector3d userDirection = this->direction;
+      _results.reserve(_origins.size());
+      for (std::size_t i = 0; i < _origins.size(); ++i)
+      {
+        this->origin = _origins[i];
+        this->direction = _directions[i];
+        _results.push_back(this->ClosestPoint(_forceSceneUpdate && i == 0u));
+      }
+      this->origin = userOrigin;
+      this->direction = userDirection;
+    }
     }
   }
 }
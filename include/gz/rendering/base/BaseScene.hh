@@ -636,12 +636,33 @@ namespace gz
       public: virtual unsigned int ShadowTextureSize(LightType _lightType) const
                   override;
 
+      // Documentation inherited.
+      public: virtual void SetShadowCachingEnabled(bool _enabled) override;
+
+      // Documentation inherited.
+      public: virtual bool ShadowCachingEnabled() const override;
+
+      // Documentation inherited.
+      public: virtual void SetShadowMapRefreshBudget(unsigned int _budget)
+                  override;
+
+      // Documentation inherited.
+      public: virtual unsigned int ShadowMapRefreshBudget() const override;
+
       // Documentation inherited.
       public: virtual void SetActiveGlobalIllumination(
             GlobalIlluminationBasePtr _gi) override;
 
       public: virtual void PreRender() override;
 
+      /// \brief Notify the scene that a material in use may have gained
+      /// shaders, either because shaders were set on it or because a sub-mesh
+      /// was given a material with shaders. Visuals whose materials use
+      /// shaders are pre-rendered every frame to update the shader
+      /// parameters, so the next PreRender visits every visual to find them
+      /// again.
+      public: void SetShaderMaterialsDirty();
+
       public: virtual void Clear() override;
 
       public: virtual void Destroy() override;
@@ -981,6 +1002,10 @@ namespace gz
       /// \brief Scene background material.
       protected: MaterialPtr backgroundMaterial;
 
+      /// \brief True if the next PreRender needs to visit every visual,
+      /// \sa SetShaderMaterialsDirty
+      protected: bool shaderMaterialsDirty = false;
+
       private: unsigned int nextObjectId;
 
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
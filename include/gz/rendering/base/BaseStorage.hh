@@ -17,9 +17,12 @@
 #ifndef GZ_RENDERING_BASE_BASESTORAGE_HH_
 #define GZ_RENDERING_BASE_BASESTORAGE_HH_
 
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
@@ -95,6 +98,7 @@ namespace gz
       typedef std::shared_ptr<U> UPtr;
 
       typedef std::map<std::string, int> UStoreMap;
+      typedef std::unordered_map<unsigned int, std::size_t> UStoreIdMap;
       typedef std::vector<UPtr> UStore;
 
       typedef typename UStore::iterator UIter;
@@ -233,7 +237,13 @@ namespace gz
       protected: virtual UIter RemoveConstness(ConstUIter _iter);
 
       protected: UStore store;
+
+      /// \brief Map of object name to its index in the store
       protected: UStoreMap storeMap;
+
+      /// \brief Map of object id to its index in the store. Kept in sync
+      /// with the store so that lookups by id do not need to walk the store.
+      protected: UStoreIdMap storeIdMap;
     };
 
     //////////////////////////////////////////////////
@@ -732,6 +742,7 @@ namespace gz
     {
       this->store.clear();
       this->storeMap.clear();
+      this->storeIdMap.clear();
     }
 
     //////////////////////////////////////////////////
@@ -859,18 +870,20 @@ namespace gz
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIter(ConstTPtr _object) const
     {
-      auto begin = this->store.begin();
-      auto end = this->store.end();
+      if (!_object)
+      {
+        return this->store.end();
+      }
 
-      for (auto iter = begin; iter != end; ++iter)
+      // ids are unique within a store, so only the object stored under the
+      // same id can be a match
+      auto iter = this->ConstIterById(_object->Id());
+      if (this->IsValidIter(iter) && *iter == _object)
       {
-        if (*iter == _object)
-        {
-          return iter;
-        }
+        return iter;
       }
 
-      return end;
+      return this->store.end();
     }
 
     //////////////////////////////////////////////////
@@ -878,18 +891,15 @@ namespace gz
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIterById(unsigned int _id) const
     {
-      auto begin = this->store.begin();
-      auto end = this->store.end();
-
-      for (auto iter = begin; iter != end; ++iter)
+      auto idx = this->storeIdMap.find(_id);
+      if (idx == this->storeIdMap.end())
       {
-        if ((*iter)->Id() == _id)
-        {
-          return iter;
-        }
+        return this->store.end();
       }
 
-      return end;
+      auto iter = this->store.begin();
+      std::advance(iter, idx->second);
+      return iter;
     }
 
     //////////////////////////////////////////////////
@@ -978,6 +988,7 @@ namespace gz
       }
 
       this->storeMap[name] = this->store.size();
+      this->storeIdMap[id] = this->store.size();
       this->store.emplace_back(_object);
       return true;
     }
@@ -993,20 +1004,22 @@ namespace gz
       }
 
 
+      UPtr result = *_iter;
+      this->storeMap.erase(result->Name());
+      this->storeIdMap.erase(result->Id());
+
+      // Move the last object into the hole and pop the back so that only
+      // the moved object needs its indices patched. This does not preserve
+      // the index order of the remaining objects.
       auto idx = std::distance(this->store.begin(), _iter);
-      std::string nameToErase;
-      for (auto &[name, objIdx] : this->storeMap)
+      if (_iter != std::prev(this->store.end()))
       {
-        if (objIdx == idx)
-          nameToErase = name;
-
-        if (objIdx >= idx)
-          objIdx--;
+        *_iter = std::move(this->store.back());
+        const UPtr &moved = *_iter;
+        this->storeMap[moved->Name()] = static_cast<int>(idx);
+        this->storeIdMap[moved->Id()] = idx;
       }
-      this->storeMap.erase(nameToErase);
-
-      UPtr result = *_iter;
-      this->store.erase(_iter);
+      this->store.pop_back();
       return result;
     }
 
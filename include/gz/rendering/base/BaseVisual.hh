@@ -22,6 +22,8 @@
 
 #include <gz/math/AxisAlignedBox.hh>
 
+#include "gz/rendering/Material.hh"
+#include "gz/rendering/Mesh.hh"
 #include "gz/rendering/Visual.hh"
 #include "gz/rendering/Storage.hh"
 #include "gz/rendering/RenderEngine.hh"
@@ -128,6 +130,13 @@ namespace gz
 
       protected: virtual void PreRenderGeometries();
 
+      /// \brief A visual only needs to be visited every frame if it has
+      /// geometries that update themselves in PreRender, i.e. any geometry
+      /// other than a mesh, or a mesh with custom shaders whose parameters
+      /// may change at any time.
+      /// \return True if this visual must be visited every frame
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       protected: virtual GeometryStorePtr Geometries() const = 0;
 
       protected: virtual bool AttachGeometry(GeometryPtr _geometry) = 0;
@@ -215,6 +224,7 @@ namespace gz
       if (this->AttachGeometry(_geometry))
       {
         this->Geometries()->Add(_geometry);
+        this->SetPreRenderDirty();
       }
     }
 
@@ -225,6 +235,7 @@ namespace gz
       if (this->DetachGeometry(_geometry))
       {
         this->Geometries()->Remove(_geometry);
+        this->SetPreRenderDirty();
       }
       return _geometry;
     }
@@ -262,6 +273,7 @@ namespace gz
       this->SetChildMaterial(_material, false);
       this->SetGeometryMaterial(_material, false);
       this->material = _material;
+      this->SetPreRenderDirty();
     }
 
     //////////////////////////////////////////////////
@@ -311,8 +323,11 @@ namespace gz
     template <class T>
     void BaseVisual<T>::PreRender()
     {
+      if (!this->PreRenderRequired())
+        return;
+
+      // T::PreRender already visits the children
       T::PreRender();
-      this->PreRenderChildren();
       this->PreRenderGeometries();
     }
 
@@ -341,6 +356,8 @@ namespace gz
       for (auto it = children_->Begin(); it != children_->End(); ++it)
       {
         (*it)->PreRender();
+        if ((*it)->PreRenderRequired())
+          this->preRenderActive = true;
       }
     }
 
@@ -357,6 +374,32 @@ namespace gz
       }
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseVisual<T>::PreRenderEveryFrame() const
+    {
+      unsigned int count = this->GeometryCount();
+
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        MeshPtr mesh =
+            std::dynamic_pointer_cast<Mesh>(this->GeometryByIndex(i));
+        if (!mesh)
+          return true;
+
+        for (unsigned int j = 0; j < mesh->SubMeshCount(); ++j)
+        {
+          MaterialPtr mat = mesh->SubMeshByIndex(j)->Material();
+          if (mat && (!mat->VertexShader().empty() ||
+              !mat->FragmentShader().empty()))
+          {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     bool BaseVisual<T>::Wireframe() const
@@ -65,6 +65,13 @@ namespace gz
       public: virtual void SetPoint(unsigned int _index,
                            const gz::math::Vector3d &_value) override;
 
+      // Documentation inherited
+      public: virtual void SetPoints(std::size_t _offset, std::size_t _count,
+                  const float *_xyz, const uint32_t *_rgba = nullptr) override;
+
+      // Documentation inherited
+      public: virtual unsigned int PointCount() const override;
+
       // Documentation inherited
       public: virtual void AddPoint(const gz::math::Vector3d &_pt,
                            const gz::math::Color &_color) override;
@@ -19,6 +19,7 @@
 
 #include <gz/math/Color.hh>
 
+#include "gz/rendering/Image.hh"
 #include "gz/rendering/base/BaseRenderTypes.hh"
 #include "gz/rendering/base/BaseRenderTarget.hh"
 #include "gz/rendering/ogre/OgreRenderTypes.hh"
@@ -126,6 +127,11 @@ namespace gz
 
       /// \brief visibility mask associated with this render target
       protected: uint32_t visibilityMask = GZ_VISIBILITY_ALL;
+
+      /// \brief Color image read back from the gpu when copying to a format
+      /// that is converted on the cpu, e.g. bayer. Kept between copies so
+      /// that it is only allocated when the size changes.
+      protected: mutable Image colorImage;
     };
 
     class GZ_RENDERING_OGRE_VISIBLE OgreRenderTexture :
@@ -16,6 +16,7 @@
  */
 
 #include "gz/rendering/InstallationDirectories.hh"
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre/OgreCamera.hh"
 #include "gz/rendering/ogre/OgreConversions.hh"
 #include "gz/rendering/ogre/OgreIncludes.hh"
@@ -132,6 +133,7 @@ void OgreCamera::SetMaterial(const MaterialPtr &_material)
 //////////////////////////////////////////////////
 void OgreCamera::Render()
 {
+  GZ_RENDERING_PROFILE("OgreCamera::Render");
   this->renderTexture->Render();
 }
 
@@ -45,7 +45,19 @@ const Ogre::PixelFormat OgreConversions::ogrePixelFormats[PF_COUNT] =
       // PF_FLOAT32_RGB
       Ogre::PF_FLOAT32_RGB,
       // PF_L16
-      Ogre::PF_L16
+      Ogre::PF_L16,
+      // PF_R8G8B8A8
+      Ogre::PF_BYTE_RGBA,
+      // PF_NV12
+      Ogre::PF_BYTE_RGB,
+      // PF_I420
+      Ogre::PF_BYTE_RGB,
+      // PF_YUYV
+      Ogre::PF_BYTE_RGB,
+      // PF_FLOAT16_R
+      Ogre::PF_FLOAT16_R,
+      // PF_FLOAT32_RG
+      Ogre::PF_FLOAT32_GR
     };
 
 //////////////////////////////////////////////////
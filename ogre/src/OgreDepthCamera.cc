@@ -26,6 +26,7 @@
 #include <gz/math/Matrix4.hh>
 
 #include "gz/rendering/InstallationDirectories.hh"
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre/OgreConversions.hh"
 #include "gz/rendering/ogre/OgreDepthCamera.hh"
 #include "gz/rendering/ogre/OgreMaterial.hh"
@@ -326,6 +327,7 @@ void OgreDepthCamera::PreRender()
 //////////////////////////////////////////////////
 void OgreDepthCamera::Render()
 {
+  GZ_RENDERING_PROFILE("OgreDepthCamera::Render");
   Ogre::SceneManager *sceneMgr = this->scene->OgreSceneManager();
   Ogre::ShadowTechnique shadowTech = sceneMgr->getShadowTechnique();
 
@@ -429,6 +431,7 @@ void OgreDepthCamera::UpdateRenderTarget(OgreRenderTexturePtr _target,
 //////////////////////////////////////////////////
 void OgreDepthCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("OgreDepthCamera::PostRender");
   unsigned int width = this->ImageWidth();
   unsigned int height = this->ImageHeight();
   unsigned int len = width * height;
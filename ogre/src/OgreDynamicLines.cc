@@ -160,7 +160,10 @@ void OgreDynamicLines::FillHardwareBuffers()
 
   Ogre::Real *prPos =
     static_cast<Ogre::Real*>(vbuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
+  if (size)
   {
+    // points may have moved inwards, start from an empty box
+    this->mBox.setNull();
     for (int i = 0; i < size; i++)
     {
       *prPos++ = this->dataPtr->points[i].X();
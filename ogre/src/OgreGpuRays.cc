@@ -22,6 +22,7 @@
 #include <gz/math/Helpers.hh>
 #include <gz/math/Vector3.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/RenderTypes.hh"
 #include "gz/rendering/ogre/OgreCamera.hh"
 #include "gz/rendering/ogre/OgreGpuRays.hh"
@@ -620,6 +621,7 @@ void OgreGpuRays::UpdateRenderTarget(Ogre::RenderTarget *_target,
 //////////////////////////////////////////////////
 void OgreGpuRays::Render()
 {
+  GZ_RENDERING_PROFILE("OgreGpuRays::Render");
   Ogre::SceneManager *sceneMgr = this->scene->OgreSceneManager();
 
   sceneMgr->_suppressRenderStateChanges(true);
@@ -670,6 +672,7 @@ void OgreGpuRays::PreRender()
 //////////////////////////////////////////////////
 void OgreGpuRays::PostRender()
 {
+  GZ_RENDERING_PROFILE("OgreGpuRays::PostRender");
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     auto rt =
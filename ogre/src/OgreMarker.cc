@@ -230,6 +230,45 @@ void OgreMarker::SetPoint(unsigned int _index,
   this->dataPtr->dynamicRenderable->SetPoint(_index, _value);
 }
 
+//////////////////////////////////////////////////
+void OgreMarker::SetPoints(std::size_t _offset, std::size_t _count,
+    const float *_xyz, const uint32_t *_rgba)
+{
+  auto &lines = this->dataPtr->dynamicRenderable;
+  const std::size_t pointCount = lines->PointCount();
+  if (_offset > pointCount ||
+      (!_xyz && _offset + _count > pointCount))
+  {
+    gzerr << "Point range [" << _offset << ", " << _offset + _count
+          << ") is out of bounds[0-" << pointCount << "]" << std::endl;
+    return;
+  }
+
+  math::Color color;
+  for (std::size_t i = 0u; i < _count; ++i)
+  {
+    const auto index = static_cast<unsigned int>(_offset + i);
+    if (_rgba)
+      color.SetFromRGBA(_rgba[i]);
+    else
+      color = math::Color::White;
+
+    if (index >= pointCount)
+    {
+      lines->AddPoint(_xyz[i*3], _xyz[i*3+1], _xyz[i*3+2], color);
+      continue;
+    }
+
+    if (_xyz)
+    {
+      lines->SetPoint(index,
+          math::Vector3d(_xyz[i*3], _xyz[i*3+1], _xyz[i*3+2]));
+    }
+    if (_rgba)
+      lines->SetColor(index, color);
+  }
+}
+
 //////////////////////////////////////////////////
 void OgreMarker::AddPoint(const math::Vector3d &_pt,
     const math::Color &_color)
@@ -237,6 +276,12 @@ void OgreMarker::AddPoint(const math::Vector3d &_pt,
   this->dataPtr->dynamicRenderable->AddPoint(_pt, _color);
 }
 
+//////////////////////////////////////////////////
+unsigned int OgreMarker::PointCount() const
+{
+  return this->dataPtr->dynamicRenderable->PointCount();
+}
+
 //////////////////////////////////////////////////
 void OgreMarker::ClearPoints()
 {
@@ -576,6 +576,9 @@ void OgreMaterial::SetVertexShader(const std::string &_path)
 
   this->vertexShaderPath = _path;
   this->vertexShaderParams.reset(new ShaderParams);
+
+  // visuals using this material now update its shader params every frame
+  this->scene->SetShaderMaterialsDirty();
 }
 
 //////////////////////////////////////////////////
@@ -627,6 +630,9 @@ void OgreMaterial::SetFragmentShader(const std::string &_path)
 
   this->fragmentShaderPath = _path;
   this->fragmentShaderParams.reset(new ShaderParams);
+
+  // visuals using this material now update its shader params every frame
+  this->scene->SetShaderMaterialsDirty();
 }
 
 //////////////////////////////////////////////////
@@ -26,6 +26,7 @@
 
 #include <gz/math/Matrix4.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre/OgreConversions.hh"
 #include "gz/rendering/ogre/OgreIncludes.hh"
 #include "gz/rendering/ogre/OgreMesh.hh"
@@ -127,6 +128,7 @@ void OgreMeshFactory::ClearMaterialsCache(const std::string &_name)
 //////////////////////////////////////////////////
 bool OgreMeshFactory::LoadImpl(const MeshDescriptor &_desc)
 {
+  GZ_RENDERING_PROFILE("OgreMeshFactory::LoadImpl");
   Ogre::MeshPtr ogreMesh;
   std::string name;
   std::string group;
@@ -37,6 +37,7 @@
 
 #include "gz/rendering/Material.hh"
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre/OgreRenderEngine.hh"
 #include "gz/rendering/ogre/OgreRenderPass.hh"
 #include "gz/rendering/ogre/OgreConversions.hh"
@@ -83,20 +84,36 @@ void OgreRenderTarget::Copy(Image &_image) const
   }
 
   Ogre::PixelFormat imageFormat;
-  if ((_image.Format() == PF_BAYER_RGGB8) ||
+  const bool bayer = (_image.Format() == PF_BAYER_RGGB8) ||
       (_image.Format() == PF_BAYER_BGGR8) ||
       (_image.Format() == PF_BAYER_GBRG8) ||
-      (_image.Format() == PF_BAYER_GRBG8))
+      (_image.Format() == PF_BAYER_GRBG8);
+  const bool yuv = (_image.Format() == PF_NV12) ||
+      (_image.Format() == PF_I420) ||
+      (_image.Format() == PF_YUYV);
+  if (bayer || yuv)
   {
-    // create tmp color image to get data from gpu
+    // get color data from gpu into a reused image
+    if (this->colorImage.Width() != this->width ||
+        this->colorImage.Height() != this->height)
+    {
+      this->colorImage = Image(this->width, this->height, PF_R8G8B8);
+    }
     imageFormat = OgreConversions::Convert(PF_R8G8B8);
-    Image colorImage(this->width, this->height, PF_R8G8B8);
-    void *data =  colorImage.Data();
+    void *data = this->colorImage.Data();
     Ogre::PixelBox ogrePixelBox(
         this->width, this->height, 1, imageFormat, data);
     this->RenderTarget()->copyContentsToMemory(ogrePixelBox);
-    // convert color image to bayer image
-    _image = gz::rendering::convertRGBToBayer(colorImage, _image.Format());
+
+    // convert color image to bayer or yuv image
+    const bool converted = bayer ?
+        gz::rendering::convertRGBToBayer(this->colorImage, _image) :
+        gz::rendering::convertRGBToYUV(this->colorImage, _image);
+    if (!converted)
+    {
+      gzerr << "Failed to convert image to format ["
+            << PixelUtil::Name(_image.Format()) << "]" << std::endl;
+    }
   }
   else
   {
@@ -170,6 +187,7 @@ void OgreRenderTarget::PostRender()
 //////////////////////////////////////////////////
 void OgreRenderTarget::Render()
 {
+  GZ_RENDERING_PROFILE("OgreRenderTarget::Render");
   if (nullptr == this->RenderTarget())
     return;
 
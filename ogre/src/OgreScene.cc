@@ -17,6 +17,7 @@
 
 #include <gz/common/Console.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/base/SceneExt.hh"
 
 #include "gz/rendering/ogre/OgreArrowVisual.hh"
@@ -291,6 +292,7 @@ void OgreScene::RemoveGradientBackgroundColor()
 //////////////////////////////////////////////////
 void OgreScene::PreRender()
 {
+  GZ_RENDERING_PROFILE("OgreScene::PreRender");
   BaseScene::PreRender();
   OgreRTShaderSystem::Instance()->Update();
 }
@@ -26,6 +26,7 @@
 #include <limits>
 
 #include <gz/math/Helpers.hh>
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ShaderParams.hh"
 #include "gz/rendering/ogre/OgreThermalCamera.hh"
 #include "gz/rendering/ogre/OgreMaterial.hh"
@@ -532,6 +533,7 @@ void OgreThermalCamera::PreRender()
 //////////////////////////////////////////////////
 void OgreThermalCamera::Render()
 {
+  GZ_RENDERING_PROFILE("OgreThermalCamera::Render");
   // render heat source
   Ogre::RenderTarget *heatRt =
       this->dataPtr->ogreHeatSourceTexture->getBuffer()->getRenderTarget();
@@ -546,6 +548,7 @@ void OgreThermalCamera::Render()
 //////////////////////////////////////////////////
 void OgreThermalCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("OgreThermalCamera::PostRender");
   if (this->dataPtr->newThermalFrame.ConnectionCount() <= 0u)
     return;
 
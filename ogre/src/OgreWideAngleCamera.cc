@@ -34,6 +34,7 @@
 
 #include "gz/rendering/CameraLens.hh"
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre/OgreWideAngleCamera.hh"
 
 #include "gz/rendering/ogre/OgreConversions.hh"
@@ -562,6 +563,7 @@ void OgreWideAngleCamera::UpdateRenderPassChain()
 //////////////////////////////////////////////////
 void OgreWideAngleCamera::Render()
 {
+  GZ_RENDERING_PROFILE("OgreWideAngleCamera::Render");
   for (unsigned int i = 0u; i < this->dataPtr->kEnvCameraCount; ++i)
   {
     this->dataPtr->envRenderTargets[i]->update();
@@ -779,6 +781,7 @@ std::vector<Ogre::Camera *> OgreWideAngleCamera::OgreEnvCameras() const
 //////////////////////////////////////////////////
 void OgreWideAngleCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("OgreWideAngleCamera::PostRender");
   if (this->dataPtr->newImageFrame.ConnectionCount() <= 0u)
     return;
 
@@ -110,7 +110,7 @@ namespace gz
       public: void BoundingBoxes3D();
 
       /// \brief Get minimal bounding box of the mesh by projecting the 3d
-      /// vertices of the vertex buffer to 2d, then get the min & max of x & y
+      /// vertices of its convex hull to 2d, then get the min & max of x & y
       /// \param[in] _mesh Mesh of the item to get its minimal bbox
       /// \param[in] _viewMatrix Camera view matrix
       /// \param[in] _projMatrix Camera projection matrix
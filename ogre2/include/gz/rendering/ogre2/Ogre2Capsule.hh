@@ -66,7 +66,11 @@ namespace gz
         public: virtual void
           SetMaterial(MaterialPtr _material, bool _unique) override;
 
-        /// \brief Update the capsule geometry in ogre
+        /// \brief Create the ogre mesh of the capsule
+        private: void CreateMesh();
+
+        /// \brief Update the vertices of the capsule mesh to its current
+        /// radius and length
         private: void Update();
 
         /// \brief Capsule should only be created by scene.
@@ -112,6 +112,10 @@ namespace gz
           std::function<void(const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber) override;
 
+      // Documentation inherited.
+      public: virtual gz::common::ConnectionPtr ConnectNewDepthFrameView(
+          std::function<void(const SensorFrameView &)> _subscriber) override;
+
       /// \brief Implementation of the render call
       public: virtual void Render() override;
 
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2DISTORTIONPASS_HH_
+#define GZ_RENDERING_OGRE2_OGRE2DISTORTIONPASS_HH_
+
+#include <memory>
+
+#include "gz/rendering/base/BaseDistortionPass.hh"
+#include "gz/rendering/ogre2/Ogre2RenderPass.hh"
+#include "gz/rendering/ogre2/Export.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    // forward declaration
+    class Ogre2DistortionPassPrivate;
+
+    /* \class Ogre2DistortionPass Ogre2DistortionPass.hh \
+     * gz/rendering/ogre2/Ogre2DistortionPass.hh
+     */
+    /// \brief Ogre2 Implementation of a lens distortion render pass.
+    ///
+    /// The distortion map is computed on the Ogre worker threads the first
+    /// time the pass is rendered, and again only when the distortion
+    /// parameters or the camera resolution or field of view change. Maps
+    /// are shared by all passes with the same parameters.
+    class GZ_RENDERING_OGRE2_VISIBLE Ogre2DistortionPass :
+      public BaseDistortionPass<Ogre2RenderPass>
+    {
+      /// \brief Constructor
+      public: Ogre2DistortionPass();
+
+      /// \brief Destructor
+      public: virtual ~Ogre2DistortionPass();
+
+      // Documentation inherited
+      public: virtual void PreRender(const CameraPtr &_camera) override;
+
+      // Documentation inherited
+      public: void Destroy() override;
+
+      // Documentation inherited
+      public: void CreateRenderPass() override;
+
+      /// \brief Pointer to private data class
+      private: std::unique_ptr<Ogre2DistortionPassPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -95,6 +95,20 @@ namespace gz
       public: void SetPoint(unsigned int _index,
                             const gz::math::Vector3d &_value);
 
+      /// \brief Set the positions and colors of a range of points. Points at
+      /// or past the current number of points are added. Only the modified
+      /// range is written to the vertex buffer on the next update.
+      /// \param[in] _offset Index of the first point to set, must not be
+      /// greater than PointCount()
+      /// \param[in] _count Number of points to set
+      /// \param[in] _xyz 3 * _count floats holding the positions of the
+      /// points, or null to leave them unchanged
+      /// \param[in] _rgba _count colors packed as by math::Color::AsRGBA, or
+      /// null to leave them unchanged
+      /// \sa Marker::SetPoints
+      public: void SetPoints(std::size_t _offset, std::size_t _count,
+                             const float *_xyz, const uint32_t *_rgba);
+
       /// \brief Change the color of an existing point in the point list
       /// \param[in] _index Index of the point to set
       /// \param[in] _color color to set the point to
@@ -140,10 +154,12 @@ namespace gz
       /// \brief Helper function to generate colors per-vertex. Only applies
       /// to points. The colors fill the normal slots on the vertex buffer.
       /// \param[in] _opType Ogre render operation type
-      /// \param[in] _vertices a list of vertices
-      /// \param[in,out] _vbuffer vertex buffer to be filled
+      /// \param[in] _begin Index of the first vertex to fill
+      /// \param[in] _end Index past the last vertex to fill
+      /// \param[in,out] _vbuffer vertex buffer to be filled, starting at
+      /// vertex _begin
       private: void GenerateColors(Ogre::OperationType _opType,
-          const std::vector<math::Vector3d> &_vertices, float *_vbuffer);
+          std::size_t _begin, std::size_t _end, float *_vbuffer);
 
       /// \brief Destroy the vertex buffer
       private: void DestroyBuffer();
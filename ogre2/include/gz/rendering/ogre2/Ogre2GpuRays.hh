@@ -98,6 +98,11 @@ namespace gz
                   unsigned int _height, unsigned int _channels,
                   const std::string &_format)> _subscriber) override;
 
+      // Documentation inherited.
+      public: virtual common::ConnectionPtr ConnectNewGpuRaysFrameView(
+                  std::function<void(const SensorFrameView &)> _subscriber)
+                  override;
+
       // Documentation inherited.
       public: virtual RenderTargetPtr RenderTarget() const override;
 
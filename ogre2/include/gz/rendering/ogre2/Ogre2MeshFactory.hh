@@ -23,6 +23,7 @@
 
 #include "gz/rendering/config.hh"
 #include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
 #include "gz/rendering/ogre2/Ogre2Mesh.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTypes.hh"
 #include "gz/rendering/ogre2/Export.hh"
@@ -57,6 +58,14 @@ namespace gz
       /// mesh
       public: virtual Ogre2MeshPtr Create(const MeshDescriptor &_desc);
 
+      /// \brief Create a mesh from an ogre mesh built by the caller, e.g.
+      /// one whose vertex buffers the caller updates. The caller keeps
+      /// ownership of the ogre mesh and removes it from the ogre mesh
+      /// manager once the mesh is destroyed.
+      /// \param[in] _ogreMesh Ogre mesh to create an item of
+      /// \return The new mesh, null if no item could be created
+      public: Ogre2MeshPtr Create(const Ogre::MeshPtr &_ogreMesh);
+
       /// \brief Cleanup and clear all internal ogre v2 meshes created by this
       /// factory
       public: virtual void Clear();
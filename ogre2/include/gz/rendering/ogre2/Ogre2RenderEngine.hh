@@ -138,7 +138,12 @@ namespace gz
       /// \return list of scenes
       protected: virtual SceneStorePtr Scenes() const override;
 
-      // Documentation Inherited.
+      /// \brief Engine implementation of Load function.
+      /// \param[in] _params Parameters to be passed to the render engine.
+      /// In addition to the graphics API and context parameters, accepts:
+      /// "shaderCachePath" : Directory where compiled shaders are saved when
+      ///                     the engine is destroyed and loaded from at
+      ///                     startup. Caching is disabled if not set.
       protected: virtual bool LoadImpl(
           const std::map<std::string, std::string> &_params) override;
 
@@ -40,8 +40,10 @@
 
 namespace Ogre
 {
+  class CompositorWorkspace;
   class Root;
   class SceneManager;
+  class SceneNode;
 }
 
 namespace gz
@@ -110,6 +112,19 @@ namespace gz
       public: unsigned int ShadowTextureSize(LightType _lightType) const
             override;
 
+      // Documentation inherited
+      public: virtual void SetShadowCachingEnabled(bool _enabled) override;
+
+      // Documentation inherited
+      public: virtual bool ShadowCachingEnabled() const override;
+
+      // Documentation inherited
+      public: virtual void SetShadowMapRefreshBudget(unsigned int _budget)
+            override;
+
+      // Documentation inherited
+      public: virtual unsigned int ShadowMapRefreshBudget() const override;
+
       // Documentation inherited
       public: virtual void SetActiveGlobalIllumination(
             GlobalIlluminationBasePtr _gi) override;
@@ -211,6 +226,35 @@ namespace gz
       /// \return True if the number of shadow casting lights changed
       /// \sa ShadowsDirty
       public: bool ShadowsDirty() const;
+
+      /// \internal
+      /// \brief Invalidate the cached shadow maps of the lights reaching
+      /// the shadow casters attached to a node or to its children. Call it
+      /// before and after changing the node so both its old and new bounds
+      /// are covered. Does nothing when shadow caching is disabled.
+      /// \param[in] _node Node about to change or that just changed
+      /// \sa SetShadowCachingEnabled
+      public: void SetShadowCasterDirty(Ogre::SceneNode *_node);
+
+      /// \internal
+      /// \brief Bring the shadow node of a workspace up to date with the
+      /// cached shadow maps: fix the cached lights to their shadow maps and
+      /// flag the ones to render again this frame. Must be called before
+      /// updating a workspace using the scene shadow node.
+      /// \param[in] _workspace Workspace about to be updated
+      public: void UpdateShadowCache(Ogre::CompositorWorkspace *_workspace);
+
+      /// \internal
+      /// \brief Create a mesh from an ogre mesh built by the caller, e.g.
+      /// one whose vertex buffers the caller updates. The caller keeps
+      /// ownership of the ogre mesh. CPU ray queries intersect the
+      /// common::Mesh registered in common::MeshManager under the name of
+      /// the ogre mesh.
+      /// \param[in] _ogreMesh Ogre mesh to create an item of
+      /// \param[in] _desc Descriptor of the mesh
+      /// \return The new mesh, null on failure
+      public: Ogre2MeshPtr CreateMeshFromOgre(const Ogre::MeshPtr &_ogreMesh,
+                  const MeshDescriptor &_desc);
       /// \endcond
 
       // Documentation inherited
@@ -402,7 +446,9 @@ namespace gz
           const;
 
       /// \brief Create a compositor shadow node with the same number of shadow
-      /// textures as the number of shadow casting lights
+      /// textures as the number of shadow casting lights. The definition is
+      /// only rebuilt, and the cameras told to recreate their compositors,
+      /// when the shadow maps it describes change.
       protected: void UpdateShadowNode();
 
       /// \brief Create ogre compositor shadow node definition. The function
@@ -96,6 +96,19 @@ namespace gz
       public: Ogre::Ray CameraToViewportRay(const math::Vector2d &_screenPos,
                                             uint32_t _faceIdx);
 
+      /// \brief Whether a cubemap face is rendered. Faces that the lens
+      /// never samples, like the back face of a 180 degree fisheye, are
+      /// skipped.
+      /// \param[in] _faceIdx Face index in range [0; 6).
+      /// See RayQuery::SetFromCamera for what each value means
+      /// \return True if the face is rendered
+      public: bool IsFaceRendered(uint32_t _faceIdx) const;
+
+      /// \brief Set whether the cubemap faces the lens never samples are
+      /// skipped. Enabled by default.
+      /// \param[in] _skip False to always render all six faces
+      public: void SetSkipUnsampledFaces(bool _skip);
+
       // Documentation inherited.
       public: virtual void PreRender() override;
 
@@ -189,6 +202,11 @@ namespace gz
       /// \brief Update the background material
       private: void UpdateBackgroundMaterial();
 
+      /// \brief Find the cubemap faces the final pass samples, given the
+      /// lens, field of view and image size. Only does work when one of
+      /// them changed.
+      private: void UpdateRenderedFaces();
+
       /// \brief Saves the CompositorPassSceneDef of each of the 6 passes
       /// defined in WideAngleCamera.compositor data file for later
       /// manipulation.
@@ -15,15 +15,19 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <map>
+#include <string>
+#include <vector>
 
 #ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable:5033)
+  #pragma warning(push, 0)
 #endif
-#include <OgreBitwise.h>
+#include <Threading/OgreUniformScalableTask.h>
 #ifdef _MSC_VER
-#pragma warning(pop)
+  #pragma warning(pop)
 #endif
 
 #include <gz/common/Console.hh>
@@ -34,6 +38,7 @@
 #include <gz/math/Matrix4.hh>
 #include <gz/math/OrientedBox.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/RenderTypes.hh"
 #include "gz/rendering/Utils.hh"
 #include "gz/rendering/ogre2/Ogre2BoundingBoxCamera.hh"
@@ -47,25 +52,49 @@
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 
 #include "Ogre2BoundingBoxMaterialSwitcher.hh"
+#include "Ogre2MeshHull.hh"
+#include "Ogre2TextureReadback.hh"
 
 using namespace gz;
 using namespace rendering;
 
 class gz::rendering::Ogre2BoundingBoxCameraPrivate
 {
-  /// \brief Merge a vector of 2D boxes. Used in multi-links model.
-  /// \param[in] _boxes Vector of 2D boxes
+  /// \brief Boundaries of an id mask in the ogre Ids map, in pixels
+  public: struct BoxBoundary
+  {
+    /// \brief Minimum x, larger than maxX if the id was not found
+    uint32_t minX = std::numeric_limits<uint32_t>::max();
+
+    /// \brief Minimum y
+    uint32_t minY = std::numeric_limits<uint32_t>::max();
+
+    /// \brief Maximum x
+    uint32_t maxX = 0;
+
+    /// \brief Maximum y
+    uint32_t maxY = 0;
+  };
+
+  /// \brief Merge the 2D boxes of a model. Used in multi-links model.
+  /// \param[in] _ids Ids of the boxes to merge
   /// \return Merged bounding box
-  public: BoundingBox MergeBoxes2D(
-    const std::vector<std::shared_ptr<BoundingBox>> &_boxes);
+  public: BoundingBox MergeBoxes2D(const std::vector<uint32_t> &_ids);
 
-  /// \brief Get the 3d vertices (in world coord.) of the item's that
-  /// belongs to the same parent (only used in multi-links models)
-  /// \param[in] _ogreIds vector of ogre ids that belongs to the same model
+  /// \brief Get the 3d vertices (in camera coord.) of the convex hulls of
+  /// the item's that belongs to the same parent (only used in multi-links
+  /// models)
+  /// \param[in] _items items that belongs to the same model
   /// \param[out] _vertices vector of 3d vertices of the item
-  public: void MeshVertices(const std::vector<uint32_t> &_ogreIds,
+  public: void MeshVertices(const std::vector<Ogre::Item *> &_items,
               std::vector<math::Vector3d> &_vertices);
 
+  /// \brief Accumulate the boundaries and labels of the ids found in a
+  /// band of rows of the ogre Ids map
+  /// \param[in] _band Index of the band
+  /// \param[in] _bandCount Number of bands the image is split into
+  public: void AccumulateBand(size_t _band, size_t _bandCount);
+
   /// \brief Add a line to the viewport. If the line's endpoints are not inside
   /// the viewport, the added line will be a clipped line that fits in the
   /// viewport. If the line to be added doesn't intersect the viewport at all,
@@ -123,8 +152,15 @@ class gz::rendering::Ogre2BoundingBoxCameraPrivate
   /// \brief Texture to create the render texture from.
   public: Ogre::TextureGpu *ogreRenderTexture {nullptr};
 
-  /// \brief Buffer to store render texture data & to be sent to listeners
-  public: uint8_t *buffer = nullptr;
+  /// \brief Mapped ogre Ids map of the current frame, null outside of
+  /// PostRender
+  public: const uint8_t *idData = nullptr;
+
+  /// \brief Bytes per row of the mapped ogre Ids map
+  public: size_t idBytesPerRow = 0u;
+
+  /// \brief Bytes per pixel of the mapped ogre Ids map
+  public: size_t idBytesPerPixel = 0u;
 
   /// \brief Dummy render texture to set image dims
   public: Ogre2RenderTexturePtr dummyTexture {nullptr};
@@ -133,34 +169,39 @@ class gz::rendering::Ogre2BoundingBoxCameraPrivate
   public: common::EventT<void(const std::vector<BoundingBox> &)>
         newBoundingBoxes;
 
-  /// \brief Image / Render Texture Format
-  public: Ogre::PixelFormatGpu format = Ogre::PFG_RGBA8_UNORM;
+  /// \brief Image / Render Texture Format. 16 bits per channel, so ids
+  /// stored in two channels can address every item of a scene.
+  public: Ogre::PixelFormatGpu format = Ogre::PFG_RGBA16_UNORM;
+
+  /// \brief Label of background pixels, copied from the material switcher
+  public: uint32_t backgroundLabel = 0u;
 
-  /// \brief map ogreId id to bounding box
-  /// Key: ogreId, value: bounding box contains max & min boundaries
-  public: std::map<uint32_t, std::shared_ptr<BoundingBox>> boundingboxes;
+  /// \brief Boundaries of each id in the ogre Ids map, indexed by id.
+  /// Ids are the indices of the items in the material switcher.
+  public: std::vector<BoxBoundary> boundaries;
 
-  /// \brief Keep track of the visible bounding boxes (used in filtering)
-  /// Key: ogreId, value: label id
-  public: std::map<uint32_t, uint32_t> visibleBoxesLabel;
+  /// \brief Label of each id in the ogre Ids map, indexed by id. Set to the
+  /// background label for the ids that are not visible (used in filtering)
+  public: std::vector<uint32_t> visibleLabels;
 
-  /// \brief Map parent name of the visual to the boxes in it to merge them.
-  /// Used in multi-link models, as each parent contains many boxes in it.
-  /// Key: parent name, value: vector of boxes that belongs to that model.
-  public: std::map<std::string, std::vector<std::shared_ptr<BoundingBox>>>
-      parentNameToBoxes;
+  /// \brief Boundaries found in each band of rows, reused every frame
+  public: std::vector<std::vector<BoxBoundary>> bandBoundaries;
 
-  /// \brief Keep track of the visible bounding boxes (used in filtering)
-  /// Key: parent name, value: vector of ogre ids of it's childern
-  public: std::map<std::string, std::vector<uint32_t>> parentNameToOgreIds;
+  /// \brief Labels found in each band of rows, reused every frame
+  public: std::vector<std::vector<uint32_t>> bandLabels;
 
-  /// \brief The ogre item's 3d vertices from the vao(used in multi-link models)
-  /// Key: ogre id, value: vector of it's 3d vertices(pointcloud or mesh points)
-  public: std::map<uint32_t, std::vector<math::Vector3d>> itemVertices;
+  /// \brief Bounding box of each id, indexed by id. Only valid where
+  /// hasBox is set.
+  public: std::vector<BoundingBox> boxes;
 
-  /// \brief Map ogre id to Ogre::Item (used in multi-link models)
-  /// Key: ogre id, value: ogre item pointer
-  public: std::map<uint32_t, Ogre::Item *> ogreIdToItem;
+  /// \brief Whether a bounding box was computed for each id
+  public: std::vector<uint8_t> hasBox;
+
+  /// \brief Map parent name of the visual to the ids of the boxes in it to
+  /// merge them. Used in multi-link models, as each parent contains many
+  /// boxes in it.
+  /// Key: parent name, value: vector of ids that belongs to that model.
+  public: std::map<std::string, std::vector<uint32_t>> parentNameToIds;
 
   /// \brief Output bounding boxes to notify listeners
   public: std::vector<BoundingBox> outputBoxes;
@@ -192,8 +233,78 @@ class gz::rendering::Ogre2BoundingBoxCameraPrivate
   /// LocationRelativeToViewPort methods.
   /// Binary representation of 1000
   private: const int kTop = 8;
+
+  /// \brief Reads back the ogre id texture from the GPU
+  public: Ogre2TextureReadback readback;
+};
+
+/// \brief Accumulates the boundaries of the ids in the ogre Ids map, with
+/// the rows of the image split in one band per worker thread
+class GZ_RENDERING_OGRE2_HIDDEN BoundingBoxIdTask final
+  : public Ogre::UniformScalableTask
+{
+  /// \brief Constructor
+  /// \param[in] _dataPtr Camera to accumulate the ids of
+  public: explicit BoundingBoxIdTask(Ogre2BoundingBoxCameraPrivate &_dataPtr)
+      : dataPtr(_dataPtr)
+  {
+  }
+
+  // Documentation inherited
+  public: void execute(size_t _threadId, size_t _numThreads) override
+  {
+    this->dataPtr.AccumulateBand(_threadId, _numThreads);
+  }
+
+  /// \brief Camera to accumulate the ids of
+  private: Ogre2BoundingBoxCameraPrivate &dataPtr;
 };
 
+/////////////////////////////////////////////////
+void Ogre2BoundingBoxCameraPrivate::AccumulateBand(size_t _band,
+    size_t _bandCount)
+{
+  const uint32_t height = this->ogreRenderTexture->getHeight();
+  const uint32_t width = this->ogreRenderTexture->getWidth();
+  const uint32_t firstRow = static_cast<uint32_t>(height * _band / _bandCount);
+  const uint32_t endRow =
+      static_cast<uint32_t>(height * (_band + 1u) / _bandCount);
+
+  std::vector<BoxBoundary> &bounds = this->bandBoundaries[_band];
+  std::vector<uint32_t> &labels = this->bandLabels[_band];
+  const uint32_t count = static_cast<uint32_t>(bounds.size());
+  const uint32_t background = this->backgroundLabel;
+
+  for (uint32_t y = firstRow; y < endRow; ++y)
+  {
+    const uint8_t *row = this->idData + y * this->idBytesPerRow;
+    for (uint32_t x = 0; x < width; ++x)
+    {
+      const uint16_t *pixel =
+          reinterpret_cast<const uint16_t *>(row + x * this->idBytesPerPixel);
+
+      uint32_t label = pixel[2];
+      if (label == background)
+        continue;
+
+      // get the id encoded in the first two channels. Items that are not
+      // drawn with the id material can give out of range ids
+      uint32_t id = pixel[0] | (static_cast<uint32_t>(pixel[1]) << 16);
+      if (id >= count)
+        continue;
+
+      if (labels[id] == background)
+        labels[id] = label;
+
+      BoxBoundary &boundary = bounds[id];
+      boundary.minX = std::min(boundary.minX, x);
+      boundary.minY = std::min(boundary.minY, y);
+      boundary.maxX = std::max(boundary.maxX, x);
+      boundary.maxY = std::max(boundary.maxY, y);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCameraPrivate::AddToViewportLines(
     const math::Vector4d &_bounds, const math::Vector2d &_p0,
@@ -406,15 +517,11 @@ void Ogre2BoundingBoxCamera::Destroy()
 {
   this->RemoveAllRenderPasses();
 
-  if (this->dataPtr->buffer)
-  {
-    delete [] this->dataPtr->buffer;
-    this->dataPtr->buffer = nullptr;
-  }
-
   if (!this->dataPtr->ogreCamera)
     return;
 
+  this->dataPtr->readback.Reset();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   Ogre::CompositorManager2 *ogreCompMgr =
@@ -521,7 +628,8 @@ void Ogre2BoundingBoxCamera::CreateBoundingBoxTexture()
     this->Name();
 
   float background = static_cast<float>(
-      this->dataPtr->materialSwitcher->backgroundLabel);
+      this->dataPtr->materialSwitcher->backgroundLabel) /
+      Ogre2BoundingBoxMaterialSwitcher::kChannelMax;
   auto backgroundColor = Ogre::ColourValue(background, background, background);
 
   // basic workspace consist of clear pass with the givin color &
@@ -545,6 +653,7 @@ void Ogre2BoundingBoxCamera::CreateBoundingBoxTexture()
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCamera::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2BoundingBoxCamera::Render");
   if (!this->scene)
   {
     gzerr << "Null scene." << std::endl;
@@ -574,6 +683,7 @@ void Ogre2BoundingBoxCamera::Render()
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2BoundingBoxCamera::PostRender");
   // return if no one is listening to the new frame
   if (this->dataPtr->newBoundingBoxes.ConnectionCount() == 0)
     return;
@@ -584,42 +694,20 @@ void Ogre2BoundingBoxCamera::PostRender()
     return;
   }
 
-  unsigned int width = this->ImageWidth();
-  unsigned int height = this->ImageHeight();
-
-  PixelFormat format = PF_R8G8B8;
-  unsigned int channelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
-  // raw gpu texture format is RGBA8
-  unsigned int rawChannelCount = 4u;
+  // The boxes are computed from the scene state of the frame being rendered,
+  // so the id image must come from the same frame. Asynchronous readback
+  // latency is therefore not supported by this camera.
+  Ogre::TextureBox box;
+  if (!this->dataPtr->readback.Read(this->dataPtr->ogreRenderTexture, box))
+    return;
+  this->readbackFrameId = this->dataPtr->readback.FrameId();
+  this->readbackFrameTime = this->dataPtr->readback.FrameTime();
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreRenderTexture, 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
-  uint8_t *imgBufferTmp = static_cast<uint8_t *>(box.data);
-  if (!this->dataPtr->buffer)
-  {
-    auto bufferSize = PixelUtil::MemorySize(format, width, height);
-    this->dataPtr->buffer = new uint8_t[bufferSize];
-  }
-
-  for (unsigned int row = 0; row < height; ++row)
-  {
-    // the texture box step size could be larger than our image buffer step
-    // size
-    unsigned int rawDataRowIdx = row * box.bytesPerRow / bytesPerChannel;
-    for (unsigned int column = 0; column < width; ++column)
-    {
-      unsigned int idx = (row * width * channelCount) +
-          column * channelCount;
-      unsigned int rawIdx = rawDataRowIdx +
-          column * rawChannelCount;
-
-      this->dataPtr->buffer[idx] = imgBufferTmp[rawIdx];
-      this->dataPtr->buffer[idx + 1] = imgBufferTmp[rawIdx + 1];
-      this->dataPtr->buffer[idx + 2] = imgBufferTmp[rawIdx + 2];
-    }
-  }
+  // the ids are read straight from the mapped texture, the texture box step
+  // size could be larger than the image width
+  this->dataPtr->idData = static_cast<const uint8_t *>(box.data);
+  this->dataPtr->idBytesPerRow = box.bytesPerRow;
+  this->dataPtr->idBytesPerPixel = box.bytesPerPixel;
 
   if (this->dataPtr->type == BoundingBoxType::BBT_VISIBLEBOX2D)
     this->VisibleBoundingBoxes();
@@ -628,13 +716,10 @@ void Ogre2BoundingBoxCamera::PostRender()
   else if (this->dataPtr->type == BoundingBoxType::BBT_BOX3D)
     this->BoundingBoxes3D();
 
-  this->dataPtr->boundingboxes.clear();
-  this->dataPtr->visibleBoxesLabel.clear();
-  this->dataPtr->parentNameToBoxes.clear();
-  this->dataPtr->parentNameToOgreIds.clear();
-  this->dataPtr->itemVertices.clear();
-  this->dataPtr->ogreIdToItem.clear();
-  this->dataPtr->materialSwitcher->ogreIdName.clear();
+  this->dataPtr->idData = nullptr;
+  this->dataPtr->readback.Unmap();
+
+  this->dataPtr->parentNameToIds.clear();
 
   this->dataPtr->newBoundingBoxes(this->dataPtr->outputBoxes);
 }
@@ -642,50 +727,77 @@ void Ogre2BoundingBoxCamera::PostRender()
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCamera::MarkVisibleBoxes()
 {
-  if (!this->dataPtr->buffer)
+  if (!this->dataPtr->idData)
   {
-    gzerr << "Null buffer" << std::endl;
+    gzerr << "Null ogre Ids map" << std::endl;
+    this->dataPtr->visibleLabels.clear();
+    this->dataPtr->hasBox.clear();
     return;
   }
 
-  uint32_t width = this->ImageWidth();
-  uint32_t height = this->ImageHeight();
-  uint32_t channelCount = 3;
+  const uint32_t count = static_cast<uint32_t>(
+      this->dataPtr->materialSwitcher->items.size());
+  const uint32_t background = this->dataPtr->materialSwitcher->backgroundLabel;
+  this->dataPtr->backgroundLabel = background;
+
+  // Each band of rows accumulates into its own arrays, which are then
+  // reduced. The arrays are indexed by id and reused from frame to frame.
+  Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
+  const size_t bandCount = std::max<size_t>(1u,
+      ogreSceneManager->getNumWorkerThreads());
+  this->dataPtr->bandBoundaries.resize(bandCount);
+  this->dataPtr->bandLabels.resize(bandCount);
+  for (size_t band = 0; band < bandCount; ++band)
+  {
+    this->dataPtr->bandBoundaries[band].assign(count,
+        Ogre2BoundingBoxCameraPrivate::BoxBoundary());
+    this->dataPtr->bandLabels[band].assign(count, background);
+  }
 
-  // Filter bounding boxes by looping over all pixels in ogre ids map
-  for (uint32_t y = 0; y < height; ++y)
+  BoundingBoxIdTask task(*this->dataPtr);
+  if (bandCount > 1u)
+    ogreSceneManager->executeUserScalableTask(&task, true);
+  else
+    task.execute(0u, 1u);
+
+  // bands are reduced in row order, so the label of an id is the one of its
+  // first pixel like when the image is scanned in a single pass
+  this->dataPtr->boundaries.assign(count,
+      Ogre2BoundingBoxCameraPrivate::BoxBoundary());
+  this->dataPtr->visibleLabels.assign(count, background);
+  for (size_t band = 0; band < bandCount; ++band)
   {
-    for (uint32_t x = 0; x < width; ++x)
+    const auto &bounds = this->dataPtr->bandBoundaries[band];
+    const auto &labels = this->dataPtr->bandLabels[band];
+    for (uint32_t id = 0; id < count; ++id)
     {
-      auto index = (y * width + x) * channelCount;
-
-      uint32_t label = this->dataPtr->buffer[index + 2];
-
-      if (label == this->dataPtr->materialSwitcher->backgroundLabel)
+      if (labels[id] == background)
         continue;
 
-      // get the ogre id encoded in 16 bit value
-      uint32_t ogreId1 = this->dataPtr->buffer[index + 1];
-      uint32_t ogreId2 = this->dataPtr->buffer[index + 0];
-      uint32_t ogreId = ogreId1 * 256 + ogreId2;
+      if (this->dataPtr->visibleLabels[id] == background)
+        this->dataPtr->visibleLabels[id] = labels[id];
 
-      // mark the ogreId as visible not to filter its bbox
-      if (!this->dataPtr->visibleBoxesLabel.count(ogreId))
-        this->dataPtr->visibleBoxesLabel[ogreId] = label;
+      auto &boundary = this->dataPtr->boundaries[id];
+      boundary.minX = std::min(boundary.minX, bounds[id].minX);
+      boundary.minY = std::min(boundary.minY, bounds[id].minY);
+      boundary.maxX = std::max(boundary.maxX, bounds[id].maxX);
+      boundary.maxY = std::max(boundary.maxY, bounds[id].maxY);
     }
   }
+
+  this->dataPtr->boxes.resize(count);
+  this->dataPtr->hasBox.assign(count, 0u);
 }
 
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCameraPrivate::MeshVertices(
-    const std::vector<uint32_t> &_ogreIds,
+    const std::vector<Ogre::Item *> &_items,
     std::vector<math::Vector3d> &_vertices)
 {
   auto viewMatrix = this->ogreCamera->getViewMatrix();
 
-  for (auto ogreId : _ogreIds)
+  for (Ogre::Item *item : _items)
   {
-    Ogre::Item *item = this->ogreIdToItem[ogreId];
     Ogre::MeshPtr mesh = item->getMesh();
     Ogre::Node *node = item->getParentNode();
 
@@ -693,68 +805,25 @@ void Ogre2BoundingBoxCameraPrivate::MeshVertices(
     Ogre::Quaternion oreintation = node->_getDerivedOrientation();
     Ogre::Vector3 scale = node->_getDerivedScale();
 
-    auto subMeshes = mesh->getSubMeshes();
-
-    for (const auto &subMesh : subMeshes)
+    // The merged box is fitted to the convex hull of the meshes, which is
+    // cached so only its vertices have to be transformed every frame
+    auto hull = Ogre2MeshHull::Get(mesh);
+    for (Ogre::Vector3 vec : hull->Vertices())
     {
-      Ogre::VertexArrayObjectArray vaos = subMesh->mVao[0];
+      // Convert to world coordinates
+      vec = (oreintation * (vec * scale)) + position;
 
-      if (!vaos.empty())
-      {
-        // Get the first LOD level
-        Ogre::VertexArrayObject *vao = vaos[0];
-
-        // request async read from buffer
-        Ogre::VertexArrayObject::ReadRequestsArray requests;
-        requests.push_back(Ogre::VertexArrayObject::ReadRequests(
-          Ogre::VES_POSITION));
-        vao->readRequests(requests);
-        vao->mapAsyncTickets(requests);
-
-        unsigned int subMeshVerticiesNum =
-          requests[0].vertexBuffer->getNumElements();
-        for (size_t i = 0; i < subMeshVerticiesNum; ++i)
-        {
-          Ogre::Vector3 vec;
-          if (requests[0].type == Ogre::VET_HALF4)
-          {
-            const Ogre::uint16* vertex = reinterpret_cast<const Ogre::uint16*>
-              (requests[0].data);
-            vec.x = Ogre::Bitwise::halfToFloat(vertex[0]);
-            vec.y = Ogre::Bitwise::halfToFloat(vertex[1]);
-            vec.z = Ogre::Bitwise::halfToFloat(vertex[2]);
-          }
-          else if (requests[0].type == Ogre::VET_FLOAT3)
-          {
-            const float* vertex =
-              reinterpret_cast<const float*>(requests[0].data);
-            vec.x = *vertex++;
-            vec.y = *vertex++;
-            vec.z = *vertex++;
-          }
-          else
-            gzerr << "Vertex Buffer type error" << std::endl;
-
-          // Convert to world coordinates
-          vec = (oreintation * (vec * scale)) + position;
-
-          // Convert to camera view coordiantes
-          Ogre::Vector4 vec4(vec.x, vec.y, vec.z, 1);
-          vec4 = viewMatrix * vec4;
-
-          vec.x = vec4.x;
-          vec.y = vec4.y;
-          vec.z = vec4.z;
-
-          // Add the vertex to the vertices of all items that
-          // belongs to the same parent
-          _vertices.push_back(Ogre2Conversions::Convert(vec));
-
-          // get the next element
-          requests[0].data += requests[0].vertexBuffer->getBytesPerElement();
-        }
-        vao->unmapAsyncTickets(requests);
-      }
+      // Convert to camera view coordiantes
+      Ogre::Vector4 vec4(vec.x, vec.y, vec.z, 1);
+      vec4 = viewMatrix * vec4;
+
+      vec.x = vec4.x;
+      vec.y = vec4.y;
+      vec.z = vec4.z;
+
+      // Add the vertex to the vertices of all items that
+      // belongs to the same parent
+      _vertices.push_back(Ogre2Conversions::Convert(vec));
     }
   }
 }
@@ -762,31 +831,38 @@ void Ogre2BoundingBoxCameraPrivate::MeshVertices(
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCamera::MergeMultiLinksModels3D()
 {
+  const auto &parentNames = this->dataPtr->materialSwitcher->parentNames;
+  const auto &items = this->dataPtr->materialSwitcher->items;
+
   // Combine the boxes with the same parent name together to merge them
-  for (const auto &box : this->dataPtr->boundingboxes)
+  for (uint32_t id = 0; id < this->dataPtr->hasBox.size(); ++id)
   {
-    auto ogreId = box.first;
-    auto parentName = this->dataPtr->materialSwitcher->ogreIdName[ogreId];
-    this->dataPtr->parentNameToOgreIds[parentName].push_back(ogreId);
+    if (this->dataPtr->hasBox[id])
+      this->dataPtr->parentNameToIds[parentNames[id]].push_back(id);
   }
 
+  std::vector<Ogre::Item *> modelItems;
+  std::vector<math::Vector3d> vertices;
+
   // Merge the boxes that is related to the same parent
-  for (const auto &nameToOgreIds : this->dataPtr->parentNameToOgreIds)
+  for (const auto &nameToIds : this->dataPtr->parentNameToIds)
   {
-    auto ogreIds = nameToOgreIds.second;
+    const auto &ids = nameToIds.second;
 
     // If not a multi-link model, add the 3d box from the OGRE API
-    if (ogreIds.size() == 1)
+    if (ids.size() == 1)
     {
-      auto box = this->dataPtr->boundingboxes[ogreIds[0]];
-      this->dataPtr->outputBoxes.push_back(*box);
+      this->dataPtr->outputBoxes.push_back(this->dataPtr->boxes[ids[0]]);
     }
     else
     {
-      std::vector<math::Vector3d> vertices;
+      modelItems.clear();
+      for (auto id : ids)
+        modelItems.push_back(items[id]);
+      vertices.clear();
 
       // Get all the 3D vertices of the sub-items(total mesh)
-      this->dataPtr->MeshVertices(ogreIds, vertices);
+      this->dataPtr->MeshVertices(modelItems, vertices);
 
       // Get the oriented bounding box from the mesh using PCA
       math::OrientedBoxd mergedBox = math::eigen3::verticesToOrientedBox(
@@ -798,7 +874,7 @@ void Ogre2BoundingBoxCamera::MergeMultiLinksModels3D()
       box.SetCenter(pose.Pos());
       box.SetOrientation(pose.Rot());
       box.SetSize(mergedBox.Size());
-      box.SetLabel(this->dataPtr->visibleBoxesLabel[ogreIds[0]]);
+      box.SetLabel(this->dataPtr->visibleLabels[ids[0]]);
 
       this->dataPtr->outputBoxes.push_back(box);
     }
@@ -812,18 +888,19 @@ void Ogre2BoundingBoxCamera::MergeMultiLinksModels3D()
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCamera::MergeMultiLinksModels2D()
 {
+  const auto &parentNames = this->dataPtr->materialSwitcher->parentNames;
+
   // Combine the boxes with the same parent name together to merge them
-  for (const auto &box : this->dataPtr->boundingboxes)
+  for (uint32_t id = 0; id < this->dataPtr->hasBox.size(); ++id)
   {
-    auto ogreId = box.first;
-    auto parentName = this->dataPtr->materialSwitcher->ogreIdName[ogreId];
-    this->dataPtr->parentNameToBoxes[parentName].push_back(box.second);
+    if (this->dataPtr->hasBox[id])
+      this->dataPtr->parentNameToIds[parentNames[id]].push_back(id);
   }
 
   // Merge the boxes that is related to the same parent
-  for (const auto &nameToBoxes : this->dataPtr->parentNameToBoxes)
+  for (const auto &nameToIds : this->dataPtr->parentNameToIds)
   {
-    auto mergedBox = this->dataPtr->MergeBoxes2D(nameToBoxes.second);
+    auto mergedBox = this->dataPtr->MergeBoxes2D(nameToIds.second);
 
     // Store boxes in the output vector
     this->dataPtr->outputBoxes.push_back(mergedBox);
@@ -836,10 +913,10 @@ void Ogre2BoundingBoxCamera::MergeMultiLinksModels2D()
 
 /////////////////////////////////////////////////
 BoundingBox Ogre2BoundingBoxCameraPrivate::MergeBoxes2D(
-        const std::vector<std::shared_ptr<BoundingBox>> &_boxes)
+        const std::vector<uint32_t> &_ids)
 {
-  if (_boxes.size() == 1)
-    return *_boxes[0];
+  if (_ids.size() == 1)
+    return this->boxes[_ids[0]];
 
   BoundingBox mergedBox;
   double minX = std::numeric_limits<double>::max();
@@ -847,12 +924,13 @@ BoundingBox Ogre2BoundingBoxCameraPrivate::MergeBoxes2D(
   double minY = std::numeric_limits<double>::max();
   double maxY = 0.0;
 
-  for (const auto &box : _boxes)
+  for (auto id : _ids)
   {
-    double boxMinX = box->Center().X() - box->Size().X() * 0.5;
-    double boxMaxX = box->Center().X() + box->Size().X() * 0.5;
-    double boxMinY = box->Center().Y() - box->Size().Y() * 0.5;
-    double boxMaxY = box->Center().Y() + box->Size().Y() * 0.5;
+    const BoundingBox &box = this->boxes[id];
+    double boxMinX = box.Center().X() - box.Size().X() * 0.5;
+    double boxMaxX = box.Center().X() + box.Size().X() * 0.5;
+    double boxMinY = box.Center().Y() - box.Size().Y() * 0.5;
+    double boxMaxY = box.Center().Y() + box.Size().Y() * 0.5;
 
     minX = std::min(minX, boxMinX);
     maxX = std::max(maxX, boxMaxX);
@@ -864,7 +942,7 @@ BoundingBox Ogre2BoundingBoxCameraPrivate::MergeBoxes2D(
   auto height = maxY - minY;
   mergedBox.SetSize({width, height, 0});
   mergedBox.SetCenter({minX + width * 0.5, minY + height * 0.5, 0});
-  mergedBox.SetLabel(_boxes[0]->Label());
+  mergedBox.SetLabel(this->boxes[_ids[0]].Label());
 
   return mergedBox;
 }
@@ -877,22 +955,15 @@ void Ogre2BoundingBoxCamera::BoundingBoxes3D()
   // used to filter the hidden boxes
   this->MarkVisibleBoxes();
 
-  auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
-      Ogre::ItemFactory::FACTORY_TYPE_NAME);
-  while (itor.hasMoreElements())
+  const auto &items = this->dataPtr->materialSwitcher->items;
+  const uint32_t background = this->dataPtr->backgroundLabel;
+  for (uint32_t id = 0; id < this->dataPtr->visibleLabels.size(); ++id)
   {
-    Ogre::MovableObject *object = itor.peekNext();
-    Ogre::Item *item = static_cast<Ogre::Item *>(object);
-    Ogre::MeshPtr mesh = item->getMesh();
-
-    uint32_t ogreId = item->getId();
-
     // Skip the items which is hidden from the ogreId map
-    if (!this->dataPtr->visibleBoxesLabel.count(ogreId))
-    {
-      itor.moveNext();
+    if (this->dataPtr->visibleLabels[id] == background)
       continue;
-    }
+
+    Ogre::Item *item = items[id];
 
     // get attached node
     Ogre::Node *node = item->getParentNode();
@@ -908,15 +979,9 @@ void Ogre2BoundingBoxCamera::BoundingBoxes3D()
     Ogre::AxisAlignedBox worldAabb;
     worldAabb.setExtents(aabb.getMinimum(), aabb.getMaximum());
     if (!this->dataPtr->ogreCamera->isVisible(worldAabb))
-    {
-      itor.moveNext();
       continue;
-    }
 
-    // Keep track of mesh, useful in multi-links models
-    this->dataPtr->ogreIdToItem[ogreId] = item;
-
-    auto box = std::make_shared<BoundingBox>();
+    BoundingBox &box = this->dataPtr->boxes[id];
 
     // Position in world coord
     Ogre::Vector3 position = worldAabb.getCenter();
@@ -925,8 +990,8 @@ void Ogre2BoundingBoxCamera::BoundingBoxes3D()
     Ogre::Vector3 viewPosition = viewMatrix * position;
 
     // Convert to gz::math
-    box->SetCenter(Ogre2Conversions::Convert(viewPosition));
-    box->SetSize(Ogre2Conversions::Convert(size));
+    box.SetCenter(Ogre2Conversions::Convert(viewPosition));
+    box.SetSize(Ogre2Conversions::Convert(size));
 
     // Compute the rotation of the box from its world rotation & view matrix
     auto worldCameraRotation = Ogre2Conversions::Convert(
@@ -935,19 +1000,10 @@ void Ogre2BoundingBoxCamera::BoundingBoxes3D()
 
     // Body to camera rotation = body_world * world_camera
     auto bodyCameraRotation = worldCameraRotation * bodyWorldRotation;
-    box->SetOrientation(bodyCameraRotation);
+    box.SetOrientation(bodyCameraRotation);
 
-    this->dataPtr->boundingboxes[ogreId] = box;
-    itor.moveNext();
-  }
-
-  // Set boxes labels
-  for (const auto &box : this->dataPtr->boundingboxes)
-  {
-    uint32_t ogreId = box.first;
-    uint32_t label = this->dataPtr->visibleBoxesLabel[ogreId];
-
-    box.second->SetLabel(label);
+    box.SetLabel(this->dataPtr->visibleLabels[id]);
+    this->dataPtr->hasBox[id] = 1u;
   }
 
   // Combine boxes of multi-links model if exists
@@ -957,85 +1013,28 @@ void Ogre2BoundingBoxCamera::BoundingBoxes3D()
 /////////////////////////////////////////////////
 void Ogre2BoundingBoxCamera::VisibleBoundingBoxes()
 {
-  if (!this->dataPtr->buffer)
-  {
-    gzerr << "Null buffer" << std::endl;
-    return;
-  }
-
-  uint32_t width = this->ImageWidth();
-  uint32_t height = this->ImageHeight();
-  uint32_t channelCount = 3;
-
-  struct BoxBoundary
-  {
-    uint32_t minX;
-    uint32_t minY;
-    uint32_t maxX;
-    uint32_t maxY;
-  };
-
-  std::unordered_map<uint32_t, std::shared_ptr<BoxBoundary>> boxesBoundary;
-
   // find item's boundaries from panoptic BoundingBox
-  for (uint32_t y = 0; y < height; y++)
-  {
-    for (uint32_t x = 0; x < width; x++)
-    {
-      auto index = (y * width + x) * channelCount;
-
-      uint32_t label = this->dataPtr->buffer[index + 2];
-      uint32_t ogreId1 = this->dataPtr->buffer[index + 1];
-      uint32_t ogreId2 = this->dataPtr->buffer[index + 0];
-
-      if (label != this->dataPtr->materialSwitcher->backgroundLabel)
-      {
-        // get the OGRE id of 16 bit value
-        uint32_t ogreId = ogreId1 * 256 + ogreId2;
-
-        std::shared_ptr<BoundingBox> box;
-        std::shared_ptr<BoxBoundary> boundary;
-
-        // create new boxes when its first pixel appears
-        if (!this->dataPtr->boundingboxes.count(ogreId))
-        {
-          box = std::make_shared<BoundingBox>();
-          box->SetLabel(label);
-
-          boundary = std::make_shared<BoxBoundary>();
-          boundary->minX = width;
-          boundary->minY = height;
-          boundary->maxX = 0;
-          boundary->maxY = 0;
-
-          boxesBoundary[ogreId] = boundary;
-          this->dataPtr->boundingboxes[ogreId] = box;
-        }
-        else
-        {
-          boundary = boxesBoundary[ogreId];
-        }
-
-        boundary->minX = std::min<uint32_t>(boundary->minX, x);
-        boundary->minY = std::min<uint32_t>(boundary->minY, y);
-        boundary->maxX = std::max<uint32_t>(boundary->maxX, x);
-        boundary->maxY = std::max<uint32_t>(boundary->maxY, y);
-      }
-    }
-  }
+  this->MarkVisibleBoxes();
 
-  for (const auto &box : this->dataPtr->boundingboxes)
+  const uint32_t background = this->dataPtr->backgroundLabel;
+  for (uint32_t id = 0; id < this->dataPtr->visibleLabels.size(); ++id)
   {
+    if (this->dataPtr->visibleLabels[id] == background)
+      continue;
+
     // Get the box's boundary
-    auto ogreId = box.first;
-    auto boundary = boxesBoundary[ogreId];
-    auto boxWidth = boundary->maxX - boundary->minX;
-    auto boxHeight = boundary->maxY - boundary->minY;
-
-    box.second->SetCenter({boundary->minX + boxWidth * 0.5,
-        boundary->minY + boxHeight * 0.5, 0});
-    box.second->SetSize(
+    const auto &boundary = this->dataPtr->boundaries[id];
+    auto boxWidth = boundary.maxX - boundary.minX;
+    auto boxHeight = boundary.maxY - boundary.minY;
+
+    BoundingBox &box = this->dataPtr->boxes[id];
+    box.SetLabel(this->dataPtr->visibleLabels[id]);
+    box.SetCenter({boundary.minX + boxWidth * 0.5,
+        boundary.minY + boxHeight * 0.5, 0});
+    box.SetSize(
         {static_cast<double>(boxWidth), static_cast<double>(boxHeight), 0.0});
+    box.SetOrientation(math::Quaterniond::Identity);
+    this->dataPtr->hasBox[id] = 1u;
   }
 
   // Combine boxes of multi-links model if exists
@@ -1051,22 +1050,16 @@ void Ogre2BoundingBoxCamera::FullBoundingBoxes()
   Ogre::Matrix4 viewMatrix = this->dataPtr->ogreCamera->getViewMatrix();
   Ogre::Matrix4 projMatrix = this->dataPtr->ogreCamera->getProjectionMatrix();
 
-  auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
-      Ogre::ItemFactory::FACTORY_TYPE_NAME);
-  while (itor.hasMoreElements())
+  const auto &items = this->dataPtr->materialSwitcher->items;
+  const uint32_t background = this->dataPtr->backgroundLabel;
+  for (uint32_t id = 0; id < this->dataPtr->visibleLabels.size(); ++id)
   {
-    Ogre::MovableObject *object = itor.peekNext();
-    Ogre::Item *item = static_cast<Ogre::Item *>(object);
-    Ogre::MeshPtr mesh = item->getMesh();
-
-    uint32_t ogreId = item->getId();
-
     // Skip the items which is hidden in the ogreId map
-    if (!this->dataPtr->visibleBoxesLabel.count(ogreId))
-    {
-      itor.moveNext();
+    if (this->dataPtr->visibleLabels[id] == background)
       continue;
-    }
+
+    Ogre::Item *item = items[id];
+    Ogre::MeshPtr mesh = item->getMesh();
 
     // get attached node
     Ogre::Node *node = item->getParentNode();
@@ -1082,10 +1075,7 @@ void Ogre2BoundingBoxCamera::FullBoundingBoxes()
 
     // filter the boxes outside the camera frustum
     if (!this->dataPtr->ogreCamera->isVisible(worldAabb))
-    {
-      itor.moveNext();
       continue;
-    }
 
     Ogre::Vector3 minVertex;
     Ogre::Vector3 maxVertex;
@@ -1104,31 +1094,20 @@ void Ogre2BoundingBoxCamera::FullBoundingBoxes()
     if ((abs(minVertex.x) > 1 && abs(maxVertex.x) > 1) ||
         (abs(minVertex.y) > 1 && abs(maxVertex.y) > 1))
     {
-      itor.moveNext();
       continue;
     }
 
     this->ConvertToScreenCoord(minVertex, maxVertex);
 
-    auto box = std::make_shared<BoundingBox>();
+    BoundingBox &box = this->dataPtr->boxes[id];
     auto boxWidth = maxVertex.x - minVertex.x;
     auto boxHeight = minVertex.y - maxVertex.y;
-    box->SetCenter(
+    box.SetCenter(
         {minVertex.x + boxWidth / 2, maxVertex.y + boxHeight / 2, 0});
-    box->SetSize({boxWidth, boxHeight, 0});
-
-    this->dataPtr->boundingboxes[ogreId] = box;
-
-    itor.moveNext();
-  }
-
-  // Set boxes label
-  for (auto box : this->dataPtr->boundingboxes)
-  {
-    uint32_t ogreId = box.first;
-    uint32_t label = this->dataPtr->visibleBoxesLabel[ogreId];
-
-    box.second->SetLabel(label);
+    box.SetSize({boxWidth, boxHeight, 0});
+    box.SetOrientation(math::Quaterniond::Identity);
+    box.SetLabel(this->dataPtr->visibleLabels[id]);
+    this->dataPtr->hasBox[id] = 1u;
   }
 
   // Combine boxes of multi-links model if exists
@@ -1154,71 +1133,30 @@ void Ogre2BoundingBoxCamera::MeshMinimalBox(
   _maxVertex.y = -std::numeric_limits<float>::max();
   _maxVertex.z = -std::numeric_limits<float>::max();
 
-  auto subMeshes = _mesh->getSubMeshes();
-
-  for (auto subMesh : subMeshes)
+  // The extremes of the projected vertices are always on the convex hull
+  // of the mesh, which is cached so only its vertices have to be projected
+  // every frame
+  const Ogre::Matrix4 viewProjMatrix = _projMatrix * _viewMatrix;
+  auto hull = Ogre2MeshHull::Get(_mesh);
+  for (Ogre::Vector3 vec : hull->Vertices())
   {
-    Ogre::VertexArrayObjectArray vaos = subMesh->mVao[0];
+    vec = (_orientation * (vec * _scale)) + _position;
 
-    if (!vaos.empty())
-    {
-      // Get the first LOD level
-      Ogre::VertexArrayObject *vao = vaos[0];
-
-      // request async read from buffer
-      Ogre::VertexArrayObject::ReadRequestsArray requests;
-      requests.push_back(Ogre::VertexArrayObject::ReadRequests(
-        Ogre::VES_POSITION));
-      vao->readRequests(requests);
-      vao->mapAsyncTickets(requests);
-
-      unsigned int subMeshVerticiesNum =
-        requests[0].vertexBuffer->getNumElements();
-      for (size_t i = 0; i < subMeshVerticiesNum; ++i)
-      {
-        Ogre::Vector3 vec;
-        if (requests[0].type == Ogre::VET_HALF4)
-        {
-          const Ogre::uint16* vertex = reinterpret_cast<const Ogre::uint16*>
-            (requests[0].data);
-          vec.x = Ogre::Bitwise::halfToFloat(vertex[0]);
-          vec.y = Ogre::Bitwise::halfToFloat(vertex[1]);
-          vec.z = Ogre::Bitwise::halfToFloat(vertex[2]);
-        }
-        else if (requests[0].type == Ogre::VET_FLOAT3)
-        {
-          const float* vertex =
-            reinterpret_cast<const float*>(requests[0].data);
-          vec.x = *vertex++;
-          vec.y = *vertex++;
-          vec.z = *vertex++;
-        }
-        else
-          gzerr << "Vertex Buffer type error" << std::endl;
-
-        vec = (_orientation * (vec * _scale)) + _position;
-
-        Ogre::Vector4 vec4(vec.x, vec.y, vec.z, 1);
-        vec4 =  _projMatrix * _viewMatrix * vec4;
-
-        // homogenous
-        vec.x = vec4.x / vec4.w;
-        vec.y = vec4.y / vec4.w;
-        vec.z = vec4.z;
-
-        _minVertex.x = std::min(_minVertex.x, vec.x);
-        _minVertex.y = std::min(_minVertex.y, vec.y);
-        _minVertex.z = std::min(_minVertex.z, vec.z);
-
-        _maxVertex.x = std::max(_maxVertex.x, vec.x);
-        _maxVertex.y = std::max(_maxVertex.y, vec.y);
-        _maxVertex.z = std::max(_maxVertex.z, vec.z);
-
-        // get the next element
-        requests[0].data += requests[0].vertexBuffer->getBytesPerElement();
-      }
-      vao->unmapAsyncTickets(requests);
-    }
+    Ogre::Vector4 vec4(vec.x, vec.y, vec.z, 1);
+    vec4 = viewProjMatrix * vec4;
+
+    // homogenous
+    vec.x = vec4.x / vec4.w;
+    vec.y = vec4.y / vec4.w;
+    vec.z = vec4.z;
+
+    _minVertex.x = std::min(_minVertex.x, vec.x);
+    _minVertex.y = std::min(_minVertex.y, vec.y);
+    _minVertex.z = std::min(_minVertex.z, vec.z);
+
+    _maxVertex.x = std::max(_maxVertex.x, vec.x);
+    _maxVertex.y = std::max(_maxVertex.y, vec.y);
+    _maxVertex.z = std::max(_maxVertex.z, vec.z);
   }
 }
 
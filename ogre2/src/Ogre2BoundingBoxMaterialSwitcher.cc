@@ -16,9 +16,13 @@
 */
 #include "Ogre2BoundingBoxMaterialSwitcher.hh"
 
+#include <algorithm>
+
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 
+#include "Ogre2TextBatch.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
@@ -87,7 +91,14 @@ VisualPtr Ogre2BoundingBoxMaterialSwitcher::TopLevelModelVisual(
 void Ogre2BoundingBoxMaterialSwitcher::cameraPreRenderScene(
     Ogre::Camera * /*_cam*/)
 {
+  // text batches belong to no visual, keep them out of the id map
+  Ogre2TextBatch::SetHiddenAll(this->scene->OgreSceneManager(), true);
+
   this->datablockMap.clear();
+  this->itemVisuals.clear();
+  this->items.clear();
+  this->parentNames.clear();
+
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
 
@@ -110,59 +121,75 @@ void Ogre2BoundingBoxMaterialSwitcher::cameraPreRenderScene(
       {
         gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
       }
-      Ogre2VisualPtr ogreVisual = std::dynamic_pointer_cast<Ogre2Visual>(
-        visual);
-
-      // get class user data
-      Variant labelAny = ogreVisual->UserData(this->labelKey);
+      if (visual)
+        this->itemVisuals.emplace_back(item, visual);
+    }
+    itor.moveNext();
+  }
 
-      int label = this->backgroundLabel;
-      try
+  // The scene manager does not keep its items in creation order, sort them
+  // so the ids they are drawn with, and the order of the boxes, are stable
+  std::sort(this->itemVisuals.begin(), this->itemVisuals.end(),
+      [](const std::pair<Ogre::Item *, VisualPtr> &_a,
+         const std::pair<Ogre::Item *, VisualPtr> &_b)
       {
-        label = std::get<int>(labelAny);
-      }
-      catch(std::bad_variant_access &e)
-      {
-        // items with no class are considered background
-        label = this->backgroundLabel;
-      }
+        return _a.first->getId() < _b.first->getId();
+      });
 
-      // for full bbox, each pixel contains 1 channel for label
-      // and 2 channels stores ogreId
-      uint32_t ogreId = item->getId();
+  for (const auto &itemVisual : this->itemVisuals)
+  {
+    Ogre::Item *item = itemVisual.first;
+    const VisualPtr &visual = itemVisual.second;
+    Ogre2VisualPtr ogreVisual = std::dynamic_pointer_cast<Ogre2Visual>(
+      visual);
 
-      float labelColor = label / 255.0;
-      float ogreId1 = (ogreId / 256) / 255.0;
-      float ogreId2 = (ogreId % 256) / 255.0;
+    // get class user data
+    Variant labelAny = ogreVisual->UserData(this->labelKey);
 
-      // Material color
-      auto customParameter = Ogre::Vector4(ogreId2, ogreId1, labelColor, 1.0);
+    int label = this->backgroundLabel;
+    try
+    {
+      label = std::get<int>(labelAny);
+    }
+    catch(std::bad_variant_access &e)
+    {
+      // items with no class are considered background
+      label = this->backgroundLabel;
+    }
 
-      // Multi-links models handeling
-      auto itemName = visual->Name();
-      std::string parentName = this->TopLevelModelVisual(visual)->Name();
+    // for full bbox, each pixel contains 1 channel for label
+    // and 2 channels stores the id of the item
+    uint32_t id = static_cast<uint32_t>(this->items.size());
 
-      this->ogreIdName[ogreId] = parentName;
+    float labelColor = static_cast<float>(label) / kChannelMax;
+    float id1 = static_cast<float>(id >> 16) / kChannelMax;
+    float id2 = static_cast<float>(id & 0xFFFF) / kChannelMax;
 
-      // Switch material for all sub items
-      for (unsigned int i = 0; i < item->getNumSubItems(); i++)
-      {
-        // save subitems material
-        Ogre::SubItem *subItem = item->getSubItem(i);
-        Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-        this->datablockMap[subItem] = datablock;
-
-        subItem->setCustomParameter(1, customParameter);
-
-        if (!datablock->getMacroblock()->mDepthWrite &&
-            !datablock->getMacroblock()->mDepthCheck)
-          subItem->setMaterial(this->plainOverlayMaterial);
-        else
-          subItem->setMaterial(this->plainMaterial);
-      }
+    // Material color
+    auto customParameter = Ogre::Vector4(id2, id1, labelColor, 1.0);
+
+    // Multi-links models handeling
+    this->items.push_back(item);
+    this->parentNames.push_back(this->TopLevelModelVisual(visual)->Name());
+
+    // Switch material for all sub items
+    for (unsigned int i = 0; i < item->getNumSubItems(); i++)
+    {
+      // save subitems material
+      Ogre::SubItem *subItem = item->getSubItem(i);
+      Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+      this->datablockMap[subItem] = datablock;
+
+      subItem->setCustomParameter(1, customParameter);
+
+      if (!datablock->getMacroblock()->mDepthWrite &&
+          !datablock->getMacroblock()->mDepthCheck)
+        subItem->setMaterial(this->plainOverlayMaterial);
+      else
+        subItem->setMaterial(this->plainMaterial);
     }
-    itor.moveNext();
   }
+  this->itemVisuals.clear();
 }
 
 /////////////////////////////////////////////////
@@ -175,4 +202,6 @@ void Ogre2BoundingBoxMaterialSwitcher::cameraPostRenderScene(
     Ogre::SubItem *subItem = it.first;
     subItem->setDatablock(it.second);
   }
+
+  Ogre2TextBatch::SetHiddenAll(this->scene->OgreSceneManager(), false);
 }
@@ -20,6 +20,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gz/rendering/config.hh"
 #include "gz/rendering/ogre2/Export.hh"
@@ -78,9 +80,22 @@ class Ogre2BoundingBoxMaterialSwitcher : public Ogre::Camera::Listener
   /// \brief Label for background pixels in the ogre Ids map
   private: uint32_t backgroundLabel {255};
 
-  /// \brief Map ogre ID to the top parent name of the item.
-  /// used in multi-link models, key: ogreId, value: parent name
-  private: std::map<uint32_t, std::string> ogreIdName;
+  /// \brief Largest value of a channel of the ogre Ids map, which has
+  /// 16 bits per channel. The id of an item is stored in the first two
+  /// channels and its label in the third one.
+  private: static constexpr uint32_t kChannelMax {65535u};
+
+  /// \brief Items drawn with their id in the ogre Ids map, sorted by ogre
+  /// id. The index of an item in this list is the id it is drawn with.
+  private: std::vector<Ogre::Item *> items;
+
+  /// \brief Top parent name of each item in items.
+  /// used in multi-link models
+  private: std::vector<std::string> parentNames;
+
+  /// \brief Items and their visuals found while switching materials,
+  /// reused every frame
+  private: std::vector<std::pair<Ogre::Item *, VisualPtr>> itemVisuals;
 
   /// \brief Ogre2 Scene
   private: Ogre2ScenePtr scene;
@@ -15,6 +15,7 @@
  *
  */
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2Camera.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTarget.hh"
@@ -154,6 +155,7 @@ void Ogre2Camera::SetMaterial(const MaterialPtr &_material)
 //////////////////////////////////////////////////
 void Ogre2Camera::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2Camera::Render");
   this->renderTexture->Render();
 }
 
@@ -16,15 +16,36 @@
  */
 
 #include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include <gz/common/Console.hh>
 #include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
 
 #include "gz/rendering/ogre2/Ogre2Capsule.hh"
 #include "gz/rendering/ogre2/Ogre2Material.hh"
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Mesh.hh"
-#include "gz/rendering/ogre2/Ogre2Visual.hh"
+
+#include "Ogre2MeshBvh.hh"
+#include "Ogre2MeshHull.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreItem.h>
+#include <OgreMesh2.h>
+#include <OgreMeshManager2.h>
+#include <OgreRoot.h>
+#include <OgreSubMesh2.h>
+#include <Vao/OgreVaoManager.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
 
 class gz::rendering::Ogre2CapsulePrivate
 {
@@ -33,11 +54,55 @@ class gz::rendering::Ogre2CapsulePrivate
 
   /// \brief Mesh Object for capsule shape
   public: Ogre2MeshPtr ogreMesh{nullptr};
+
+  /// \brief Name of the ogre mesh of this capsule and of its mesh in
+  /// common::MeshManager
+  public: std::string ogreMeshName;
+
+  /// \brief Submesh of the mesh registered in common::MeshManager, which
+  /// owns it. Ray queries intersect it, so it is kept at the current size.
+  public: common::SubMesh *registeredSubMesh = nullptr;
+
+  /// \brief Vertex buffer of the ogre mesh
+  public: Ogre::VertexBufferPacked *vertexBuffer = nullptr;
+
+  /// \brief Interleaved position, normal and texture coordinates of the
+  /// vertices, written to the vertex buffer when the size changes
+  public: std::vector<float> vertexData;
+
+  /// \brief Positions of the vertices of the unit capsule template
+  public: std::vector<math::Vector3d> unitPositions;
 };
 
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+  /// \brief Name of the unit capsule all capsules are shaped from
+  const char kUnitCapsule[] = "unit_capsule";
+
+  /// \brief Number of floats per vertex: position, normal and texture
+  /// coordinates
+  const std::size_t kVertexFloats = 8u;
+
+  /// \brief Get the unit capsule template, creating it the first time.
+  /// It has a radius of 1 and a length of 2, so the cylinder spans z in
+  /// [-1, 1] and the hemispheres are the vertices outside of it.
+  /// \return The template submesh, null if it could not be created
+  const common::SubMesh *UnitCapsule()
+  {
+    common::MeshManager *meshMgr = common::MeshManager::Instance();
+    if (!meshMgr->HasMesh(kUnitCapsule))
+      meshMgr->CreateCapsule(kUnitCapsule, 1.0, 2.0, 32, 32);
+
+    const common::Mesh *mesh = meshMgr->MeshByName(kUnitCapsule);
+    if (!mesh || mesh->SubMeshCount() == 0u)
+      return nullptr;
+    return mesh->SubMeshByIndex(0u).lock().get();
+  }
+}
+
 //////////////////////////////////////////////////
 Ogre2Capsule::Ogre2Capsule()
   : dataPtr(new Ogre2CapsulePrivate)
@@ -69,6 +134,7 @@ void Ogre2Capsule::PreRender()
 //////////////////////////////////////////////////
 void Ogre2Capsule::Init()
 {
+  this->CreateMesh();
   this->Update();
 }
 
@@ -81,6 +147,24 @@ void Ogre2Capsule::Destroy()
     this->dataPtr->ogreMesh.reset();
   }
 
+  // the ogre mesh is owned by the capsule, not by the mesh factory
+  if (!this->dataPtr->ogreMeshName.empty() &&
+      Ogre::MeshManager::getSingletonPtr() &&
+      Ogre::MeshManager::getSingleton().resourceExists(
+      this->dataPtr->ogreMeshName))
+  {
+    Ogre::MeshManager::getSingleton().remove(this->dataPtr->ogreMeshName);
+  }
+  if (!this->dataPtr->ogreMeshName.empty())
+  {
+    common::MeshManager::Instance()->RemoveMesh(this->dataPtr->ogreMeshName);
+    Ogre2MeshHull::Invalidate(this->dataPtr->ogreMeshName);
+    Ogre2MeshBvh::Invalidate(this->dataPtr->ogreMeshName);
+  }
+  this->dataPtr->ogreMeshName.clear();
+  this->dataPtr->registeredSubMesh = nullptr;
+  this->dataPtr->vertexBuffer = nullptr;
+
   if (this->dataPtr->material && this->Scene())
   {
     this->Scene()->DestroyMaterial(this->dataPtr->material);
@@ -89,50 +173,179 @@ void Ogre2Capsule::Destroy()
 }
 
 //////////////////////////////////////////////////
-void Ogre2Capsule::Update()
+void Ogre2Capsule::CreateMesh()
 {
-  common::MeshManager *meshMgr = common::MeshManager::Instance();
-  std::string capsuleMeshName = "capsule_mesh";
-  capsuleMeshName += "_" + std::to_string(this->radius)
-      + "_" + std::to_string(this->length);
+  const common::SubMesh *unitCapsule = UnitCapsule();
+  if (!unitCapsule)
+  {
+    gzerr << "Capsule mesh is unavailable in the Mesh Manager" << std::endl;
+    return;
+  }
 
-  // Create new mesh if needed
-  if (!meshMgr->HasMesh(capsuleMeshName))
+  // All capsules are shaped from the same unit capsule, so a capsule has
+  // a single mesh for its whole life whatever its size, and resizing it
+  // only moves its vertices.
+  const unsigned int vertexCount = unitCapsule->VertexCount();
+  this->dataPtr->unitPositions.resize(vertexCount);
+  this->dataPtr->vertexData.assign(vertexCount * kVertexFloats, 0.0f);
+  for (unsigned int i = 0; i < vertexCount; ++i)
   {
-    meshMgr->CreateCapsule(capsuleMeshName, this->radius, this->length, 32, 32);
+    this->dataPtr->unitPositions[i] = unitCapsule->Vertex(i);
+    float *v = this->dataPtr->vertexData.data() + i * kVertexFloats;
+    if (i < unitCapsule->NormalCount())
+    {
+      const math::Vector3d &n = unitCapsule->Normal(i);
+      v[3] = static_cast<float>(n.X());
+      v[4] = static_cast<float>(n.Y());
+      v[5] = static_cast<float>(n.Z());
+    }
+    if (i < unitCapsule->TexCoordCount())
+    {
+      const math::Vector2d &uv = unitCapsule->TexCoord(i);
+      v[6] = static_cast<float>(uv.X());
+      v[7] = static_cast<float>(uv.Y());
+    }
   }
 
-  MeshDescriptor meshDescriptor;
-  meshDescriptor.mesh = meshMgr->MeshByName(capsuleMeshName);
-  if (meshDescriptor.mesh == nullptr)
+  std::vector<uint32_t> indices(unitCapsule->IndexCount());
+  for (unsigned int i = 0; i < indices.size(); ++i)
+    indices[i] = static_cast<uint32_t>(unitCapsule->Index(i));
+
+  Ogre::VaoManager *vaoManager = Ogre2RenderEngine::Instance()->OgreRoot()->
+      getRenderSystem()->getVaoManager();
+
+  // Ray queries look the mesh up in common::MeshManager by the ogre mesh
+  // name cut at the first "::". Object names contain "::" and are only
+  // unique within a scene, so the mesh is named after the scene and
+  // geometry ids, skipping names that are already taken.
+  common::MeshManager *meshMgr = common::MeshManager::Instance();
+  const std::string baseName = "capsule_mesh_" +
+      std::to_string(this->scene->Id()) + "_" + std::to_string(this->Id());
+  std::string meshName = baseName;
+  for (unsigned int i = 1u; meshMgr->HasMesh(meshName) ||
+      Ogre::MeshManager::getSingleton().resourceExists(meshName); ++i)
   {
-    gzerr << "Capsule mesh is unavailable in the Mesh Manager" << std::endl;
-    return;
+    meshName = baseName + "_" + std::to_string(i);
   }
+  this->dataPtr->ogreMeshName = meshName;
+  Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().createManual(
+      this->dataPtr->ogreMeshName,
+      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  Ogre::SubMesh *subMesh = mesh->createSubMesh();
 
-  auto visual = std::dynamic_pointer_cast<Ogre2Visual>(this->Parent());
+  Ogre::VertexElement2Vec vertexElements;
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_POSITION));
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_NORMAL));
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES));
 
-  // clear geom if needed
-  if (this->dataPtr->ogreMesh)
+  // the vertex buffer is written again when the capsule is resized, the
+  // indices never change
+  this->dataPtr->vertexBuffer = vaoManager->createVertexBuffer(
+      vertexElements, vertexCount, Ogre::BT_DEFAULT,
+      this->dataPtr->vertexData.data(), false);
+  Ogre::IndexBufferPacked *indexBuffer = vaoManager->createIndexBuffer(
+      Ogre::IndexBufferPacked::IT_32BIT, indices.size(), Ogre::BT_IMMUTABLE,
+      indices.data(), false);
+
+  Ogre::VertexBufferPackedVec vertexBuffers;
+  vertexBuffers.push_back(this->dataPtr->vertexBuffer);
+  Ogre::VertexArrayObject *vao = vaoManager->createVertexArrayObject(
+      vertexBuffers, indexBuffer, Ogre::OT_TRIANGLE_LIST);
+  subMesh->mVao[Ogre::VpNormal].push_back(vao);
+  // Use the same geometry for shadow casting.
+  subMesh->mVao[Ogre::VpShadow].push_back(vao);
+  mesh->_setBounds(Ogre::Aabb(Ogre::Vector3::ZERO, Ogre::Vector3::UNIT_SCALE),
+      false);
+
+  // Register a copy of the unit capsule under the same name for ray
+  // queries, Update moves its vertices along with the ogre ones.
+  common::Mesh *registeredMesh = new common::Mesh();
+  registeredMesh->SetName(this->dataPtr->ogreMeshName);
+  registeredMesh->AddSubMesh(*unitCapsule);
+  this->dataPtr->registeredSubMesh =
+      registeredMesh->SubMeshByIndex(0u).lock().get();
+  meshMgr->AddMesh(registeredMesh);
+
+  MeshDescriptor meshDescriptor;
+  meshDescriptor.mesh = registeredMesh;
+  meshDescriptor.meshName = this->dataPtr->ogreMeshName;
+  this->dataPtr->ogreMesh =
+      this->scene->CreateMeshFromOgre(mesh, meshDescriptor);
+  if (!this->dataPtr->ogreMesh)
   {
-    if (visual)
-    {
-      visual->RemoveGeometry(
-          std::dynamic_pointer_cast<Geometry>(shared_from_this()));
-    }
-    this->dataPtr->ogreMesh->Destroy();
+    gzerr << "Failed to create capsule mesh" << std::endl;
+    return;
   }
-  this->dataPtr->ogreMesh = std::dynamic_pointer_cast<Ogre2Mesh>(
-      this->Scene()->CreateMesh(meshDescriptor));
   if (this->dataPtr->material != nullptr)
   {
     this->dataPtr->ogreMesh->SetMaterial(this->dataPtr->material, false);
   }
-  if (visual)
+}
+
+//////////////////////////////////////////////////
+void Ogre2Capsule::Update()
+{
+  if (!this->dataPtr->vertexBuffer || !this->dataPtr->ogreMesh)
+    return;
+
+  // record where the capsule casts shadows before and after the resize
+  Ogre::SceneNode *node = this->dataPtr->ogreMesh->OgreObject()->
+      getParentSceneNode();
+  this->scene->SetShadowCasterDirty(node);
+
+  // Stretch the cylinder of the unit capsule along z and move its
+  // hemispheres to its ends. Normals and texture coordinates do not depend
+  // on the size.
+  const double halfLength = this->length * 0.5;
+  for (std::size_t i = 0u; i < this->dataPtr->unitPositions.size(); ++i)
+  {
+    const math::Vector3d &p = this->dataPtr->unitPositions[i];
+    double z;
+    if (std::abs(p.Z()) <= 1.0)
+    {
+      z = p.Z() * halfLength;
+    }
+    else
+    {
+      const double side = p.Z() > 0.0 ? 1.0 : -1.0;
+      z = (p.Z() - side) * this->radius + side * halfLength;
+    }
+
+    float *v = this->dataPtr->vertexData.data() + i * kVertexFloats;
+    v[0] = static_cast<float>(p.X() * this->radius);
+    v[1] = static_cast<float>(p.Y() * this->radius);
+    v[2] = static_cast<float>(z);
+
+    if (this->dataPtr->registeredSubMesh)
+    {
+      this->dataPtr->registeredSubMesh->SetVertex(static_cast<unsigned int>(i),
+          math::Vector3d(p.X() * this->radius, p.Y() * this->radius, z));
+    }
+  }
+  this->dataPtr->vertexBuffer->upload(this->dataPtr->vertexData.data(), 0u,
+      this->dataPtr->unitPositions.size());
+
+  // The mesh keeps its name and vertex count when resized, so cached
+  // hulls and hierarchies built from the old vertices would be reused.
+  Ogre2MeshHull::Invalidate(this->dataPtr->ogreMeshName);
+  Ogre2MeshBvh::Invalidate(this->dataPtr->ogreMeshName);
+
+  // Set the bounds to get frustum culling and LOD to work correctly.
+  const Ogre::Vector3 halfSize(this->radius, this->radius,
+      this->radius + halfLength);
+  const Ogre::Aabb bounds(Ogre::Vector3::ZERO, halfSize);
+  Ogre::Item *item =
+      dynamic_cast<Ogre::Item *>(this->dataPtr->ogreMesh->OgreObject());
+  if (item)
   {
-    visual->AddGeometry(
-        std::dynamic_pointer_cast<Geometry>(shared_from_this()));
+    item->getMesh()->_setBounds(bounds, false);
+    item->getMesh()->_setBoundingSphereRadius(halfSize.length());
+    item->setLocalAabb(bounds);
   }
+  this->scene->SetShadowCasterDirty(node);
 }
 
 //////////////////////////////////////////////////
@@ -56,6 +56,16 @@ const Ogre::PixelFormatGpu Ogre2Conversions::ogrePixelFormats[PF_COUNT] =
       Ogre::PFG_R16_UNORM,
       // PF_R8G8B8A8
       Ogre::PFG_RGBA8_UNORM,
+      // PF_NV12
+      Ogre::PFG_RGB8_UNORM,
+      // PF_I420
+      Ogre::PFG_RGB8_UNORM,
+      // PF_YUYV
+      Ogre::PFG_RGB8_UNORM,
+      // PF_FLOAT16_R
+      Ogre::PFG_R16_FLOAT,
+      // PF_FLOAT32_RG
+      Ogre::PFG_RG32_FLOAT,
     };
 
 //////////////////////////////////////////////////
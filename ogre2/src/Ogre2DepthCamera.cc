@@ -24,10 +24,12 @@
 #endif
 
 #include <cstdint>
+#include <limits>
 #include <math.h>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Matrix4.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/RenderTypes.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2DepthCamera.hh"
@@ -40,6 +42,7 @@
 #include "gz/rendering/ogre2/Ogre2Sensor.hh"
 
 #include "Ogre2ParticleNoiseListener.hh"
+#include "Ogre2TextureReadback.hh"
 
 #ifdef _MSC_VER
   #pragma warning(push, 0)
@@ -145,6 +148,9 @@ class gz::rendering::Ogre2DepthCameraPrivate
               unsigned int, unsigned int, unsigned int,
               const std::string &)> newDepthFrame;
 
+  /// \brief Event used to signal a view of the mapped depth data
+  public: gz::common::EventT<void(const SensorFrameView &)> newDepthFrameView;
+
   /// \brief standard deviation of particle noise
   public: double particleStddev = 0.01;
 
@@ -174,11 +180,182 @@ class gz::rendering::Ogre2DepthCameraPrivate
 
   /// \brief Pointer to the particle target definition in the workspace
   public: Ogre::CompositorTargetDef *particleTargetDef{nullptr};
+
+  /// \brief Reads back the depth texture from the GPU
+  public: Ogre2TextureReadback readback;
+
+  /// \brief Create the texture and workspace packing the depth into a
+  /// single channel texture for the depth only formats, if they do not
+  /// exist or no longer match the format and output of the camera
+  /// \param[in] _sceneManager Scene manager of the camera
+  /// \param[in] _camera Ogre camera of the depth camera
+  /// \param[in] _name Name of the depth camera
+  /// \param[in] _format Depth only format, see DepthCamera::SetDepthFormat
+  public: void UpdatePackWorkspace(Ogre::SceneManager *_sceneManager,
+      Ogre::Camera *_camera, const std::string &_name, PixelFormat _format);
+
+  /// \brief Destroy the pack workspace, its texture and material
+  public: void DestroyPackWorkspace();
+
+  /// \brief Single channel texture the depth is packed into for the depth
+  /// only formats
+  public: Ogre::TextureGpu *packTexture = nullptr;
+
+  /// \brief Workspace packing the depth into packTexture
+  public: Ogre::CompositorWorkspace *packWorkspace = nullptr;
+
+  /// \brief Output texture the pack workspace reads from
+  public: Ogre::TextureGpu *packInput = nullptr;
+
+  /// \brief Material of the pack workspace
+  public: Ogre::MaterialPtr packMaterial;
+
+  /// \brief Name of the pack workspace definition
+  public: std::string packWorkspaceDef;
+
+  /// \brief True if the packed depth is read back this frame instead of
+  /// the full point cloud data
+  public: bool readPacked = false;
 };
 
 using namespace gz;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+void Ogre2DepthCameraPrivate::UpdatePackWorkspace(
+    Ogre::SceneManager *_sceneManager, Ogre::Camera *_camera,
+    const std::string &_name, PixelFormat _format)
+{
+  Ogre::TextureGpu *input = this->ogreDepthTexture[1];
+  const Ogre::PixelFormatGpu packFormat = Ogre2Conversions::Convert(_format);
+  if (this->packTexture && this->packInput == input &&
+      this->packTexture->getPixelFormat() == packFormat &&
+      this->packTexture->getWidth() == input->getWidth() &&
+      this->packTexture->getHeight() == input->getHeight())
+  {
+    return;
+  }
+
+  this->DestroyPackWorkspace();
+
+  auto ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
+  Ogre::TextureGpuManager *textureMgr =
+      ogreRoot->getRenderSystem()->getTextureGpuManager();
+  this->packTexture = textureMgr->createTexture(
+      _name + "_depthPacked",
+      Ogre::GpuPageOutStrategy::Discard,
+      Ogre::TextureFlags::RenderToTexture,
+      Ogre::TextureTypes::Type2D);
+  this->packTexture->setResolution(input->getWidth(), input->getHeight());
+  this->packTexture->setNumMipmaps(1u);
+  this->packTexture->setPixelFormat(packFormat);
+  this->packTexture->scheduleTransitionTo(Ogre::GpuResidency::Resident);
+  this->packInput = input;
+
+  // downloads in flight may hold data of another format
+  this->readback.Reset();
+
+  // The DepthCameraPack material is defined in script (depth_camera.material)
+  const std::string baseMatName = "DepthCameraPack";
+  Ogre::MaterialPtr baseMat =
+      Ogre::MaterialManager::getSingleton().getByName(baseMatName);
+  if (!baseMat)
+  {
+    gzerr << baseMatName << " material not found, the full depth camera "
+          << "data is read back" << std::endl;
+    return;
+  }
+  if (!baseMat->isLoaded())
+    baseMat->load();
+  this->packMaterial = baseMat->clone(_name + "_" + baseMatName);
+  this->packMaterial->load();
+  this->packMaterial->getTechnique(0)->getPass(0)->
+      getFragmentProgramParameters()->setNamedConstant("params",
+      Ogre::Vector4(_format == PF_L16 ? 1 : 0, 0, 0, 0));
+
+  // compositor_node PackNode
+  // {
+  //   in 0 rt_input
+  //   in 1 rt_output
+  //
+  //   target rt_output
+  //   {
+  //     pass render_quad
+  //     {
+  //       material DepthCameraPack // Use copy instead of original
+  //       input 0 rt_input
+  //     }
+  //   }
+  // }
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+  const std::string wsDefName = "DepthCameraPackWorkspace_" + _name;
+  const std::string nodeDefName = wsDefName + "/PackNode";
+  this->packWorkspaceDef = wsDefName;
+  if (!ogreCompMgr->hasWorkspaceDefinition(wsDefName))
+  {
+    Ogre::CompositorNodeDef *nodeDef =
+        ogreCompMgr->addNodeDefinition(nodeDefName);
+    nodeDef->addTextureSourceName("rt_input", 0,
+        Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+    nodeDef->addTextureSourceName("rt_output", 1,
+        Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+
+    nodeDef->setNumTargetPass(1);
+    Ogre::CompositorTargetDef *targetDef = nodeDef->addTargetPass("rt_output");
+    targetDef->setNumPasses(1);
+    {
+      Ogre::CompositorPassQuadDef *passQuad =
+          static_cast<Ogre::CompositorPassQuadDef *>(
+          targetDef->addPass(Ogre::PASS_QUAD));
+      passQuad->setAllLoadActions(Ogre::LoadAction::DontCare);
+      passQuad->mMaterialName = this->packMaterial->getName();
+      passQuad->addQuadTextureSource(0, "rt_input");
+    }
+
+    Ogre::CompositorWorkspaceDef *workDef =
+        ogreCompMgr->addWorkspaceDefinition(wsDefName);
+    workDef->connectExternal(0, nodeDefName, 0);
+    workDef->connectExternal(1, nodeDefName, 1);
+  }
+
+  Ogre::CompositorChannelVec externalTargets(2u);
+  externalTargets[0] = this->packInput;
+  externalTargets[1] = this->packTexture;
+  this->packWorkspace = ogreCompMgr->addWorkspace(_sceneManager,
+      externalTargets, _camera, wsDefName, false);
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCameraPrivate::DestroyPackWorkspace()
+{
+  auto ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+  if (this->packWorkspace)
+  {
+    ogreCompMgr->removeWorkspace(this->packWorkspace);
+    this->packWorkspace = nullptr;
+  }
+  if (!this->packWorkspaceDef.empty())
+  {
+    ogreCompMgr->removeWorkspaceDefinition(this->packWorkspaceDef);
+    ogreCompMgr->removeNodeDefinition(this->packWorkspaceDef + "/PackNode");
+    this->packWorkspaceDef.clear();
+  }
+  if (this->packMaterial)
+  {
+    Ogre::MaterialManager::getSingleton().remove(
+        this->packMaterial->getName());
+    this->packMaterial.setNull();
+  }
+  if (this->packTexture)
+  {
+    ogreRoot->getRenderSystem()->getTextureGpuManager()->destroyTexture(
+        this->packTexture);
+    this->packTexture = nullptr;
+  }
+  this->packInput = nullptr;
+}
+
 //////////////////////////////////////////////////
 void Ogre2DepthGaussianNoisePass::PreRender(const CameraPtr &/*_camera*/)
 {
@@ -317,6 +494,9 @@ void Ogre2DepthCamera::Destroy()
   if (!this->ogreCamera)
     return;
 
+  this->dataPtr->readback.Reset();
+  this->dataPtr->DestroyPackWorkspace();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
@@ -1029,6 +1209,7 @@ void Ogre2DepthCamera::SetProjectionMatrix(const math::Matrix4d &_matrix)
 //////////////////////////////////////////////////
 void Ogre2DepthCamera::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2DepthCamera::Render");
   // Our shaders rely on clamped values so enable it for this sensor
   //
   // TODO(anyone): Matias N. Goldberg (dark_sylinc) insists this is a hack
@@ -1038,6 +1219,7 @@ void Ogre2DepthCamera::Render()
   this->ogreCamera->_setNeedsDepthClamp(true);
 
   this->scene->StartRendering(this->ogreCamera);
+  this->scene->UpdateShadowCache(this->dataPtr->ogreCompositorWorkspace);
 
   // update the compositors
   this->dataPtr->ogreCompositorWorkspace->_validateFinalTarget();
@@ -1049,6 +1231,14 @@ void Ogre2DepthCamera::Render()
   swappedTargets.reserve(2u);
   this->dataPtr->ogreCompositorWorkspace->_swapFinalTarget(swappedTargets);
 
+  if (this->dataPtr->readPacked)
+  {
+    this->dataPtr->packWorkspace->_validateFinalTarget();
+    this->dataPtr->packWorkspace->_beginUpdate(false);
+    this->dataPtr->packWorkspace->_update();
+    this->dataPtr->packWorkspace->_endUpdate(false);
+  }
+
   this->scene->FlushGpuCommandsAndStartNewFrame(1u, false);
 
   this->ogreCamera->_setNeedsDepthClamp(bOldDepthClamp);
@@ -1125,6 +1315,19 @@ void Ogre2DepthCamera::PreRender()
       pass->PreRender(camera);
   }
 
+  // The depth only formats pack the depth into a single channel texture so
+  // that only that texture is read back, unless the point cloud data is
+  // needed. The pack workspace follows the output texture, which may change
+  // when render passes are added.
+  this->dataPtr->readPacked = false;
+  if (this->depthFormat != PF_FLOAT32_RGBA &&
+      this->dataPtr->newRgbPointCloud.ConnectionCount() == 0u)
+  {
+    this->dataPtr->UpdatePackWorkspace(this->scene->OgreSceneManager(),
+        this->ogreCamera, this->Name(), this->depthFormat);
+    this->dataPtr->readPacked = this->dataPtr->packWorkspace != nullptr;
+  }
+
   // add the particle noise listener again if worksapce is recreated due to
   // dirty render pass
   if (this->dataPtr->renderPassDirty)
@@ -1155,32 +1358,47 @@ void Ogre2DepthCamera::PreRender()
 //////////////////////////////////////////////////
 void Ogre2DepthCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2DepthCamera::PostRender");
   unsigned int width = this->ImageWidth();
   unsigned int height = this->ImageHeight();
 
-  PixelFormat format = PF_FLOAT32_RGBA;
+  const bool packed = this->dataPtr->readPacked;
+  PixelFormat format = packed ? this->depthFormat : PF_FLOAT32_RGBA;
+  Ogre::TextureGpu *texture = packed ? this->dataPtr->packTexture :
+      this->dataPtr->ogreDepthTexture[1];
 
   int len = width * height;
   unsigned int channelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreDepthTexture[1], 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
-  float *depthBufferTmp = static_cast<float *>(box.data);
-  if (!this->dataPtr->depthBuffer)
-  {
-    this->dataPtr->depthBuffer = new float[len * channelCount];
-  }
+  this->dataPtr->readback.SetLatency(this->ReadbackLatency());
+  Ogre::TextureBox box;
+  if (!this->dataPtr->readback.Read(texture, box))
+    return;
+  this->readbackFrameId = this->dataPtr->readback.FrameId();
+  this->readbackFrameTime = this->dataPtr->readback.FrameTime();
 
-  // copy data row by row. The texture box may not be a contiguous region of
-  // a texture
-  for (unsigned int i = 0; i < height; ++i)
+  // hand the mapped memory to subscribers that can deal with row padding
+  if (this->dataPtr->newDepthFrameView.ConnectionCount() > 0u)
   {
-    unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-    unsigned int rowIdx = i * width * channelCount;
-    memcpy(&this->dataPtr->depthBuffer[rowIdx], &depthBufferTmp[rawDataRowIdx],
-        width * channelCount * bytesPerChannel);
+    SensorFrameView view;
+    view.data = box.data;
+    view.width = width;
+    view.height = height;
+    view.rowPitch = static_cast<unsigned int>(box.bytesPerRow);
+    view.pixelStride = static_cast<unsigned int>(box.bytesPerPixel);
+    view.channels = channelCount;
+    view.format = format;
+    view.frameId = this->readbackFrameId;
+    view.token = this->dataPtr->readback.Token();
+    this->dataPtr->newDepthFrameView(view);
+
+    // the packed buffers are only needed by the packed subscribers
+    if (this->dataPtr->newDepthFrame.ConnectionCount() == 0u &&
+        this->dataPtr->newRgbPointCloud.ConnectionCount() == 0u)
+    {
+      this->dataPtr->readback.Unmap();
+      return;
+    }
   }
 
   if (!this->dataPtr->depthImage)
@@ -1188,16 +1406,52 @@ void Ogre2DepthCamera::PostRender()
     this->dataPtr->depthImage = new float[len];
   }
 
-  // fill depth data
-  for (unsigned int i = 0; i < height; ++i)
+  // depth only data is converted to depth in meters straight from the
+  // mapped memory, it is read only once
+  if (packed)
   {
-    unsigned int step = i*width*channelCount;
-    for (unsigned int j = 0; j < width; ++j)
+    if (format == PF_L16)
+    {
+      const float invalid = std::numeric_limits<float>::quiet_NaN();
+      for (unsigned int y = 0u; y < height; ++y)
+      {
+        const uint16_t *row = reinterpret_cast<const uint16_t *>(
+            static_cast<const uint8_t *>(box.data) + y * box.bytesPerRow);
+        float *depthRow = this->dataPtr->depthImage + y * width;
+        for (unsigned int x = 0u; x < width; ++x)
+          depthRow[x] = row[x] == 0u ? invalid : row[x] * 0.001f;
+      }
+    }
+    else
     {
-      float x = this->dataPtr->depthBuffer[step + j*channelCount];
-      this->dataPtr->depthImage[i*width + j] = x;
+      PixelUtil::Convert(box.data, format,
+          static_cast<unsigned int>(box.bytesPerRow),
+          this->dataPtr->depthImage, PF_FLOAT32_R, 0u, width, height);
     }
+    this->dataPtr->readback.Unmap();
+
+    this->dataPtr->newDepthFrame(
+          this->dataPtr->depthImage, width, height, 1, "FLOAT32");
+    return;
+  }
+
+  if (!this->dataPtr->depthBuffer)
+  {
+    this->dataPtr->depthBuffer = new float[len * channelCount];
   }
+
+  // copy data row by row. The texture box may not be a contiguous region of
+  // a texture
+  PixelUtil::Convert(box.data, format,
+      static_cast<unsigned int>(box.bytesPerRow), this->dataPtr->depthBuffer,
+      format, 0u, width, height);
+  this->dataPtr->readback.Unmap();
+
+  // fill depth data from the local copy rather than the mapped memory, which
+  // may be slow to read
+  PixelUtil::Convert(this->dataPtr->depthBuffer, format, 0u,
+      this->dataPtr->depthImage, PF_FLOAT32_R, 0u, width, height);
+
   this->dataPtr->newDepthFrame(
         this->dataPtr->depthImage, width, height, 1, "FLOAT32");
 
@@ -1274,6 +1528,13 @@ common::ConnectionPtr Ogre2DepthCamera::ConnectNewRgbPointCloud(
   return this->dataPtr->newRgbPointCloud.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+common::ConnectionPtr Ogre2DepthCamera::ConnectNewDepthFrameView(
+    std::function<void(const SensorFrameView &)> _subscriber)
+{
+  return this->dataPtr->newDepthFrameView.Connect(_subscriber);
+}
+
 //////////////////////////////////////////////////
 RenderTargetPtr Ogre2DepthCamera::RenderTarget() const
 {
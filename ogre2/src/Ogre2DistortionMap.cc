@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreRoot.h>
+#include <OgreTextureGpuManager.h>
+#include <OgreStagingTexture.h>
+#include <OgrePixelFormatGpuUtils.h>
+#include <Threading/OgreUniformScalableTask.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+#include <gz/common/Console.hh>
+#include <gz/math/Helpers.hh>
+
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+
+#include "Ogre2DistortionMap.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Maps by k1, k2, k3, p1, p2, center x, center y, size and focal
+  /// length
+  typedef std::tuple<double, double, double, double, double, double, double,
+      unsigned int, double> MapKey;
+
+  /// \brief Runs one phase of the map computation, with the rows of the
+  /// map split in one band per worker thread
+  class Ogre2DistortionMapTask final
+    : public Ogre::UniformScalableTask
+  {
+    /// \brief Constructor
+    /// \param[in] _map Map to compute
+    /// \param[in] _fill False to distort the pixels of the undistorted
+    /// image, true to fill and write the map once they are resolved
+    public: Ogre2DistortionMapTask(Ogre2DistortionMap &_map, bool _fill)
+        : map(_map), fill(_fill)
+    {
+    }
+
+    // Documentation inherited
+    public: void execute(size_t _threadId, size_t _numThreads) override
+    {
+      if (this->fill)
+        this->map.FillBand(_threadId, _numThreads);
+      else
+        this->map.DistortBand(_threadId, _numThreads);
+    }
+
+    /// \brief Map to compute
+    private: Ogre2DistortionMap &map;
+
+    /// \brief Phase to run
+    private: bool fill;
+  };
+
+  /// \brief Run a task on the worker threads of a scene manager, or on the
+  /// calling thread if it has none
+  /// \param[in] _task Task to run
+  /// \param[in] _sceneManager Scene manager, can be null
+  void Execute(Ogre2DistortionMapTask &_task,
+      Ogre::SceneManager *_sceneManager)
+  {
+    if (_sceneManager && _sceneManager->getNumWorkerThreads() > 1u)
+      _sceneManager->executeUserScalableTask(&_task, true);
+    else
+      _task.execute(0u, 1u);
+  }
+}
+
+//////////////////////////////////////////////////
+Ogre2DistortionMap::Ogre2DistortionMap(
+    const Ogre2DistortionMapParams &_params,
+    Ogre::SceneManager *_sceneManager)
+  : params(_params)
+{
+  const unsigned int size = this->params.size;
+  const std::size_t pixelCount = static_cast<std::size_t>(size) * size;
+
+  // distort every pixel of the undistorted image
+  this->targets.assign(pixelCount, -1);
+  {
+    Ogre2DistortionMapTask task(*this, false);
+    Execute(task, _sceneManager);
+  }
+
+  // Resolve the pixels that several undistorted pixels are distorted to.
+  // For significant distortions the distorted image folds over itself, so
+  // the pixel closest to the center of distortion is favored. This is
+  // a single cheap pass that is kept serial so that ties are always broken
+  // the same way.
+  const double centerX = this->params.center.X() * size;
+  const double centerY = this->params.center.Y() * size;
+  auto centerDistanceSq = [&](int _index)
+  {
+    const double dx = (_index % size) - centerX;
+    const double dy = (_index / size) - centerY;
+    return dx * dx + dy * dy;
+  };
+  this->sources.assign(pixelCount, -1);
+  for (std::size_t i = 0; i < pixelCount; ++i)
+  {
+    const int target = this->targets[i];
+    if (target < 0)
+      continue;
+    int &source = this->sources[target];
+    if (source < 0 || centerDistanceSq(static_cast<int>(i)) <
+        centerDistanceSq(source))
+    {
+      source = static_cast<int>(i);
+    }
+  }
+  this->targets.clear();
+  this->targets.shrink_to_fit();
+
+  // create the texture, following the layout of its system ram copy
+  auto engine = Ogre2RenderEngine::Instance();
+  Ogre::TextureGpuManager *textureMgr =
+    engine->OgreRoot()->getRenderSystem()->getTextureGpuManager();
+  static unsigned int mapId = 0u;
+  this->texture = textureMgr->createOrRetrieveTexture(
+      "gz_distortion_map_" + std::to_string(mapId++),
+      Ogre::GpuPageOutStrategy::SaveToSystemRam,
+      Ogre::TextureFlags::ManualTexture,
+      Ogre::TextureTypes::Type2D,
+      Ogre::BLANKSTRING,
+      0u);
+  this->texture->setTextureType(Ogre::TextureTypes::Type2D);
+  this->texture->setResolution(size, size);
+  this->texture->setNumMipmaps(1u);
+  this->texture->setPixelFormat(Ogre::PFG_RG32_FLOAT);
+
+  const size_t dataSize = Ogre::PixelFormatGpuUtils::getSizeBytes(
+      size, size, 1u, 1u, this->texture->getPixelFormat(), 1u);
+  const size_t bytesPerRow = this->texture->_getSysRamCopyBytesPerRow(0);
+  this->upload = reinterpret_cast<float *>(
+      OGRE_MALLOC_SIMD(dataSize, Ogre::MEMCATEGORY_RESOURCE));
+  this->uploadRowFloats = bytesPerRow / sizeof(float);
+
+  // fill the pixels no pixel was distorted to and write the map
+  {
+    Ogre2DistortionMapTask task(*this, true);
+    Execute(task, _sceneManager);
+  }
+  this->sources.clear();
+  this->sources.shrink_to_fit();
+
+  // the texture takes ownership of the system ram copy
+  this->texture->_transitionTo(Ogre::GpuResidency::Resident,
+      reinterpret_cast<Ogre::uint8 *>(this->upload));
+
+  Ogre::StagingTexture *stagingTexture = textureMgr->getStagingTexture(
+      size, size, 1u, 1u, this->texture->getPixelFormat());
+  stagingTexture->startMapRegion();
+  Ogre::TextureBox texBox = stagingTexture->mapRegion(
+      size, size, 1u, 1u, this->texture->getPixelFormat());
+  texBox.copyFrom(this->upload, size, size, bytesPerRow);
+  stagingTexture->stopMapRegion();
+  stagingTexture->upload(texBox, this->texture, 0, 0, 0, true);
+  textureMgr->removeStagingTexture(stagingTexture);
+  this->upload = nullptr;
+
+  // Scale up the image to crop the black border of barrel distortion.
+  // Note this only matches the map for a square image.
+  if (this->params.k1 < 0)
+  {
+    math::Vector2d boundA = Distort(math::Vector2d(0, 0), this->params);
+    math::Vector2d boundB = Distort(math::Vector2d(1, 1), this->params);
+    math::Vector2d newScale = boundB - boundA;
+    // If the scale is extremely small, don't crop
+    if (newScale.X() < 1e-7 || newScale.Y() < 1e-7)
+    {
+      gzerr << "Distortion model attempted to apply a scale parameter of ("
+            << newScale.X() << ", " << newScale.Y()
+            << "), which is invalid." << std::endl;
+    }
+    else
+    {
+      this->scale = newScale;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+Ogre2DistortionMap::~Ogre2DistortionMap()
+{
+  // the texture is gone already if the engine was shut down first
+  auto engine = Ogre2RenderEngine::Instance();
+  Ogre::Root *ogreRoot = engine->OgreRoot();
+  if (this->texture && ogreRoot && ogreRoot->getRenderSystem())
+  {
+    ogreRoot->getRenderSystem()->getTextureGpuManager()->destroyTexture(
+        this->texture);
+  }
+  this->texture = nullptr;
+}
+
+//////////////////////////////////////////////////
+Ogre::TextureGpu *Ogre2DistortionMap::Texture() const
+{
+  return this->texture;
+}
+
+//////////////////////////////////////////////////
+const math::Vector2d &Ogre2DistortionMap::Scale() const
+{
+  return this->scale;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<Ogre2DistortionMap> Ogre2DistortionMap::Get(
+    const Ogre2DistortionMapParams &_params,
+    Ogre::SceneManager *_sceneManager)
+{
+  static std::mutex mutex;
+  static std::map<MapKey, std::weak_ptr<Ogre2DistortionMap>> maps;
+
+  const MapKey key(_params.k1, _params.k2, _params.k3, _params.p1,
+      _params.p2, _params.center.X(), _params.center.Y(), _params.size,
+      _params.focalLength);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = maps.find(key);
+  if (it != maps.end())
+  {
+    std::shared_ptr<Ogre2DistortionMap> map = it->second.lock();
+    if (map)
+      return map;
+  }
+
+  // drop the entries of maps that were released
+  for (auto mapIt = maps.begin(); mapIt != maps.end();)
+  {
+    if (mapIt->second.expired())
+      mapIt = maps.erase(mapIt);
+    else
+      ++mapIt;
+  }
+
+  auto map = std::make_shared<Ogre2DistortionMap>(_params, _sceneManager);
+  maps[key] = map;
+  return map;
+}
+
+//////////////////////////////////////////////////
+math::Vector2d Ogre2DistortionMap::Distort(const math::Vector2d &_in,
+    const Ogre2DistortionMapParams &_params)
+{
+  // apply Brown's distortion model, see
+  // http://en.wikipedia.org/wiki/Distortion_%28optics%29#Software_correction
+  const double width = _params.size;
+  const double f = _params.focalLength;
+
+  math::Vector2d normalized = (_in - _params.center) * (width / f);
+  double rSq = normalized.X() * normalized.X() +
+               normalized.Y() * normalized.Y();
+
+  // radial
+  math::Vector2d dist = normalized * (1.0 +
+      _params.k1 * rSq +
+      _params.k2 * rSq * rSq +
+      _params.k3 * rSq * rSq * rSq);
+
+  // tangential
+  dist.X() += _params.p2 * (rSq + 2 * (normalized.X() * normalized.X())) +
+      2 * _params.p1 * normalized.X() * normalized.Y();
+  dist.Y() += _params.p1 * (rSq + 2 * (normalized.Y() * normalized.Y())) +
+      2 * _params.p2 * normalized.X() * normalized.Y();
+
+  return ((_params.center * width) + dist * f) / width;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionMap::DistortBand(std::size_t _band,
+    std::size_t _bandCount)
+{
+  const unsigned int size = this->params.size;
+  const std::size_t firstRow = size * _band / _bandCount;
+  const std::size_t endRow = size * (_band + 1u) / _bandCount;
+  const double stepSize = 1.0 / size;
+
+  for (std::size_t row = firstRow; row < endRow; ++row)
+  {
+    for (unsigned int col = 0; col < size; ++col)
+    {
+      math::Vector2d distorted = Distort(
+          math::Vector2d(col * stepSize, row * stepSize), this->params);
+
+      const int distortedCol =
+          static_cast<int>(std::round(distorted.X() * size));
+      const int distortedRow =
+          static_cast<int>(std::round(distorted.Y() * size));
+
+      // Pixels distorted outside of the image are expected, they keep the
+      // image free of black borders
+      if (distortedCol >= 0 && distortedRow >= 0 &&
+          static_cast<unsigned int>(distortedCol) < size &&
+          static_cast<unsigned int>(distortedRow) < size)
+      {
+        this->targets[row * size + col] = distortedRow * size + distortedCol;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionMap::FillBand(std::size_t _band, std::size_t _bandCount)
+{
+  const unsigned int size = this->params.size;
+  const std::size_t firstRow = size * _band / _bandCount;
+  const std::size_t endRow = size * (_band + 1u) / _bandCount;
+
+  for (std::size_t row = firstRow; row < endRow; ++row)
+  {
+    float *dest = this->upload + row * this->uploadRowFloats;
+    const int i = static_cast<int>(row);
+    for (unsigned int col = 0; col < size; ++col)
+    {
+      const int j = static_cast<int>(col);
+      math::Vector2d vec = this->ValueClamped(j, i);
+
+      // check for empty mapping and correct it by interpolating the eight
+      // neighboring distortion map values
+      if (vec.X() < -0.5 && vec.Y() < -0.5)
+      {
+        const math::Vector2d neighbors[8] = {
+            this->ValueClamped(j + 1, i),
+            this->ValueClamped(j - 1, i),
+            this->ValueClamped(j, i - 1),
+            this->ValueClamped(j, i + 1),
+            this->ValueClamped(j + 1, i + 1),
+            this->ValueClamped(j - 1, i + 1),
+            this->ValueClamped(j + 1, i - 1),
+            this->ValueClamped(j - 1, i - 1)};
+
+        math::Vector2d interpolated;
+        double divisor = 0;
+        for (unsigned int n = 0; n < 8u; ++n)
+        {
+          if (neighbors[n].X() > -0.5)
+          {
+            // diagonal neighbors are further away
+            const double weight = n < 4u ? 1.0 : 0.707;
+            divisor += weight;
+            interpolated += neighbors[n] * weight;
+          }
+        }
+
+        if (divisor > 0.5)
+          interpolated /= divisor;
+        *dest++ = static_cast<float>(math::clamp(interpolated.X(), 0.0, 1.0));
+        *dest++ = static_cast<float>(math::clamp(interpolated.Y(), 0.0, 1.0));
+      }
+      else
+      {
+        *dest++ = static_cast<float>(vec.X());
+        *dest++ = static_cast<float>(vec.Y());
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+math::Vector2d Ogre2DistortionMap::ValueClamped(int _x, int _y) const
+{
+  const int size = static_cast<int>(this->params.size);
+  if (_x < 0 || _x >= size || _y < 0 || _y >= size)
+    return math::Vector2d(-1, -1);
+
+  const int source = this->sources[_y * size + _x];
+  if (source < 0)
+    return math::Vector2d(-1, -1);
+
+  // The half texel offset is necessary for the compositor to correctly
+  // interpolate pixel values
+  const double stepSize = 1.0 / size;
+  return math::Vector2d(
+      (source % size + 0.5) * stepSize,
+      (source / size + 0.5) * stepSize);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2DISTORTIONMAP_HH_
+#define GZ_RENDERING_OGRE2_OGRE2DISTORTIONMAP_HH_
+
+#include <memory>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Parameters a distortion map is computed from
+    struct Ogre2DistortionMapParams
+    {
+      /// \brief Radial distortion coefficient k1
+      double k1 = 0.0;
+
+      /// \brief Radial distortion coefficient k2
+      double k2 = 0.0;
+
+      /// \brief Radial distortion coefficient k3
+      double k3 = 0.0;
+
+      /// \brief Tangential distortion coefficient p1
+      double p1 = 0.0;
+
+      /// \brief Tangential distortion coefficient p2
+      double p2 = 0.0;
+
+      /// \brief Normalized distortion center
+      math::Vector2d center = {0.5, 0.5};
+
+      /// \brief Width and height of the square map in pixels
+      unsigned int size = 0u;
+
+      /// \brief Focal length in pixels
+      double focalLength = 1.0;
+
+      /// \brief Equality operator
+      /// \param[in] _other Parameters to compare to
+      /// \return True if all parameters are exactly the same
+      bool operator==(const Ogre2DistortionMapParams &_other) const
+      {
+        return this->k1 == _other.k1 && this->k2 == _other.k2 &&
+            this->k3 == _other.k3 && this->p1 == _other.p1 &&
+            this->p2 == _other.p2 && this->center.X() == _other.center.X() &&
+            this->center.Y() == _other.center.Y() &&
+            this->size == _other.size &&
+            this->focalLength == _other.focalLength;
+      }
+    };
+
+    /// \brief Texture that maps every pixel of a distorted image to the
+    /// normalized coordinates of the undistorted image it shows.
+    ///
+    /// Maps only depend on their parameters, so they are cached and shared:
+    /// a rig of identical cameras uses a single texture, and a camera that
+    /// is recreated or whose pass is rebuilt does not compute its map again.
+    class Ogre2DistortionMap
+    {
+      /// \brief Constructor, computes the map and uploads it. Use Get()
+      /// instead.
+      /// \param[in] _params Distortion parameters
+      /// \param[in] _sceneManager Scene manager whose worker threads are used
+      /// to compute the map
+      public: Ogre2DistortionMap(const Ogre2DistortionMapParams &_params,
+                  Ogre::SceneManager *_sceneManager);
+
+      /// \brief Destructor, releases the texture
+      public: ~Ogre2DistortionMap();
+
+      /// \brief Texture holding the map, two 32 bit float channels per pixel
+      /// \return The texture
+      public: Ogre::TextureGpu *Texture() const;
+
+      /// \brief Scale to apply to the distorted image so that the black
+      /// border of barrel distortion is cropped
+      /// \return The scale, (1, 1) if the image is not cropped
+      public: const math::Vector2d &Scale() const;
+
+      /// \brief Get the map for a set of parameters, computing it the first
+      /// time. Maps are released when the last pass using them does.
+      /// \param[in] _params Distortion parameters
+      /// \param[in] _sceneManager Scene manager whose worker threads are used
+      /// to compute the map
+      /// \return The map
+      public: static std::shared_ptr<Ogre2DistortionMap> Get(
+                  const Ogre2DistortionMapParams &_params,
+                  Ogre::SceneManager *_sceneManager);
+
+      /// \brief Apply the distortion model to normalized image coordinates
+      /// \param[in] _in Normalized undistorted coordinates
+      /// \param[in] _params Distortion parameters
+      /// \return Normalized distorted coordinates
+      public: static math::Vector2d Distort(const math::Vector2d &_in,
+                  const Ogre2DistortionMapParams &_params);
+
+      /// \brief Compute the distorted location of the pixels of a band of
+      /// rows of the undistorted image
+      /// \param[in] _band Index of the band
+      /// \param[in] _bandCount Number of bands the map is split into
+      public: void DistortBand(std::size_t _band, std::size_t _bandCount);
+
+      /// \brief Fill the pixels of a band of rows of the map that no pixel
+      /// was distorted to and write them to the upload buffer
+      /// \param[in] _band Index of the band
+      /// \param[in] _bandCount Number of bands the map is split into
+      public: void FillBand(std::size_t _band, std::size_t _bandCount);
+
+      /// \brief Map value at a pixel, or (-1, -1) outside of the map or if
+      /// no pixel was distorted to it
+      /// \param[in] _x Column of the pixel
+      /// \param[in] _y Row of the pixel
+      /// \return Normalized undistorted coordinates
+      private: math::Vector2d ValueClamped(int _x, int _y) const;
+
+      /// \brief Distortion parameters
+      private: Ogre2DistortionMapParams params;
+
+      /// \brief Index of the map pixel each undistorted pixel is distorted
+      /// to, or -1 if it falls outside of the map
+      private: std::vector<int> targets;
+
+      /// \brief Undistorted pixel each map pixel shows, or -1
+      private: std::vector<int> sources;
+
+      /// \brief Map values in the layout of the texture, only used while
+      /// it is uploaded
+      private: float *upload = nullptr;
+
+      /// \brief Number of floats in a row of the upload buffer
+      private: std::size_t uploadRowFloats = 0u;
+
+      /// \brief Texture holding the map
+      private: Ogre::TextureGpu *texture = nullptr;
+
+      /// \brief Scale to crop the black border
+      private: math::Vector2d scale = {1.0, 1.0};
+    };
+    }
+  }
+}
+#endif
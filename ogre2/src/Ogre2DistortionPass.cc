@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Helpers.hh>
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/RenderPassSystem.hh"
+#include "gz/rendering/ogre2/Ogre2DistortionPass.hh"
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
+
+#include "Ogre2DistortionMap.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Compositor/OgreCompositorManager2.h>
+#include <Compositor/OgreCompositorNodeDef.h>
+#include <Compositor/Pass/PassQuad/OgreCompositorPassQuadDef.h>
+#include <OgreMaterial.h>
+#include <OgreMaterialManager.h>
+#include <OgrePass.h>
+#include <OgreRoot.h>
+#include <OgreTechnique.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+/// \brief Private data for the Ogre2DistortionPass class
+class gz::rendering::Ogre2DistortionPassPrivate
+{
+  /// brief Pointer to the distortion ogre material
+  public: Ogre::Material *distortionMat = nullptr;
+
+  /// \brief Distortion map in use, shared with other passes
+  public: std::shared_ptr<Ogre2DistortionMap> distortionMap;
+
+  /// \brief Parameters of the distortion map in use
+  public: Ogre2DistortionMapParams mapParams;
+};
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+Ogre2DistortionPass::Ogre2DistortionPass()
+  : dataPtr(std::make_unique<Ogre2DistortionPassPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+Ogre2DistortionPass::~Ogre2DistortionPass()
+{
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionPass::PreRender(const CameraPtr &_camera)
+{
+  if (!this->dataPtr->distortionMat || !_camera)
+    return;
+
+  if (!this->enabled)
+    return;
+
+  const unsigned int width = _camera->ImageWidth();
+  const unsigned int height = _camera->ImageHeight();
+  if (width == 0u || height == 0u)
+    return;
+
+  // seems to work best with a square distortion map texture. The focal
+  // length in pixels is the same along both axes.
+  Ogre2DistortionMapParams params;
+  params.k1 = this->k1;
+  params.k2 = this->k2;
+  params.k3 = this->k3;
+  params.p1 = this->p1;
+  params.p2 = this->p2;
+  params.center = this->lensCenter;
+  params.size = std::max(width, height);
+  params.focalLength =
+      width / (2.0 * std::tan(_camera->HFOV().Radian() / 2.0));
+
+  // The map only depends on these parameters, it is not computed again
+  // every frame, nor for each camera of a rig of identical cameras
+  if (this->dataPtr->distortionMap && params == this->dataPtr->mapParams)
+    return;
+
+  Ogre::SceneManager *sceneManager = nullptr;
+  auto ogreScene = std::dynamic_pointer_cast<Ogre2Scene>(_camera->Scene());
+  if (ogreScene)
+    sceneManager = ogreScene->OgreSceneManager();
+
+  this->dataPtr->distortionMap = Ogre2DistortionMap::Get(params,
+      sceneManager);
+  this->dataPtr->mapParams = params;
+
+  // These calls are setting parameters that are declared in two places:
+  // 1. media/materials/scripts/distortion.material, in
+  //    fragment_program DistortionFS
+  // 2. media/materials/programs/GLSL/distortion_fs.glsl
+  Ogre::Pass *pass =
+      this->dataPtr->distortionMat->getTechnique(0)->getPass(0);
+  pass->getTextureUnitState(1u)->setTexture(
+      this->dataPtr->distortionMap->Texture());
+  const math::Vector2d &scale = this->dataPtr->distortionMap->Scale();
+  const float scaleParam[2] = {static_cast<float>(scale.X()),
+      static_cast<float>(scale.Y())};
+  Ogre::GpuProgramParametersSharedPtr psParams =
+      pass->getFragmentProgramParameters();
+  psParams->setNamedConstant("scale", scaleParam, 1u, 2u);
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionPass::Destroy()
+{
+  this->dataPtr->distortionMap.reset();
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionPass::CreateRenderPass()
+{
+  if (!this->ogreCompositorNodeDefName.empty())
+    return;
+
+  // If no distortion is required, immediately return.
+  if (math::equal(this->k1, 0.0) &&
+      math::equal(this->k2, 0.0) &&
+      math::equal(this->k3, 0.0) &&
+      math::equal(this->p1, 0.0) &&
+      math::equal(this->p2, 0.0))
+  {
+    return;
+  }
+
+  // The Distortion material is defined in script (distortion.material).
+  // clone the material
+  std::string matName = "Distortion";
+  Ogre::MaterialPtr ogreMat =
+      Ogre::MaterialManager::getSingleton().getByName(matName);
+  if (!ogreMat)
+  {
+    gzerr << "Distortion material not found: '" << matName << "'"
+          << std::endl;
+    return;
+  }
+  if (!ogreMat->isLoaded())
+    ogreMat->load();
+
+  static int distortionNodeCounter = 0;
+
+  std::string materialName = matName + "_" +
+      std::to_string(distortionNodeCounter);
+  this->dataPtr->distortionMat = ogreMat->clone(materialName).get();
+
+  // create the compositor node definition, the distortion map is only
+  // bound to the material when the pass is rendered since it depends on
+  // the camera. This is equivalent to the following ogre compositor script:
+  // compositor_node DistortionNode
+  // {
+  //   in 0 rt_input
+  //   in 1 rt_output
+  //
+  //   target rt_output
+  //   {
+  //     pass render_quad
+  //     {
+  //       material Distortion // Use copy instead of original
+  //       input 0 rt_input
+  //     }
+  //   }
+  //   out 0 rt_output
+  //   out 1 rt_input
+  // }
+
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+
+  std::string nodeDefName = "DistortionNode_"
+      + std::to_string(distortionNodeCounter);
+
+  this->ogreCompositorNodeDefName = nodeDefName;
+  distortionNodeCounter++;
+
+  Ogre::CompositorNodeDef *nodeDef =
+      ogreCompMgr->addNodeDefinition(nodeDefName);
+
+  // Input texture
+  nodeDef->addTextureSourceName("rt_input", 0,
+      Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+  nodeDef->addTextureSourceName("rt_output", 1,
+      Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+
+  // rt_input target
+  nodeDef->setNumTargetPass(1);
+  Ogre::CompositorTargetDef *inputTargetDef =
+      nodeDef->addTargetPass("rt_output");
+  inputTargetDef->setNumPasses(1);
+  {
+    // quad pass
+    Ogre::CompositorPassQuadDef *passQuad =
+        static_cast<Ogre::CompositorPassQuadDef *>(
+        inputTargetDef->addPass(Ogre::PASS_QUAD));
+    passQuad->mMaterialName = materialName;
+    passQuad->addQuadTextureSource(0, "rt_input");
+  }
+  nodeDef->mapOutputChannel(0, "rt_output");
+  nodeDef->mapOutputChannel(1, "rt_input");
+}
+
+GZ_RENDERING_REGISTER_RENDER_PASS(Ogre2DistortionPass, DistortionPass)
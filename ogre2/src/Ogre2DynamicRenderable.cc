@@ -26,6 +26,9 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <utility>
+
 #include "gz/common/Console.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2DynamicRenderable.hh"
@@ -40,8 +43,10 @@
 #include <OgreMesh2.h>
 #include <OgreMeshManager2.h>
 #include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
 #include <OgreSubMesh2.h>
 #include <Vao/OgreVaoManager.h>
+#include <Vao/OgreVertexArrayObject.h>
 #ifdef _MSC_VER
   #pragma warning(pop)
 #endif
@@ -58,6 +63,48 @@ class gz::rendering::Ogre2DynamicRenderablePrivate
   /// \brief Used to indicate if the lines require an update
   public: bool dirty = false;
 
+  /// \brief True if all points need to be written on the next update, e.g.
+  /// because points were removed
+  public: bool fullUpdate = true;
+
+  /// \brief Index of the first point modified since the last update
+  public: size_t dirtyBegin = 0u;
+
+  /// \brief Index past the last point modified since the last update
+  public: size_t dirtyEnd = 0u;
+
+  /// \brief Range of points that is out of date in each region of the
+  /// vertex buffer. Persistent dynamic buffers hold one copy of the data per
+  /// frame in flight, each map() moves to the next one.
+  public: std::vector<std::pair<size_t, size_t>> staleRanges;
+
+  /// \brief Region of the vertex buffer the last map() wrote to
+  public: size_t currentRegion = 0u;
+
+  /// \brief Bounding box of the points
+  public: Ogre::Aabb bbox;
+
+  /// \brief Number of points in the bounding box as of the last update
+  public: size_t bboxPointCount = 0u;
+
+  /// \brief Mark a range of points as modified
+  /// \param[in] _begin Index of the first modified point
+  /// \param[in] _end Index past the last modified point
+  public: void MarkDirty(size_t _begin, size_t _end)
+  {
+    if (this->dirtyBegin == this->dirtyEnd)
+    {
+      this->dirtyBegin = _begin;
+      this->dirtyEnd = _end;
+    }
+    else
+    {
+      this->dirtyBegin = std::min(this->dirtyBegin, _begin);
+      this->dirtyEnd = std::max(this->dirtyEnd, _end);
+    }
+    this->dirty = true;
+  }
+
   /// \brief Render operation type
   public: Ogre::OperationType operationType;
 
@@ -187,7 +234,28 @@ Ogre::MovableObject *Ogre2DynamicRenderable::OgreObject() const
 //////////////////////////////////////////////////
 void Ogre2DynamicRenderable::Update()
 {
+  Ogre::SceneNode *node = this->dataPtr->ogreItem ?
+      this->dataPtr->ogreItem->getParentSceneNode() : nullptr;
+  if (!node || !this->dataPtr->dirty)
+  {
+    this->UpdateBuffer();
+    return;
+  }
+
+  // new vertices move the shadows the item casts, both where it was and
+  // where it is now
+  Ogre2ScenePtr s = std::dynamic_pointer_cast<Ogre2Scene>(this->dataPtr->scene);
+  if (s)
+    s->SetShadowCasterDirty(node);
+
   this->UpdateBuffer();
+
+  // bounds of static items are only updated when notified
+  if (node->isStatic())
+    this->dataPtr->sceneManager->notifyStaticDirty(node);
+
+  if (s)
+    s->SetShadowCasterDirty(node);
 }
 
 //////////////////////////////////////////////////
@@ -253,6 +321,7 @@ void Ogre2DynamicRenderable::UpdateBuffer()
   }
 
   // recreate vao if needed
+  bool recreated = false;
   if (newVertCapacity != this->dataPtr->vertexBufferCapacity)
   {
     this->dataPtr->vertexBufferCapacity = newVertCapacity;
@@ -290,62 +359,119 @@ void Ogre2DynamicRenderable::UpdateBuffer()
     this->dataPtr->subMesh->mVao[Ogre::VpNormal].push_back(this->dataPtr->vao);
     // Use the same geometry for shadow casting.
     this->dataPtr->subMesh->mVao[Ogre::VpShadow].push_back(this->dataPtr->vao);
-  }
 
-  // map buffer and update the geometry
-  Ogre::Aabb bbox;
-  float * RESTRICT_ALIAS vertices = reinterpret_cast<float * RESTRICT_ALIAS>(
-      this->dataPtr->vertexBuffer->map(
-      0, this->dataPtr->vertexBuffer->getNumElements()));
+    recreated = true;
+  }
 
-  // fill vertices
-  for (unsigned int i = 0; i < vertexCount; ++i)
+  // Normals of triangles are averaged with the ones of their neighbours, so
+  // they are always generated for all the points
+  const bool isTriangles =
+      this->dataPtr->operationType == Ogre::OperationType::OT_TRIANGLE_LIST ||
+      this->dataPtr->operationType == Ogre::OperationType::OT_TRIANGLE_STRIP ||
+      this->dataPtr->operationType == Ogre::OperationType::OT_TRIANGLE_FAN;
+  const bool fullUpdate = recreated || isTriangles ||
+      this->dataPtr->fullUpdate;
+
+  size_t dirtyBegin = std::min<size_t>(this->dataPtr->dirtyBegin, vertexCount);
+  size_t dirtyEnd = std::min<size_t>(this->dataPtr->dirtyEnd, vertexCount);
+  if (fullUpdate)
   {
-    unsigned int idx = i*6;
-    Ogre::Vector3 v = Ogre2Conversions::Convert(this->dataPtr->vertices[i]);
-    vertices[idx] = v.x;
-    vertices[idx+1] = v.y;
-    vertices[idx+2] = v.z;
-
-    bbox.merge(v);
+    dirtyBegin = 0u;
+    dirtyEnd = vertexCount;
   }
 
-  // fill the rest of the buffer with the position of the last vertex to avoid
-  // the geometry connecting back to 0, 0, 0
-  if (vertexCount > 0 && vertexCount < this->dataPtr->vertexBufferCapacity)
+  // every region of the buffer misses the modified points. A new buffer
+  // misses all of them.
+  const size_t regionCount = vaoManager->getDynamicBufferMultiplier();
+  if (recreated || this->dataPtr->staleRanges.size() != regionCount)
+  {
+    this->dataPtr->staleRanges.assign(regionCount,
+        std::make_pair(size_t(0u), size_t(vertexCount)));
+    this->dataPtr->currentRegion = 0u;
+  }
+  for (auto &range : this->dataPtr->staleRanges)
   {
-    math::Vector3d lastVertex = this->dataPtr->vertices[vertexCount-1];
-    for (unsigned int i = vertexCount; i < this->dataPtr->vertexBufferCapacity;
-        ++i)
+    if (fullUpdate || range.first == range.second)
+    {
+      range = std::make_pair(dirtyBegin, dirtyEnd);
+    }
+    else if (dirtyBegin != dirtyEnd)
     {
-      unsigned int idx = i * 6;
-      vertices[idx] = lastVertex.X();
-      vertices[idx+1] = lastVertex.Y();
-      vertices[idx+2] = lastVertex.Z();
-
-      vertices[idx+3] = 0;
-      vertices[idx+4] = 0;
-      vertices[idx+5] = 1;
+      range.first = std::min(range.first, dirtyBegin);
+      range.second = std::max(range.second, dirtyEnd);
     }
+    range.second = std::min<size_t>(range.second, vertexCount);
+    range.first = std::min(range.first, range.second);
+  }
+
+  // the bounding box grows with modified points. It is computed from
+  // scratch over all points when they are all written or when points were
+  // removed, since it can only shrink then.
+  size_t bboxBegin = dirtyBegin;
+  size_t bboxEnd = dirtyEnd;
+  if (fullUpdate || (dirtyBegin == 0u && dirtyEnd == vertexCount) ||
+      vertexCount < this->dataPtr->bboxPointCount)
+  {
+    this->dataPtr->bbox = Ogre::Aabb();
+    bboxBegin = 0u;
+    bboxEnd = vertexCount;
   }
+  for (size_t i = bboxBegin; i < bboxEnd; ++i)
+  {
+    this->dataPtr->bbox.merge(
+        Ogre2Conversions::Convert(this->dataPtr->vertices[i]));
+  }
+  this->dataPtr->bboxPointCount = vertexCount;
+
+  // map() writes to the next region of the buffer, only its stale range is
+  // written. Nothing is mapped if that range is empty, in which case the
+  // region drawn last is up to date as well and stays current.
+  const size_t nextRegion = (this->dataPtr->currentRegion + 1u) % regionCount;
+  auto &stale = this->dataPtr->staleRanges[nextRegion];
+  if (stale.first != stale.second)
+  {
+    this->dataPtr->currentRegion = nextRegion;
+    const size_t writeBegin = stale.first;
+    const size_t writeEnd = stale.second;
+    float * RESTRICT_ALIAS vertices = reinterpret_cast<float * RESTRICT_ALIAS>(
+        this->dataPtr->vertexBuffer->map(writeBegin, writeEnd - writeBegin));
+
+    // fill vertices
+    for (size_t i = writeBegin; i < writeEnd; ++i)
+    {
+      size_t idx = (i - writeBegin) * 6;
+      const math::Vector3d &v = this->dataPtr->vertices[i];
+      vertices[idx] = static_cast<float>(v.X());
+      vertices[idx+1] = static_cast<float>(v.Y());
+      vertices[idx+2] = static_cast<float>(v.Z());
+    }
 
-  // fill normals
-  this->GenerateNormals(this->dataPtr->operationType, this->dataPtr->vertices,
-      vertices);
+    // fill normals, triangles always write from the first point
+    this->GenerateNormals(this->dataPtr->operationType,
+        this->dataPtr->vertices, vertices);
 
-  // fill colors for points
-  this->GenerateColors(this->dataPtr->operationType, this->dataPtr->vertices,
-      vertices);
+    // fill colors for points
+    this->GenerateColors(this->dataPtr->operationType, writeBegin, writeEnd,
+        vertices);
 
-  // unmap buffer
-  this->dataPtr->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+    // unmap buffer
+    this->dataPtr->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+    stale = std::make_pair(size_t(0u), size_t(0u));
+  }
+
+  // only draw the points in use, the rest of the buffer is left as is
+  this->dataPtr->vao->setPrimitiveRange(0u, vertexCount);
 
   // Set the bounds to get frustum culling and LOD to work correctly.
   Ogre::Mesh *mesh = this->dataPtr->subMesh->mParent;
-  mesh->_setBounds(bbox, true);
+  mesh->_setBounds(this->dataPtr->bbox, true);
 
   // update item aabb
-  if (this->dataPtr->ogreItem)
+  if (this->dataPtr->ogreItem && !recreated)
+  {
+    this->dataPtr->ogreItem->setLocalAabb(this->dataPtr->bbox);
+  }
+  else if (this->dataPtr->ogreItem)
   {
     bool castShadows = this->dataPtr->ogreItem->getCastShadows();
     auto lowLevelMat = this->dataPtr->ogreItem->getSubItem(0)->getMaterial();
@@ -374,6 +500,9 @@ void Ogre2DynamicRenderable::UpdateBuffer()
   }
 
   this->dataPtr->dirty = false;
+  this->dataPtr->fullUpdate = false;
+  this->dataPtr->dirtyBegin = 0u;
+  this->dataPtr->dirtyEnd = 0u;
 }
 
 //////////////////////////////////////////////////
@@ -458,7 +587,8 @@ void Ogre2DynamicRenderable::AddPoint(const math::Vector3d &_pt,
   // https://forums.ogre3d.org/viewtopic.php?t=93627#p539276
   this->dataPtr->colors.push_back(_color);
 
-  this->dataPtr->dirty = true;
+  this->dataPtr->MarkDirty(this->dataPtr->vertices.size() - 1u,
+      this->dataPtr->vertices.size());
 }
 
 /////////////////////////////////////////////////
@@ -481,7 +611,46 @@ void Ogre2DynamicRenderable::SetPoint(unsigned int _index,
 
   this->dataPtr->vertices[_index] = _value;
 
-  this->dataPtr->dirty = true;
+  this->dataPtr->MarkDirty(_index, _index + 1u);
+}
+
+/////////////////////////////////////////////////
+void Ogre2DynamicRenderable::SetPoints(std::size_t _offset,
+    std::size_t _count, const float *_xyz, const uint32_t *_rgba)
+{
+  const std::size_t pointCount = this->dataPtr->vertices.size();
+  if (_offset > pointCount || (!_xyz && _offset + _count > pointCount))
+  {
+    gzerr << "Point range [" << _offset << ", " << _offset + _count
+          << ") is out of bounds[0-" << pointCount << "]" << std::endl;
+    return;
+  }
+
+  if (_count == 0u)
+    return;
+
+  const std::size_t end = _offset + _count;
+  if (end > pointCount)
+  {
+    this->dataPtr->vertices.resize(end);
+    this->dataPtr->colors.resize(end, math::Color::White);
+  }
+
+  if (_xyz)
+  {
+    math::Vector3d *vertices = this->dataPtr->vertices.data() + _offset;
+    for (std::size_t i = 0u; i < _count; ++i)
+      vertices[i].Set(_xyz[i*3], _xyz[i*3+1], _xyz[i*3+2]);
+  }
+
+  if (_rgba && this->dataPtr->colors.size() >= end)
+  {
+    math::Color *colors = this->dataPtr->colors.data() + _offset;
+    for (std::size_t i = 0u; i < _count; ++i)
+      colors[i].SetFromRGBA(_rgba[i]);
+  }
+
+  this->dataPtr->MarkDirty(_offset, end);
 }
 
 /////////////////////////////////////////////////
@@ -502,7 +671,7 @@ void Ogre2DynamicRenderable::SetColor(unsigned int _index,
   // https://forums.ogre3d.org/viewtopic.php?t=93627#p539276
   this->dataPtr->colors[_index] = _color;
 
-  this->dataPtr->dirty = true;
+  this->dataPtr->MarkDirty(_index, _index + 1u);
 }
 
 /////////////////////////////////////////////////
@@ -536,6 +705,7 @@ void Ogre2DynamicRenderable::Clear()
 
   this->dataPtr->vertices.clear();
   this->dataPtr->colors.clear();
+  this->dataPtr->fullUpdate = true;
   this->dataPtr->dirty = true;
 }
 
@@ -721,10 +891,10 @@ void Ogre2DynamicRenderable::GenerateNormals(Ogre::OperationType _opType,
 
 //////////////////////////////////////////////////
 void Ogre2DynamicRenderable::GenerateColors(Ogre::OperationType _opType,
-  const std::vector<math::Vector3d> &_vertices, float *_vbuffer)
+  std::size_t _begin, std::size_t _end, float *_vbuffer)
 {
   // Skip if colors haven't been setup per-vertex correctly.
-  if (_vertices.size() != this->dataPtr->colors.size())
+  if (this->dataPtr->vertices.size() != this->dataPtr->colors.size())
     return;
 
   // Each vertex occupies 6 elements in the vbuffer float array. Normally,
@@ -740,12 +910,11 @@ void Ogre2DynamicRenderable::GenerateColors(Ogre::OperationType _opType,
   {
     case Ogre::OperationType::OT_POINT_LIST:
     {
-      for (unsigned int i = 0; i < this->dataPtr->vertexBufferCapacity; ++i)
+      for (std::size_t i = _begin; i < _end; ++i)
       {
-        math::Color color = i < this->dataPtr->colors.size() ?
-            this->dataPtr->colors[i] : this->dataPtr->colors.back();
+        const math::Color &color = this->dataPtr->colors[i];
 
-        unsigned int idx = i * 6;
+        std::size_t idx = (i - _begin) * 6;
         _vbuffer[idx+3] = color.R();
         _vbuffer[idx+4] = color.G();
         _vbuffer[idx+5] = color.B();
@@ -15,12 +15,16 @@
  *
 */
 
+#include <cstdint>
+#include <vector>
+
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
 
 #include <gz/common/Console.hh>
 #include <gz/math/Helpers.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2Camera.hh"
 #include "gz/rendering/ogre2/Ogre2GpuRays.hh"
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
@@ -36,6 +40,7 @@
 
 #include "Ogre2GzHlmsSphericalClipMinDistance.hh"
 #include "Ogre2ParticleNoiseListener.hh"
+#include "Ogre2TextureReadback.hh"
 #include "Terra/Hlms/PbsListener/OgreHlmsPbsTerraShadows.h"
 
 #include "Terra/Terra.h"
@@ -127,9 +132,17 @@ class GZ_RENDERING_OGRE2_HIDDEN gz::rendering::Ogre2GpuRaysPrivate
                unsigned int, unsigned int, unsigned int,
                const std::string &)> newGpuRaysFrame;
 
+  /// \brief Event used to signal a view of the mapped gpu rays data
+  public: gz::common::EventT<void(const SensorFrameView &)>
+      newGpuRaysFrameView;
+
   /// \brief Outgoing gpu rays data, used by newGpuRaysFrame event.
   public: float *gpuRaysScan = nullptr;
 
+  /// \brief Gpu rays data in the RGBA layout of frame views, used by
+  /// newGpuRaysFrameView event. Reused across frames.
+  public: std::vector<float> gpuRaysViewScan;
+
   /// \brief Cubemap camera
   public: Ogre::Camera *cubeCam{nullptr};
 
@@ -212,6 +225,9 @@ class GZ_RENDERING_OGRE2_HIDDEN gz::rendering::Ogre2GpuRaysPrivate
 
   /// \brief Pointer to the particle target definition in the workspace
   public: Ogre::CompositorTargetDef *particleTargetDef{nullptr};
+
+  /// \brief Reads back the 2nd pass texture from the GPU
+  public: Ogre2TextureReadback readback;
 };
 
 using namespace gz;
@@ -588,6 +604,8 @@ void Ogre2GpuRays::Destroy()
     this->dataPtr->gpuRaysScan = nullptr;
   }
 
+  this->dataPtr->readback.Reset();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   auto textureGpuManager = ogreRoot->getRenderSystem()->getTextureGpuManager();
@@ -1116,8 +1134,10 @@ void Ogre2GpuRays::Setup2ndPass()
   this->dataPtr->secondPassTexture->setResolution(
     this->dataPtr->w2nd, this->dataPtr->h2nd);
   this->dataPtr->secondPassTexture->setNumMipmaps(1u);
+  // only the range and retro values are stored, the 3rd channel of the
+  // output data is always 0
   this->dataPtr->secondPassTexture->setPixelFormat(
-    Ogre::PFG_RGBA32_FLOAT);
+    Ogre::PFG_RG32_FLOAT);
   this->dataPtr->secondPassTexture->_setDepthBufferDefaults(
     Ogre::DepthBuffer::POOL_NO_DEPTH, false, Ogre::PFG_UNKNOWN);
 
@@ -1247,6 +1267,7 @@ void Ogre2GpuRays::UpdateRenderTarget2ndPass()
 //////////////////////////////////////////////////
 void Ogre2GpuRays::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2GpuRays::Render");
   this->scene->StartRendering(this->dataPtr->ogreCamera);
 
   auto engine = Ogre2RenderEngine::Instance();
@@ -1299,47 +1320,77 @@ void Ogre2GpuRays::PreRender()
 //////////////////////////////////////////////////
 void Ogre2GpuRays::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2GpuRays::PostRender");
   unsigned int width = this->dataPtr->w2nd;
   unsigned int height = this->dataPtr->h2nd;
 
-  PixelFormat format = PF_FLOAT32_RGBA;
-  unsigned int rawChannelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
+  PixelFormat format = PF_FLOAT32_RG;
 
   // blit data from gpu to cpu
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->secondPassTexture, 0u, 0u);
-  Ogre::TextureBox box = image.getData(0u);
-  float *bufferTmp = static_cast<float *>(box.data);
-
-  // Metal does not support RGB32_FLOAT so the internal texture format is
-  // RGBA32_FLOAT. For backward compatibility, output data is kept in RGB
-  // format instead of RGBA
-  int outputLen = width * height * this->Channels();
-  if (!this->dataPtr->gpuRaysScan)
-  {
-    this->dataPtr->gpuRaysScan = new float[outputLen];
-  }
+  this->dataPtr->readback.SetLatency(this->ReadbackLatency());
+  Ogre::TextureBox box;
+  if (!this->dataPtr->readback.Read(this->dataPtr->secondPassTexture, box))
+    return;
+  this->readbackFrameId = this->dataPtr->readback.FrameId();
+  this->readbackFrameTime = this->dataPtr->readback.FrameTime();
 
-  // copy data from RGBA buffer to RGB buffer
-  for (unsigned int row = 0; row < height; ++row)
+  // Frame views hold the readings in RGBA pixels, see
+  // GpuRays::ConnectNewGpuRaysFrameView. The RG data read back is expanded
+  // once into a buffer kept across frames, skipping the row padding.
+  if (this->dataPtr->newGpuRaysFrameView.ConnectionCount() > 0u)
   {
-    unsigned int rawDataRowIdx = row * box.bytesPerRow / bytesPerChannel;
-    unsigned int rowIdx = row * width * this->Channels();
-
-    // the texture box step size could be larger than our image buffer step
-    // size
-    for (unsigned int column = 0; column < width; ++column)
+    auto &viewScan = this->dataPtr->gpuRaysViewScan;
+    viewScan.resize(static_cast<size_t>(width) * height * 4u);
+    for (unsigned int y = 0u; y < height; ++y)
     {
-      unsigned int idx = rowIdx + column * this->Channels();
-      unsigned int rawIdx = rawDataRowIdx + column * rawChannelCount;
+      const float *row = reinterpret_cast<const float *>(
+          static_cast<const uint8_t *>(box.data) + y * box.bytesPerRow);
+      float *viewRow = viewScan.data() + static_cast<size_t>(y) * width * 4u;
+      for (unsigned int x = 0u; x < width; ++x)
+      {
+        viewRow[x * 4u] = row[x * 2u];
+        viewRow[x * 4u + 1u] = row[x * 2u + 1u];
+        viewRow[x * 4u + 2u] = 0.0f;
+        viewRow[x * 4u + 3u] = 0.0f;
+      }
+    }
 
-      this->dataPtr->gpuRaysScan[idx] = bufferTmp[rawIdx];
-      this->dataPtr->gpuRaysScan[idx + 1] = bufferTmp[rawIdx + 1];
-      this->dataPtr->gpuRaysScan[idx + 2] = bufferTmp[rawIdx + 2];
+    SensorFrameView view;
+    view.data = viewScan.data();
+    view.width = width;
+    view.height = height;
+    view.rowPitch = width * 4u * sizeof(float);
+    view.pixelStride = 4u * sizeof(float);
+    view.channels = this->Channels();
+    view.format = PF_FLOAT32_RGBA;
+    view.frameId = this->readbackFrameId;
+    view.token = this->dataPtr->readback.Token();
+    this->dataPtr->newGpuRaysFrameView(view);
+
+    // the packed buffer is only needed by the packed subscribers
+    if (this->dataPtr->newGpuRaysFrame.ConnectionCount() == 0u)
+    {
+      this->dataPtr->readback.Unmap();
+      return;
     }
   }
 
+  // The internal texture format is RG32_FLOAT, which halves the data read
+  // back compared to RGBA32_FLOAT (Metal does not support RGB32_FLOAT).
+  // For backward compatibility, output data is kept in RGB format
+  int outputLen = width * height * this->Channels();
+  if (!this->dataPtr->gpuRaysScan)
+  {
+    this->dataPtr->gpuRaysScan = new float[outputLen];
+  }
+
+  // copy data from RG buffer to RGB buffer. The texture box step size
+  // could be larger than our image buffer step size
+  PixelUtil::Convert(box.data, format,
+      static_cast<unsigned int>(box.bytesPerRow),
+      this->dataPtr->gpuRaysScan, PF_FLOAT32_RGB, 0u, width, height);
+  this->dataPtr->readback.Unmap();
+
   this->dataPtr->newGpuRaysFrame(this->dataPtr->gpuRaysScan,
       width, height, this->Channels(), "PF_FLOAT32_RGB");
 
@@ -1403,6 +1454,13 @@ common::ConnectionPtr Ogre2GpuRays::ConnectNewGpuRaysFrame(
   return this->dataPtr->newGpuRaysFrame.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+common::ConnectionPtr Ogre2GpuRays::ConnectNewGpuRaysFrameView(
+    std::function<void(const SensorFrameView &)> _subscriber)
+{
+  return this->dataPtr->newGpuRaysFrameView.Connect(_subscriber);
+}
+
 //////////////////////////////////////////////////
 RenderTargetPtr Ogre2GpuRays::RenderTarget() const
 {
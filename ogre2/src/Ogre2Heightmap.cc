@@ -234,12 +234,12 @@ void Ogre2Heightmap::Init()
   Ogre::SceneManager *ogreSceneManager = ogreScene->OgreSceneManager();
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
 
-  // TODO(anyone): Gazebo doesn't support SCENE_STATIC scene nodes
+  // The terrain is created dynamic and moves to SCENE_STATIC memory with
+  // the visual it is attached to, see Ogre2Visual::SetStatic
   this->dataPtr->terra =
       std::make_unique<Ogre::Terra>(
         Ogre::Id::generateNewId<Ogre::MovableObject>(),
-        &ogreSceneManager->_getEntityMemoryManager(
-          Ogre::/*SCENE_STATIC*/SCENE_DYNAMIC),
+        &ogreSceneManager->_getEntityMemoryManager(Ogre::SCENE_DYNAMIC),
         ogreSceneManager, 11u, ogreCompMgr, nullptr, true );
 
   // Does not cast shadows because it uses a raymarching implementation
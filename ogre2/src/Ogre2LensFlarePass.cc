@@ -102,6 +102,25 @@ class gz::rendering::Ogre2LensFlarePass::Implementation
   /// \brief See Ogre2LensFlarePassWorkspaceListenerPrivate
   public: Ogre2LensFlarePassWorkspaceListenerPrivate workspaceListener;
 
+  /// \brief Advance currentFaceIdx past the cubemap faces that the wide
+  /// angle camera being rendered does not render
+  /// \param[in] _afterStitching True if the pass is applied after the faces
+  /// are stitched, in which case it is only done once
+  public: void SkipUnrenderedFaces(bool _afterStitching)
+  {
+    if (_afterStitching)
+      return;
+    Ogre2WideAngleCameraPtr wideAngleCamera =
+      std::dynamic_pointer_cast<Ogre2WideAngleCamera>(this->currentCamera);
+    if (!wideAngleCamera)
+      return;
+    while (this->currentFaceIdx < 6u &&
+           !wideAngleCamera->IsFaceRendered(this->currentFaceIdx))
+    {
+      ++this->currentFaceIdx;
+    }
+  }
+
   public: explicit Implementation(gz::rendering::Ogre2LensFlarePass &_owner) :
     workspaceListener(_owner)
   {
@@ -167,6 +186,7 @@ void Ogre2LensFlarePass::PreRender(const CameraPtr &_camera)
 
   this->dataPtr->currentCamera = _camera;
   this->dataPtr->currentFaceIdx = 0u;
+  this->dataPtr->SkipUnrenderedFaces(this->WideAngleCameraAfterStitching());
 }
 
 //////////////////////////////////////////////////
@@ -380,6 +400,8 @@ void Ogre2LensFlarePassWorkspaceListenerPrivate::passPreExecute(
   }
 
   ++this->owner.dataPtr->currentFaceIdx;
+  this->owner.dataPtr->SkipUnrenderedFaces(
+    this->owner.WideAngleCameraAfterStitching());
 
   GpuProgramParametersSharedPtr psParams = pass->getFragmentProgramParameters();
 
@@ -25,8 +25,14 @@
 #endif
 #endif
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2DynamicRenderable.hh"
 #include "gz/rendering/ogre2/Ogre2LidarVisual.hh"
@@ -49,20 +55,30 @@
 
 class gz::rendering::Ogre2LidarVisualPrivate
 {
+  /// \brief Create a renderable attached to the visual
+  /// \param[in] _scene Scene to create the renderable in
+  /// \param[in] _node Node to attach the renderable to
+  /// \param[in] _type Type of primitives drawn by the renderable
+  /// \param[in] _material Name of the material of the renderable
+  /// \return The new renderable
+  public: std::shared_ptr<Ogre2DynamicRenderable> CreateRenderable(
+              ScenePtr _scene, Ogre::SceneNode *_node, MarkerType _type,
+              const std::string &_material);
+
   /// \brief Non Hitting DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> noHitRayStrips;
+  public: std::shared_ptr<Ogre2DynamicRenderable> noHitRayStrips;
 
   /// \brief Hitting DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> rayStrips;
+  public: std::shared_ptr<Ogre2DynamicRenderable> rayStrips;
 
   /// \brief Dead Zone Geometry DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> deadZoneRayFans;
+  public: std::shared_ptr<Ogre2DynamicRenderable> deadZoneRayFans;
 
   /// \brief Lidar Ray DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> rayLines;
+  public: std::shared_ptr<Ogre2DynamicRenderable> rayLines;
 
   /// \brief Lidar Points DynamicLines Object to display
-  public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> points;
+  public: std::shared_ptr<Ogre2DynamicRenderable> points;
 
   /// \brief Lidar visual type
   public: LidarVisualType lidarVisType =
@@ -83,11 +99,116 @@ class gz::rendering::Ogre2LidarVisualPrivate
   /// \brief Pointer to point cloud material.
   /// Used when LidarVisualType = LVT_POINTS.
   public: Ogre::MaterialPtr pointsMat;
+
+  /// \brief x, y and z of the unit direction of each ray in the visual
+  /// frame, row by row. Only computed again when the lidar configuration
+  /// changes.
+  public: std::vector<float> rayDirections;
+
+  /// \brief Angles, counts and offset rotation the ray directions were
+  /// computed for
+  public: std::vector<double> rayConfig;
+
+  /// \brief Positions written to the ray lines renderable
+  public: std::vector<float> rayLinesXyz;
+
+  /// \brief Positions written to the hitting strips renderable
+  public: std::vector<float> rayStripsXyz;
+
+  /// \brief Positions written to the non hitting strips renderable
+  public: std::vector<float> noHitRayStripsXyz;
+
+  /// \brief Positions written to the dead zone renderable
+  public: std::vector<float> deadZoneXyz;
+
+  /// \brief Positions written to the points renderable
+  public: std::vector<float> pointsXyz;
+
+  /// \brief Colors written to the points renderable
+  public: std::vector<uint32_t> pointsRgba;
 };
 
+namespace
+{
+  /// \brief Compute a point along a ray
+  /// \param[in] _origin x, y and z of the origin of the ray
+  /// \param[in] _dir x, y and z of the unit direction of the ray
+  /// \param[in] _range Distance from the origin
+  /// \param[out] _pt x, y and z of the point
+  void RayPoint(const float *_origin, const float *_dir, float _range,
+      float *_pt)
+  {
+    _pt[0] = _origin[0] + _dir[0] * _range;
+    _pt[1] = _origin[1] + _dir[1] * _range;
+    _pt[2] = _origin[2] + _dir[2] * _range;
+  }
+
+  /// \brief Append a point to a buffer of x, y, z coordinates
+  /// \param[in,out] _xyz Buffer to append to
+  /// \param[in] _pt x, y and z of the point to append
+  void AppendPoint(std::vector<float> &_xyz, const float *_pt)
+  {
+    _xyz.insert(_xyz.end(), _pt, _pt + 3);
+  }
+
+  /// \brief Start a new triangle strip in a buffer already holding one.
+  /// The last point and the first point of the new strip are repeated, which
+  /// creates degenerate triangles that are not drawn. An even number of
+  /// points is added so that the winding of the new strip is unchanged.
+  /// \param[in,out] _xyz Buffer holding the strips
+  /// \param[in] _first x, y and z of the first point of the new strip
+  void JoinStrip(std::vector<float> &_xyz, const float *_first)
+  {
+    if (_xyz.size() < 3u)
+      return;
+    const std::size_t last = _xyz.size() - 3u;
+    for (std::size_t k = 0u; k < 3u; ++k)
+      _xyz.push_back(_xyz[last + k]);
+    AppendPoint(_xyz, _first);
+  }
+
+  /// \brief Replace all the points of a renderable and update it
+  /// \param[in] _renderable Renderable to update
+  /// \param[in] _xyz Positions of the points
+  /// \param[in] _rgba Packed colors of the points, or null
+  void UploadPoints(gz::rendering::Ogre2DynamicRenderable &_renderable,
+      const std::vector<float> &_xyz, const uint32_t *_rgba = nullptr)
+  {
+    const std::size_t count = _xyz.size() / 3u;
+    if (count < _renderable.PointCount())
+      _renderable.Clear();
+    _renderable.SetPoints(0u, count, _xyz.data(), _rgba);
+    _renderable.Update();
+  }
+}
+
 using namespace gz;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+std::shared_ptr<Ogre2DynamicRenderable>
+    Ogre2LidarVisualPrivate::CreateRenderable(ScenePtr _scene,
+    Ogre::SceneNode *_node, MarkerType _type, const std::string &_material)
+{
+  auto renderable = std::make_shared<Ogre2DynamicRenderable>(_scene);
+  renderable->SetOperationType(_type);
+
+  if (_type == MT_POINTS)
+  {
+    // use low level programmable material so we can customize point size
+    Ogre::Item *item = dynamic_cast<Ogre::Item *>(renderable->OgreObject());
+    item->setCastShadows(false);
+    item->getSubItem(0)->setMaterial(this->pointsMat);
+  }
+  else
+  {
+    renderable->SetMaterial(_scene->Material(_material), false);
+  }
+
+  _node->attachObject(renderable->OgreObject());
+  return renderable;
+}
+
 //////////////////////////////////////////////////
 Ogre2LidarVisual::Ogre2LidarVisual()
   : dataPtr(new Ogre2LidarVisualPrivate)
@@ -110,35 +231,7 @@ void Ogre2LidarVisual::PreRender()
 void Ogre2LidarVisual::Destroy()
 {
   BaseLidarVisual::Destroy();
-  for (auto ray : this->dataPtr->noHitRayStrips)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->rayStrips)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->rayLines)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->deadZoneRayFans)
-  {
-    ray->Clear();
-    ray.reset();
-  }
-
-  for (auto ray : this->dataPtr->points)
-  {
-    ray->Clear();
-    ray.reset();
-  }
+  this->ClearVisualData();
 
   this->dataPtr->lidarPoints.clear();
   this->dataPtr->pointsMat.setNull();
@@ -187,11 +280,11 @@ void Ogre2LidarVisual::ClearPoints()
 //////////////////////////////////////////////////
 void Ogre2LidarVisual::ClearVisualData()
 {
-  this->dataPtr->noHitRayStrips.clear();
-  this->dataPtr->deadZoneRayFans.clear();
-  this->dataPtr->rayLines.clear();
-  this->dataPtr->rayStrips.clear();
-  this->dataPtr->points.clear();
+  this->dataPtr->noHitRayStrips.reset();
+  this->dataPtr->deadZoneRayFans.reset();
+  this->dataPtr->rayLines.reset();
+  this->dataPtr->rayStrips.reset();
+  this->dataPtr->points.reset();
 }
 
 //////////////////////////////////////////////////
@@ -204,6 +297,8 @@ void Ogre2LidarVisual::SetPoints(const std::vector<double> &_points)
 //////////////////////////////////////////////////
 void Ogre2LidarVisual::Update()
 {
+  GZ_RENDERING_PROFILE("Ogre2LidarVisual::Update");
+
   if (this->lidarVisualType == LidarVisualType::LVT_NONE)
   {
     this->ClearVisualData();
@@ -217,30 +312,16 @@ void Ogre2LidarVisual::Update()
     return;
   }
 
-  bool clearVisuals = false;
-
-  if (this->lidarVisualType != this->dataPtr->lidarVisType
-        || !this->displayNonHitting)
-  {
-    clearVisuals = true;
-  }
-
-  if (this->displayNonHitting != this->dataPtr->currentDisplayNonHitting)
-  {
-    clearVisuals = true;
-    this->dataPtr->currentDisplayNonHitting = this->displayNonHitting;
-  }
-
   // if visual type is changed, clear all DynamicLines
-  if (clearVisuals)
+  if (this->lidarVisualType != this->dataPtr->lidarVisType ||
+      this->displayNonHitting != this->dataPtr->currentDisplayNonHitting)
   {
     this->ClearVisualData();
+    this->dataPtr->currentDisplayNonHitting = this->displayNonHitting;
   }
   this->dataPtr->lidarVisType = this->lidarVisualType;
 
   this->dataPtr->receivedData = false;
-  double horizontalAngle = this->minHorizontalAngle;
-  double verticalAngle = this->minVerticalAngle;
 
   if (this->horizontalCount > 1)
   {
@@ -265,231 +346,175 @@ void Ogre2LidarVisual::Update()
     return;
   }
 
-  // Process each point from received data
-  // Every line segment, and every triangle is saved separately,
-  // as a pointer to a DynamicLine
-  // This initializes and updates only the selected DynamicLine variables
-  for (unsigned int j = 0; j < this->verticalCount; ++j)
+  // The direction of the rays only depends on the lidar configuration, so
+  // it is not computed again for every scan
+  const math::Quaterniond &offsetRot = this->offset.Rot();
+  const std::vector<double> rayConfig = {
+      this->minHorizontalAngle, this->horizontalAngleStep,
+      this->minVerticalAngle, this->verticalAngleStep,
+      static_cast<double>(this->horizontalCount),
+      static_cast<double>(this->verticalCount),
+      offsetRot.W(), offsetRot.X(), offsetRot.Y(), offsetRot.Z()};
+  if (rayConfig != this->dataPtr->rayConfig)
   {
-    horizontalAngle = this->minHorizontalAngle;
-
-    if (this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES ||
-        this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
+    this->dataPtr->rayConfig = rayConfig;
+    this->dataPtr->rayDirections.resize(
+        this->verticalCount * this->horizontalCount * 3u);
+    for (unsigned int j = 0; j < this->verticalCount; ++j)
     {
-      if (j+1 > this->dataPtr->rayLines.size())
+      double verticalAngle =
+          this->minVerticalAngle + j * this->verticalAngleStep;
+      for (unsigned int i = 0; i < this->horizontalCount; ++i)
       {
-        std::shared_ptr<Ogre2DynamicRenderable> renderable =
-                        std::shared_ptr<Ogre2DynamicRenderable>(
-                                    new Ogre2DynamicRenderable(this->Scene()));
-
-        renderable->SetOperationType(MT_LINE_LIST);
-        MaterialPtr mat = this->Scene()->Material("Lidar/BlueRay");
-        renderable->SetMaterial(mat, false);
-
-        this->ogreNode->attachObject(renderable->OgreObject());
-        this->dataPtr->rayLines.push_back(renderable);
-
-        if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
-        {
-          renderable = std::shared_ptr<Ogre2DynamicRenderable>(
-                                  new Ogre2DynamicRenderable(this->Scene()));
-
-          renderable->SetOperationType(MT_TRIANGLE_STRIP);
-          mat = this->Scene()->Material("Lidar/LightBlueStrips");
-
-          renderable->SetMaterial(mat, false);
-
-          this->ogreNode->attachObject(renderable->OgreObject());
-          this->dataPtr->noHitRayStrips.push_back(renderable);
-
-          renderable = std::shared_ptr<Ogre2DynamicRenderable>(
-                                  new Ogre2DynamicRenderable(this->Scene()));
-
-          renderable->SetOperationType(MT_TRIANGLE_FAN);
-          mat = this->Scene()->Material("Lidar/TransBlack");
-
-          renderable->SetMaterial(mat, false);
-
-          this->ogreNode->attachObject(renderable->OgreObject());
-          this->dataPtr->deadZoneRayFans.push_back(renderable);
-          this->dataPtr->deadZoneRayFans[j]->AddPoint(
-                      gz::math::Vector3d::Zero);
-
-          renderable = std::shared_ptr<Ogre2DynamicRenderable>(
-                                  new Ogre2DynamicRenderable(this->Scene()));
-
-          renderable->SetOperationType(MT_TRIANGLE_STRIP);
-          mat = this->Scene()->Material("Lidar/BlueStrips");
-
-          renderable->SetMaterial(mat, false);
-
-          this->ogreNode->attachObject(renderable->OgreObject());
-          this->dataPtr->rayStrips.push_back(renderable);
-        }
-      }
-    }
-
-    else if (this->dataPtr->lidarVisType ==
-                  LidarVisualType::LVT_POINTS)
-    {
-      if (j+1 > this->dataPtr->points.size())
-      {
-        std::shared_ptr<Ogre2DynamicRenderable> renderable =
-                        std::shared_ptr<Ogre2DynamicRenderable>(
-                                    new Ogre2DynamicRenderable(this->Scene()));
-
-        renderable->SetOperationType(MT_POINTS);
-
-        // use low level programmable material so we can customize point size
-        Ogre::Item *item = dynamic_cast<Ogre::Item *>(renderable->OgreObject());
-        item->setCastShadows(false);
-        item->getSubItem(0)->setMaterial(this->dataPtr->pointsMat);
-
-        this->ogreNode->attachObject(renderable->OgreObject());
-        this->dataPtr->points.push_back(renderable);
+        double horizontalAngle =
+            this->minHorizontalAngle + i * this->horizontalAngleStep;
+        math::Quaterniond ray(
+            math::Vector3d(0.0, -verticalAngle, horizontalAngle));
+        const math::Vector3d axis =
+            offsetRot * ray * math::Vector3d(1.0, 0.0, 0.0);
+        float *dir = &this->dataPtr->rayDirections[
+            (j * this->horizontalCount + i) * 3u];
+        dir[0] = static_cast<float>(axis.X());
+        dir[1] = static_cast<float>(axis.Y());
+        dir[2] = static_cast<float>(axis.Z());
       }
     }
+  }
 
-    if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
+  const bool strips =
+      this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS;
+  const bool lines = strips ||
+      this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES;
+  const bool points =
+      this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS;
+
+  auto &rayLinesXyz = this->dataPtr->rayLinesXyz;
+  auto &rayStripsXyz = this->dataPtr->rayStripsXyz;
+  auto &noHitRayStripsXyz = this->dataPtr->noHitRayStripsXyz;
+  auto &deadZoneXyz = this->dataPtr->deadZoneXyz;
+  auto &pointsXyz = this->dataPtr->pointsXyz;
+  rayLinesXyz.clear();
+  rayStripsXyz.clear();
+  noHitRayStripsXyz.clear();
+  deadZoneXyz.clear();
+  pointsXyz.clear();
+
+  const float origin[3] = {
+      static_cast<float>(this->offset.Pos().X()),
+      static_cast<float>(this->offset.Pos().Y()),
+      static_cast<float>(this->offset.Pos().Z())};
+  const float minRange = static_cast<float>(this->minRange);
+  const float maxRange = static_cast<float>(this->maxRange);
+  float startPt[3];
+  float pt[3];
+  float noHitPt[3];
+
+  // All the rows are written to a single renderable per primitive type, so
+  // that a scan is uploaded and drawn in one go whatever the number of rows
+  for (unsigned int j = 0; j < this->verticalCount; ++j)
+  {
+    for (unsigned int i = 0; i < this->horizontalCount; ++i)
     {
-      this->dataPtr->deadZoneRayFans[j]->SetPoint(0, this->offset.Pos());
-    }
+      const unsigned int index = j * this->horizontalCount + i;
 
-    auto pointMat = this->Scene()->Material("Lidar/BlueRay");
-
-    unsigned count = this->horizontalCount;
-    // Process each ray in current scan
-    for (unsigned int i = 0; i < count; ++i)
-    {
       // calculate range of the ray
-      double r = this->dataPtr->lidarPoints[ j * this->horizontalCount + i];
+      double r = this->dataPtr->lidarPoints[index];
 
       bool inf = (std::isinf(r) || r >= this->maxRange);
-      gz::math::Quaterniond ray(
-        gz::math::Vector3d(0.0, -verticalAngle, horizontalAngle));
-
-      gz::math::Vector3d axis = this->offset.Rot() * ray *
-        gz::math::Vector3d(1.0, 0.0, 0.0);
+      const float *axis = &this->dataPtr->rayDirections[index * 3u];
 
       // Check for infinite range, which indicates the ray did not
       // intersect an object.
-      double hitRange = inf ? 0 : r;
+      float hitRange = inf ? 0.0f : static_cast<float>(r);
 
       // Compute the start point of the ray
-      gz::math::Vector3d startPt =
-                  (axis * this->minRange) + this->offset.Pos();
+      RayPoint(origin, axis, minRange, startPt);
 
       // Compute the end point of the ray
-      gz::math::Vector3d pt =
-                  (axis * hitRange) + this->offset.Pos();
+      RayPoint(origin, axis, hitRange, pt);
 
-      double noHitRange = inf ? this->maxRange : hitRange;
+      float noHitRange = inf ? maxRange : hitRange;
 
       // Compute the end point of the no-hit ray
-      gz::math::Vector3d noHitPt =
-                  (axis * noHitRange) + this->offset.Pos();
-
-      // Update the lines and strips that represent each simulated ray.
+      RayPoint(origin, axis, noHitRange, noHitPt);
 
-      // For TRIANGLE_STRIPS Lidar Visual to be displayed
-      if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS
-        || this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES)
+      if (lines && (this->displayNonHitting || !inf))
       {
-        if (i >= this->dataPtr->rayLines[j]->PointCount()/2)
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->rayLines[j]->AddPoint(startPt);
-            this->dataPtr->rayLines[j]->AddPoint(inf ? noHitPt: pt);
-          }
-
-          if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_TRIANGLE_STRIPS)
-          {
-            this->dataPtr->rayStrips[j]->AddPoint(startPt);
-            this->dataPtr->rayStrips[j]->AddPoint(inf ? startPt : pt);
-
-            this->dataPtr->noHitRayStrips[j]->AddPoint(startPt);
-            this->dataPtr->noHitRayStrips[j]->AddPoint(
-                inf ? (this->displayNonHitting? noHitPt: startPt) : pt);
-          }
-        }
-        else
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->rayLines[j]->SetPoint(i*2, startPt);
-            this->dataPtr->rayLines[j]->SetPoint(i*2+1, inf ? noHitPt: pt);
-          }
-
-          if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_TRIANGLE_STRIPS)
-          {
-            this->dataPtr->rayStrips[j]->SetPoint(i*2, startPt);
-            this->dataPtr->rayStrips[j]->SetPoint(i*2+1, inf? startPt : pt);
-
-            this->dataPtr->noHitRayStrips[j]->SetPoint(i*2, startPt);
-            this->dataPtr->noHitRayStrips[j]->SetPoint(i*2+1,
-                inf ? (this->displayNonHitting? noHitPt: startPt) : pt);
-          }
-        }
-        if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
-        {
-          // Draw the triangle fan that indicates the dead zone.
-          if (i+1 >= this->dataPtr->deadZoneRayFans[j]->PointCount())
-            this->dataPtr->deadZoneRayFans[j]->AddPoint(startPt);
-          else
-            this->dataPtr->deadZoneRayFans[j]->SetPoint(i+1, startPt);
-        }
+        AppendPoint(rayLinesXyz, startPt);
+        AppendPoint(rayLinesXyz, inf ? noHitPt : pt);
       }
 
-      // For POINTS Lidar Visual to be displayed
-      else if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_POINTS)
+      if (strips)
       {
-        if (i >= this->dataPtr->points[j]->PointCount())
+        // rows are separate strips
+        if (i == 0)
         {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->points[j]->AddPoint(inf ? noHitPt : pt,
-                pointMat->Diffuse());
-          }
-        }
-        else
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->points[j]->SetPoint(i, inf ? noHitPt : pt);
-            this->dataPtr->points[j]->SetColor(i, pointMat->Diffuse());
-          }
+          JoinStrip(rayStripsXyz, startPt);
+          JoinStrip(noHitRayStripsXyz, startPt);
+          JoinStrip(deadZoneXyz, origin);
         }
+
+        AppendPoint(rayStripsXyz, startPt);
+        AppendPoint(rayStripsXyz, inf ? startPt : pt);
+
+        AppendPoint(noHitRayStripsXyz, startPt);
+        AppendPoint(noHitRayStripsXyz,
+            inf ? (this->displayNonHitting ? noHitPt : startPt) : pt);
+
+        // The dead zone is a fan around the origin, drawn as a strip
+        // alternating the origin and the start points
+        AppendPoint(deadZoneXyz, origin);
+        AppendPoint(deadZoneXyz, startPt);
       }
-      horizontalAngle += this->horizontalAngleStep;
+
+      if (points && (this->displayNonHitting || !inf))
+        AppendPoint(pointsXyz, inf ? noHitPt : pt);
     }
+  }
 
-    // Update the DynamicLines pointers after adding points based on type
-    if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS
-      || this->dataPtr->lidarVisType == LidarVisualType::LVT_RAY_LINES)
+  // Create the renderables on first use and upload the points
+  ScenePtr scene = this->Scene();
+  if (lines)
+  {
+    if (!this->dataPtr->rayLines)
     {
-      this->dataPtr->rayLines[j]->Update();
-      if (this->dataPtr->lidarVisType ==
-                      LidarVisualType::LVT_TRIANGLE_STRIPS)
-      {
-        this->dataPtr->rayStrips[j]->Update();
-        this->dataPtr->noHitRayStrips[j]->Update();
-        this->dataPtr->deadZoneRayFans[j]->Update();
-      }
+      this->dataPtr->rayLines = this->dataPtr->CreateRenderable(scene,
+          this->ogreNode, MT_LINE_LIST, "Lidar/BlueRay");
     }
-    else if (this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS)
+    UploadPoints(*this->dataPtr->rayLines, rayLinesXyz);
+  }
+
+  if (strips)
+  {
+    if (!this->dataPtr->noHitRayStrips)
     {
-      this->dataPtr->points[j]->Update();
+      this->dataPtr->noHitRayStrips = this->dataPtr->CreateRenderable(scene,
+          this->ogreNode, MT_TRIANGLE_STRIP, "Lidar/LightBlueStrips");
+      this->dataPtr->deadZoneRayFans = this->dataPtr->CreateRenderable(scene,
+          this->ogreNode, MT_TRIANGLE_STRIP, "Lidar/TransBlack");
+      this->dataPtr->rayStrips = this->dataPtr->CreateRenderable(scene,
+          this->ogreNode, MT_TRIANGLE_STRIP, "Lidar/BlueStrips");
     }
-    verticalAngle += this->verticalAngleStep;
+    UploadPoints(*this->dataPtr->noHitRayStrips, noHitRayStripsXyz);
+    UploadPoints(*this->dataPtr->deadZoneRayFans, deadZoneXyz);
+    UploadPoints(*this->dataPtr->rayStrips, rayStripsXyz);
   }
 
-  if (this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS &&
-      !this->dataPtr->points.empty())
+  if (points)
   {
+    if (!this->dataPtr->points)
+    {
+      this->dataPtr->points = this->dataPtr->CreateRenderable(scene,
+          this->ogreNode, MT_POINTS, "");
+    }
+
+    // all points have the same color
+    const uint32_t rgba =
+        scene->Material("Lidar/BlueRay")->Diffuse().AsRGBA();
+    this->dataPtr->pointsRgba.assign(pointsXyz.size() / 3u, rgba);
+    UploadPoints(*this->dataPtr->points, pointsXyz,
+        this->dataPtr->pointsRgba.data());
+
     // point renderables use low level materials
     // get the material and set size uniform variable
     auto pass = this->dataPtr->pointsMat->getTechnique(0)->getPass(0);
@@ -174,6 +174,9 @@ Ogre::Light *Ogre2Light::Light() const
 void Ogre2Light::Destroy()
 {
   BaseLight::Destroy();
+  // the shadow maps must not keep using the destroyed light
+  if (this->ogreLight->getCastShadows())
+    this->scene->SetShadowsDirty(true);
   Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
   ogreSceneManager->destroySceneNode(this->ogreLight->getParentSceneNode());
   ogreSceneManager->destroyLight(this->ogreLight);
@@ -294,6 +294,14 @@ void Ogre2Marker::SetPoint(unsigned int _index,
   this->dataPtr->dynamicRenderable->SetPoint(_index, _value);
 }
 
+//////////////////////////////////////////////////
+void Ogre2Marker::SetPoints(std::size_t _offset, std::size_t _count,
+    const float *_xyz, const uint32_t *_rgba)
+{
+  BaseMarker::SetPoints(_offset, _count, _xyz, _rgba);
+  this->dataPtr->dynamicRenderable->SetPoints(_offset, _count, _xyz, _rgba);
+}
+
 //////////////////////////////////////////////////
 void Ogre2Marker::AddPoint(const math::Vector3d &_pt,
     const math::Color &_color)
@@ -302,6 +310,12 @@ void Ogre2Marker::AddPoint(const math::Vector3d &_pt,
   this->dataPtr->dynamicRenderable->AddPoint(_pt, _color);
 }
 
+//////////////////////////////////////////////////
+unsigned int Ogre2Marker::PointCount() const
+{
+  return this->dataPtr->dynamicRenderable->PointCount();
+}
+
 //////////////////////////////////////////////////
 void Ogre2Marker::ClearPoints()
 {
@@ -1523,6 +1523,9 @@ void Ogre2Material::SetVertexShader(const std::string &_path)
 
   this->dataPtr->vertexShaderPath = _path;
   this->dataPtr->vertexShaderParams.reset(new ShaderParams);
+
+  // visuals using this material now update its shader params every frame
+  this->scene->SetShaderMaterialsDirty();
 }
 
 //////////////////////////////////////////////////
@@ -1591,6 +1594,9 @@ void Ogre2Material::SetFragmentShader(const std::string &_path)
   mat->load();
   this->dataPtr->fragmentShaderPath = _path;
   this->dataPtr->fragmentShaderParams.reset(new ShaderParams);
+
+  // visuals using this material now update its shader params every frame
+  this->scene->SetShaderMaterialsDirty();
 }
 
 //////////////////////////////////////////////////
@@ -38,6 +38,7 @@
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2Mesh.hh"
 #include "gz/rendering/ogre2/Ogre2Material.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 
 /// brief Private implementation of the Ogre2Mesh class
@@ -143,6 +144,9 @@ void Ogre2Mesh::SetSkeletonLocalTransforms(
       bone->setOrientation(Ogre2Conversions::Convert(tf.Rotation()));
     }
   }
+
+  // the new pose moves the shadows the item casts
+  this->scene->SetShadowCasterDirty(this->ogreItem->getParentSceneNode());
 }
 
 //////////////////////////////////////////////////
@@ -194,6 +198,9 @@ void Ogre2Mesh::SetSkeletonWeights(
       }
     }
   }
+
+  // the blended pose moves the shadows the item casts
+  this->scene->SetShadowCasterDirty(this->ogreItem->getParentSceneNode());
 }
 
 //////////////////////////////////////////////////
@@ -226,6 +233,9 @@ void Ogre2Mesh::SetSkeletonAnimationEnabled(const std::string &_name,
   anim->setEnabled(_enabled);
   anim->setLoop(_loop);
   anim->mWeight = _weight;
+
+  // the pose changes with the animation, so do the shadows the item casts
+  this->scene->SetShadowCasterDirty(this->ogreItem->getParentSceneNode());
 }
 
 //////////////////////////////////////////////////
@@ -239,6 +249,7 @@ void Ogre2Mesh::UpdateSkeletonAnimation(
 
   Ogre::SkeletonInstance *skel = this->ogreItem->getSkeletonInstance();
   auto animations = skel->getAnimations();
+  bool animated = false;
   for (auto &anim : animations)
   {
     Ogre::SkeletonAnimation *sa = skel->getAnimation(anim.getName());
@@ -248,8 +259,13 @@ void Ogre2Mesh::UpdateSkeletonAnimation(
           std::chrono::duration_cast<std::chrono::milliseconds>(_time).count() /
           1000.0;
       sa->setTime(seconds);
+      animated = true;
     }
   }
+
+  // the animated pose moves the shadows the item casts
+  if (animated)
+    this->scene->SetShadowCasterDirty(this->ogreItem->getParentSceneNode());
 }
 
 //////////////////////////////////////////////////
@@ -381,7 +397,13 @@ void Ogre2SubMesh::SetMaterialImpl(MaterialPtr _material)
   }
 
   // set cast shadows
-  this->ogreSubItem->getParent()->setCastShadows(_material->CastShadows());
+  Ogre::Item *item = this->ogreSubItem->getParent();
+  if (item->getCastShadows() != _material->CastShadows())
+  {
+    this->scene->SetShadowCasterDirty(item->getParentSceneNode());
+    item->setCastShadows(_material->CastShadows());
+    this->scene->SetShadowCasterDirty(item->getParentSceneNode());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -0,0 +1,520 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <gz/common/Mesh.hh>
+#include <gz/common/SubMesh.hh>
+
+#include "Ogre2MeshBvh.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Number of bins per axis used to evaluate split candidates
+  const unsigned int kBinCount = 16u;
+
+  /// \brief Leaves are not split further below this many triangles
+  const unsigned int kMinSplitCount = 2u;
+
+  /// \brief Leaves are always split above this many triangles, even when
+  /// the surface area heuristic says it is not worth it
+  const unsigned int kMaxLeafCount = 8u;
+
+  /// \brief Cost of visiting a node relative to intersecting a triangle
+  const float kTraversalCost = 1.0f;
+
+  /// \brief Maximum depth of the hierarchy, which bounds the size of the
+  /// traversal stack. Nodes at this depth become leaves regardless of their
+  /// triangle count, which only happens for pathological meshes.
+  const unsigned int kMaxDepth = 64u;
+
+  /// \brief Axis aligned bounds used during the build
+  struct Bounds
+  {
+    /// \brief Minimum corner
+    float min[3] = {std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+
+    /// \brief Maximum corner
+    float max[3] = {std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest()};
+
+    /// \brief Grow to include a point
+    /// \param[in] _p Point
+    void Grow(const float *_p)
+    {
+      for (unsigned int i = 0u; i < 3u; ++i)
+      {
+        this->min[i] = std::min(this->min[i], _p[i]);
+        this->max[i] = std::max(this->max[i], _p[i]);
+      }
+    }
+
+    /// \brief Grow to include other bounds
+    /// \param[in] _b Bounds
+    void Grow(const Bounds &_b)
+    {
+      for (unsigned int i = 0u; i < 3u; ++i)
+      {
+        this->min[i] = std::min(this->min[i], _b.min[i]);
+        this->max[i] = std::max(this->max[i], _b.max[i]);
+      }
+    }
+
+    /// \brief Half the surface area, which is all the heuristic needs
+    /// \return Half area, 0 for empty bounds
+    float HalfArea() const
+    {
+      if (this->min[0] > this->max[0])
+        return 0.0f;
+      float dx = this->max[0] - this->min[0];
+      float dy = this->max[1] - this->min[1];
+      float dz = this->max[2] - this->min[2];
+      return dx * dy + dy * dz + dz * dx;
+    }
+  };
+
+  /// \brief Per triangle data only needed during the build
+  struct BuildTriangle
+  {
+    /// \brief Triangle bounds
+    Bounds bounds;
+
+    /// \brief Triangle centroid
+    float centroid[3];
+  };
+
+  /// \brief A bin of split candidates
+  struct Bin
+  {
+    /// \brief Bounds of the triangles in the bin
+    Bounds bounds;
+
+    /// \brief Number of triangles in the bin
+    unsigned int count = 0u;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Intersect a ray with a node's bounds
+  /// \param[in] _min Minimum corner
+  /// \param[in] _max Maximum corner
+  /// \param[in] _origin Ray origin
+  /// \param[in] _invDir Inverse of the ray direction
+  /// \param[in] _maxDistance Hits further than this are ignored
+  /// \return Entry distance, or infinity if the bounds are missed
+  inline float IntersectBounds(const float *_min, const float *_max,
+      const float *_origin, const float *_invDir, float _maxDistance)
+  {
+    float tMin = 0.0f;
+    float tMax = _maxDistance;
+    for (unsigned int i = 0u; i < 3u; ++i)
+    {
+      float t1 = (_min[i] - _origin[i]) * _invDir[i];
+      float t2 = (_max[i] - _origin[i]) * _invDir[i];
+      tMin = std::max(tMin, std::min(t1, t2));
+      tMax = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax ? tMin : std::numeric_limits<float>::infinity();
+  }
+}
+
+//////////////////////////////////////////////////
+Ogre2MeshBvh::Ogre2MeshBvh(const common::Mesh &_mesh)
+  : mesh(&_mesh)
+{
+  // gather the triangles of all submeshes
+  std::vector<Triangle> meshTriangles;
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto submesh = _mesh.SubMeshByIndex(i).lock();
+    if (!submesh || submesh->VertexCount() < 3u)
+      continue;
+
+    const unsigned int vertexCount = submesh->VertexCount();
+    const unsigned int indexCount = submesh->IndexCount();
+    const math::Vector3d *vertices = submesh->VertexPtr();
+    const unsigned int *indices = submesh->IndexPtr();
+    for (unsigned int k = 0u; k + 2u < indexCount; k += 3u)
+    {
+      if (indices[k] >= vertexCount || indices[k + 1u] >= vertexCount ||
+          indices[k + 2u] >= vertexCount)
+      {
+        continue;
+      }
+      const math::Vector3d &a = vertices[indices[k]];
+      const math::Vector3d &b = vertices[indices[k + 1u]];
+      const math::Vector3d &c = vertices[indices[k + 2u]];
+      Triangle tri;
+      for (unsigned int j = 0u; j < 3u; ++j)
+      {
+        tri.v0[j] = static_cast<float>(a[j]);
+        tri.e1[j] = static_cast<float>(b[j]) - tri.v0[j];
+        tri.e2[j] = static_cast<float>(c[j]) - tri.v0[j];
+      }
+      meshTriangles.push_back(tri);
+    }
+  }
+
+  if (meshTriangles.empty())
+    return;
+
+  const uint32_t triangleCount = static_cast<uint32_t>(meshTriangles.size());
+  std::vector<BuildTriangle> buildTriangles(triangleCount);
+  for (uint32_t i = 0u; i < triangleCount; ++i)
+  {
+    const Triangle &tri = meshTriangles[i];
+    BuildTriangle &build = buildTriangles[i];
+    float b[3];
+    float c[3];
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      b[j] = tri.v0[j] + tri.e1[j];
+      c[j] = tri.v0[j] + tri.e2[j];
+    }
+    build.bounds.Grow(tri.v0);
+    build.bounds.Grow(b);
+    build.bounds.Grow(c);
+    for (unsigned int j = 0u; j < 3u; ++j)
+      build.centroid[j] = (tri.v0[j] + b[j] + c[j]) / 3.0f;
+  }
+
+  std::vector<uint32_t> order(triangleCount);
+  for (uint32_t i = 0u; i < triangleCount; ++i)
+    order[i] = i;
+
+  // a binary tree with leaves of at least one triangle has fewer than
+  // 2 * triangleCount nodes
+  this->nodes.reserve(2u * static_cast<std::size_t>(triangleCount));
+  this->nodes.push_back(Node());
+  this->nodes[0].leftOrFirst = 0u;
+  this->nodes[0].count = triangleCount;
+
+  // nodes left to split and their depth. Each node spans
+  // [leftOrFirst, leftOrFirst + count) of the triangle order.
+  std::vector<std::pair<uint32_t, unsigned int>> pending = {{0u, 1u}};
+  while (!pending.empty())
+  {
+    const uint32_t nodeIdx = pending.back().first;
+    const unsigned int depth = pending.back().second;
+    pending.pop_back();
+
+    const uint32_t first = this->nodes[nodeIdx].leftOrFirst;
+    const uint32_t count = this->nodes[nodeIdx].count;
+
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (uint32_t i = first; i < first + count; ++i)
+    {
+      bounds.Grow(buildTriangles[order[i]].bounds);
+      centroidBounds.Grow(buildTriangles[order[i]].centroid);
+    }
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      this->nodes[nodeIdx].min[j] = bounds.min[j];
+      this->nodes[nodeIdx].max[j] = bounds.max[j];
+    }
+
+    if (count <= kMinSplitCount || depth >= kMaxDepth)
+      continue;
+
+    // evaluate the surface area heuristic at the bin boundaries of each axis
+    float bestCost = std::numeric_limits<float>::max();
+    int bestAxis = -1;
+    unsigned int bestSplit = 0u;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+      if (extent <= 0.0f)
+        continue;
+      const float scale = kBinCount / extent;
+
+      Bin bins[kBinCount];
+      for (uint32_t i = first; i < first + count; ++i)
+      {
+        const BuildTriangle &build = buildTriangles[order[i]];
+        unsigned int b = std::min(kBinCount - 1u, static_cast<unsigned int>(
+            (build.centroid[axis] - centroidBounds.min[axis]) * scale));
+        bins[b].bounds.Grow(build.bounds);
+        ++bins[b].count;
+      }
+
+      float leftArea[kBinCount - 1u];
+      unsigned int leftCount[kBinCount - 1u];
+      Bounds left;
+      unsigned int leftSum = 0u;
+      for (unsigned int b = 0u; b < kBinCount - 1u; ++b)
+      {
+        left.Grow(bins[b].bounds);
+        leftSum += bins[b].count;
+        leftArea[b] = left.HalfArea();
+        leftCount[b] = leftSum;
+      }
+
+      Bounds right;
+      unsigned int rightSum = 0u;
+      for (unsigned int b = kBinCount - 1u; b > 0u; --b)
+      {
+        right.Grow(bins[b].bounds);
+        rightSum += bins[b].count;
+        if (leftCount[b - 1u] == 0u || rightSum == 0u)
+          continue;
+        float cost = leftArea[b - 1u] * leftCount[b - 1u] +
+            right.HalfArea() * rightSum;
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestSplit = b;
+        }
+      }
+    }
+
+    // all centroids coincide, nothing to split on
+    if (bestAxis < 0)
+      continue;
+
+    const float leafCost = static_cast<float>(count);
+    const float area = bounds.HalfArea();
+    const float splitCost =
+        kTraversalCost + (area > 0.0f ? bestCost / area : 0.0f);
+    if (splitCost >= leafCost && count <= kMaxLeafCount)
+      continue;
+
+    const float extent =
+        centroidBounds.max[bestAxis] - centroidBounds.min[bestAxis];
+    const float scale = kBinCount / extent;
+    auto middle = std::partition(order.begin() + first,
+        order.begin() + first + count,
+        [&](uint32_t _idx)
+        {
+          const BuildTriangle &build = buildTriangles[_idx];
+          unsigned int b = std::min(kBinCount - 1u, static_cast<unsigned int>(
+              (build.centroid[bestAxis] - centroidBounds.min[bestAxis]) *
+              scale));
+          return b < bestSplit;
+        });
+    uint32_t leftCountSplit =
+        static_cast<uint32_t>(middle - (order.begin() + first));
+    if (leftCountSplit == 0u || leftCountSplit == count)
+      continue;
+
+    const uint32_t leftIdx = static_cast<uint32_t>(this->nodes.size());
+    Node leftNode;
+    leftNode.leftOrFirst = first;
+    leftNode.count = leftCountSplit;
+    Node rightNode;
+    rightNode.leftOrFirst = first + leftCountSplit;
+    rightNode.count = count - leftCountSplit;
+    this->nodes.push_back(leftNode);
+    this->nodes.push_back(rightNode);
+
+    this->nodes[nodeIdx].leftOrFirst = leftIdx;
+    this->nodes[nodeIdx].count = 0u;
+
+    pending.push_back({leftIdx + 1u, depth + 1u});
+    pending.push_back({leftIdx, depth + 1u});
+  }
+  this->nodes.shrink_to_fit();
+
+  this->triangles.resize(triangleCount);
+  for (uint32_t i = 0u; i < triangleCount; ++i)
+    this->triangles[i] = meshTriangles[order[i]];
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshBvh::Intersect(const Ogre::Ray &_ray,
+    Ogre::Real &_distance) const
+{
+  if (this->nodes.empty())
+    return false;
+
+  const Ogre::Vector3 &rayOrigin = _ray.getOrigin();
+  const Ogre::Vector3 &rayDir = _ray.getDirection();
+  const float origin[3] = {static_cast<float>(rayOrigin.x),
+      static_cast<float>(rayOrigin.y), static_cast<float>(rayOrigin.z)};
+  const float dir[3] = {static_cast<float>(rayDir.x),
+      static_cast<float>(rayDir.y), static_cast<float>(rayDir.z)};
+  float invDir[3];
+  for (unsigned int i = 0u; i < 3u; ++i)
+  {
+    // avoid 0 * inf for rays parallel to a slab that start on its plane
+    const float d = std::fabs(dir[i]) > 1e-20f ? dir[i] :
+        std::copysign(1e-20f, dir[i]);
+    invDir[i] = 1.0f / d;
+  }
+
+  float best = static_cast<float>(_distance);
+  bool hit = false;
+
+  const Node *root = this->nodes.data();
+  if (IntersectBounds(root->min, root->max, origin, invDir, best) ==
+      std::numeric_limits<float>::infinity())
+  {
+    return false;
+  }
+
+  const Node *stack[kMaxDepth];
+  unsigned int stackSize = 0u;
+  const Node *node = root;
+  while (true)
+  {
+    if (node->count > 0u)
+    {
+      const Triangle *tri = this->triangles.data() + node->leftOrFirst;
+      for (uint32_t i = 0u; i < node->count; ++i, ++tri)
+      {
+        // Moller-Trumbore, culling back faces like
+        // Ogre::Math::intersects(ray, a, b, c, true, false) does
+        const float p[3] = {
+            dir[1] * tri->e2[2] - dir[2] * tri->e2[1],
+            dir[2] * tri->e2[0] - dir[0] * tri->e2[2],
+            dir[0] * tri->e2[1] - dir[1] * tri->e2[0]};
+        const float det =
+            tri->e1[0] * p[0] + tri->e1[1] * p[1] + tri->e1[2] * p[2];
+        if (det <= std::numeric_limits<float>::epsilon())
+          continue;
+        const float invDet = 1.0f / det;
+        const float s[3] = {origin[0] - tri->v0[0], origin[1] - tri->v0[1],
+            origin[2] - tri->v0[2]};
+        const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+        if (u < 0.0f || u > 1.0f)
+          continue;
+        const float q[3] = {
+            s[1] * tri->e1[2] - s[2] * tri->e1[1],
+            s[2] * tri->e1[0] - s[0] * tri->e1[2],
+            s[0] * tri->e1[1] - s[1] * tri->e1[0]};
+        const float v = (dir[0] * q[0] + dir[1] * q[1] + dir[2] * q[2]) *
+            invDet;
+        if (v < 0.0f || u + v > 1.0f)
+          continue;
+        const float t =
+            (tri->e2[0] * q[0] + tri->e2[1] * q[1] + tri->e2[2] * q[2]) *
+            invDet;
+        if (t >= 0.0f && t < best)
+        {
+          best = t;
+          hit = true;
+        }
+      }
+    }
+    else
+    {
+      // visit the nearest child first, and skip children that start
+      // further than the closest hit so far
+      const Node *child1 = root + node->leftOrFirst;
+      const Node *child2 = child1 + 1;
+      float dist1 =
+          IntersectBounds(child1->min, child1->max, origin, invDir, best);
+      float dist2 =
+          IntersectBounds(child2->min, child2->max, origin, invDir, best);
+      if (dist1 > dist2)
+      {
+        std::swap(dist1, dist2);
+        std::swap(child1, child2);
+      }
+      if (dist1 != std::numeric_limits<float>::infinity())
+      {
+        if (dist2 != std::numeric_limits<float>::infinity())
+          stack[stackSize++] = child2;
+        node = child1;
+        continue;
+      }
+    }
+
+    if (stackSize == 0u)
+      break;
+    node = stack[--stackSize];
+  }
+
+  if (hit)
+    _distance = static_cast<Ogre::Real>(best);
+  return hit;
+}
+
+//////////////////////////////////////////////////
+std::size_t Ogre2MeshBvh::TriangleCount() const
+{
+  return this->triangles.size();
+}
+
+//////////////////////////////////////////////////
+std::size_t Ogre2MeshBvh::NodeCount() const
+{
+  return this->nodes.size();
+}
+
+namespace
+{
+  /// \brief Hierarchies of meshes, keyed by mesh name
+  struct BvhCache
+  {
+    /// \brief Guards entries
+    std::mutex mutex;
+
+    /// \brief Cached hierarchies
+    std::unordered_map<std::string,
+        std::shared_ptr<const Ogre2MeshBvh>> entries;
+  };
+
+  /// \brief Get the process wide hierarchy cache
+  /// \return The cache
+  BvhCache &Cache()
+  {
+    static BvhCache cache;
+    return cache;
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const Ogre2MeshBvh> Ogre2MeshBvh::Get(
+    const std::string &_name, const common::Mesh &_mesh)
+{
+  std::mutex &mutex = Cache().mutex;
+  auto &cache = Cache().entries;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(_name);
+    if (it != cache.end() && it->second->mesh == &_mesh)
+      return it->second;
+  }
+
+  // build outside of the lock so queries on other meshes are not blocked.
+  // If two threads build the same mesh at once the last one wins, which
+  // only wastes work.
+  auto bvh = std::make_shared<const Ogre2MeshBvh>(_mesh);
+  std::lock_guard<std::mutex> lock(mutex);
+  cache[_name] = bvh;
+  return bvh;
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshBvh::Invalidate(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(Cache().mutex);
+  Cache().entries.erase(_name);
+}
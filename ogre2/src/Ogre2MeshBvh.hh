@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2MESHBVH_HH_
+#define GZ_RENDERING_OGRE2_OGRE2MESHBVH_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace common
+  {
+    class Mesh;
+  }
+
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Bounding volume hierarchy over all triangles of a
+    /// common::Mesh, used to speed up CPU ray queries. It is built with the
+    /// surface area heuristic over binned triangle centroids and stored as
+    /// a flat array of 32 byte nodes in which the two children of a node
+    /// are next to each other. Triangles are stored in leaf order as a
+    /// vertex plus two edges, ready for the intersection test.
+    ///
+    /// Instances are immutable once built and can be queried from multiple
+    /// threads at the same time.
+    class Ogre2MeshBvh
+    {
+      /// \brief Build the hierarchy
+      /// \param[in] _mesh Mesh to build the hierarchy for, in mesh space
+      public: explicit Ogre2MeshBvh(const common::Mesh &_mesh);
+
+      /// \brief Find the closest front facing triangle hit by a ray, with
+      /// the same semantics as Ogre::Math::intersects(ray, a, b, c, true,
+      /// false) run on every triangle of the mesh
+      /// \param[in] _ray Ray in mesh space
+      /// \param[in,out] _distance Only hits closer than this value are
+      /// considered. Set to the distance along the ray of the hit, if any.
+      /// \return True if a triangle closer than _distance was hit
+      public: bool Intersect(const Ogre::Ray &_ray,
+                  Ogre::Real &_distance) const;
+
+      /// \brief Number of triangles in the hierarchy
+      /// \return Triangle count
+      public: std::size_t TriangleCount() const;
+
+      /// \brief Number of nodes in the hierarchy
+      /// \return Node count
+      public: std::size_t NodeCount() const;
+
+      /// \brief Get the hierarchy of a mesh, building it the first time the
+      /// mesh is requested. Hierarchies are cached by mesh name for the
+      /// lifetime of the process, like meshes are in common::MeshManager.
+      /// The cached hierarchy is rebuilt if a different mesh is later
+      /// registered under the same name.
+      /// \param[in] _name Name of the mesh in common::MeshManager
+      /// \param[in] _mesh The mesh
+      /// \return The hierarchy of the mesh
+      public: static std::shared_ptr<const Ogre2MeshBvh> Get(
+                  const std::string &_name, const common::Mesh &_mesh);
+
+      /// \brief Drop the cached hierarchy of a mesh so the next Get builds
+      /// it again. Needed when the vertices of a registered mesh are moved.
+      /// \param[in] _name Name of the mesh in common::MeshManager
+      public: static void Invalidate(const std::string &_name);
+
+      /// \brief A node of the hierarchy
+      private: struct Node
+      {
+        /// \brief Minimum corner of the node bounds
+        float min[3];
+
+        /// \brief Index of the left child for interior nodes, index of the
+        /// first triangle for leaves
+        uint32_t leftOrFirst;
+
+        /// \brief Maximum corner of the node bounds
+        float max[3];
+
+        /// \brief Number of triangles, 0 for interior nodes
+        uint32_t count;
+      };
+
+      /// \brief A triangle, stored as its first vertex and two edges
+      private: struct Triangle
+      {
+        /// \brief First vertex
+        float v0[3];
+
+        /// \brief Second vertex minus first vertex
+        float e1[3];
+
+        /// \brief Third vertex minus first vertex
+        float e2[3];
+      };
+
+      /// \brief Flattened nodes, the root is at index 0
+      private: std::vector<Node> nodes;
+
+      /// \brief Triangles in leaf order
+      private: std::vector<Triangle> triangles;
+
+      /// \brief Mesh the hierarchy was built for, only used to detect stale
+      /// cache entries
+      private: const common::Mesh *mesh = nullptr;
+    };
+    }
+  }
+}
+#endif
@@ -26,6 +26,7 @@
 
 #include <gz/math/Matrix4.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2Mesh.hh"
 #include "gz/rendering/ogre2/Ogre2MeshFactory.hh"
@@ -138,6 +139,33 @@ Ogre2MeshPtr Ogre2MeshFactory::Create(const MeshDescriptor &_desc)
   return mesh;
 }
 
+//////////////////////////////////////////////////
+Ogre2MeshPtr Ogre2MeshFactory::Create(const Ogre::MeshPtr &_ogreMesh)
+{
+  if (!_ogreMesh)
+    return nullptr;
+
+  Ogre2MeshPtr mesh(new Ogre2Mesh);
+  mesh->ogreItem = this->scene->OgreSceneManager()->createItem(
+      _ogreMesh, Ogre::SCENE_DYNAMIC);
+  if (!mesh->ogreItem)
+  {
+    gzerr << "Failed to get Ogre item for [" << _ogreMesh->getName() << "]"
+           << std::endl;
+    return nullptr;
+  }
+
+  Ogre2SubMeshStoreFactory subMeshFactory(this->scene, mesh->ogreItem);
+  mesh->subMeshes = subMeshFactory.Create();
+  for (unsigned int i = 0; i < mesh->subMeshes->Size(); i++)
+  {
+    Ogre2SubMeshPtr submesh =
+        std::dynamic_pointer_cast<Ogre2SubMesh>(mesh->subMeshes->GetById(i));
+    submesh->SetMeshName(_ogreMesh->getName());
+  }
+  return mesh;
+}
+
 //////////////////////////////////////////////////
 Ogre::Item *Ogre2MeshFactory::OgreItem(const MeshDescriptor &_desc)
 {
@@ -197,6 +225,7 @@ bool Ogre2MeshFactory::IsLoaded(const MeshDescriptor &_desc)
 //////////////////////////////////////////////////
 bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
 {
+  GZ_RENDERING_PROFILE("Ogre2MeshFactory::LoadImpl");
   Ogre::v1::MeshPtr ogreMesh;
   std::string name;
   std::string group;
@@ -0,0 +1,601 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:5033)
+#endif
+#include <OgreBitwise.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "Ogre2MeshHull.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief A point in double precision, the hull is built in double
+  /// precision to keep the orientation tests robust
+  using Point = std::array<double, 3>;
+
+  /// \brief A triangular face of the hull being built
+  struct HullFace
+  {
+    /// \brief Vertex indices, counter clockwise seen from outside
+    uint32_t v[3];
+
+    /// \brief Index of the face across the edge v[i] -> v[(i + 1) % 3]
+    uint32_t adj[3];
+
+    /// \brief Outward normal, not normalized
+    Point normal;
+
+    /// \brief Plane offset, so that the signed distance of p is
+    /// dot(normal, p) - offset
+    double offset;
+
+    /// \brief Points that are in front of this face and not yet on the hull
+    std::vector<uint32_t> outside;
+
+    /// \brief False once the face has been replaced
+    bool alive = true;
+
+    /// \brief Scratch flag used while finding the visible faces
+    bool visible = false;
+  };
+
+  /// \brief a - b
+  Point Sub(const Point &_a, const Point &_b)
+  {
+    return {_a[0] - _b[0], _a[1] - _b[1], _a[2] - _b[2]};
+  }
+
+  /// \brief Cross product
+  Point Cross(const Point &_a, const Point &_b)
+  {
+    return {_a[1] * _b[2] - _a[2] * _b[1],
+            _a[2] * _b[0] - _a[0] * _b[2],
+            _a[0] * _b[1] - _a[1] * _b[0]};
+  }
+
+  /// \brief Dot product
+  double Dot(const Point &_a, const Point &_b)
+  {
+    return _a[0] * _b[0] + _a[1] * _b[1] + _a[2] * _b[2];
+  }
+
+  /// \brief Incremental convex hull of a set of distinct points, built with
+  /// the quickhull algorithm
+  class HullBuilder
+  {
+    /// \brief Constructor
+    /// \param[in] _points Distinct points
+    public: explicit HullBuilder(const std::vector<Point> &_points)
+        : points(_points)
+    {
+    }
+
+    /// \brief Build the hull
+    /// \param[out] _hull Indices of the hull vertices
+    /// \return False if the points are degenerate or the hull could not be
+    /// built robustly, in which case _hull is not valid
+    public: bool Build(std::vector<uint32_t> &_hull);
+
+    /// \brief Add a face and compute its plane
+    /// \return Index of the new face
+    private: uint32_t AddFace(uint32_t _a, uint32_t _b, uint32_t _c);
+
+    /// \brief Signed distance of a point to the plane of a face
+    private: double Distance(const HullFace &_face, uint32_t _p) const
+    {
+      return Dot(_face.normal, this->points[_p]) - _face.offset;
+    }
+
+    /// \brief Add a point to the outside set of the first of a range of
+    /// faces it is in front of. Points behind all faces are dropped.
+    private: void Assign(uint32_t _p, uint32_t _firstFace,
+                 uint32_t _endFace);
+
+    /// \brief Input points
+    private: const std::vector<Point> &points;
+
+    /// \brief All faces created so far, including the replaced ones
+    private: std::vector<HullFace> faces;
+
+    /// \brief Distance below which a point is considered on a face
+    private: double epsilon = 0.0;
+  };
+
+  //////////////////////////////////////////////////
+  uint32_t HullBuilder::AddFace(uint32_t _a, uint32_t _b, uint32_t _c)
+  {
+    HullFace face;
+    face.v[0] = _a;
+    face.v[1] = _b;
+    face.v[2] = _c;
+    face.adj[0] = face.adj[1] = face.adj[2] = 0u;
+    const Point &pa = this->points[_a];
+    face.normal = Cross(Sub(this->points[_b], pa), Sub(this->points[_c], pa));
+    double length = std::sqrt(Dot(face.normal, face.normal));
+    if (length > 0.0)
+    {
+      for (double &n : face.normal)
+        n /= length;
+    }
+    face.offset = Dot(face.normal, pa);
+    this->faces.push_back(std::move(face));
+    return static_cast<uint32_t>(this->faces.size() - 1u);
+  }
+
+  //////////////////////////////////////////////////
+  void HullBuilder::Assign(uint32_t _p, uint32_t _firstFace,
+      uint32_t _endFace)
+  {
+    for (uint32_t f = _firstFace; f < _endFace; ++f)
+    {
+      if (this->Distance(this->faces[f], _p) > this->epsilon)
+      {
+        this->faces[f].outside.push_back(_p);
+        return;
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////
+  bool HullBuilder::Build(std::vector<uint32_t> &_hull)
+  {
+    const uint32_t count = static_cast<uint32_t>(this->points.size());
+    if (count < 4u)
+      return false;
+
+    // extreme points along each axis
+    uint32_t minIdx[3] = {0u, 0u, 0u};
+    uint32_t maxIdx[3] = {0u, 0u, 0u};
+    for (uint32_t i = 1u; i < count; ++i)
+    {
+      for (int a = 0; a < 3; ++a)
+      {
+        if (this->points[i][a] < this->points[minIdx[a]][a])
+          minIdx[a] = i;
+        if (this->points[i][a] > this->points[maxIdx[a]][a])
+          maxIdx[a] = i;
+      }
+    }
+
+    // tolerance relative to the size of the point set, like qhull does
+    double extent = 0.0;
+    int widest = 0;
+    double widestSpan = -1.0;
+    for (int a = 0; a < 3; ++a)
+    {
+      double lo = this->points[minIdx[a]][a];
+      double hi = this->points[maxIdx[a]][a];
+      extent += std::max(std::abs(lo), std::abs(hi));
+      if (hi - lo > widestSpan)
+      {
+        widestSpan = hi - lo;
+        widest = a;
+      }
+    }
+    this->epsilon = 1e-9 * extent;
+
+    // initial tetrahedron: the widest pair, the point farthest from their
+    // line and the point farthest from the plane of the three
+    uint32_t i0 = minIdx[widest];
+    uint32_t i1 = maxIdx[widest];
+    if (widestSpan <= this->epsilon)
+      return false;
+
+    const Point line = Sub(this->points[i1], this->points[i0]);
+    uint32_t i2 = i0;
+    double best = 0.0;
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+      Point c = Cross(line, Sub(this->points[i], this->points[i0]));
+      double d = Dot(c, c);
+      if (d > best)
+      {
+        best = d;
+        i2 = i;
+      }
+    }
+    if (std::sqrt(best) <= this->epsilon * widestSpan)
+      return false;
+
+    Point normal = Cross(line, Sub(this->points[i2], this->points[i0]));
+    normal = {normal[0] / std::sqrt(best), normal[1] / std::sqrt(best),
+        normal[2] / std::sqrt(best)};
+    uint32_t i3 = i0;
+    best = 0.0;
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+      double d = std::abs(Dot(normal, Sub(this->points[i], this->points[i0])));
+      if (d > best)
+      {
+        best = d;
+        i3 = i;
+      }
+    }
+    if (best <= this->epsilon)
+      return false;
+
+    // orient the tetrahedron so that all faces point outwards
+    if (Dot(normal, Sub(this->points[i3], this->points[i0])) > 0.0)
+      std::swap(i1, i2);
+
+    this->faces.reserve(count);
+    this->AddFace(i0, i1, i2);
+    this->AddFace(i0, i3, i1);
+    this->AddFace(i1, i3, i2);
+    this->AddFace(i2, i3, i0);
+    // link the faces across their shared edges
+    for (uint32_t f = 0u; f < 4u; ++f)
+    {
+      for (int e = 0; e < 3; ++e)
+      {
+        uint32_t a = this->faces[f].v[e];
+        uint32_t b = this->faces[f].v[(e + 1) % 3];
+        for (uint32_t g = 0u; g < 4u; ++g)
+        {
+          for (int k = 0; k < 3; ++k)
+          {
+            if (this->faces[g].v[k] == b &&
+                this->faces[g].v[(k + 1) % 3] == a)
+            {
+              this->faces[f].adj[e] = g;
+            }
+          }
+        }
+      }
+    }
+
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+      if (i != i0 && i != i1 && i != i2 && i != i3)
+        this->Assign(i, 0u, 4u);
+    }
+
+    // Faces are only given outside points when they are created, so a
+    // single pass over the growing face list processes all of them
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> visibleFaces;
+    // horizon edges (a, b), the face beyond them and the visible face
+    // they belong to
+    struct HorizonEdge
+    {
+      uint32_t a;
+      uint32_t b;
+      uint32_t neighbor;
+      uint32_t visibleFace;
+    };
+    std::vector<HorizonEdge> horizon;
+    std::unordered_map<uint32_t, uint32_t> faceByStart;
+    for (uint32_t f = 0u; f < this->faces.size(); ++f)
+    {
+      if (!this->faces[f].alive || this->faces[f].outside.empty())
+        continue;
+
+      // the farthest outside point is certainly on the hull
+      uint32_t eye = this->faces[f].outside[0];
+      double eyeDistance = this->Distance(this->faces[f], eye);
+      for (uint32_t p : this->faces[f].outside)
+      {
+        double d = this->Distance(this->faces[f], p);
+        if (d > eyeDistance)
+        {
+          eyeDistance = d;
+          eye = p;
+        }
+      }
+
+      // find all faces visible from the eye point and their boundary
+      visibleFaces.clear();
+      horizon.clear();
+      stack.assign(1u, f);
+      this->faces[f].visible = true;
+      while (!stack.empty())
+      {
+        uint32_t v = stack.back();
+        stack.pop_back();
+        visibleFaces.push_back(v);
+        for (int e = 0; e < 3; ++e)
+        {
+          uint32_t n = this->faces[v].adj[e];
+          if (this->faces[n].visible)
+            continue;
+          if (this->Distance(this->faces[n], eye) > this->epsilon)
+          {
+            this->faces[n].visible = true;
+            stack.push_back(n);
+          }
+          else
+          {
+            horizon.push_back({this->faces[v].v[e],
+                this->faces[v].v[(e + 1) % 3], n, v});
+          }
+        }
+      }
+
+      // replace the visible faces by a cone from the horizon to the eye
+      const uint32_t firstNew = static_cast<uint32_t>(this->faces.size());
+      faceByStart.clear();
+      for (const auto &edge : horizon)
+      {
+        uint32_t nf = this->AddFace(edge.a, edge.b, eye);
+        if (!faceByStart.emplace(edge.a, nf).second)
+        {
+          // the horizon is not a simple loop, which only happens with
+          // nearly coplanar points within the tolerance
+          return false;
+        }
+        HullFace &newFace = this->faces[nf];
+        newFace.adj[0] = edge.neighbor;
+        HullFace &neighbor = this->faces[edge.neighbor];
+        for (int k = 0; k < 3; ++k)
+        {
+          if (neighbor.adj[k] == edge.visibleFace &&
+              neighbor.v[k] == edge.b)
+          {
+            neighbor.adj[k] = nf;
+          }
+        }
+      }
+      for (uint32_t nf = firstNew; nf < this->faces.size(); ++nf)
+      {
+        // (a, b, eye) is followed by (b, c, eye) across (b, eye)
+        auto next = faceByStart.find(this->faces[nf].v[1]);
+        if (next == faceByStart.end())
+          return false;
+        this->faces[nf].adj[1] = next->second;
+        this->faces[next->second].adj[2] = nf;
+      }
+
+      // hand over the outside points of the replaced faces
+      const uint32_t endNew = static_cast<uint32_t>(this->faces.size());
+      for (uint32_t v : visibleFaces)
+      {
+        std::vector<uint32_t> outside;
+        outside.swap(this->faces[v].outside);
+        this->faces[v].alive = false;
+        for (uint32_t p : outside)
+        {
+          if (p != eye)
+            this->Assign(p, firstNew, endNew);
+        }
+      }
+    }
+
+    std::vector<bool> onHull(count, false);
+    for (const auto &face : this->faces)
+    {
+      if (!face.alive)
+        continue;
+      for (uint32_t v : face.v)
+        onHull[v] = true;
+    }
+    _hull.clear();
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+      if (onHull[i])
+        _hull.push_back(i);
+    }
+    return true;
+  }
+
+  /// \brief Read the positions of the first LOD of all submeshes of a mesh
+  /// \param[in] _mesh Mesh to read
+  /// \param[out] _positions Vertex positions in mesh space
+  /// \param[out] _dynamic True if any of the vertex buffers is dynamic
+  void ReadPositions(const Ogre::MeshPtr &_mesh,
+      std::vector<Ogre::Vector3> &_positions, bool &_dynamic)
+  {
+    _dynamic = false;
+    for (const auto &subMesh : _mesh->getSubMeshes())
+    {
+      Ogre::VertexArrayObjectArray vaos = subMesh->mVao[0];
+      if (vaos.empty())
+        continue;
+
+      // Get the first LOD level
+      Ogre::VertexArrayObject *vao = vaos[0];
+
+      // request async read from buffer
+      Ogre::VertexArrayObject::ReadRequestsArray requests;
+      requests.push_back(Ogre::VertexArrayObject::ReadRequests(
+        Ogre::VES_POSITION));
+      vao->readRequests(requests);
+      vao->mapAsyncTickets(requests);
+
+      if (requests[0].vertexBuffer->getBufferType() >=
+          Ogre::BT_DYNAMIC_DEFAULT)
+      {
+        _dynamic = true;
+      }
+
+      size_t vertexCount = requests[0].vertexBuffer->getNumElements();
+      _positions.reserve(_positions.size() + vertexCount);
+      for (size_t i = 0; i < vertexCount; ++i)
+      {
+        Ogre::Vector3 vec;
+        if (requests[0].type == Ogre::VET_HALF4)
+        {
+          const Ogre::uint16* vertex = reinterpret_cast<const Ogre::uint16*>
+            (requests[0].data);
+          vec.x = Ogre::Bitwise::halfToFloat(vertex[0]);
+          vec.y = Ogre::Bitwise::halfToFloat(vertex[1]);
+          vec.z = Ogre::Bitwise::halfToFloat(vertex[2]);
+        }
+        else if (requests[0].type == Ogre::VET_FLOAT3)
+        {
+          const float* vertex =
+            reinterpret_cast<const float*>(requests[0].data);
+          vec.x = *vertex++;
+          vec.y = *vertex++;
+          vec.z = *vertex++;
+        }
+        else
+        {
+          gzerr << "Vertex Buffer type error" << std::endl;
+          break;
+        }
+        _positions.push_back(vec);
+
+        // get the next element
+        requests[0].data += requests[0].vertexBuffer->getBytesPerElement();
+      }
+      vao->unmapAsyncTickets(requests);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+Ogre2MeshHull::Ogre2MeshHull(const std::vector<Ogre::Vector3> &_points)
+{
+  // meshes repeat positions for every normal and texture coordinate
+  // they are used with, hull building only needs them once
+  std::vector<Point> unique;
+  unique.reserve(_points.size());
+  for (const auto &p : _points)
+  {
+    unique.push_back({static_cast<double>(p.x), static_cast<double>(p.y),
+        static_cast<double>(p.z)});
+  }
+  std::sort(unique.begin(), unique.end());
+  unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+  std::vector<uint32_t> hull;
+  HullBuilder builder(unique);
+  if (builder.Build(hull))
+  {
+    this->vertices.reserve(hull.size());
+    for (uint32_t i : hull)
+    {
+      const Point &p = unique[i];
+      this->vertices.emplace_back(static_cast<Ogre::Real>(p[0]),
+          static_cast<Ogre::Real>(p[1]), static_cast<Ogre::Real>(p[2]));
+    }
+  }
+  else
+  {
+    // degenerate point set, all the points are needed
+    this->vertices.reserve(unique.size());
+    for (const Point &p : unique)
+    {
+      this->vertices.emplace_back(static_cast<Ogre::Real>(p[0]),
+          static_cast<Ogre::Real>(p[1]), static_cast<Ogre::Real>(p[2]));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+const std::vector<Ogre::Vector3> &Ogre2MeshHull::Vertices() const
+{
+  return this->vertices;
+}
+
+namespace
+{
+  /// \brief Hulls of meshes with static buffers, keyed by mesh name
+  struct HullCache
+  {
+    /// \brief Guards entries
+    std::mutex mutex;
+
+    /// \brief Cached hulls
+    std::unordered_map<std::string,
+        std::shared_ptr<const Ogre2MeshHull>> entries;
+  };
+
+  /// \brief Get the process wide hull cache
+  /// \return The cache
+  HullCache &Cache()
+  {
+    static HullCache cache;
+    return cache;
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const Ogre2MeshHull> Ogre2MeshHull::Get(
+    const Ogre::MeshPtr &_mesh)
+{
+  std::mutex &mutex = Cache().mutex;
+  auto &cache = Cache().entries;
+
+  // counting the vertices is cheap and catches a different mesh that was
+  // created under the same name at the same address
+  std::size_t vertexCount = 0u;
+  for (const auto &subMesh : _mesh->getSubMeshes())
+  {
+    if (!subMesh->mVao[0].empty())
+    {
+      const Ogre::VertexBufferPackedVec &buffers =
+          subMesh->mVao[0][0]->getVertexBuffers();
+      if (!buffers.empty())
+        vertexCount += buffers[0]->getNumElements();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(_mesh->getName());
+    if (it != cache.end() && it->second->mesh == _mesh.get() &&
+        it->second->meshVertexCount == vertexCount)
+    {
+      return it->second;
+    }
+  }
+
+  std::vector<Ogre::Vector3> positions;
+  bool dynamic = false;
+  ReadPositions(_mesh, positions, dynamic);
+
+  if (dynamic)
+  {
+    std::shared_ptr<Ogre2MeshHull> all(new Ogre2MeshHull());
+    all->vertices = std::move(positions);
+    return all;
+  }
+
+  std::shared_ptr<Ogre2MeshHull> hull(new Ogre2MeshHull(positions));
+  hull->mesh = _mesh.get();
+  hull->meshVertexCount = vertexCount;
+  std::lock_guard<std::mutex> lock(mutex);
+  cache[_mesh->getName()] = hull;
+  return hull;
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshHull::Invalidate(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(Cache().mutex);
+  Cache().entries.erase(_name);
+}
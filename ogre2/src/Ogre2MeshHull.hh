@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2MESHHULL_HH_
+#define GZ_RENDERING_OGRE2_OGRE2MESHHULL_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Vertices of the convex hull of an Ogre mesh, in mesh space.
+    /// Any box computed from the extremes of the mesh vertices under an
+    /// affine or perspective transform can be computed from the hull
+    /// vertices alone, which are usually far fewer than the mesh vertices.
+    ///
+    /// Instances are immutable once built and can be shared between
+    /// cameras.
+    class Ogre2MeshHull
+    {
+      /// \brief Build the hull of a set of points
+      /// \param[in] _points Points to build the hull of
+      public: explicit Ogre2MeshHull(const std::vector<Ogre::Vector3> &_points);
+
+      /// \brief Vertices of the hull. If the points are degenerate (fewer
+      /// than four of them, or all of them in a plane) these are all the
+      /// distinct input points.
+      /// \return Hull vertices
+      public: const std::vector<Ogre::Vector3> &Vertices() const;
+
+      /// \brief Get the hull of a mesh. The position buffers of the first
+      /// LOD of all submeshes are read back and the hull is built the first
+      /// time a mesh is requested, after that it is served from a cache
+      /// keyed by mesh name. Meshes with dynamic vertex buffers are not
+      /// cached and no hull is built for them, all their vertices are
+      /// returned instead, since their content can change every frame.
+      /// \param[in] _mesh The mesh
+      /// \return Hull of the mesh
+      public: static std::shared_ptr<const Ogre2MeshHull> Get(
+                  const Ogre::MeshPtr &_mesh);
+
+      /// \brief Drop the cached hull of a mesh so the next Get builds it
+      /// again. Needed when the vertices of a mesh with static buffers are
+      /// moved without changing their count.
+      /// \param[in] _name Name of the ogre mesh
+      public: static void Invalidate(const std::string &_name);
+
+      /// \brief Constructor that takes the vertices as they are
+      private: Ogre2MeshHull() = default;
+
+      /// \brief Hull vertices
+      private: std::vector<Ogre::Vector3> vertices;
+
+      /// \brief Mesh the hull was built for, only used to detect stale
+      /// cache entries
+      private: const Ogre::Mesh *mesh = nullptr;
+
+      /// \brief Number of vertices of the mesh the hull was built for, only
+      /// used to detect stale cache entries
+      private: std::size_t meshVertexCount = 0u;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
+
+#include "Ogre2MeshHull.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreMesh2.h>
+#include <OgreMeshManager2.h>
+#include <OgreRenderSystem.h>
+#include <OgreRoot.h>
+#include <OgreSubMesh2.h>
+#include <Vao/OgreVaoManager.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+/// \brief Get the corners of a cube centered on the origin
+/// \param[in] _half Half of the size of the cube
+/// \return The 8 corners
+std::vector<Ogre::Vector3> CubeCorners(Ogre::Real _half)
+{
+  std::vector<Ogre::Vector3> corners;
+  for (Ogre::Real x : {-_half, _half})
+    for (Ogre::Real y : {-_half, _half})
+      for (Ogre::Real z : {-_half, _half})
+        corners.emplace_back(x, y, z);
+  return corners;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that two sets of points hold the same points, in any order
+/// \param[in] _expected Expected points
+/// \param[in] _actual Actual points
+void ExpectSamePoints(std::vector<Ogre::Vector3> _expected,
+    std::vector<Ogre::Vector3> _actual)
+{
+  // Ogre::Vector3::operator< compares all components at once, which is not
+  // an order
+  auto less = [](const Ogre::Vector3 &_a, const Ogre::Vector3 &_b)
+  {
+    return std::tie(_a.x, _a.y, _a.z) < std::tie(_b.x, _b.y, _b.z);
+  };
+  std::sort(_expected.begin(), _expected.end(), less);
+  std::sort(_actual.begin(), _actual.end(), less);
+  ASSERT_EQ(_expected.size(), _actual.size());
+  for (size_t i = 0u; i < _expected.size(); ++i)
+    EXPECT_EQ(_expected[i], _actual[i]) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2MeshHullTest, CubeWithInteriorPoints)
+{
+  const std::vector<Ogre::Vector3> corners = CubeCorners(1.0f);
+
+  // corners repeated as meshes do, with points inside the cube and on its
+  // faces and edges
+  std::vector<Ogre::Vector3> points = corners;
+  points.insert(points.end(), corners.begin(), corners.end());
+  for (int i = 0; i < 50; ++i)
+  {
+    points.emplace_back(-0.9f + 0.036f * i, 0.5f - 0.02f * i,
+        0.3f * std::sin(static_cast<float>(i)));
+  }
+  points.emplace_back(0.0f, 0.0f, 0.0f);
+  points.emplace_back(1.0f, 0.0f, 0.0f);
+  points.emplace_back(0.0f, -1.0f, 0.5f);
+  points.emplace_back(1.0f, 1.0f, 0.0f);
+
+  Ogre2MeshHull hull(points);
+  ExpectSamePoints(corners, hull.Vertices());
+}
+
+/////////////////////////////////////////////////
+TEST(Ogre2MeshHullTest, Degenerate)
+{
+  // no points
+  EXPECT_TRUE(
+      Ogre2MeshHull(std::vector<Ogre::Vector3>()).Vertices().empty());
+
+  // fewer than 4 points, duplicates are dropped
+  std::vector<Ogre::Vector3> few = {
+      {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+  std::vector<Ogre::Vector3> points = few;
+  points.push_back(few[1]);
+  ExpectSamePoints(few, Ogre2MeshHull(points).Vertices());
+
+  // points on a line
+  std::vector<Ogre::Vector3> line;
+  for (int i = 0; i < 5; ++i)
+    line.emplace_back(1.0f * i, 2.0f * i, -1.0f * i);
+  ExpectSamePoints(line, Ogre2MeshHull(line).Vertices());
+
+  // points in a plane, including interior points
+  std::vector<Ogre::Vector3> planar;
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      planar.emplace_back(1.0f * i, 1.0f * j, 2.0f);
+  ExpectSamePoints(planar, Ogre2MeshHull(planar).Vertices());
+}
+
+/////////////////////////////////////////////////
+class Ogre2MeshHullCacheTest : public testing::Test
+{
+  /// \brief Load the render engine once for all the tests
+  public: static void SetUpTestSuite()
+  {
+    common::Console::SetVerbosity(4);
+
+    std::map<std::string, std::string> params;
+    params["headless"] = "1";
+    Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+    if (engine->Load(params))
+      engine->Init();
+  }
+
+  /// \brief Unload the render engine
+  public: static void TearDownTestSuite()
+  {
+    Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+    if (engine->IsInitialized())
+      engine->Fini();
+  }
+
+  /// \brief Skip the tests if the render engine could not be loaded
+  public: void SetUp() override
+  {
+    this->engine = Ogre2RenderEngine::Instance();
+    if (!this->engine->IsInitialized())
+      GTEST_SKIP() << "Engine 'ogre2' could not be loaded";
+  }
+
+  /// \brief Create a point list mesh
+  /// \param[in] _name Name of the mesh
+  /// \param[in] _points Vertices of the mesh
+  /// \param[in] _bufferType Type of the vertex buffer
+  /// \return The mesh
+  public: Ogre::MeshPtr CreateMesh(const std::string &_name,
+              const std::vector<Ogre::Vector3> &_points,
+              Ogre::BufferType _bufferType = Ogre::BT_IMMUTABLE)
+  {
+    Ogre::VaoManager *vaoManager =
+        this->engine->OgreRoot()->getRenderSystem()->getVaoManager();
+
+    std::vector<float> data;
+    for (const auto &p : _points)
+      data.insert(data.end(), {p.x, p.y, p.z});
+
+    Ogre::VertexElement2Vec elements;
+    elements.push_back(
+        Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_POSITION));
+    Ogre::VertexBufferPacked *vertexBuffer = vaoManager->createVertexBuffer(
+        elements, _points.size(), _bufferType, data.data(), false);
+    Ogre::VertexBufferPackedVec vertexBuffers{vertexBuffer};
+    Ogre::VertexArrayObject *vao = vaoManager->createVertexArrayObject(
+        vertexBuffers, nullptr, Ogre::OT_POINT_LIST);
+
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().createManual(
+        _name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::SubMesh *subMesh = mesh->createSubMesh();
+    subMesh->mVao[Ogre::VpNormal].push_back(vao);
+    subMesh->mVao[Ogre::VpShadow].push_back(vao);
+    return mesh;
+  }
+
+  /// \brief Remove a mesh created by CreateMesh
+  /// \param[in,out] _mesh The mesh, reset
+  public: void RemoveMesh(Ogre::MeshPtr &_mesh)
+  {
+    Ogre::MeshManager::getSingleton().remove(_mesh);
+    _mesh.reset();
+  }
+
+  /// \brief The render engine
+  public: Ogre2RenderEngine *engine = nullptr;
+};
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2MeshHullCacheTest, Invalidate)
+{
+  std::vector<Ogre::Vector3> points = CubeCorners(1.0f);
+  points.emplace_back(0.0f, 0.0f, 0.0f);
+  Ogre::MeshPtr mesh = this->CreateMesh("hull_test_invalidate", points);
+
+  auto hull = Ogre2MeshHull::Get(mesh);
+  ASSERT_NE(nullptr, hull);
+  ExpectSamePoints(CubeCorners(1.0f), hull->Vertices());
+
+  // served from the cache
+  EXPECT_EQ(hull, Ogre2MeshHull::Get(mesh));
+
+  // built again once invalidated
+  Ogre2MeshHull::Invalidate(mesh->getName());
+  auto rebuilt = Ogre2MeshHull::Get(mesh);
+  ASSERT_NE(nullptr, rebuilt);
+  EXPECT_NE(hull, rebuilt);
+  ExpectSamePoints(CubeCorners(1.0f), rebuilt->Vertices());
+  EXPECT_EQ(rebuilt, Ogre2MeshHull::Get(mesh));
+
+  // other meshes are left alone
+  Ogre2MeshHull::Invalidate("hull_test_unknown");
+  EXPECT_EQ(rebuilt, Ogre2MeshHull::Get(mesh));
+
+  this->RemoveMesh(mesh);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2MeshHullCacheTest, VertexCountChange)
+{
+  const std::string name = "hull_test_vertex_count";
+  Ogre::MeshPtr mesh = this->CreateMesh(name, CubeCorners(1.0f));
+  auto hull = Ogre2MeshHull::Get(mesh);
+  ASSERT_NE(nullptr, hull);
+  ExpectSamePoints(CubeCorners(1.0f), hull->Vertices());
+  this->RemoveMesh(mesh);
+
+  // a mesh created again under the same name with a different vertex
+  // count does not get the stale hull, even at the same address
+  std::vector<Ogre::Vector3> points = CubeCorners(2.0f);
+  points.emplace_back(0.0f, 0.0f, 0.0f);
+  mesh = this->CreateMesh(name, points);
+  auto newHull = Ogre2MeshHull::Get(mesh);
+  ASSERT_NE(nullptr, newHull);
+  ExpectSamePoints(CubeCorners(2.0f), newHull->Vertices());
+
+  this->RemoveMesh(mesh);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2MeshHullCacheTest, DynamicBuffer)
+{
+  // vertices of dynamic buffers can change every frame, they are all
+  // returned and never cached
+  std::vector<Ogre::Vector3> points = CubeCorners(1.0f);
+  points.emplace_back(0.0f, 0.0f, 0.0f);
+  Ogre::MeshPtr mesh = this->CreateMesh("hull_test_dynamic", points,
+      Ogre::BT_DYNAMIC_DEFAULT);
+
+  auto hull = Ogre2MeshHull::Get(mesh);
+  ASSERT_NE(nullptr, hull);
+  ExpectSamePoints(points, hull->Vertices());
+  EXPECT_NE(hull, Ogre2MeshHull::Get(mesh));
+
+  this->RemoveMesh(mesh);
+}
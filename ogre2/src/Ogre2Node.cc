@@ -27,6 +27,7 @@
   #pragma warning(push, 0)
 #endif
 #include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
 #ifdef _MSC_VER
   #pragma warning(pop)
 #endif
@@ -34,6 +35,21 @@
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Tell Ogre the transform of a node changed. Dynamic nodes are
+  /// updated every frame, static nodes only when notified.
+  /// \param[in] _sceneManager Ogre scene manager
+  /// \param[in] _node Node whose transform changed
+  void NotifyTransformChanged(Ogre::SceneManager *_sceneManager,
+      Ogre::SceneNode *_node)
+  {
+    if (_node->isStatic())
+      _sceneManager->notifyStaticDirty(_node);
+  }
+}
+
 //////////////////////////////////////////////////
 Ogre2Node::Ogre2Node()
 {
@@ -72,6 +88,7 @@ void Ogre2Node::Destroy()
 
   if (nullptr != this->scene)
   {
+    this->scene->SetShadowCasterDirty(this->ogreNode);
     Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
     if (nullptr != ogreSceneManager)
       ogreSceneManager->destroySceneNode(this->ogreNode);
@@ -120,7 +137,15 @@ void Ogre2Node::SetRawLocalPosition(const math::Vector3d &_position)
           << "1e9 from origin" << std::endl;
     return;
   }
-  this->ogreNode->setPosition(Ogre2Conversions::Convert(_position));
+
+  const Ogre::Vector3 position = Ogre2Conversions::Convert(_position);
+  if (position == this->ogreNode->getPosition())
+    return;
+
+  this->scene->SetShadowCasterDirty(this->ogreNode);
+  this->ogreNode->setPosition(position);
+  NotifyTransformChanged(this->scene->OgreSceneManager(), this->ogreNode);
+  this->scene->SetShadowCasterDirty(this->ogreNode);
 }
 
 //////////////////////////////////////////////////
@@ -138,7 +163,14 @@ void Ogre2Node::SetRawLocalRotation(const math::Quaterniond &_rotation)
   if (nullptr == this->ogreNode)
     return;
 
-  this->ogreNode->setOrientation(Ogre2Conversions::Convert(_rotation));
+  const Ogre::Quaternion orientation = Ogre2Conversions::Convert(_rotation);
+  if (orientation == this->ogreNode->getOrientation())
+    return;
+
+  this->scene->SetShadowCasterDirty(this->ogreNode);
+  this->ogreNode->setOrientation(orientation);
+  NotifyTransformChanged(this->scene->OgreSceneManager(), this->ogreNode);
+  this->scene->SetShadowCasterDirty(this->ogreNode);
 }
 
 //////////////////////////////////////////////////
@@ -213,8 +245,11 @@ bool Ogre2Node::AttachChild(NodePtr _child)
     p = p->getParent();
   }
 
+  this->scene->SetShadowCasterDirty(derived->Node());
   derived->SetParent(this->SharedThis());
   this->ogreNode->addChild(derived->Node());
+  NotifyTransformChanged(this->scene->OgreSceneManager(), derived->Node());
+  this->scene->SetShadowCasterDirty(derived->Node());
   return true;
 }
 
@@ -233,6 +268,7 @@ bool Ogre2Node::DetachChild(NodePtr _child)
     return false;
   }
 
+  this->scene->SetShadowCasterDirty(derived->Node());
   this->ogreNode->removeChild(derived->Node());
 
   return true;
@@ -278,5 +314,12 @@ void Ogre2Node::SetLocalScaleImpl(const math::Vector3d &_scale)
   if (nullptr == this->ogreNode)
     return;
 
-  this->ogreNode->setScale(Ogre2Conversions::Convert(_scale));
+  const Ogre::Vector3 scale = Ogre2Conversions::Convert(_scale);
+  if (scale == this->ogreNode->getScale())
+    return;
+
+  this->scene->SetShadowCasterDirty(this->ogreNode);
+  this->ogreNode->setScale(scale);
+  NotifyTransformChanged(this->scene->OgreSceneManager(), this->ogreNode);
+  this->scene->SetShadowCasterDirty(this->ogreNode);
 }
@@ -15,6 +15,15 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
@@ -31,6 +40,8 @@
 #include "gz/rendering/ogre2/Ogre2ThermalCamera.hh"
 #include "gz/rendering/ogre2/Ogre2WideAngleCamera.hh"
 
+#include "Ogre2MeshBvh.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
@@ -54,6 +65,7 @@
 // animated objects) or you want to benchmark.
 // The new version should produce identical results (without accounting random
 // floating point precision issues).
+// This also disables the per-mesh bounding volume hierarchies.
 // #define SLOW_METHOD
 
 /// \brief Private data class for Ogre2RayQuery
@@ -280,18 +292,256 @@ RayQueryResult Ogre2RayQuery::ClosestPointBySelectionBuffer()
 
 //////////////////////////////////////////////////
 
+/// \brief An item returned by the broadphase query that has a mesh the ray
+/// can be tested against
+struct RayQueryCandidate
+{
+  /// \brief The item
+  Ogre::Item *item = nullptr;
+
+  /// \brief Mesh of the item, as loaded by common::MeshManager
+  const common::Mesh *mesh = nullptr;
+
+  /// \brief Bounding volume hierarchy of the mesh. Null if the brute force
+  /// method has to be used, i.e. if the item's transform is not affine.
+  std::shared_ptr<const Ogre2MeshBvh> bvh;
+
+  /// \brief Full transform of the item's parent node
+  Ogre::Matrix4 transform;
+
+  /// \brief Inverse of the transform, only set if it is affine
+  Ogre::Matrix4 invTransform;
+
+  /// \brief Rotation and scale part of the inverse transform
+  Ogre::Matrix3 invTransform3x3;
+
+  /// \brief Whether the transform is affine
+  bool isAffine = false;
+
+  /// \brief Id of the object the item belongs to
+  unsigned int objectId = 0u;
+};
+
+//////////////////////////////////////////////////
+/// \brief Check whether a movable object can be hit by CPU ray queries and
+/// resolve the data needed to test it. This looks the mesh up by name and
+/// builds its bounding volume hierarchy if it is not cached yet, so it
+/// should not be called from worker threads.
+/// \param[in] _movable Movable object
+/// \param[out] _candidate Data needed to test the object
+/// \return True if the object can be hit
+static bool MakeRayQueryCandidate(Ogre::MovableObject *_movable,
+    RayQueryCandidate &_candidate)
+{
+  // items are iterated straight from the scene manager in batched queries,
+  // where they may not be attached to the scene graph
+  if (!_movable || !_movable->getVisible() || !_movable->getParentSceneNode())
+    return false;
+
+  auto userAny = _movable->getUserObjectBindings().getUserAny();
+  if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int) ||
+      _movable->getMovableType() != "Item")
+  {
+    return false;
+  }
+
+  Ogre::Item *ogreItem = static_cast<Ogre::Item *>(_movable);
+
+  // mesh factory creates name with ::CENTER or ::ORIGINAL depending on
+  // the params passed in the MeshDescriptor when loading the mesh
+  // so strip off the suffix
+  std::string meshName = ogreItem->getMesh()->getName();
+  size_t idx = meshName.find("::");
+  if (idx != std::string::npos)
+    meshName = meshName.substr(0, idx);
+
+  const common::Mesh *mesh =
+    common::MeshManager::Instance()->MeshByName(meshName);
+
+  if (!mesh)
+    return false;
+
+  _candidate.item = ogreItem;
+  _candidate.mesh = mesh;
+  _candidate.transform = ogreItem->_getParentNodeFullTransform();
+  _candidate.objectId = Ogre::any_cast<unsigned int>(userAny);
+  _candidate.isAffine = _candidate.transform.isAffine();
+  _candidate.bvh.reset();
+#ifndef SLOW_METHOD
+  if (_candidate.isAffine)
+  {
+    _candidate.invTransform = _candidate.transform.inverse();
+    _candidate.invTransform.extract3x3Matrix(_candidate.invTransform3x3);
+    _candidate.bvh = Ogre2MeshBvh::Get(meshName, *mesh);
+  }
+#endif
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Test a ray against the triangles of a candidate
+/// \param[in] _candidate Candidate to test
+/// \param[in] _rayOrigin Raycast's origin in world space
+/// \param[in] _rayDir Raycast's direction in world space
+/// \param[in] _threadId Index of the calling thread. Meshes without a
+/// bounding volume hierarchy are brute forced, with their triangles split
+/// evenly across threads.
+/// \param[in] _numThreads Number of threads sharing the work
+/// \param[in,out] _distance Distance of the closest hit so far
+/// \param[out] _result Set if a closer hit is found
+static void IntersectRayQueryCandidate(const RayQueryCandidate &_candidate,
+    const Ogre::Vector3 &_rayOrigin, const Ogre::Vector3 &_rayDir,
+    unsigned int _threadId, unsigned int _numThreads, double &_distance,
+    RayQueryResult &_result)
+{
+  const Ogre::Matrix4 &transform = _candidate.transform;
+
+  if (_candidate.bvh)
+  {
+    Ogre::Ray mouseRay(_candidate.invTransform * _rayOrigin,
+        (_candidate.invTransform3x3 * _rayDir).normalisedCopy());
+
+    Ogre::Real hitDistance = std::numeric_limits<Ogre::Real>::max();
+    if (_candidate.bvh->Intersect(mouseRay, hitDistance) &&
+        _distance > hitDistance)
+    {
+      // this is the closest so far, save it off
+      _distance = hitDistance;
+      _result.distance = _distance;
+      _result.point = Ogre2Conversions::Convert(
+        transform * mouseRay.getPoint(hitDistance));
+      _result.objectId = _candidate.objectId;
+    }
+    return;
+  }
+
+  const common::Mesh *mesh = _candidate.mesh;
+
+  const bool bIsAffine = _candidate.isAffine;
+
+  Ogre::Ray mouseRay;
+#ifndef SLOW_METHOD
+  if (bIsAffine)
+  {
+    mouseRay = Ogre::Ray(_candidate.invTransform * _rayOrigin,
+        (_candidate.invTransform3x3 * _rayDir).normalisedCopy());
+  }
+  else
+#endif
+  {
+    mouseRay = Ogre::Ray(_rayOrigin, _rayDir);
+  }
+
+  // test for hitting individual triangles on the mesh
+  for (unsigned int j = 0; j < mesh->SubMeshCount(); ++j)
+  {
+    auto s = mesh->SubMeshByIndex(j);
+    auto submesh = s.lock();
+    if (!submesh || submesh->VertexCount() < 3u)
+      continue;
+    const unsigned int indexCount = submesh->IndexCount();
+
+    const math::Vector3d *RESTRICT_ALIAS vertices =
+      submesh->VertexPtr();
+    const unsigned int *RESTRICT_ALIAS indices = submesh->IndexPtr();
+
+    std::pair<bool, Ogre::Real> bestHit = {
+      false, std::numeric_limits<Ogre::Real>::max()
+    };
+
+    // Round up to next multiple of numThreads and divide by it
+    unsigned int indexCountPerThread =
+      (indexCount + (_numThreads - 1u)) / _numThreads;
+    // indexCountPerThread must be multiple of 3
+    indexCountPerThread = ((indexCountPerThread + 2u) / 3u) * 3u;
+
+    unsigned int indexStart =
+      std::min(indexCountPerThread * _threadId, indexCount);
+    unsigned int indexEnd =
+      std::min(indexCountPerThread * (_threadId + 1u), indexCount);
+
+    for (unsigned int k = indexStart; k < indexEnd; k += 3)
+    {
+      if (indexCount <= k + 2)
+        continue;
+
+#ifdef SLOW_METHOD
+      math::Vector3d vertexA = submesh->Vertex(submesh->Index(k));
+      math::Vector3d vertexB = submesh->Vertex(submesh->Index(k + 1));
+      math::Vector3d vertexC = submesh->Vertex(submesh->Index(k + 2));
+
+      Ogre::Vector3 worldVertexA =
+        transform * Ogre2Conversions::Convert(vertexA);
+      Ogre::Vector3 worldVertexB =
+        transform * Ogre2Conversions::Convert(vertexB);
+      Ogre::Vector3 worldVertexC =
+        transform * Ogre2Conversions::Convert(vertexC);
+#else
+      Ogre::Vector3 worldVertexA, worldVertexB, worldVertexC;
+
+      if (bIsAffine)
+      {
+        worldVertexA = Ogre2Conversions::Convert(vertices[indices[k]]);
+        worldVertexB = Ogre2Conversions::Convert(vertices[indices[k + 1]]);
+        worldVertexC = Ogre2Conversions::Convert(vertices[indices[k + 2]]);
+      }
+      else
+      {
+        worldVertexA =
+          transform * Ogre2Conversions::Convert(vertices[indices[k]]);
+        worldVertexB =
+          transform * Ogre2Conversions::Convert(vertices[indices[k + 1]]);
+        worldVertexC =
+          transform * Ogre2Conversions::Convert(vertices[indices[k + 2]]);
+      }
+#endif
+
+      // check for a hit against this triangle
+      std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(
+        mouseRay, worldVertexA, worldVertexB, worldVertexC, true, false);
+
+      // if it was a hit check if its the closest
+      if (hit.first && hit.second < bestHit.second)
+      {
+        bestHit = hit;
+      }
+    }
+
+    if (bestHit.first && _distance > bestHit.second)
+    {
+      // this is the closest so far, save it off
+      _distance = bestHit.second;
+      _result.distance = _distance;
+      if (bIsAffine)
+      {
+        _result.point = Ogre2Conversions::Convert(
+          transform * mouseRay.getPoint(_distance));
+      }
+      else
+      {
+        _result.point =
+          Ogre2Conversions::Convert(mouseRay.getPoint(_distance));
+      }
+      _result.objectId = _candidate.objectId;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+
 /// \brief This class performs a Triangle-level raycast over the broadphase
 /// results returned by OgreNext spreading the work as evenly as possible
 /// across multiple threads
 ///
-/// On multicore machines this can lead to considerable speed ups, specially
-/// if the scene has a lot of triangles.
+/// Meshes with an affine transform are tested through a bounding volume
+/// hierarchy that is built the first time the mesh is hit and cached, so
+/// they are spread across threads one mesh at a time. Other meshes are
+/// brute forced, with their triangles spread across threads.
 class GZ_RENDERING_OGRE2_HIDDEN ThreadedTriRay final
   : public Ogre::UniformScalableTask
 {
-  /// \brief Stores the result Ogre2RayQueryPrivate::rayQuery->execute
-  /// that we will iterate for triangle intersection matches.
-  private: Ogre::RaySceneQueryResult ogreResult;
+  /// \brief Items whose triangles we will iterate for intersection matches.
+  private: std::vector<RayQueryCandidate> candidates;
 
   /// \brief Raycast's origin
   private: const Ogre::Vector3 rayOrigin;
@@ -303,23 +553,16 @@ class GZ_RENDERING_OGRE2_HIDDEN ThreadedTriRay final
   /// One entry per thread.
   public: std::vector<RayQueryResult> collectedResults;
 
-  /// \brief Constructor
-  /// \param[in, out] _ogreResult Ray Query done by Ogre that we will iterate
-  /// We take ownership of its internal pointer, thus it becomes empty
-  /// afterwards
+  /// \brief Constructor. Resolves the mesh of every item in the broadphase
+  /// results, building missing hierarchies on the calling thread.
+  /// \param[in] _ogreResult Ray Query done by Ogre that we will iterate
   /// \param[in] _rayOrigin Raycast's origin
   /// \param[in] _rayDir Raycast's direction
   /// \param[in] _numThreads Number of worker threads
-  public: ThreadedTriRay(Ogre::RaySceneQueryResult &_ogreResult,
+  public: ThreadedTriRay(const Ogre::RaySceneQueryResult &_ogreResult,
                          const Ogre::Vector3 &_rayOrigin,
                          const Ogre::Vector3 &_rayDir,
-                         size_t _numThreads) :
-      rayOrigin(_rayOrigin),
-      rayDir(_rayDir)
-  {
-    this->ogreResult.swap(_ogreResult);
-    this->collectedResults.resize(_numThreads);
-  }
+                         size_t _numThreads);
 
   // Documentation inherited
   public: void execute(size_t threadId, size_t numThreads) override;
@@ -330,6 +573,27 @@ class GZ_RENDERING_OGRE2_HIDDEN ThreadedTriRay final
   public: RayQueryResult CollapseCollectedResults();
 };
 
+//////////////////////////////////////////////////
+ThreadedTriRay::ThreadedTriRay(const Ogre::RaySceneQueryResult &_ogreResult,
+    const Ogre::Vector3 &_rayOrigin, const Ogre::Vector3 &_rayDir,
+    size_t _numThreads) :
+  rayOrigin(_rayOrigin),
+  rayDir(_rayDir)
+{
+  this->collectedResults.resize(_numThreads);
+  this->candidates.reserve(_ogreResult.size());
+
+  for (const auto &entry : _ogreResult)
+  {
+    if (entry.distance <= 0.0)
+      continue;
+
+    RayQueryCandidate candidate;
+    if (MakeRayQueryCandidate(entry.movable, candidate))
+      this->candidates.push_back(std::move(candidate));
+  }
+}
+
 //////////////////////////////////////////////////
 void ThreadedTriRay::execute(size_t _threadId, size_t _numThreads)
 {
@@ -340,150 +604,25 @@ void ThreadedTriRay::execute(size_t _threadId, size_t _numThreads)
 
   RayQueryResult result;
 
-  // Iterate over all the results.
-  for (auto iter = this->ogreResult.begin(); iter != this->ogreResult.end();
-       ++iter)
+  // Iterate over all the candidates.
+  for (std::size_t c = 0u; c < this->candidates.size(); ++c)
   {
-    if (iter->distance <= 0.0)
-      continue;
-
-    if (!iter->movable || !iter->movable->getVisible())
-      continue;
-
-    auto userAny = iter->movable->getUserObjectBindings().getUserAny();
-    if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int) &&
-        iter->movable->getMovableType() == "Item")
+    const RayQueryCandidate &candidate = this->candidates[c];
+    if (candidate.bvh)
     {
-      Ogre::Item *ogreItem = static_cast<Ogre::Item *>(iter->movable);
-
-      // mesh factory creates name with ::CENTER or ::ORIGINAL depending on
-      // the params passed in the MeshDescriptor when loading the mesh
-      // so strip off the suffix
-      std::string meshName = ogreItem->getMesh()->getName();
-      size_t idx = meshName.find("::");
-      if (idx != std::string::npos)
-        meshName = meshName.substr(0, idx);
-
-      const common::Mesh *mesh =
-        common::MeshManager::Instance()->MeshByName(meshName);
-
-      if (!mesh)
-        continue;
-
-      Ogre::Matrix4 transform = ogreItem->_getParentNodeFullTransform();
-
-      const bool bIsAffine = transform.isAffine();
-
-      Ogre::Ray mouseRay;
-#ifndef SLOW_METHOD
-      if (bIsAffine)
-      {
-        Ogre::Matrix4 invTransform = transform.inverse();
-        Ogre::Matrix3 invTransform3x3;
-        invTransform.extract3x3Matrix(invTransform3x3);
-        mouseRay = Ogre::Ray(invTransform * this->rayOrigin,
-                             (invTransform3x3 * this->rayDir).normalisedCopy());
-      }
-      else
-#endif
-      {
-        mouseRay = Ogre::Ray(this->rayOrigin, this->rayDir);
-      }
-
-      // test for hitting individual triangles on the mesh
-      for (unsigned int j = 0; j < mesh->SubMeshCount(); ++j)
+      // meshes with a hierarchy are cheap to test, so each one is tested
+      // by a single thread
+      if (c % numThreads == threadId)
       {
-        auto s = mesh->SubMeshByIndex(j);
-        auto submesh = s.lock();
-        if (!submesh || submesh->VertexCount() < 3u)
-          continue;
-        const unsigned int indexCount = submesh->IndexCount();
-
-        const math::Vector3d *RESTRICT_ALIAS vertices =
-          submesh->VertexPtr();
-        const unsigned int *RESTRICT_ALIAS indices = submesh->IndexPtr();
-
-        std::pair<bool, Ogre::Real> bestHit = {
-          false, std::numeric_limits<Ogre::Real>::max()
-        };
-
-        // Round up to next multiple of numThreads and divide by it
-        unsigned int indexCountPerThread =
-          (indexCount + (numThreads - 1u)) / numThreads;
-        // indexCountPerThread must be multiple of 3
-        indexCountPerThread = ((indexCountPerThread + 2u) / 3u) * 3u;
-
-        unsigned int indexStart =
-          std::min(indexCountPerThread * threadId, indexCount);
-        unsigned int indexEnd =
-          std::min(indexCountPerThread * (threadId + 1u), indexCount);
-
-        for (unsigned int k = indexStart; k < indexEnd; k += 3)
-        {
-          if (indexCount <= k + 2)
-            continue;
-
-#ifdef SLOW_METHOD
-          math::Vector3d vertexA = submesh->Vertex(submesh->Index(k));
-          math::Vector3d vertexB = submesh->Vertex(submesh->Index(k + 1));
-          math::Vector3d vertexC = submesh->Vertex(submesh->Index(k + 2));
-
-          Ogre::Vector3 worldVertexA =
-            transform * Ogre2Conversions::Convert(vertexA);
-          Ogre::Vector3 worldVertexB =
-            transform * Ogre2Conversions::Convert(vertexB);
-          Ogre::Vector3 worldVertexC =
-            transform * Ogre2Conversions::Convert(vertexC);
-#else
-          Ogre::Vector3 worldVertexA, worldVertexB, worldVertexC;
-
-          if (bIsAffine)
-          {
-            worldVertexA = Ogre2Conversions::Convert(vertices[indices[k]]);
-            worldVertexB = Ogre2Conversions::Convert(vertices[indices[k + 1]]);
-            worldVertexC = Ogre2Conversions::Convert(vertices[indices[k + 2]]);
-          }
-          else
-          {
-            worldVertexA =
-              transform * Ogre2Conversions::Convert(vertices[indices[k]]);
-            worldVertexB =
-              transform * Ogre2Conversions::Convert(vertices[indices[k + 1]]);
-            worldVertexC =
-              transform * Ogre2Conversions::Convert(vertices[indices[k + 2]]);
-          }
-#endif
-
-          // check for a hit against this triangle
-          std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(
-            mouseRay, worldVertexA, worldVertexB, worldVertexC, true, false);
-
-          // if it was a hit check if its the closest
-          if (hit.first && hit.second < bestHit.second)
-          {
-            bestHit = hit;
-          }
-        }
-
-        if (bestHit.first && distance > bestHit.second)
-        {
-          // this is the closest so far, save it off
-          distance = bestHit.second;
-          result.distance = distance;
-          if (bIsAffine)
-          {
-            result.point = Ogre2Conversions::Convert(
-              transform * mouseRay.getPoint(distance));
-          }
-          else
-          {
-            result.point =
-              Ogre2Conversions::Convert(mouseRay.getPoint(distance));
-          }
-          result.objectId = Ogre::any_cast<unsigned int>(userAny);
-        }
+        IntersectRayQueryCandidate(candidate, this->rayOrigin, this->rayDir,
+            0u, 1u, distance, result);
       }
     }
+    else
+    {
+      IntersectRayQueryCandidate(candidate, this->rayOrigin, this->rayDir,
+          threadId, numThreads, distance, result);
+    }
   }
 
   collectedResults[_threadId] = result;
@@ -550,3 +689,374 @@ RayQueryResult Ogre2RayQuery::ClosestPointByIntersection(bool _forceSceneUpdate)
 
   return result;
 }
+
+//////////////////////////////////////////////////
+
+/// \brief Bounding volume hierarchy over the world space bounds of the ray
+/// query candidates of a scene. It is built once per batch of rays and
+/// replaces the OgreNext ray scene query, which would otherwise run once
+/// per ray.
+class GZ_RENDERING_OGRE2_HIDDEN RayQueryBroadphase
+{
+  /// \brief Constructor. Builds the hierarchy.
+  /// \param[in] _candidates Candidates, whose items must have up to date
+  /// world bounds
+  public: explicit RayQueryBroadphase(
+              const std::vector<RayQueryCandidate> &_candidates);
+
+  /// \brief Call a function for each candidate whose bounds are hit by a
+  /// ray. Candidates whose bounds contain the ray origin are skipped, like
+  /// the ray scene query results at distance 0 are in
+  /// Ogre2RayQuery::ClosestPoint.
+  /// \param[in] _origin Ray origin
+  /// \param[in] _dir Ray direction
+  /// \param[in] _func Function called with the index of each candidate
+  public: template <typename F>
+          void Traverse(const Ogre::Vector3 &_origin,
+              const Ogre::Vector3 &_dir, F _func) const;
+
+  /// \brief Split the nodes recursively
+  /// \param[in] _nodeIdx Index of the node to split
+  /// \param[in] _centroids Centroid of each candidate's bounds
+  private: void Split(uint32_t _nodeIdx,
+               const std::vector<Ogre::Vector3> &_centroids);
+
+  /// \brief A node of the hierarchy, see Ogre2MeshBvh
+  private: struct Node
+  {
+    /// \brief Minimum corner of the node bounds
+    float min[3];
+
+    /// \brief Index of the left child for interior nodes, index of the
+    /// first entry of order for leaves
+    uint32_t leftOrFirst;
+
+    /// \brief Maximum corner of the node bounds
+    float max[3];
+
+    /// \brief Number of candidates, 0 for interior nodes
+    uint32_t count;
+  };
+
+  /// \brief Flattened nodes, the root is at index 0
+  private: std::vector<Node> nodes;
+
+  /// \brief Candidate indices in leaf order
+  private: std::vector<uint32_t> order;
+
+  /// \brief World bounds of each candidate, as min x, y, z, max x, y, z
+  private: std::vector<std::array<float, 6>> bounds;
+};
+
+//////////////////////////////////////////////////
+RayQueryBroadphase::RayQueryBroadphase(
+    const std::vector<RayQueryCandidate> &_candidates)
+{
+  const uint32_t count = static_cast<uint32_t>(_candidates.size());
+  if (count == 0u)
+    return;
+
+  std::vector<Ogre::Vector3> centroids(count);
+  this->bounds.resize(count);
+  this->order.resize(count);
+  for (uint32_t i = 0u; i < count; ++i)
+  {
+    Ogre::Aabb aabb = _candidates[i].item->getWorldAabbUpdated();
+    Ogre::Vector3 min = aabb.getMinimum();
+    Ogre::Vector3 max = aabb.getMaximum();
+    this->bounds[i] = {min.x, min.y, min.z, max.x, max.y, max.z};
+    centroids[i] = aabb.mCenter;
+    this->order[i] = i;
+  }
+
+  this->nodes.reserve(2u * static_cast<std::size_t>(count));
+  Node root;
+  root.leftOrFirst = 0u;
+  root.count = count;
+  this->nodes.push_back(root);
+  this->Split(0u, centroids);
+}
+
+//////////////////////////////////////////////////
+void RayQueryBroadphase::Split(uint32_t _nodeIdx,
+    const std::vector<Ogre::Vector3> &_centroids)
+{
+  const uint32_t first = this->nodes[_nodeIdx].leftOrFirst;
+  const uint32_t count = this->nodes[_nodeIdx].count;
+
+  Ogre::Vector3 centroidMin(std::numeric_limits<Ogre::Real>::max());
+  Ogre::Vector3 centroidMax(std::numeric_limits<Ogre::Real>::lowest());
+  for (unsigned int j = 0u; j < 3u; ++j)
+  {
+    this->nodes[_nodeIdx].min[j] = std::numeric_limits<float>::max();
+    this->nodes[_nodeIdx].max[j] = std::numeric_limits<float>::lowest();
+  }
+  for (uint32_t i = first; i < first + count; ++i)
+  {
+    const auto &box = this->bounds[this->order[i]];
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      this->nodes[_nodeIdx].min[j] =
+          std::min(this->nodes[_nodeIdx].min[j], box[j]);
+      this->nodes[_nodeIdx].max[j] =
+          std::max(this->nodes[_nodeIdx].max[j], box[j + 3u]);
+    }
+    centroidMin.makeFloor(_centroids[this->order[i]]);
+    centroidMax.makeCeil(_centroids[this->order[i]]);
+  }
+
+  if (count <= 2u)
+    return;
+
+  // median split along the longest axis of the centroids. Scenes have few
+  // enough objects that this is not worth the surface area heuristic.
+  Ogre::Vector3 extent = centroidMax - centroidMin;
+  int axis = 0;
+  if (extent.y > extent.x)
+    axis = 1;
+  if (extent.z > extent[axis])
+    axis = 2;
+  if (extent[axis] <= 0.0f)
+    return;
+
+  const uint32_t half = count / 2u;
+  std::nth_element(this->order.begin() + first,
+      this->order.begin() + first + half,
+      this->order.begin() + first + count,
+      [&](uint32_t _a, uint32_t _b)
+      {
+        return _centroids[_a][axis] < _centroids[_b][axis];
+      });
+
+  const uint32_t leftIdx = static_cast<uint32_t>(this->nodes.size());
+  Node left;
+  left.leftOrFirst = first;
+  left.count = half;
+  Node right;
+  right.leftOrFirst = first + half;
+  right.count = count - half;
+  this->nodes.push_back(left);
+  this->nodes.push_back(right);
+  this->nodes[_nodeIdx].leftOrFirst = leftIdx;
+  this->nodes[_nodeIdx].count = 0u;
+
+  this->Split(leftIdx, _centroids);
+  this->Split(leftIdx + 1u, _centroids);
+}
+
+//////////////////////////////////////////////////
+template <typename F>
+void RayQueryBroadphase::Traverse(const Ogre::Vector3 &_origin,
+    const Ogre::Vector3 &_dir, F _func) const
+{
+  if (this->nodes.empty())
+    return;
+
+  const float origin[3] = {_origin.x, _origin.y, _origin.z};
+  float invDir[3];
+  for (unsigned int i = 0u; i < 3u; ++i)
+  {
+    // avoid 0 * inf for rays parallel to a slab that start on its plane
+    const float d = std::fabs(_dir[i]) > 1e-20f ? _dir[i] :
+        std::copysign(1e-20f, _dir[i]);
+    invDir[i] = 1.0f / d;
+  }
+
+  // entry and exit distances of a ray through a box
+  auto slabs = [&](const float *_min, const float *_max, float &_near,
+      float &_far)
+  {
+    _near = std::numeric_limits<float>::lowest();
+    _far = std::numeric_limits<float>::max();
+    for (unsigned int i = 0u; i < 3u; ++i)
+    {
+      float t1 = (_min[i] - origin[i]) * invDir[i];
+      float t2 = (_max[i] - origin[i]) * invDir[i];
+      _near = std::max(_near, std::min(t1, t2));
+      _far = std::min(_far, std::max(t1, t2));
+    }
+  };
+
+  // a median split hierarchy over 2^32 objects is 33 levels deep
+  uint32_t stack[64];
+  unsigned int stackSize = 0u;
+  stack[stackSize++] = 0u;
+  while (stackSize > 0u)
+  {
+    const Node &node = this->nodes[stack[--stackSize]];
+    float tNear;
+    float tFar;
+    slabs(node.min, node.max, tNear, tFar);
+    if (tFar < 0.0f || tNear > tFar)
+      continue;
+
+    if (node.count == 0u)
+    {
+      stack[stackSize++] = node.leftOrFirst + 1u;
+      stack[stackSize++] = node.leftOrFirst;
+      continue;
+    }
+
+    for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count;
+         ++i)
+    {
+      const auto &box = this->bounds[this->order[i]];
+      slabs(box.data(), box.data() + 3, tNear, tFar);
+      if (tFar < 0.0f || tNear > tFar || tNear <= 0.0f)
+        continue;
+      _func(this->order[i]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+
+/// \brief This class performs Triangle-level raycasts for a batch of rays,
+/// spreading the rays across multiple threads. Each thread handles a
+/// contiguous range of rays, so rays that are next to each other in the
+/// batch, which are usually close to each other in space, traverse the
+/// same hierarchies one after the other.
+class GZ_RENDERING_OGRE2_HIDDEN ThreadedBatchRay final
+  : public Ogre::UniformScalableTask
+{
+  /// \brief Constructor
+  /// \param[in] _candidates Items the rays can hit
+  /// \param[in] _broadphase Hierarchy over the candidates' bounds
+  /// \param[in] _origins Ray origins
+  /// \param[in] _directions Ray directions
+  /// \param[out] _results Closest hit of each ray, must be as large as
+  /// the number of rays
+  /// \param[in] _numThreads Maximum number of threads to split the rays
+  /// across. Any further worker threads are left idle.
+  public: ThreadedBatchRay(const std::vector<RayQueryCandidate> &_candidates,
+              const RayQueryBroadphase &_broadphase,
+              const std::vector<math::Vector3d> &_origins,
+              const std::vector<math::Vector3d> &_directions,
+              std::vector<RayQueryResult> &_results,
+              size_t _numThreads) :
+      candidates(_candidates),
+      broadphase(_broadphase),
+      origins(_origins),
+      directions(_directions),
+      results(_results),
+      maxThreads(_numThreads)
+  {
+  }
+
+  // Documentation inherited
+  public: void execute(size_t _threadId, size_t _numThreads) override;
+
+  /// \brief Items the rays can hit
+  private: const std::vector<RayQueryCandidate> &candidates;
+
+  /// \brief Hierarchy over the candidates' bounds
+  private: const RayQueryBroadphase &broadphase;
+
+  /// \brief Ray origins
+  private: const std::vector<math::Vector3d> &origins;
+
+  /// \brief Ray directions
+  private: const std::vector<math::Vector3d> &directions;
+
+  /// \brief Closest hit of each ray
+  private: std::vector<RayQueryResult> &results;
+
+  /// \brief Maximum number of threads to split the rays across
+  private: size_t maxThreads;
+};
+
+//////////////////////////////////////////////////
+void ThreadedBatchRay::execute(size_t _threadId, size_t _numThreads)
+{
+  const std::size_t numThreads = std::min(_numThreads, this->maxThreads);
+  if (_threadId >= numThreads)
+    return;
+
+  const std::size_t rayCount = this->origins.size();
+  const std::size_t start = rayCount * _threadId / numThreads;
+  const std::size_t end = rayCount * (_threadId + 1u) / numThreads;
+
+  for (std::size_t i = start; i < end; ++i)
+  {
+    RayQueryResult result;
+    if (!this->origins[i].IsFinite() || !this->directions[i].IsFinite())
+    {
+      this->results[i] = result;
+      continue;
+    }
+
+    const Ogre::Vector3 rayOrigin = Ogre2Conversions::Convert(this->origins[i]);
+    const Ogre::Vector3 rayDir = Ogre2Conversions::Convert(this->directions[i]);
+    double distance = std::numeric_limits<double>::max();
+    this->broadphase.Traverse(rayOrigin, rayDir,
+        [&](uint32_t _idx)
+        {
+          IntersectRayQueryCandidate(this->candidates[_idx], rayOrigin,
+              rayDir, 0u, 1u, distance, result);
+        });
+    this->results[i] = result;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2RayQuery::ClosestPoints(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions,
+    std::vector<RayQueryResult> &_results, bool _forceSceneUpdate)
+{
+  _results.clear();
+  if (_origins.size() != _directions.size())
+  {
+    gzerr << "Number of ray origins [" << _origins.size() << "] and "
+          << "directions [" << _directions.size() << "] do not match"
+          << std::endl;
+    return;
+  }
+  _results.resize(_origins.size());
+  if (_origins.empty())
+    return;
+
+  Ogre2ScenePtr ogreScene =
+      std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+  if (!ogreScene)
+    return;
+
+  Ogre::SceneManager *ogreSceneManager = ogreScene->OgreSceneManager();
+
+  if (_forceSceneUpdate)
+  {
+    ogreSceneManager->updateSceneGraph();
+  }
+
+  // single broadphase pass over all items for the whole batch
+  std::vector<RayQueryCandidate> candidates;
+  auto itemIt = ogreSceneManager->getMovableObjectIterator(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME);
+  while (itemIt.hasMoreElements())
+  {
+    RayQueryCandidate candidate;
+    if (MakeRayQueryCandidate(itemIt.getNext(), candidate))
+      candidates.push_back(std::move(candidate));
+  }
+  if (candidates.empty())
+    return;
+
+  RayQueryBroadphase broadphase(candidates);
+
+#ifndef SINGLE_THREADED
+  // not worth waking up a worker thread for a handful of rays
+  const std::size_t minRaysPerThread = 64u;
+  const std::size_t numThreads = std::min<std::size_t>(
+      ogreSceneManager->getNumWorkerThreads(),
+      (_origins.size() + minRaysPerThread - 1u) / minRaysPerThread);
+#else
+  const std::size_t numThreads = 1u;
+#endif
+  ThreadedBatchRay rayTask(candidates, broadphase, _origins, _directions,
+      _results, numThreads);
+
+  if (numThreads > 1u)
+    ogreSceneManager->executeUserScalableTask(&rayTask, true);
+  else
+    rayTask.execute(0u, 1u);
+}
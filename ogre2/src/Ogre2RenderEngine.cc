@@ -41,6 +41,7 @@
 #include "Ogre2GzHlmsPbsPrivate.hh"
 #include "Ogre2GzHlmsTerraPrivate.hh"
 #include "Ogre2GzHlmsUnlitPrivate.hh"
+#include "Ogre2ShaderCache.hh"
 
 #ifdef OGRE_BUILD_RENDERSYSTEM_VULKAN
 #  include "vulkan/vulkan_core.h"
@@ -107,6 +108,10 @@ class GZ_RENDERING_OGRE2_HIDDEN
   /// \brief Custom Terra modifications
   public: Ogre::Ogre2GzHlmsTerra *gzHlmsTerra{nullptr};
 
+  /// \brief On-disk cache of the compiled shaders, only set if the
+  /// shaderCachePath param is given
+  public: std::unique_ptr<gz::rendering::Ogre2ShaderCache> shaderCache;
+
 #ifdef OGRE_BUILD_RENDERSYSTEM_VULKAN
   /// \brief Needed to receive an external Vulkan device from Qt
   /// and inject it into OgreNext.
@@ -193,6 +198,13 @@ void Ogre2RenderEngine::Destroy()
   delete this->ogreOverlaySystem;
   this->ogreOverlaySystem = nullptr;
 
+  // save the shaders compiled by this process before the Hlms are destroyed
+  if (this->dataPtr->shaderCache)
+  {
+    this->dataPtr->shaderCache->Save(this->ogreRoot);
+    this->dataPtr->shaderCache.reset();
+  }
+
   this->dataPtr->hlmsPbsTerraShadows.reset();
 
   if (this->ogreRoot)
@@ -385,6 +397,13 @@ bool Ogre2RenderEngine::LoadImpl(
   if (it != _params.end())
     std::istringstream(it->second) >> this->winID;
 
+  it = _params.find("shaderCachePath");
+  if (it != _params.end() && !it->second.empty())
+  {
+    this->dataPtr->shaderCache =
+        std::make_unique<Ogre2ShaderCache>(it->second);
+  }
+
   it = _params.find("metal");
   if (it != _params.end())
   {
@@ -1077,6 +1096,11 @@ void Ogre2RenderEngine::CreateResources()
     mediaPath = common::joinPaths(resourcePath, "ogre2", "src", "media");
   }
 
+  // the Hlms are registered, load the shaders compiled by previous runs
+  // before any material is loaded
+  if (this->dataPtr->shaderCache)
+    this->dataPtr->shaderCache->Load(this->ogreRoot, mediaPath);
+
   // register low level materials (ogre v1 materials)
   // and compute shader stuff too
   std::vector< std::pair<std::string, std::string> > archNames;
@@ -1118,6 +1142,16 @@ void Ogre2RenderEngine::CreateResources()
     archNames.push_back(
         std::make_pair(p + "/Hlms/Pbs/Any", "General"));
 
+    // fonts are shared with the ogre engine, in the source tree they live
+    // in its media directory
+    std::string fontsPath = common::joinPaths(p, "fonts");
+    if (!common::isDirectory(fontsPath))
+    {
+      fontsPath = common::joinPaths(resourcePath, "ogre", "src", "media",
+          "fonts");
+    }
+    archNames.push_back(std::make_pair(fontsPath, "General"));
+
     for (auto aiter = archNames.begin(); aiter != archNames.end(); ++aiter)
     {
       try
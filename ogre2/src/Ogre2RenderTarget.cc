@@ -19,6 +19,7 @@
 
 #include "gz/rendering/Material.hh"
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2Includes.hh"
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "gz/rendering/ogre2/Ogre2RenderPass.hh"
@@ -102,11 +103,240 @@ class gz::rendering::Ogre2RenderTargetPrivate
   /// actual window
   ///
   public: Ogre::TextureGpu *ogreTexture[2] = {nullptr, nullptr};
+
+  /// \brief Color image the render target is read back into before it is
+  /// converted to a bayer or YUV image, when that image is not packed on
+  /// the GPU. Kept to avoid allocating on every copy.
+  public: Image packColorImage;
+
+  /// \brief Create the workspace that packs the final image into
+  /// packTexture
+  /// \param[in] _sceneManager Ogre scene manager
+  /// \param[in] _camera Ogre camera of the render target
+  /// \param[in] _name Name of the render target
+  /// \param[in] _format Bayer or YUV format of the render target
+  public: void CreatePackWorkspace(Ogre::SceneManager *_sceneManager,
+              Ogre::Camera *_camera, const std::string &_name,
+              PixelFormat _format);
+
+  /// \brief Destroy the pack workspace
+  public: void DestroyPackWorkspace();
+
+  /// \brief Single channel texture holding the bytes of the bayer or YUV
+  /// image, only created for these formats
+  public: Ogre::TextureGpu *packTexture = nullptr;
+
+  /// \brief Workspace packing the final image into packTexture
+  public: Ogre::CompositorWorkspace *packWorkspace = nullptr;
+
+  /// \brief Texture the pack workspace reads from. The workspace is created
+  /// again if the final image moves to the other ping pong texture.
+  public: Ogre::TextureGpu *packInput = nullptr;
+
+  /// \brief Name of the pack material of the render target
+  public: std::string packMaterialName;
+
+  /// \brief Name of the pack workspace definition
+  public: std::string packWorkspaceDefName;
 };
 
+namespace
+{
+  /// \brief Check if a format is a bayer format
+  /// \param[in] _format Pixel format
+  /// \return True for all PF_BAYER_* formats
+  bool IsBayer(gz::rendering::PixelFormat _format)
+  {
+    return _format == gz::rendering::PF_BAYER_RGGB8 ||
+        _format == gz::rendering::PF_BAYER_BGGR8 ||
+        _format == gz::rendering::PF_BAYER_GBRG8 ||
+        _format == gz::rendering::PF_BAYER_GRBG8;
+  }
+
+  /// \brief Check if a format is a YUV format
+  /// \param[in] _format Pixel format
+  /// \return True for PF_NV12, PF_I420 and PF_YUYV
+  bool IsYuv(gz::rendering::PixelFormat _format)
+  {
+    return _format == gz::rendering::PF_NV12 ||
+        _format == gz::rendering::PF_I420 ||
+        _format == gz::rendering::PF_YUYV;
+  }
+
+  /// \brief Get the size of the single channel texture an image is packed
+  /// into on the GPU. Its bytes are the ones of the image.
+  /// \param[in] _format Pixel format of the image
+  /// \param[in] _width Image width
+  /// \param[in] _height Image height
+  /// \param[out] _packedWidth Width of the texture
+  /// \param[out] _packedHeight Height of the texture
+  /// \return False if images of this format and size are not packed on the
+  /// GPU
+  bool PackedSize(gz::rendering::PixelFormat _format, unsigned int _width,
+      unsigned int _height, unsigned int &_packedWidth,
+      unsigned int &_packedHeight)
+  {
+    if (IsBayer(_format))
+    {
+      _packedWidth = _width;
+      _packedHeight = _height;
+      return true;
+    }
+
+    // Chroma is sampled from whole 2x2 blocks of pixels. Odd sized images
+    // have partial blocks, which the CPU conversion handles instead.
+    if (!IsYuv(_format) || _width % 2u != 0u || _height % 2u != 0u)
+      return false;
+
+    if (_format == gz::rendering::PF_YUYV)
+    {
+      _packedWidth = _width * 2u;
+      _packedHeight = _height;
+    }
+    else
+    {
+      // the chroma planes follow the luma plane, taking half its rows
+      _packedWidth = _width;
+      _packedHeight = _height + _height / 2u;
+    }
+    return true;
+  }
+}
+
 using namespace gz;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+void Ogre2RenderTargetPrivate::CreatePackWorkspace(
+    Ogre::SceneManager *_sceneManager, Ogre::Camera *_camera,
+    const std::string &_name, PixelFormat _format)
+{
+  this->DestroyPackWorkspace();
+
+  // The Bayer and Yuv materials are defined in script (bayer.material and
+  // yuv.material). Their parameters select the layout of the output.
+  Ogre::Vector4 param;
+  switch (_format)
+  {
+    // Channel sampled at each site of the 2x2 tile, 0: red, 1: green,
+    // 2: blue, indexed by (row % 2) * 2 + column % 2
+    case PF_BAYER_RGGB8:
+      param = Ogre::Vector4(0, 1, 1, 2);
+      break;
+    case PF_BAYER_BGGR8:
+      param = Ogre::Vector4(2, 1, 1, 0);
+      break;
+    case PF_BAYER_GBRG8:
+      param = Ogre::Vector4(1, 0, 2, 1);
+      break;
+    case PF_BAYER_GRBG8:
+      param = Ogre::Vector4(1, 2, 0, 1);
+      break;
+    // Image size and layout of the planes, 0: NV12, 1: I420, 2: YUYV
+    case PF_NV12:
+    case PF_I420:
+    case PF_YUYV:
+      param = Ogre::Vector4(
+          static_cast<Ogre::Real>(this->packInput->getWidth()),
+          static_cast<Ogre::Real>(this->packInput->getHeight()),
+          static_cast<Ogre::Real>(_format - PF_NV12), 0);
+      break;
+    default:
+      return;
+  }
+  const std::string baseMatName = IsBayer(_format) ? "Bayer" : "Yuv";
+  const std::string paramName = IsBayer(_format) ? "tile" : "params";
+
+  Ogre::MaterialPtr baseMat =
+      Ogre::MaterialManager::getSingleton().getByName(baseMatName);
+  if (!baseMat)
+  {
+    gzerr << baseMatName << " material not found, "
+          << PixelUtil::Name(_format) << " images are converted on the CPU"
+          << std::endl;
+    return;
+  }
+  if (!baseMat->isLoaded())
+    baseMat->load();
+
+  this->packMaterialName = baseMatName + "_" + _name;
+  Ogre::MaterialPtr mat =
+      Ogre::MaterialManager::getSingleton().getByName(
+      this->packMaterialName);
+  if (!mat)
+    mat = baseMat->clone(this->packMaterialName);
+  mat->getTechnique(0)->getPass(0)->getFragmentProgramParameters()->
+      setNamedConstant(paramName, param);
+
+  auto ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+
+  // compositor_node PackNode
+  // {
+  //   in 0 rt_input
+  //   in 1 rt_output
+  //
+  //   target rt_output
+  //   {
+  //     pass render_quad
+  //     {
+  //       material <Bayer|Yuv>_<name>
+  //       input 0 rt_input
+  //     }
+  //   }
+  // }
+  const std::string wsDefName = "PackWorkspace_" + _name;
+  this->packWorkspaceDefName = wsDefName;
+  const std::string nodeDefName = wsDefName + "/PackNode";
+  if (!ogreCompMgr->hasWorkspaceDefinition(wsDefName))
+  {
+    Ogre::CompositorNodeDef *nodeDef =
+        ogreCompMgr->addNodeDefinition(nodeDefName);
+    nodeDef->addTextureSourceName("rt_input", 0,
+        Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+    nodeDef->addTextureSourceName("rt_output", 1,
+        Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+
+    nodeDef->setNumTargetPass(1);
+    Ogre::CompositorTargetDef *targetDef = nodeDef->addTargetPass("rt_output");
+    targetDef->setNumPasses(1);
+    {
+      Ogre::CompositorPassQuadDef *passQuad =
+          static_cast<Ogre::CompositorPassQuadDef *>(
+          targetDef->addPass(Ogre::PASS_QUAD));
+      passQuad->setAllLoadActions(Ogre::LoadAction::DontCare);
+      passQuad->mMaterialName = this->packMaterialName;
+      passQuad->addQuadTextureSource(0, "rt_input");
+    }
+
+    Ogre::CompositorWorkspaceDef *workDef =
+        ogreCompMgr->addWorkspaceDefinition(wsDefName);
+    workDef->connectExternal(0, nodeDefName, 0);
+    workDef->connectExternal(1, nodeDefName, 1);
+  }
+
+  Ogre::CompositorChannelVec externalTargets(2u);
+  externalTargets[0] = this->packInput;
+  externalTargets[1] = this->packTexture;
+  this->packWorkspace = ogreCompMgr->addWorkspace(_sceneManager,
+      externalTargets, _camera, wsDefName, false);
+}
+
+//////////////////////////////////////////////////
+void Ogre2RenderTargetPrivate::DestroyPackWorkspace()
+{
+  if (!this->packWorkspace)
+    return;
+
+  auto ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+  ogreCompMgr->removeWorkspace(this->packWorkspace);
+  ogreCompMgr->removeWorkspaceDefinition(this->packWorkspaceDefName);
+  ogreCompMgr->removeNodeDefinition(
+      this->packWorkspaceDefName + "/PackNode");
+  this->packWorkspace = nullptr;
+}
+
 //////////////////////////////////////////////////
 // Ogre2RenderTarget
 //////////////////////////////////////////////////
@@ -319,6 +549,15 @@ void Ogre2RenderTarget::BuildCompositor()
       dynamic_cast<Ogre2RenderPass *>(pass.get());
     ogre2RenderPass->WorkspaceAdded(this->ogreCompositorWorkspace);
   }
+
+  // Bayer and YUV images are packed on the GPU by a separate workspace
+  // reading the final image
+  if (this->dataPtr->packTexture)
+  {
+    this->dataPtr->packInput = this->dataPtr->ogreTexture[1];
+    this->dataPtr->CreatePackWorkspace(this->scene->OgreSceneManager(),
+        this->ogreCamera, this->Name(), this->format);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -327,6 +566,8 @@ void Ogre2RenderTarget::DestroyCompositor()
   if (!this->ogreCompositorWorkspace)
     return;
 
+  this->dataPtr->DestroyPackWorkspace();
+
   for (RenderPassPtr &renderPass : this->renderPasses)
   {
     Ogre2RenderPass *ogre2RenderPass =
@@ -370,19 +611,40 @@ void Ogre2RenderTarget::RebuildCompositor()
 //////////////////////////////////////////////////
 void Ogre2RenderTarget::Copy(Image &_image) const
 {
-  // TODO(anyone) handle Bayer conversions
-
   if (_image.Width() != this->width || _image.Height() != this->height)
   {
     gzerr << "Invalid image dimensions" << std::endl;
     return;
   }
 
+  const bool bayer = IsBayer(_image.Format());
+  const bool yuv = IsYuv(_image.Format());
+
+  // Bayer and YUV images packed on the GPU are read back as they are, one
+  // byte per pixel for bayer, 1.5 or 2 for YUV
+  if ((bayer || yuv) && this->dataPtr->packWorkspace &&
+      _image.Format() == this->format)
+  {
+    Ogre::TextureGpu *texture = this->dataPtr->packTexture;
+    const Ogre::PixelFormatGpu dstOgrePf = texture->getPixelFormat();
+    Ogre::TextureBox dstBox(
+      texture->getInternalWidth(), texture->getInternalHeight(),
+      texture->getDepth(), texture->getNumSlices(),
+      static_cast<uint32_t>(
+        Ogre::PixelFormatGpuUtils::getBytesPerPixel(dstOgrePf)),
+      static_cast<uint32_t>(Ogre::PixelFormatGpuUtils::getSizeBytes(
+        texture->getInternalWidth(), 1u, 1u, 1u, dstOgrePf, 1u)),
+      static_cast<uint32_t>(Ogre::PixelFormatGpuUtils::getSizeBytes(
+        texture->getInternalWidth(), texture->getInternalHeight(), 1u, 1u,
+        dstOgrePf, 1u)));
+    dstBox.data = _image.Data();
+    Ogre::Image2::copyContentsToMemory(
+        texture, texture->getEmptyBox(0u), dstBox, dstOgrePf);
+    return;
+  }
+
   Ogre::PixelFormatGpu dstOgrePf;
-  if ((_image.Format() == PF_BAYER_RGGB8) ||
-      (_image.Format() == PF_BAYER_BGGR8) ||
-      (_image.Format() == PF_BAYER_GBRG8) ||
-      (_image.Format() == PF_BAYER_GRBG8))
+  if (bayer || yuv)
   {
     dstOgrePf = Ogre2Conversions::Convert(PF_R8G8B8);
   }
@@ -415,18 +677,23 @@ void Ogre2RenderTarget::Copy(Image &_image) const
       texture->getInternalWidth(), texture->getInternalHeight(), 1u, 1u,
       dstOgrePf, 1u)));
 
-  if ((_image.Format() == PF_BAYER_RGGB8) ||
-      (_image.Format() == PF_BAYER_BGGR8) ||
-      (_image.Format() == PF_BAYER_GBRG8) ||
-      (_image.Format() == PF_BAYER_GRBG8))
+  if (bayer || yuv)
   {
-    // create tmp color image to get data from gpu
-    Image colorImage(this->width, this->height, PF_R8G8B8);
+    // get color data from gpu into a reused buffer
+    Image &colorImage = this->dataPtr->packColorImage;
+    if (colorImage.Width() != this->width ||
+        colorImage.Height() != this->height)
+    {
+      colorImage = Image(this->width, this->height, PF_R8G8B8);
+    }
     dstBox.data = colorImage.Data();
     Ogre::Image2::copyContentsToMemory(
         texture, texture->getEmptyBox(0u), dstBox, dstOgrePf);
-    // convert color image to bayer image
-    _image = gz::rendering::convertRGBToBayer(colorImage, _image.Format());
+    // convert color image to bayer or yuv image in place
+    if (bayer)
+      gz::rendering::convertRGBToBayer(colorImage, _image);
+    else
+      gz::rendering::convertRGBToYUV(colorImage, _image);
   }
   else
   {
@@ -511,7 +778,9 @@ void Ogre2RenderTarget::PostRender()
 //////////////////////////////////////////////////
 void Ogre2RenderTarget::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2RenderTarget::Render");
   this->scene->StartRendering(this->ogreCamera);
+  this->scene->UpdateShadowCache(this->ogreCompositorWorkspace);
 
   this->ogreCompositorWorkspace->_validateFinalTarget();
   this->ogreCompositorWorkspace->_beginUpdate(false);
@@ -522,6 +791,25 @@ void Ogre2RenderTarget::Render()
   swappedTargets.reserve(2u);
   this->ogreCompositorWorkspace->_swapFinalTarget(swappedTargets);
 
+  if (this->dataPtr->packWorkspace)
+  {
+    // render passes added or toggled may have moved the final image
+    if (this->dataPtr->packInput != this->dataPtr->ogreTexture[1])
+    {
+      this->dataPtr->packInput = this->dataPtr->ogreTexture[1];
+      this->dataPtr->CreatePackWorkspace(this->scene->OgreSceneManager(),
+          this->ogreCamera, this->Name(), this->format);
+    }
+
+    if (this->dataPtr->packWorkspace)
+    {
+      this->dataPtr->packWorkspace->_validateFinalTarget();
+      this->dataPtr->packWorkspace->_beginUpdate(false);
+      this->dataPtr->packWorkspace->_update();
+      this->dataPtr->packWorkspace->_endUpdate(false);
+    }
+  }
+
   this->scene->FlushGpuCommandsAndStartNewFrame(1u, false);
 }
 
@@ -549,6 +837,13 @@ void Ogre2RenderTarget::DestroyTargetImpl()
     this->dataPtr->ogreTexture[i] = nullptr;
   }
 
+  if (this->dataPtr->packTexture)
+  {
+    textureManager->destroyTexture(this->dataPtr->packTexture);
+    this->dataPtr->packTexture = nullptr;
+  }
+  this->dataPtr->packInput = nullptr;
+
   // TODO(anyone) there is memory leak when a render texture is destroyed.
   // The RenderSystem::_cleanupDepthBuffers method used in ogre1 does not
   // seem to work in ogre2
@@ -585,6 +880,26 @@ void Ogre2RenderTarget::BuildTargetImpl()
     this->dataPtr->ogreTexture[i]->scheduleTransitionTo(
           Ogre::GpuResidency::Resident);
   }
+
+  // single channel target bayer and YUV images are packed into, so that
+  // only the bytes of the image are read back
+  unsigned int packedWidth = 0u;
+  unsigned int packedHeight = 0u;
+  if (!this->IsRenderWindow() && PackedSize(this->format, this->width,
+      this->height, packedWidth, packedHeight))
+  {
+    this->dataPtr->packTexture =
+        textureMgr->createTexture(
+          this->name + "_packed",
+          Ogre::GpuPageOutStrategy::Discard,
+          Ogre::TextureFlags::RenderToTexture,
+          Ogre::TextureTypes::Type2D);
+    this->dataPtr->packTexture->setResolution(packedWidth, packedHeight);
+    this->dataPtr->packTexture->setNumMipmaps(1u);
+    this->dataPtr->packTexture->setPixelFormat(Ogre::PFG_R8_UNORM);
+    this->dataPtr->packTexture->scheduleTransitionTo(
+        Ogre::GpuResidency::Resident);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -29,8 +29,16 @@
   #include <GL/gl.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/base/SceneExt.hh"
 #include "gz/rendering/GraphicsAPI.hh"
 #include "gz/rendering/RenderTypes.hh"
@@ -66,22 +74,28 @@
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2ThermalCamera.hh"
 #include "gz/rendering/ogre2/Ogre2SegmentationCamera.hh"
+#include "gz/rendering/ogre2/Ogre2Text.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 #include "gz/rendering/ogre2/Ogre2WideAngleCamera.hh"
 #include "gz/rendering/ogre2/Ogre2WireBox.hh"
 
+#include "Ogre2TextBatch.hh"
+
 #ifdef _MSC_VER
   #pragma warning(push, 0)
 #endif
 #include <Compositor/OgreCompositorManager2.h>
+#include <Compositor/OgreCompositorWorkspace.h>
 #include <Compositor/Pass/PassClear/OgreCompositorPassClearDef.h>
 #include <Compositor/Pass/PassQuad/OgreCompositorPassQuadDef.h>
 #include <Compositor/Pass/PassScene/OgreCompositorPassSceneDef.h>
 #include <OgreDepthBuffer.h>
+#include <OgreLight.h>
 #include <OgreMatrix4.h>
 #include <OgrePlatformInformation.h>
 #include <OgreRoot.h>
 #include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
 #include <Overlay/OgreOverlayManager.h>
 #include <Overlay/OgreOverlaySystem.h>
 #if OGRE_VERSION_MAJOR == 2 && OGRE_VERSION_MINOR == 1
@@ -135,11 +149,306 @@ class gz::rendering::Ogre2ScenePrivate
 
   /// \brief See Ogre2Scene::SetLightsGiDirty
   public: bool lightsGiDirty = false;
+
+  /// \brief A shadow map of a spot or point light that is only rendered
+  /// again when needed
+  public: struct CachedShadowMap
+  {
+    /// \brief Id of the light
+    unsigned int lightId = 0u;
+
+    /// \brief Ogre light fixed to the shadow map
+    Ogre::Light *light = nullptr;
+
+    /// \brief Index of the shadow map in the shadow node
+    size_t shadowMapIdx = 0u;
+
+    /// \brief World position of the light when last checked
+    Ogre::Vector3 position = Ogre::Vector3::ZERO;
+
+    /// \brief World orientation of the light when last checked
+    Ogre::Quaternion orientation = Ogre::Quaternion::IDENTITY;
+
+    /// \brief Range of the light when last checked
+    Ogre::Real range = 0;
+
+    /// \brief Spot light outer angle when last checked
+    Ogre::Radian outerAngle{0};
+
+    /// \brief Incremented every time the shadow map is rendered again
+    uint64_t version = 0u;
+
+    /// \brief True if the shadow map has to be rendered again
+    bool dirty = true;
+
+    /// \brief Frame since which the shadow map is dirty
+    uint64_t dirtyFrame = 0u;
+  };
+
+  /// \brief State of the cached shadow maps in the shadow node of a
+  /// workspace
+  public: struct ShadowNodeCache
+  {
+    /// \brief Light fixed to each cached shadow map
+    std::vector<Ogre::Light *> lights;
+
+    /// \brief Version of each cached shadow map last rendered
+    std::vector<uint64_t> versions;
+
+    /// \brief Last frame the workspace was updated
+    uint64_t lastFrame = 0u;
+  };
+
+  /// \brief Check which cached shadow maps have to be rendered again this
+  /// frame, within the refresh budget
+  /// \param[in] _scene Scene the shadow maps belong to
+  public: void UpdateCachedShadowMaps(Ogre2Scene *_scene);
+
+  /// \brief True if shadow maps of spot and point lights are cached
+  public: bool shadowCaching = false;
+
+  /// \brief Max number of cached shadow maps rendered again per frame,
+  /// 0 for no limit
+  public: unsigned int shadowMapRefreshBudget = 0u;
+
+  /// \brief Shadow parameters the shadow node definition was built with
+  public: Ogre::ShadowNodeHelper::ShadowParamVec shadowParams;
+
+  /// \brief Index of the first shadow map of spot and point lights
+  public: size_t firstSpotPointShadowMap = 0u;
+
+  /// \brief Number of shadow maps of spot and point lights
+  public: unsigned int spotPointShadowMapCount = 0u;
+
+  /// \brief Cached shadow maps, one per shadow casting spot or point light
+  public: std::vector<CachedShadowMap> cachedShadowMaps;
+
+  /// \brief World bounds of the shadow casters changed since the last
+  /// frame
+  public: std::vector<Ogre::Aabb> shadowCasterChanges;
+
+  /// \brief State of the cached shadow maps in each shadow node instance,
+  /// indexed by id
+  public: std::unordered_map<Ogre::IdType, ShadowNodeCache> shadowNodeCaches;
+
+  /// \brief Frame counter of the shadow cache
+  public: uint64_t shadowCacheFrame = 0u;
+
+  /// \brief Incremented every time a cached shadow map is rendered again
+  public: uint64_t shadowCacheVersion = 0u;
+
+  /// \brief Number of frames after which the state of a shadow node
+  /// instance that was not updated is discarded
+  public: static constexpr uint64_t kShadowNodeCacheFrames = 1000u;
 };
 
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Check whether two sets of shadow parameters describe the same
+  /// shadow maps
+  /// \param[in] _a First shadow parameters
+  /// \param[in] _b Second shadow parameters
+  /// \return True if the shadow node definitions built from the two are
+  /// the same
+  bool SameShadowParams(const Ogre::ShadowNodeHelper::ShadowParamVec &_a,
+      const Ogre::ShadowNodeHelper::ShadowParamVec &_b)
+  {
+    if (_a.size() != _b.size())
+      return false;
+
+    for (size_t i = 0u; i < _a.size(); ++i)
+    {
+      const Ogre::ShadowNodeHelper::ShadowParam &a = _a[i];
+      const Ogre::ShadowNodeHelper::ShadowParam &b = _b[i];
+      if (a.technique != b.technique || a.atlasId != b.atlasId ||
+          a.supportedLightTypes != b.supportedLightTypes)
+      {
+        return false;
+      }
+
+      const size_t numSplits = a.technique == Ogre::SHADOWMAP_PSSM ?
+          a.numPssmSplits : 1u;
+      if (a.technique == Ogre::SHADOWMAP_PSSM &&
+          a.numPssmSplits != b.numPssmSplits)
+      {
+        return false;
+      }
+      for (size_t j = 0u; j < numSplits; ++j)
+      {
+        if (a.resolution[j].x != b.resolution[j].x ||
+            a.resolution[j].y != b.resolution[j].y ||
+            a.atlasStart[j].x != b.atlasStart[j].x ||
+            a.atlasStart[j].y != b.atlasStart[j].y)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Merge the world bounds of the visible shadow casters attached
+  /// to a node and its children
+  /// \param[in] _node Node to get the shadow casters of
+  /// \param[in,out] _bounds Bounds to merge into
+  /// \param[in,out] _valid True if _bounds holds any shadow caster
+  void MergeShadowCasterBounds(Ogre::SceneNode *_node, Ogre::Aabb &_bounds,
+      bool &_valid)
+  {
+    for (size_t i = 0u; i < _node->numAttachedObjects(); ++i)
+    {
+      Ogre::MovableObject *object = _node->getAttachedObject(i);
+      if (!object->getCastShadows() || !object->getVisible())
+        continue;
+
+      const Ogre::Aabb aabb = object->getWorldAabbUpdated();
+      if (_valid)
+      {
+        _bounds.merge(aabb);
+      }
+      else
+      {
+        _bounds = aabb;
+        _valid = true;
+      }
+    }
+
+    for (size_t i = 0u; i < _node->numChildren(); ++i)
+    {
+      MergeShadowCasterBounds(
+          static_cast<Ogre::SceneNode *>(_node->getChild(i)), _bounds,
+          _valid);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check whether bounds are within the range of a light
+  /// \param[in] _bounds World bounds
+  /// \param[in] _position World position of the light
+  /// \param[in] _range Range of the light
+  /// \return True if the bounds intersect the sphere of the light range
+  bool InLightRange(const Ogre::Aabb &_bounds, const Ogre::Vector3 &_position,
+      Ogre::Real _range)
+  {
+    Ogre::Vector3 distance = _bounds.mCenter - _position;
+    distance.x = std::max<Ogre::Real>(
+        std::abs(distance.x) - _bounds.mHalfSize.x, 0);
+    distance.y = std::max<Ogre::Real>(
+        std::abs(distance.y) - _bounds.mHalfSize.y, 0);
+    distance.z = std::max<Ogre::Real>(
+        std::abs(distance.z) - _bounds.mHalfSize.z, 0);
+    return distance.squaredLength() <= _range * _range;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2ScenePrivate::UpdateCachedShadowMaps(Ogre2Scene *_scene)
+{
+  ++this->shadowCacheFrame;
+
+  // drop the state of shadow node instances that are gone, e.g. after a
+  // camera recreated its compositor
+  for (auto it = this->shadowNodeCaches.begin();
+      it != this->shadowNodeCaches.end();)
+  {
+    if (it->second.lastFrame + kShadowNodeCacheFrames < this->shadowCacheFrame)
+      it = this->shadowNodeCaches.erase(it);
+    else
+      ++it;
+  }
+
+  if (!this->shadowCaching)
+  {
+    this->cachedShadowMaps.clear();
+    this->shadowCasterChanges.clear();
+    return;
+  }
+
+  // the spot and point lights are fixed to their shadow maps in the same
+  // order UpdateShadowNode counted them
+  std::vector<LightPtr> lights;
+  for (unsigned int i = 0u; i < _scene->LightCount() &&
+      lights.size() < this->spotPointShadowMapCount; ++i)
+  {
+    LightPtr light = _scene->LightByIndex(i);
+    if (light->CastShadows() &&
+        !std::dynamic_pointer_cast<DirectionalLight>(light))
+    {
+      lights.push_back(light);
+    }
+  }
+  this->cachedShadowMaps.resize(lights.size());
+
+  for (size_t i = 0u; i < lights.size(); ++i)
+  {
+    CachedShadowMap &shadowMap = this->cachedShadowMaps[i];
+    Ogre::Light *ogreLight =
+        std::dynamic_pointer_cast<Ogre2Light>(lights[i])->Light();
+    if (shadowMap.lightId != lights[i]->Id() || shadowMap.light != ogreLight)
+    {
+      shadowMap = CachedShadowMap();
+      shadowMap.lightId = lights[i]->Id();
+      shadowMap.light = ogreLight;
+      shadowMap.dirtyFrame = this->shadowCacheFrame;
+    }
+    shadowMap.shadowMapIdx = this->firstSpotPointShadowMap + i;
+
+    Ogre::Node *node = ogreLight->getParentNode();
+    const Ogre::Vector3 position = node->_getDerivedPositionUpdated();
+    const Ogre::Quaternion orientation =
+        node->_getDerivedOrientationUpdated();
+    const Ogre::Real range = ogreLight->getAttenuationRange();
+    const Ogre::Radian outerAngle = ogreLight->getSpotlightOuterAngle();
+    bool dirty = position != shadowMap.position ||
+        orientation != shadowMap.orientation || range != shadowMap.range ||
+        outerAngle != shadowMap.outerAngle;
+    shadowMap.position = position;
+    shadowMap.orientation = orientation;
+    shadowMap.range = range;
+    shadowMap.outerAngle = outerAngle;
+
+    for (size_t j = 0u; !dirty && !shadowMap.dirty &&
+        j < this->shadowCasterChanges.size(); ++j)
+    {
+      dirty = InLightRange(this->shadowCasterChanges[j], position, range);
+    }
+
+    if (dirty && !shadowMap.dirty)
+    {
+      shadowMap.dirty = true;
+      shadowMap.dirtyFrame = this->shadowCacheFrame;
+    }
+  }
+  this->shadowCasterChanges.clear();
+
+  // render again the shadow maps waiting the longest first
+  std::vector<CachedShadowMap *> dirtyShadowMaps;
+  for (auto &shadowMap : this->cachedShadowMaps)
+  {
+    if (shadowMap.dirty)
+      dirtyShadowMaps.push_back(&shadowMap);
+  }
+  std::stable_sort(dirtyShadowMaps.begin(), dirtyShadowMaps.end(),
+      [](const CachedShadowMap *_a, const CachedShadowMap *_b)
+      {
+        return _a->dirtyFrame < _b->dirtyFrame;
+      });
+
+  size_t count = dirtyShadowMaps.size();
+  if (this->shadowMapRefreshBudget > 0u)
+    count = std::min<size_t>(count, this->shadowMapRefreshBudget);
+  for (size_t i = 0u; i < count; ++i)
+  {
+    dirtyShadowMaps[i]->version = ++this->shadowCacheVersion;
+    dirtyShadowMaps[i]->dirty = false;
+  }
+}
+
 //////////////////////////////////////////////////
 Ogre2Scene::Ogre2Scene(unsigned int _id, const std::string &_name) :
   BaseScene(_id, _name), dataPtr(std::make_unique<Ogre2ScenePrivate>())
@@ -230,6 +539,7 @@ void Ogre2Scene::SetBackgroundColor(const math::Color &_color)
 //////////////////////////////////////////////////
 void Ogre2Scene::PreRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2Scene::PreRender");
   GZ_ASSERT((this->LegacyAutoGpuFlush() ||
               this->dataPtr->frameUpdateStarted == false),
              "Scene::PreRender called again before calling Scene::PostRender. "
@@ -237,23 +547,16 @@ void Ogre2Scene::PreRender()
   this->dataPtr->frameUpdateStarted = true;
 
   if (this->ShadowsDirty())
-  {
-    // notify all render targets
-    for (unsigned int i  = 0; i < this->SensorCount(); ++i)
-    {
-      auto camera = std::dynamic_pointer_cast<Camera>(
-          this->SensorByIndex(i));
-      if (camera)
-      {
-         camera->SetShadowsDirty();
-      }
-    }
-
     this->UpdateShadowNode();
-  }
 
   BaseScene::PreRender();
 
+  this->dataPtr->UpdateCachedShadowMaps(this);
+
+  // texts were pre-rendered with their visuals, upload the glyphs of the
+  // ones that changed
+  Ogre2TextBatch::UpdateAll(this->ogreSceneManager);
+
   if (!this->LegacyAutoGpuFlush())
   {
     auto engine = Ogre2RenderEngine::Instance();
@@ -283,6 +586,7 @@ void Ogre2Scene::PreRender()
 //////////////////////////////////////////////////
 void Ogre2Scene::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2Scene::PostRender");
   GZ_ASSERT((this->LegacyAutoGpuFlush() ||
               this->dataPtr->frameUpdateStarted == true),
              "Scene::PostRender called again before calling Scene::PreRender. "
@@ -347,6 +651,7 @@ void Ogre2Scene::EndForcedRender()
 //////////////////////////////////////////////////
 void Ogre2Scene::StartRendering(Ogre::Camera *_camera)
 {
+  GZ_RENDERING_PROFILE("Ogre2Scene::StartRendering");
   if (_camera)
     this->UpdateAllHeightmaps(_camera);
 
@@ -410,6 +715,7 @@ void Ogre2Scene::FlushGpuCommandsAndStartNewFrame(uint8_t _numPasses,
 //////////////////////////////////////////////////
 void Ogre2Scene::FlushGpuCommandsOnly()
 {
+  GZ_RENDERING_PROFILE("Ogre2Scene::FlushGpuCommandsOnly");
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
@@ -437,6 +743,7 @@ void Ogre2Scene::FlushGpuCommandsOnly()
 //////////////////////////////////////////////////
 void Ogre2Scene::EndFrame()
 {
+  GZ_RENDERING_PROFILE("Ogre2Scene::EndFrame");
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
 
@@ -492,6 +799,9 @@ void Ogre2Scene::Destroy()
 {
   this->DestroyNodes();
 
+  // text batches are shared by all texts of the scene and can outlive them
+  Ogre2TextBatch::DestroyAll(this->ogreSceneManager);
+
   // cleanup any items that were not attached to nodes
   // make sure to do this before destroying materials done by BaseScene::Destroy
   // otherwise ogre throws an exception when unlinking a renderable from a
@@ -629,6 +939,7 @@ void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera)
 //////////////////////////////////////////////////
 void Ogre2Scene::UpdateShadowNode()
 {
+  GZ_RENDERING_PROFILE("Ogre2Scene::UpdateShadowNode");
   if (!this->ShadowsDirty())
     return;
 
@@ -711,6 +1022,11 @@ void Ogre2Scene::UpdateShadowNode()
   }
 
   // others
+  // cached shadow maps cover the whole frustum of their light as they are
+  // shared by all camera views
+  const Ogre::ShadowMapTechniques spotPointTechnique =
+      this->dataPtr->shadowCaching ? Ogre::SHADOWMAP_UNIFORM :
+      Ogre::SHADOWMAP_FOCUSED;
   unsigned int spotPointTexSize = this->dataPtr->spotPointTexSize;
   unsigned int rowIdx = 0;
   unsigned int colIdx = 0;
@@ -719,7 +1035,7 @@ void Ogre2Scene::UpdateShadowNode()
 
   for (unsigned int i = 0; i < spotPointLightCount; ++i)
   {
-    shadowParam.technique = Ogre::SHADOWMAP_FOCUSED;
+    shadowParam.technique = spotPointTechnique;
     shadowParam.atlasId = atlasId;
     shadowParam.resolution[0].x = spotPointTexSize;
     shadowParam.resolution[0].y = spotPointTexSize;
@@ -747,12 +1063,37 @@ void Ogre2Scene::UpdateShadowNode()
     }
   }
 
+  this->dataPtr->firstSpotPointShadowMap = dirLightCount * 3u;
+  this->dataPtr->spotPointShadowMapCount = spotPointLightCount;
+
+  // the shadow node is only rebuilt when the shadow maps change, e.g. not
+  // when a light that casts shadows is replaced by another one
   std::string shadowNodeDefName = this->dataPtr->kShadowNodeName;
+  if (compositorManager->hasShadowNodeDefinition(shadowNodeDefName) &&
+      SameShadowParams(shadowParams, this->dataPtr->shadowParams))
+  {
+    this->SetShadowsDirty(false);
+    return;
+  }
+
+  // notify all render targets
+  for (unsigned int i  = 0; i < this->SensorCount(); ++i)
+  {
+    auto camera = std::dynamic_pointer_cast<Camera>(
+        this->SensorByIndex(i));
+    if (camera)
+    {
+       camera->SetShadowsDirty();
+    }
+  }
+
   if (compositorManager->hasShadowNodeDefinition(shadowNodeDefName))
     compositorManager->removeShadowNodeDefinition(shadowNodeDefName);
 
   this->CreateShadowNodeWithSettings(compositorManager, shadowNodeDefName,
       shadowParams);
+  this->dataPtr->shadowParams = shadowParams;
+  this->dataPtr->shadowNodeCaches.clear();
 
   this->SetShadowsDirty(false);
 }
@@ -1289,6 +1630,22 @@ MeshPtr Ogre2Scene::CreateMeshImpl(unsigned int _id,
   return (result) ? mesh : nullptr;
 }
 
+//////////////////////////////////////////////////
+Ogre2MeshPtr Ogre2Scene::CreateMeshFromOgre(const Ogre::MeshPtr &_ogreMesh,
+    const MeshDescriptor &_desc)
+{
+  Ogre2MeshPtr mesh = this->meshFactory->Create(_ogreMesh);
+  if (nullptr == mesh)
+    return nullptr;
+  mesh->SetDescriptor(_desc);
+
+  unsigned int objId = this->CreateObjectId();
+  std::string objName =
+      this->CreateObjectName(objId, "Mesh-" + _ogreMesh->getName());
+  bool result = this->InitObject(mesh, objId, objName);
+  return (result) ? mesh : nullptr;
+}
+
 //////////////////////////////////////////////////
 CapsulePtr Ogre2Scene::CreateCapsuleImpl(unsigned int _id,
     const std::string &_name)
@@ -1345,11 +1702,12 @@ LidarVisualPtr Ogre2Scene::CreateLidarVisualImpl(unsigned int _id,
 }
 
 //////////////////////////////////////////////////
-TextPtr Ogre2Scene::CreateTextImpl(unsigned int /*_id*/,
-    const std::string &/*_name*/)
+TextPtr Ogre2Scene::CreateTextImpl(unsigned int _id,
+    const std::string &_name)
 {
-  // TODO(anyone)
-  return TextPtr();
+  Ogre2TextPtr text(new Ogre2Text);
+  bool result = this->InitObject(text, _id, _name);
+  return (result) ? text : nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -1544,6 +1902,92 @@ bool Ogre2Scene::ShadowsDirty() const
   return this->dataPtr->shadowsDirty;
 }
 
+//////////////////////////////////////////////////
+void Ogre2Scene::SetShadowCasterDirty(Ogre::SceneNode *_node)
+{
+  if (!this->dataPtr->shadowCaching || !_node ||
+      this->dataPtr->cachedShadowMaps.empty())
+  {
+    return;
+  }
+
+  Ogre::Aabb bounds;
+  bool valid = false;
+  MergeShadowCasterBounds(_node, bounds, valid);
+  if (valid)
+    this->dataPtr->shadowCasterChanges.push_back(bounds);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::UpdateShadowCache(Ogre::CompositorWorkspace *_workspace)
+{
+  const auto &cachedShadowMaps = this->dataPtr->cachedShadowMaps;
+  if (!this->dataPtr->shadowCaching || !_workspace ||
+      cachedShadowMaps.empty())
+  {
+    return;
+  }
+
+  Ogre::CompositorShadowNode *shadowNode =
+      _workspace->findShadowNode(this->dataPtr->kShadowNodeName);
+  if (!shadowNode)
+    return;
+
+  // each workspace has its own shadow node, with its own shadow maps
+  auto &cache = this->dataPtr->shadowNodeCaches[shadowNode->getId()];
+  cache.lastFrame = this->dataPtr->shadowCacheFrame;
+  cache.lights.resize(cachedShadowMaps.size(), nullptr);
+  cache.versions.resize(cachedShadowMaps.size(),
+      std::numeric_limits<uint64_t>::max());
+
+  for (size_t i = 0u; i < cachedShadowMaps.size(); ++i)
+  {
+    const auto &shadowMap = cachedShadowMaps[i];
+    if (cache.lights[i] != shadowMap.light)
+    {
+      shadowNode->setLightFixedToShadowMap(shadowMap.shadowMapIdx,
+          shadowMap.light);
+      cache.lights[i] = shadowMap.light;
+      cache.versions[i] = std::numeric_limits<uint64_t>::max();
+    }
+
+    if (cache.versions[i] != shadowMap.version)
+    {
+      shadowNode->setStaticShadowMapDirty(shadowMap.shadowMapIdx, false);
+      cache.versions[i] = shadowMap.version;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::SetShadowCachingEnabled(bool _enabled)
+{
+  if (this->dataPtr->shadowCaching == _enabled)
+    return;
+
+  // spot and point light shadow maps change technique
+  this->dataPtr->shadowCaching = _enabled;
+  this->SetShadowsDirty(true);
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Scene::ShadowCachingEnabled() const
+{
+  return this->dataPtr->shadowCaching;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::SetShadowMapRefreshBudget(unsigned int _budget)
+{
+  this->dataPtr->shadowMapRefreshBudget = _budget;
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2Scene::ShadowMapRefreshBudget() const
+{
+  return this->dataPtr->shadowMapRefreshBudget;
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::SetSkyEnabled(bool _enabled)
 {
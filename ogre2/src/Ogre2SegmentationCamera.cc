@@ -15,12 +15,26 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Threading/OgreUniformScalableTask.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
 
 #include <gz/common/Console.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Matrix4.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2Camera.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2Includes.hh"
@@ -34,6 +48,7 @@
 #include "gz/rendering/Utils.hh"
 
 #include "Ogre2SegmentationMaterialSwitcher.hh"
+#include "Ogre2TextureReadback.hh"
 
 /// \brief Private data for the Ogre2SegmentationCamera class
 class gz::rendering::Ogre2SegmentationCameraPrivate
@@ -70,6 +85,64 @@ class gz::rendering::Ogre2SegmentationCameraPrivate
   /// with colored version for segmentation
   public: std::unique_ptr<Ogre2SegmentationMaterialSwitcher>
           materialSwitcher {nullptr};
+
+  /// \brief Reads back the segmentation texture from the GPU
+  public: Ogre2TextureReadback readback;
+
+  /// \brief Decode the rows of a band of the colored map into the label map
+  /// \param[in] _band Index of the band
+  /// \param[in] _bandCount Number of bands the image is split into
+  public: void DecodeBand(size_t _band, size_t _bandCount) const;
+
+  /// \brief Color ids of the colored map, sorted, used to decode it.
+  /// This is a compact copy of the material switcher's color to label map.
+  public: std::vector<uint32_t> decodeColors;
+
+  /// \brief Label map pixel of each color in decodeColors, with its three
+  /// channels packed in the lower 24 bits
+  public: std::vector<uint32_t> decodePixels;
+
+  /// \brief Label map pixel of the colors that are not in decodeColors
+  public: uint32_t decodeBackground = 0u;
+
+  /// \brief Version of the material switcher's color to label map the
+  /// decode table was built from
+  public: uint64_t decodeVersion = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Segmentation type the decode table was built for
+  public: SegmentationType decodeType = SegmentationType::ST_SEMANTIC;
+
+  /// \brief Label map being written by DecodeBand
+  public: uint8_t *decodeOutput = nullptr;
+
+  /// \brief Width of the image being decoded
+  public: uint32_t decodeWidth = 0u;
+
+  /// \brief Height of the image being decoded
+  public: uint32_t decodeHeight = 0u;
+};
+
+/// \brief Decodes the colored map into the label map, with the rows of the
+/// image split in one band per worker thread
+class GZ_RENDERING_OGRE2_HIDDEN SegmentationDecodeTask final
+  : public Ogre::UniformScalableTask
+{
+  /// \brief Constructor
+  /// \param[in] _dataPtr Camera to decode the colored map of
+  public: explicit SegmentationDecodeTask(
+              const gz::rendering::Ogre2SegmentationCameraPrivate &_dataPtr)
+      : dataPtr(_dataPtr)
+  {
+  }
+
+  // Documentation inherited
+  public: void execute(size_t _threadId, size_t _numThreads) override
+  {
+    this->dataPtr.DecodeBand(_threadId, _numThreads);
+  }
+
+  /// \brief Camera to decode the colored map of
+  private: const gz::rendering::Ogre2SegmentationCameraPrivate &dataPtr;
 };
 
 using namespace gz;
@@ -114,6 +187,8 @@ void Ogre2SegmentationCamera::Destroy()
   if (!this->ogreCamera)
     return;
 
+  this->dataPtr->readback.Reset();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   auto ogreCompMgr = ogreRoot->getCompositorManager2();
@@ -254,6 +329,7 @@ void Ogre2SegmentationCamera::CreateSegmentationTexture()
 /////////////////////////////////////////////////
 void Ogre2SegmentationCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2SegmentationCamera::PostRender");
   // return if no one is listening to the new frame
   if (this->dataPtr->newSegmentationFrame.ConnectionCount() == 0)
     return;
@@ -267,34 +343,26 @@ void Ogre2SegmentationCamera::PostRender()
   const auto bytesPerChannel = PixelUtil::BytesPerChannel(format);
   const auto bufferSize = len * channelCount * bytesPerChannel;
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreSegmentationTexture, 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
+  this->dataPtr->readback.SetLatency(this->ReadbackLatency());
+  Ogre::TextureBox box;
+  if (!this->dataPtr->readback.Read(
+      this->dataPtr->ogreSegmentationTexture, box))
+  {
+    return;
+  }
+  this->readbackFrameId = this->dataPtr->readback.FrameId();
+  this->readbackFrameTime = this->dataPtr->readback.FrameTime();
 
   if (!this->dataPtr->buffer)
   {
     this->dataPtr->buffer = new uint8_t[bufferSize];
   }
 
-  uint8_t *bufferTmp = static_cast<uint8_t*>(box.data);
-
-  auto rawChannelCount = 4u;
-
-  for (unsigned int row = 0; row < height; ++row)
-  {
-    unsigned int rawDataRowIdx = row * box.bytesPerRow / bytesPerChannel;
-    for (unsigned int column = 0; column < width; ++column)
-    {
-      unsigned int idx = (row * width * channelCount) +
-          column * channelCount;
-      unsigned int rawIdx = rawDataRowIdx +
-          column * rawChannelCount;
-
-      this->dataPtr->buffer[idx] = bufferTmp[rawIdx];
-      this->dataPtr->buffer[idx + 1] = bufferTmp[rawIdx + 1];
-      this->dataPtr->buffer[idx + 2] = bufferTmp[rawIdx + 2];
-    }
-  }
+  // raw gpu texture format is RGBA8
+  PixelUtil::Convert(box.data, PF_R8G8B8A8,
+      static_cast<unsigned int>(box.bytesPerRow), this->dataPtr->buffer,
+      format, 0u, width, height);
+  this->dataPtr->readback.Unmap();
 
   this->dataPtr->newSegmentationFrame(
     this->dataPtr->buffer,
@@ -314,6 +382,7 @@ gz::common::ConnectionPtr
 /////////////////////////////////////////////////
 void Ogre2SegmentationCamera::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2SegmentationCamera::Render");
   // update the compositors
   this->scene->StartRendering(this->ogreCamera);
 
@@ -353,6 +422,47 @@ void Ogre2SegmentationCamera::SetBackgroundLabel(int _label)
     math::Color(_label / 255.0, _label / 255.0, _label / 255.0));
 }
 
+/////////////////////////////////////////////////
+void Ogre2SegmentationCameraPrivate::DecodeBand(size_t _band,
+  size_t _bandCount) const
+{
+  const size_t firstRow = this->decodeHeight * _band / _bandCount;
+  const size_t endRow = this->decodeHeight * (_band + 1u) / _bandCount;
+  const size_t begin = firstRow * this->decodeWidth * 3u;
+  const size_t end = endRow * this->decodeWidth * 3u;
+
+  const uint8_t *input = this->buffer;
+  uint8_t *output = this->decodeOutput;
+  const auto colorsBegin = this->decodeColors.begin();
+  const auto colorsEnd = this->decodeColors.end();
+
+  // Neighboring pixels mostly belong to the same object, so the table is
+  // only searched when the color changes. No 24 bit color has this value.
+  uint32_t lastColor = std::numeric_limits<uint32_t>::max();
+  uint32_t lastPixel = this->decodeBackground;
+  for (size_t index = begin; index < end; index += 3u)
+  {
+    // get color 24 bit unique id, the buffer is in range [0-255] already
+    uint32_t colorId = (static_cast<uint32_t>(input[index]) << 16) |
+        (static_cast<uint32_t>(input[index + 1]) << 8) |
+        static_cast<uint32_t>(input[index + 2]);
+
+    if (colorId != lastColor)
+    {
+      lastColor = colorId;
+      auto it = std::lower_bound(colorsBegin, colorsEnd, colorId);
+      if (it != colorsEnd && *it == colorId)
+        lastPixel = this->decodePixels[it - colorsBegin];
+      else
+        lastPixel = this->decodeBackground;
+    }
+
+    output[index] = static_cast<uint8_t>(lastPixel);
+    output[index + 1] = static_cast<uint8_t>(lastPixel >> 8);
+    output[index + 2] = static_cast<uint8_t>(lastPixel >> 16);
+  }
+}
+
 /////////////////////////////////////////////////
 void Ogre2SegmentationCamera::LabelMapFromColoredBuffer(
   uint8_t * _labelBuffer) const
@@ -363,61 +473,67 @@ void Ogre2SegmentationCamera::LabelMapFromColoredBuffer(
   if (!this->dataPtr->buffer)
     return;
 
-  auto colorToLabel = this->dataPtr->materialSwitcher->ColorToLabel();
-
-  auto width = this->ImageWidth();
-  auto height = this->ImageHeight();
+  // background pixels have the background label in all channels
+  const uint32_t background = static_cast<uint8_t>(this->backgroundLabel);
+  this->dataPtr->decodeBackground =
+      background | (background << 8) | (background << 16);
 
-  for (uint32_t i = 0; i < height; ++i)
+  // The color to label map only changes when objects are added, removed or
+  // relabeled. Rebuild the sorted decode table when it does.
+  const auto &switcher = this->dataPtr->materialSwitcher;
+  if (this->dataPtr->decodeVersion != switcher->ColorToLabelVersion() ||
+      this->dataPtr->decodeType != this->type)
   {
-    for (uint32_t j = 0; j < width; ++j)
-    {
-      auto index = (i * width + j) * 3;
-      auto r = this->dataPtr->buffer[index];
-      auto g = this->dataPtr->buffer[index + 1];
-      auto b = this->dataPtr->buffer[index + 2];
-
-      // get color 24 bit unique id, we don't multiply it by 255 like before
-      // as they are not normalized we read it from the buffer in
-      // range [0-255] already
-      int64_t colorId = r * 256 * 256 + g * 256 + b;
-
-      // initialize the pixel with the background label value
-      _labelBuffer[index] = this->backgroundLabel;
-      _labelBuffer[index + 1] = this->backgroundLabel;
-      _labelBuffer[index + 2] = this->backgroundLabel;
-
-      // skip if not exist
-      auto it = colorToLabel.find(colorId);
-      if (it == colorToLabel.end())
-        continue;
-
-      int64_t label = it->second;
+    this->dataPtr->decodeVersion = switcher->ColorToLabelVersion();
+    this->dataPtr->decodeType = this->type;
 
+    std::vector<std::pair<uint32_t, uint32_t>> table;
+    for (const auto &colorLabel : switcher->ColorToLabel())
+    {
+      int64_t label = colorLabel.second;
+      uint32_t pixel = 0u;
       if (this->type == SegmentationType::ST_SEMANTIC)
       {
-        uint8_t label8bit = label % 256;
-
-        _labelBuffer[index] = label8bit;
-        _labelBuffer[index + 1] = label8bit;
-        _labelBuffer[index + 2] = label8bit;
+        uint32_t label8bit = static_cast<uint32_t>(label % 256);
+        pixel = label8bit | (label8bit << 8) | (label8bit << 16);
       }
       else if (this->type == SegmentationType::ST_PANOPTIC)
       {
         // get the label and instance counts from the composite label id
-        uint8_t label8bit = label / (256 * 256);
-        // get the rest 16 bit
-        uint16_t instanceCount = label % (256 * 256);
-        // composite that 16 bit count to two 8 bit channels
-        uint8_t instanceCount1 = instanceCount / 256;
-        uint8_t instanceCount2 = instanceCount % 256;
-
-        _labelBuffer[index + 2] = label8bit;
-        _labelBuffer[index + 1] = instanceCount1;
-        _labelBuffer[index] = instanceCount2;
+        uint32_t label8bit = static_cast<uint32_t>(label / (256 * 256)) & 0xFF;
+        // get the rest 16 bit, composited to two 8 bit channels
+        uint32_t instanceCount = static_cast<uint32_t>(label % (256 * 256));
+        pixel = instanceCount | (label8bit << 16);
+      }
+      else
+      {
+        continue;
       }
+      table.push_back({static_cast<uint32_t>(colorLabel.first), pixel});
+    }
+    std::sort(table.begin(), table.end());
+
+    this->dataPtr->decodeColors.resize(table.size());
+    this->dataPtr->decodePixels.resize(table.size());
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+      this->dataPtr->decodeColors[i] = table[i].first;
+      this->dataPtr->decodePixels[i] = table[i].second;
     }
   }
+
+  this->dataPtr->decodeOutput = _labelBuffer;
+  this->dataPtr->decodeWidth = this->ImageWidth();
+  this->dataPtr->decodeHeight = this->ImageHeight();
+
+  SegmentationDecodeTask task(*this->dataPtr);
+  Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
+  if (ogreSceneManager->getNumWorkerThreads() > 1u)
+    ogreSceneManager->executeUserScalableTask(&task, true);
+  else
+    task.execute(0u, 1u);
+
+  this->dataPtr->decodeOutput = nullptr;
 }
 
 //////////////////////////////////////////////////
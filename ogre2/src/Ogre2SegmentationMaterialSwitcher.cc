@@ -18,17 +18,22 @@
 #include "Ogre2SegmentationMaterialSwitcher.hh"
 
 #include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
 
 #include "gz/rendering/ogre2/Ogre2Heightmap.hh"
+#include "gz/rendering/ogre2/Ogre2Node.hh"
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 #include "gz/rendering/RenderTypes.hh"
 
+#include "Ogre2TextBatch.hh"
 #include "Terra/Terra.h"
 
 #ifdef _MSC_VER
@@ -61,41 +66,86 @@ Ogre2SegmentationMaterialSwitcher::~Ogre2SegmentationMaterialSwitcher()
 }
 
 /////////////////////////////////////////////////
-bool Ogre2SegmentationMaterialSwitcher::IsTakenColor(const math::Color &_color)
+int Ogre2SegmentationMaterialSwitcher::LabelForVisual(
+  const VisualPtr &_visual) const
 {
-  // Get the int value of the 24 bit color
-  // Multiply by 255 as color values are normalized
-  int64_t colorId = static_cast<int64_t>((_color.R() * 255) * 256 * 256 +
-    (_color.G() * 255) * 256 + (_color.B() * 255));
-
-  if (this->takenColors.count(colorId))
+  // get class user data
+  Variant labelAny = _visual->UserData("label");
+  try
   {
-    return true;
+    return std::get<int>(labelAny);
   }
-  else
+  catch (std::bad_variant_access &)
   {
-    this->takenColors.insert(colorId);
-    return false;
+    // items with no class are considered background
+    return this->segmentationCamera->BackgroundLabel();
   }
 }
 
 /////////////////////////////////////////////////
-Ogre::Vector4 Ogre2SegmentationMaterialSwitcher::ColorForVisual(
-  const VisualPtr &_visual, std::string &_prevParentName)
+Ogre2SegmentationMaterialSwitcher::VisualColor *
+Ogre2SegmentationMaterialSwitcher::FindVisualColor(unsigned int _visualId,
+  const Ogre::Node *_node, const Ogre::Node *_rootNode, bool &_pending)
 {
-  // get class user data
-  Variant labelAny = _visual->UserData("label");
-  int label;
-  try
+  _pending = false;
+
+  auto it = this->visualColors.find(_visualId);
+  VisualPtr visual;
+  if (it != this->visualColors.end())
+    visual = it->second.visual.lock();
+  if (!visual)
   {
-    label = std::get<int>(labelAny);
+    try
+    {
+      visual = this->scene->VisualById(_visualId);
+    }
+    catch(Ogre::Exception &e)
+    {
+      gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
+    }
+    if (!visual)
+      return nullptr;
   }
-  catch (std::bad_variant_access &)
+
+  // The ogre nodes mirror the visual tree, walking them up to the top level
+  // model is much cheaper than walking the visuals
+  const Ogre::Node *topNode = _node;
+  while (topNode && topNode->getParent() && topNode->getParent() != _rootNode)
+    topNode = topNode->getParent();
+
+  const int label = this->LabelForVisual(visual);
+
+  if (it == this->visualColors.end())
   {
-    // items with no class are considered background
-    label = this->segmentationCamera->BackgroundLabel();
+    it = this->visualColors.emplace(_visualId, VisualColor()).first;
+    _pending = true;
+  }
+  else if (it->second.label != label || it->second.topNode != topNode)
+  {
+    _pending = true;
   }
 
+  VisualColor &entry = it->second;
+  if (entry.frame != this->frame)
+  {
+    entry.frame = this->frame;
+    ++this->seenVisuals;
+  }
+  if (_pending)
+  {
+    entry.visual = visual;
+    entry.label = label;
+    entry.topNode = topNode;
+    entry.parentName = this->TopLevelModelVisual(visual)->Name();
+  }
+  return &entry;
+}
+
+/////////////////////////////////////////////////
+void Ogre2SegmentationMaterialSwitcher::ColorForVisual(VisualColor &_entry)
+{
+  const int label = _entry.label;
+
   // sub item custom parameter to set the pixel color material
   Ogre::Vector4 customParameter;
 
@@ -104,8 +154,16 @@ Ogre::Vector4 Ogre2SegmentationMaterialSwitcher::ColorForVisual(
   {
     if (this->segmentationCamera->IsColoredMap())
     {
-      // semantic material (each pixel has item's color)
-      math::Color color = this->LabelToColor(label);
+      // semantic material (each pixel has item's color). All items with
+      // the same label have the same color
+      auto it = this->labelColors.find(label);
+      if (it == this->labelColors.end())
+      {
+        int64_t colorId;
+        it = this->labelColors.emplace(label,
+            this->LabelToColor(label, colorId)).first;
+      }
+      const math::Color &color = it->second;
       customParameter = Ogre::Vector4(color.R(), color.G(), color.B(), 1.0);
     }
     else
@@ -117,40 +175,41 @@ Ogre::Vector4 Ogre2SegmentationMaterialSwitcher::ColorForVisual(
   }
   else if (this->segmentationCamera->Type() == SegmentationType::ST_PANOPTIC)
   {
-    auto itemName = _visual->Name();
-    std::string parentName = this->TopLevelModelVisual(_visual)->Name();
-
-    auto it = this->instancesCount.find(label);
-    if (it == this->instancesCount.end())
-      it = this->instancesCount.insert(std::make_pair(label, 0)).first;
-
-    // Multi link model has many links with the same first name and should
-    // have the same pixels color
-    bool isMultiLink = false;
-    if (parentName == _prevParentName)
+    // Multi link model has many links with the same top level model and
+    // should have the same pixels color, so instances are given per model
+    auto key = std::make_pair(_entry.parentName, label);
+    auto it = this->modelInstances.find(key);
+    bool newInstance = it == this->modelInstances.end();
+    if (newInstance)
     {
-      isMultiLink = true;
-    }
-    else
-    {
-      it->second++;
-      _prevParentName = parentName;
+      it = this->modelInstances.emplace(key, ModelInstance()).first;
+      it->second.instance = ++this->instancesCount[label];
     }
+    ModelInstance &model = it->second;
 
-    const int instanceCount = it->second;
+    const int instanceCount = model.instance;
 
     if (this->segmentationCamera->IsColoredMap())
     {
       math::Color color;
       if (label == this->segmentationCamera->BackgroundLabel())
       {
-        color = this->LabelToColor(label, isMultiLink);
+        color = this->segmentationCamera->BackgroundColor();
       }
       else
       {
         // convert 24 bit number to int64
         const int compositeId = label * 256 * 256 + instanceCount;
-        color = this->LabelToColor(compositeId, isMultiLink);
+        if (newInstance)
+        {
+          color = this->LabelToColor(compositeId, model.colorId);
+        }
+        else
+        {
+          color.Set(((model.colorId >> 16) & 0xFF) / 255.0f,
+              ((model.colorId >> 8) & 0xFF) / 255.0f,
+              (model.colorId & 0xFF) / 255.0f);
+        }
       }
 
       customParameter = Ogre::Vector4(color.R(), color.G(), color.B(), 1.0);
@@ -167,13 +226,14 @@ Ogre::Vector4 Ogre2SegmentationMaterialSwitcher::ColorForVisual(
     }
   }
 
-  return customParameter;
+  _entry.customParameter = customParameter;
 }
 
 /////////////////////////////////////////////////
 math::Color Ogre2SegmentationMaterialSwitcher::LabelToColor(int64_t _label,
-  bool _isMultiLink)
+  int64_t &_colorId)
 {
+  _colorId = -1;
   if (_label == this->segmentationCamera->BackgroundLabel())
     return this->segmentationCamera->BackgroundColor();
 
@@ -181,37 +241,26 @@ math::Color Ogre2SegmentationMaterialSwitcher::LabelToColor(int64_t _label,
   this->generator.seed(_label);
   std::uniform_int_distribution<int> distribution(0, 255);
 
-  // random color
-  int r = distribution(this->generator);
-  int g = distribution(this->generator);
-  int b = distribution(this->generator);
-
-  math::Color color(
-    static_cast<float>(r / 255.0f),
-    static_cast<float>(g / 255.0f),
-    static_cast<float>(b / 255.0f));
-
-  // if the label is colored before return the color
-  // don't check for taken colors in that case, all items
-  // with the same label will have the same color
-  if (this->segmentationCamera->Type() == SegmentationType::ST_SEMANTIC &&
-    this->coloredLabel.count(_label))
-    return color;
-
-  if (_isMultiLink)
-    return color;
-
-  // loop recursivly till finding a unique color
-  if (this->IsTakenColor(color))
-      return this->LabelToColor(_label);
-
-  this->coloredLabel.insert(_label);
-
-  // We don't multiply by 255 here as (r,g,b) are in [0-255] range
-  int64_t colorId = r * 256 * 256 + g * 256 + b;
-  this->colorToLabel[colorId] = _label;
+  // draw random colors till finding a unique one
+  while (true)
+  {
+    int r = distribution(this->generator);
+    int g = distribution(this->generator);
+    int b = distribution(this->generator);
 
-  return color;
+    // We don't multiply by 255 here as (r,g,b) are in [0-255] range
+    int64_t colorId = r * 256 * 256 + g * 256 + b;
+    if (this->takenColors.insert(colorId).second)
+    {
+      this->colorToLabel[colorId] = _label;
+      ++this->colorToLabelVersion;
+      _colorId = colorId;
+      return math::Color(
+        static_cast<float>(r / 255.0f),
+        static_cast<float>(g / 255.0f),
+        static_cast<float>(b / 255.0f));
+    }
+  }
 }
 
 ////////////////////////////////////////////////
@@ -226,37 +275,170 @@ VisualPtr Ogre2SegmentationMaterialSwitcher::TopLevelModelVisual(
   return p;
 }
 
+////////////////////////////////////////////////
+void Ogre2SegmentationMaterialSwitcher::CheckRegistrySettings()
+{
+  const SegmentationType type = this->segmentationCamera->Type();
+  const bool coloredMap = this->segmentationCamera->IsColoredMap();
+  const int backgroundLabel = this->segmentationCamera->BackgroundLabel();
+  const math::Color backgroundColor =
+      this->segmentationCamera->BackgroundColor();
+
+  if (type == this->registryType && coloredMap == this->registryColoredMap &&
+      backgroundLabel == this->registryBackgroundLabel &&
+      backgroundColor == this->registryBackgroundColor)
+  {
+    return;
+  }
+
+  this->registryType = type;
+  this->registryColoredMap = coloredMap;
+  this->registryBackgroundLabel = backgroundLabel;
+  this->registryBackgroundColor = backgroundColor;
+
+  this->visualColors.clear();
+  this->modelInstances.clear();
+  this->labelColors.clear();
+  this->instancesCount.clear();
+  this->takenColors.clear();
+  this->colorToLabel.clear();
+  ++this->colorToLabelVersion;
+}
+
+////////////////////////////////////////////////
+void Ogre2SegmentationMaterialSwitcher::PruneRegistry()
+{
+  for (auto it = this->visualColors.begin(); it != this->visualColors.end();)
+  {
+    if (it->second.frame != this->frame)
+      it = this->visualColors.erase(it);
+    else
+      ++it;
+  }
+
+  // release the instances, and their colors, that no visual uses anymore.
+  // Instance numbers are not reused so the remaining models keep theirs.
+  std::set<std::pair<std::string, int>> usedModels;
+  for (const auto &visualColor : this->visualColors)
+  {
+    usedModels.insert(std::make_pair(visualColor.second.parentName,
+        visualColor.second.label));
+  }
+  for (auto it = this->modelInstances.begin();
+       it != this->modelInstances.end();)
+  {
+    if (usedModels.count(it->first))
+    {
+      ++it;
+      continue;
+    }
+    if (it->second.colorId >= 0)
+    {
+      this->takenColors.erase(it->second.colorId);
+      this->colorToLabel.erase(it->second.colorId);
+      ++this->colorToLabelVersion;
+    }
+    it = this->modelInstances.erase(it);
+  }
+}
+
 ////////////////////////////////////////////////
 void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
     Ogre::Camera * /*_cam*/)
 {
-  this->colorToLabel.clear();
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
 
   auto engine = Ogre2RenderEngine::Instance();
   engine->SetGzOgreRenderingMode(GORM_SOLID_COLOR);
 
-  // Used for multi-link models, where each model has many ogre items but
-  // belongs to the same object, and all of them has the same parent name
-  std::string prevParentName = "";
+  // text batches belong to no visual, keep them out of the label map
+  Ogre2TextBatch::SetHiddenAll(this->scene->OgreSceneManager(), true);
+
+  this->CheckRegistrySettings();
+  ++this->frame;
+  this->seenVisuals = 0u;
 
-  // Store the ogre objects in a vector
-  std::vector<Ogre::MovableObject *> ogreObjects;
+  const Ogre::Node *rootNode = nullptr;
+  Ogre2NodePtr rootVisual =
+      std::dynamic_pointer_cast<Ogre2Node>(this->scene->RootVisual());
+  if (rootVisual)
+    rootNode = rootVisual->Node();
+
+  // Colors are kept from frame to frame, only the visuals that are new or
+  // whose label or top level model changed are colored
+  this->frameItems.clear();
+  this->pendingItems.clear();
   while (itor.hasMoreElements())
   {
     Ogre::MovableObject *object = itor.peekNext();
-    ogreObjects.push_back(object);
+    Ogre::Item *item = static_cast<Ogre::Item *>(object);
     itor.moveNext();
+
+    // get visual from ogre item
+    Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+      continue;
+
+    // get visual id for the ogre item
+    auto visualId = Ogre::any_cast<unsigned int>(userAny);
+
+    bool pending = false;
+    VisualColor *entry = this->FindVisualColor(visualId,
+        item->getParentNode(), rootNode, pending);
+    if (!entry)
+      continue;
+
+    this->frameItems.push_back({item, entry});
+    if (pending)
+      this->pendingItems.push_back({item, entry});
   }
 
-  // Sort the ogre objects by name
-  // The algorithm of handeling multi-link models depends on a sorted objects
-  // by name, so all links that belongs to the same object come in order
-  std::sort(ogreObjects.begin(), ogreObjects.end(),
-    [] (Ogre::MovableObject * object1, Ogre::MovableObject * object2) {
-      return object1->getName() > object2->getName();
-  });
+  // Do the same with heightmaps / terrain
+  std::vector<std::pair<Ogre2HeightmapPtr, VisualColor *>> heightmapColors;
+  auto heightmaps = this->scene->Heightmaps();
+  for (auto h : heightmaps)
+  {
+    auto heightmap = h.lock();
+    if (!heightmap)
+      continue;
+
+    Ogre2NodePtr visual =
+        std::dynamic_pointer_cast<Ogre2Node>(heightmap->Parent());
+    if (!visual)
+      continue;
+
+    bool pending = false;
+    VisualColor *entry = this->FindVisualColor(visual->Id(), visual->Node(),
+        rootNode, pending);
+    if (!entry)
+      continue;
+
+    heightmapColors.push_back({heightmap, entry});
+    if (pending)
+      this->pendingItems.push_back({nullptr, entry});
+  }
+
+  if (this->visualColors.size() > this->seenVisuals)
+    this->PruneRegistry();
+
+  // Color the new visuals in the same order as the whole scene used to be
+  // colored, sorted by name, so instances and colors only depend on the
+  // order objects are added in
+  if (!this->pendingItems.empty())
+  {
+    std::stable_sort(this->pendingItems.begin(), this->pendingItems.end(),
+      [] (const std::pair<Ogre::Item *, VisualColor *> &_a,
+          const std::pair<Ogre::Item *, VisualColor *> &_b)
+      {
+        // heightmaps come last
+        if (!_a.first || !_b.first)
+          return _a.first && !_b.first;
+        return _a.first->getName() > _b.first->getName();
+      });
+    for (auto &pendingItem : this->pendingItems)
+      this->ColorForVisual(*pendingItem.second);
+  }
 
   this->materialMap.clear();
   this->datablockMap.clear();
@@ -270,123 +452,91 @@ void Ogre2SegmentationMaterialSwitcher::cameraPreRenderScene(
   const Ogre::HlmsBlendblock *noBlend =
     hlmsManager->getBlendblock(Ogre::HlmsBlendblock());
 
-  for (auto object : ogreObjects)
+  for (const auto &frameItem : this->frameItems)
   {
-    Ogre::Item *item = static_cast<Ogre::Item *>(object);
-
-    // get visual from ogre item
-    Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
-
-    if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
+    Ogre::Item *item = frameItem.first;
+    const Ogre::Vector4 &customParameter = frameItem.second->customParameter;
+    const size_t numSubItems = item->getNumSubItems();
+    for (size_t i = 0; i < numSubItems; ++i)
     {
-      // get visual id for the ogre item
-      auto visualId = Ogre::any_cast<unsigned int>(userAny);
-
-      VisualPtr visual;
-      try
-      {
-        visual = this->scene->VisualById(visualId);
-      }
-      catch(Ogre::Exception &e)
-      {
-        gzerr << "Ogre Error:" << e.getFullDescription() << "\n";
-      }
-
-      const Ogre::Vector4 customParameter =
-        ColorForVisual(visual, prevParentName);
+      // Set the custom value to the sub item to render
+      Ogre::SubItem *subItem = item->getSubItem(i);
+      subItem->setCustomParameter(1, customParameter);
 
-      const size_t numSubItems = item->getNumSubItems();
-      for (size_t i = 0; i < numSubItems; ++i)
+      if (!subItem->getMaterial().isNull())
       {
-        // Set the custom value to the sub item to render
-        Ogre::SubItem *subItem = item->getSubItem(i);
-        subItem->setCustomParameter(1, customParameter);
-
-        if (!subItem->getMaterial().isNull())
+        this->materialMap.push_back({ subItem, subItem->getMaterial() });
+
+        // We need to keep the material's vertex shader
+        // to keep vertex deformation consistent; so we use
+        // a cloned material with a different pixel shader
+        // https://github.com/gazebosim/gz-rendering/issues/544
+        //
+        // material may be a nullptr if we called setMaterial directly
+        // (i.e. it's not using Ogre2Material interface).
+        // In those cases we fallback to PBS in the current GORM mode.
+        auto material = Ogre::MaterialManager::getSingleton().getByName(
+          subItem->getMaterial()->getName() + "_solid",
+          Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        if (material)
         {
-          this->materialMap.push_back({ subItem, subItem->getMaterial() });
-
-          // We need to keep the material's vertex shader
-          // to keep vertex deformation consistent; so we use
-          // a cloned material with a different pixel shader
-          // https://github.com/gazebosim/gz-rendering/issues/544
-          //
-          // material may be a nullptr if we called setMaterial directly
-          // (i.e. it's not using Ogre2Material interface).
-          // In those cases we fallback to PBS in the current GORM mode.
-          auto material = Ogre::MaterialManager::getSingleton().getByName(
-            subItem->getMaterial()->getName() + "_solid",
-            Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-          if (material)
+          if (material->getLoadingState() ==
+              Ogre::Resource::LOADSTATE_UNLOADED)
           {
-            if (material->getLoadingState() ==
-                Ogre::Resource::LOADSTATE_UNLOADED)
-            {
-              // Manually defined materials like PointCloudPoint_solid need this
-              material->load();
-            }
-
-            if (material->getNumSupportedTechniques() > 0u)
-            {
-              subItem->setMaterial(material);
-            }
+            // Manually defined materials like PointCloudPoint_solid need this
+            material->load();
           }
-          else
+
+          if (material->getNumSupportedTechniques() > 0u)
           {
-            // The supplied vertex shader could not pair with the
-            // pixel shader we provide. Try to salvage the situation
-            // using PBS shader. Custom deformation won't work but
-            // if we're lucky that won't matter
-            subItem->setDatablock(defaultPbs);
+            subItem->setMaterial(material);
           }
         }
         else
         {
-          Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-          const Ogre::HlmsBlendblock *blendblock = datablock->getBlendblock();
-
-          // We can't do any sort of blending. This isn't colour what we're
-          // storing, but rather an ID.
-          if (blendblock->mSourceBlendFactor != Ogre::SBF_ONE ||
-              blendblock->mDestBlendFactor != Ogre::SBF_ZERO ||
-              blendblock->mBlendOperation != Ogre::SBO_ADD ||
-              (blendblock->mSeparateBlend &&
-               (blendblock->mSourceBlendFactorAlpha != Ogre::SBF_ONE ||
-                blendblock->mDestBlendFactorAlpha != Ogre::SBF_ZERO ||
-                blendblock->mBlendOperationAlpha != Ogre::SBO_ADD)))
-          {
-            hlmsManager->addReference(blendblock);
-            this->datablockMap[datablock] = blendblock;
-            datablock->setBlendblock(noBlend);
-          }
+          // The supplied vertex shader could not pair with the
+          // pixel shader we provide. Try to salvage the situation
+          // using PBS shader. Custom deformation won't work but
+          // if we're lucky that won't matter
+          subItem->setDatablock(defaultPbs);
+        }
+      }
+      else
+      {
+        Ogre::HlmsDatablock *datablock = subItem->getDatablock();
+        const Ogre::HlmsBlendblock *blendblock = datablock->getBlendblock();
+
+        // We can't do any sort of blending. This isn't colour what we're
+        // storing, but rather an ID.
+        if (blendblock->mSourceBlendFactor != Ogre::SBF_ONE ||
+            blendblock->mDestBlendFactor != Ogre::SBF_ZERO ||
+            blendblock->mBlendOperation != Ogre::SBO_ADD ||
+            (blendblock->mSeparateBlend &&
+             (blendblock->mSourceBlendFactorAlpha != Ogre::SBF_ONE ||
+              blendblock->mDestBlendFactorAlpha != Ogre::SBF_ZERO ||
+              blendblock->mBlendOperationAlpha != Ogre::SBO_ADD)))
+        {
+          hlmsManager->addReference(blendblock);
+          this->datablockMap[datablock] = blendblock;
+          datablock->setBlendblock(noBlend);
         }
       }
     }
   }
 
-  // Do the same with heightmaps / terrain
-  auto heightmaps = this->scene->Heightmaps();
-  for (auto h : heightmaps)
+  for (const auto &heightmapColor : heightmapColors)
   {
-    auto heightmap = h.lock();
-    if (heightmap)
-    {
-      // TODO(anyone): Retrieve datablock and make sure it's not blending
-      // like we do with Items (it should be impossible?)
-      VisualPtr visual = heightmap->Parent();
-      const Ogre::Vector4 customParameter =
-        ColorForVisual(visual, prevParentName);
-      heightmap->Terra()->SetSolidColor(1u, customParameter);
-    }
+    // TODO(anyone): Retrieve datablock and make sure it's not blending
+    // like we do with Items (it should be impossible?)
+    heightmapColor.first->Terra()->SetSolidColor(1u,
+        heightmapColor.second->customParameter);
   }
 
   // Remove the reference count on noBlend we created
   hlmsManager->destroyBlendblock(noBlend);
 
-  // reset the count & colors tracking
-  this->instancesCount.clear();
-  this->takenColors.clear();
-  this->coloredLabel.clear();
+  this->frameItems.clear();
+  this->pendingItems.clear();
 }
 
 ////////////////////////////////////////////////
@@ -444,6 +594,7 @@ void Ogre2SegmentationMaterialSwitcher::cameraPostRenderScene(
       heightmap->Terra()->UnsetSolidColors();
   }
 
+  Ogre2TextBatch::SetHiddenAll(this->scene->OgreSceneManager(), false);
   engine->SetGzOgreRenderingMode(GORM_NORMAL);
 }
 
@@ -453,3 +604,9 @@ Ogre2SegmentationMaterialSwitcher::ColorToLabel() const
 {
   return this->colorToLabel;
 }
+
+////////////////////////////////////////////////
+uint64_t Ogre2SegmentationMaterialSwitcher::ColorToLabelVersion() const
+{
+  return this->colorToLabelVersion;
+}
@@ -18,6 +18,8 @@
 #ifndef GZ_RENDERING_OGRE2_OGRE2SEGMENTATIONMATERIALSWITCHER_HH_
 #define GZ_RENDERING_OGRE2_OGRE2SEGMENTATIONMATERIALSWITCHER_HH_
 
+#include <map>
+#include <memory>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -69,23 +71,75 @@ class GZ_RENDERING_OGRE2_VISIBLE Ogre2SegmentationMaterialSwitcher :
   /// \return The map between color and label IDs
   public: const std::unordered_map<int64_t, int64_t> &ColorToLabel() const;
 
-  /// \brief Create a color to apply for the given visual
-  /// \param[in] _visual Visual will be applying the color to
-  /// \param[in,out] _prevParentName A persistent string between call
-  /// to ensure multilink visuals receive the same color
-  /// \return The color to apply to the visual
-  private: Ogre::Vector4 ColorForVisual(const VisualPtr &_visual,
-                                        std::string &_prevParentName);
-
-  /// \brief Convert label of semantic map to a unique color for colored map and
-  /// add the color of the label to the taken colors if it doesn't exist
+  /// \brief Get a number that changes every time the map between color IDs
+  /// and label IDs changes, so users can cache data derived from it
+  /// \return Version of the map between color and label IDs
+  public: uint64_t ColorToLabelVersion() const;
+
+  /// \brief Color and custom parameter of a visual, kept from frame to
+  /// frame until the visual's label or top level model changes
+  private: struct VisualColor
+  {
+    /// \brief Visual the entry belongs to
+    std::weak_ptr<Visual> visual;
+
+    /// \brief Label the color was computed for
+    int label = 0;
+
+    /// \brief Ogre node of the top level model visual the color was
+    /// computed for
+    const Ogre::Node *topNode = nullptr;
+
+    /// \brief Name of the top level model visual
+    std::string parentName;
+
+    /// \brief Custom parameter to bind to the visual's sub items
+    Ogre::Vector4 customParameter;
+
+    /// \brief Last frame the visual was seen in
+    uint64_t frame = 0u;
+  };
+
+  /// \brief Instance assigned to a model in panoptic mode
+  private: struct ModelInstance
+  {
+    /// \brief Instance number, unique among the models with the same label
+    int instance = 0;
+
+    /// \brief Id of the color of the instance in colored maps, -1 if the
+    /// instance has no color of its own
+    int64_t colorId = -1;
+  };
+
+  /// \brief Get the label of a visual from its user data
+  /// \param[in] _visual Visual to get the label of
+  /// \return The label, or the background label if the visual has none
+  private: int LabelForVisual(const VisualPtr &_visual) const;
+
+  /// \brief Find the registry entry of a visual, updating it if the
+  /// visual's label or top level model changed since the last frame
+  /// \param[in] _visualId Id of the visual
+  /// \param[in] _node Ogre node of the visual
+  /// \param[in] _rootNode Ogre node of the root visual of the scene
+  /// \param[out] _pending Set to true if the entry was created or must be
+  /// recolored. The caller must then call ColorForVisual.
+  /// \return The entry, null if the visual does not exist
+  private: VisualColor *FindVisualColor(unsigned int _visualId,
+               const Ogre::Node *_node, const Ogre::Node *_rootNode,
+               bool &_pending);
+
+  /// \brief Create a color to apply for a visual and store it in its
+  /// registry entry
+  /// \param[in,out] _entry Registry entry of the visual
+  private: void ColorForVisual(VisualColor &_entry);
+
+  /// \brief Convert label of semantic map to a unique color for colored map.
+  /// The color is drawn from a generator seeded with the label, and drawn
+  /// again while it is taken by another label.
   /// \param[in] _label id of the semantic map or encoded id of panoptic map
-  /// \param[in] _isMultiLink bool used to skip the taken color check if the
-  /// label is for a multi link model (all links for the same model should have
-  /// the same color)
+  /// \param[out] _colorId Encoded id of the color, -1 for the background
   /// \return Unique color in the colored map for that label
-  private: math::Color LabelToColor(int64_t _label,
-    bool _isMultiLink = false);
+  private: math::Color LabelToColor(int64_t _label, int64_t &_colorId);
 
   /// \brief Get the top level model visual of a particular visual
   /// \param[in] _visual The visual who's top level model visual we are
@@ -93,15 +147,29 @@ class GZ_RENDERING_OGRE2_VISIBLE Ogre2SegmentationMaterialSwitcher :
   /// \return The top level model visual of _visual
   private: VisualPtr TopLevelModelVisual(VisualPtr _visual) const;
 
-  /// \brief Check if the color is already taken and add it to taken colors
-  /// if it does not exist
-  /// \param[in] _color Color to be checked
-  /// \return True if taken, False otherwise
-  private: bool IsTakenColor(const math::Color &_color);
+  /// \brief Remove the entries of visuals not seen in the current frame,
+  /// and the models and colors only they used
+  private: void PruneRegistry();
+
+  /// \brief Clear the registry if the camera settings it depends on changed
+  private: void CheckRegistrySettings();
 
   /// \brief A map of ogre sub item pointer to its original hlms maults to 10mK
   private: double resolution = 0.01;
 
+  /// \brief Registry of the colors of the visuals
+  /// Key: visual id, value: color of the visual
+  private: std::unordered_map<unsigned int, VisualColor> visualColors;
+
+  /// \brief Instances assigned to the models, in panoptic mode
+  /// Key: top level model name and label, value: instance of the model
+  private: std::map<std::pair<std::string, int>, ModelInstance>
+      modelInstances;
+
+  /// \brief Colors assigned to the labels, in semantic mode
+  /// Key: label, value: color of the label
+  private: std::unordered_map<int, math::Color> labelColors;
+
   /// \brief Keep track of num of instances of the same label
   /// Key: label id, value: num of instances
   private: std::unordered_map<int, unsigned int> instancesCount;
@@ -109,16 +177,41 @@ class GZ_RENDERING_OGRE2_VISIBLE Ogre2SegmentationMaterialSwitcher :
   /// \brief keep track of the random colors (store encoded id of r,g,b)
   private: std::unordered_set<int64_t> takenColors;
 
-  /// \brief keep track of the labels that are already colored.
-  /// Useful for coloring items in semantic mode in LabelToColor()
-  private: std::unordered_set<int64_t> coloredLabel;
-
   /// \brief Mapping from the colorId to the label id, used in converting
   /// the colored map to label ids map
   /// Key: colorId, value: label in case of semantic segmentation
   /// or composite id (8 bit label + 16 bit instances) in instance type
   private: std::unordered_map<int64_t, int64_t> colorToLabel;
 
+  /// \brief Incremented every time colorToLabel changes
+  private: uint64_t colorToLabelVersion = 0u;
+
+  /// \brief Frame counter used to find the visuals that were removed
+  private: uint64_t frame = 0u;
+
+  /// \brief Number of distinct visuals seen in the current frame
+  private: std::size_t seenVisuals = 0u;
+
+  /// \brief Segmentation type the registry was built for
+  private: SegmentationType registryType = SegmentationType::ST_SEMANTIC;
+
+  /// \brief Colored map setting the registry was built for
+  private: bool registryColoredMap = false;
+
+  /// \brief Background label the registry was built for
+  private: int registryBackgroundLabel = 0;
+
+  /// \brief Background color the registry was built for
+  private: math::Color registryBackgroundColor;
+
+  /// \brief Items found in the current frame and their registry entries,
+  /// reused every frame
+  private: std::vector<std::pair<Ogre::Item *, VisualColor *>> frameItems;
+
+  /// \brief Entries created or changed in the current frame, reused every
+  /// frame
+  private: std::vector<std::pair<Ogre::Item *, VisualColor *>> pendingItems;
+
   /// \brief A map of ogre datablock pointer to their original blendblocks
   private: std::unordered_map<Ogre::HlmsDatablock *,
       const Ogre::HlmsBlendblock *> datablockMap;
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreDataStream.h>
+#include <OgreGpuProgramManager.h>
+#include <OgreHlms.h>
+#include <OgreHlmsDiskCache.h>
+#include <OgreHlmsManager.h>
+#include <OgreRenderSystem.h>
+#include <OgreRenderSystemCapabilities.h>
+#include <OgreRoot.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "Ogre2ShaderCache.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Name of the file holding the microcode cache
+  const char kMicrocodeCacheFile[] = "microcodeCache.cache";
+
+  /// \brief Add data to a FNV-1a hash
+  /// \param[in] _hash Hash to update
+  /// \param[in] _data Data to add
+  /// \return Updated hash
+  uint64_t HashAppend(uint64_t _hash, const std::string &_data)
+  {
+    for (unsigned char c : _data)
+    {
+      _hash ^= c;
+      _hash *= 1099511628211ull;
+    }
+    return _hash;
+  }
+
+  /// \brief Initial value of a FNV-1a hash
+  const uint64_t kHashSeed = 14695981039346656037ull;
+
+  /// \brief Collect the files of a directory and its sub directories,
+  /// except textures
+  /// \param[in] _dir Directory to look into
+  /// \param[out] _files Paths of the files found
+  void CollectFiles(const std::string &_dir, std::vector<std::string> &_files)
+  {
+    common::DirIter endIter;
+    for (common::DirIter dirIter(_dir); dirIter != endIter; ++dirIter)
+    {
+      const std::string path = *dirIter;
+      if (common::isDirectory(path))
+      {
+        if (common::basename(path) != "textures")
+          CollectFiles(path, _files);
+      }
+      else if (common::isFile(path))
+      {
+        _files.push_back(path);
+      }
+    }
+  }
+
+  /// \brief Name of the file holding the cache of an Hlms
+  /// \param[in] _type Type of the Hlms
+  /// \return File name
+  std::string HlmsCacheFile(size_t _type)
+  {
+    return "hlmsDiskCache" + std::to_string(_type) + ".bin";
+  }
+
+  /// \brief Open a cache file for reading
+  /// \param[in] _path Path to the file
+  /// \return Stream, null if the file does not exist
+  Ogre::DataStreamPtr OpenCacheFile(const std::string &_path)
+  {
+    if (!common::isFile(_path))
+      return Ogre::DataStreamPtr();
+
+    // the stream owns the file and closes it when released
+    auto *file = OGRE_NEW_T(std::ifstream, Ogre::MEMCATEGORY_GENERAL)(
+        _path.c_str(), std::ios::in | std::ios::binary);
+    Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(
+        _path, file, true));
+    if (!file->is_open())
+      return Ogre::DataStreamPtr();
+    return stream;
+  }
+
+  /// \brief Write a cache file. The file is written under a temporary name
+  /// then renamed so that processes sharing the cache never read a
+  /// partially written file.
+  /// \param[in] _path Path to the file
+  /// \param[in] _write Function writing the cache to a stream
+  template <typename WriteFn>
+  void WriteCacheFile(const std::string &_path, WriteFn _write)
+  {
+    std::random_device rd;
+    std::stringstream tmpPath;
+    tmpPath << _path << ".tmp" << std::hex << rd();
+
+    {
+      auto *file = OGRE_NEW_T(std::fstream, Ogre::MEMCATEGORY_GENERAL)(
+          tmpPath.str().c_str(),
+          std::ios::out | std::ios::binary | std::ios::trunc);
+      Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(
+          tmpPath.str(), file, true));
+      if (!file->is_open())
+      {
+        gzwarn << "Unable to write shader cache file [" << tmpPath.str()
+               << "]" << std::endl;
+        return;
+      }
+      _write(stream);
+      stream->close();
+    }
+
+    if (std::rename(tmpPath.str().c_str(), _path.c_str()) != 0)
+    {
+      // rename does not replace existing files on windows
+      std::remove(_path.c_str());
+      if (std::rename(tmpPath.str().c_str(), _path.c_str()) != 0)
+        std::remove(tmpPath.str().c_str());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+Ogre2ShaderCache::Ogre2ShaderCache(const std::string &_path)
+  : path(_path)
+{
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2ShaderCache::HashSources(const std::string &_mediaPath)
+{
+  std::vector<std::string> files;
+  if (common::isDirectory(_mediaPath))
+    CollectFiles(_mediaPath, files);
+  std::sort(files.begin(), files.end());
+
+  uint64_t hash = kHashSeed;
+  for (const auto &file : files)
+  {
+    std::ifstream stream(file, std::ios::in | std::ios::binary);
+    if (!stream)
+      continue;
+    std::string content((std::istreambuf_iterator<char>(stream)),
+        std::istreambuf_iterator<char>());
+    // relative path so that the hash does not depend on the install prefix
+    hash = HashAppend(hash, file.substr(_mediaPath.size()));
+    hash = HashAppend(hash, content);
+  }
+  return hash;
+}
+
+//////////////////////////////////////////////////
+void Ogre2ShaderCache::Load(Ogre::Root *_root, const std::string &_mediaPath)
+{
+  if (this->path.empty() || !_root || !_root->getRenderSystem())
+    return;
+
+  Ogre::RenderSystem *renderSystem = _root->getRenderSystem();
+  const Ogre::RenderSystemCapabilities *caps =
+      renderSystem->getCapabilities();
+
+  // Compiled shaders are only valid for the same driver, and cached Hlms
+  // shaders for the same templates
+  std::stringstream key;
+  key << OGRE_VERSION_MAJOR << "." << OGRE_VERSION_MINOR << "."
+      << OGRE_VERSION_PATCH << "\n"
+      << renderSystem->getName() << "\n";
+  if (caps)
+  {
+    key << caps->getVendor() << "\n"
+        << caps->getDeviceName() << "\n"
+        << caps->getDriverVersion().toString() << "\n";
+  }
+  key << HashSources(_mediaPath);
+
+  std::stringstream dirName;
+  dirName << std::hex << std::setw(16) << std::setfill('0')
+          << HashAppend(kHashSeed, key.str());
+  this->keyedPath = common::joinPaths(this->path, dirName.str());
+
+  Ogre::GpuProgramManager &gpuProgramMgr =
+      Ogre::GpuProgramManager::getSingleton();
+  gpuProgramMgr.setSaveMicrocodesToCache(true);
+
+  try
+  {
+    Ogre::DataStreamPtr stream = OpenCacheFile(
+        common::joinPaths(this->keyedPath, kMicrocodeCacheFile));
+    if (stream)
+      gpuProgramMgr.loadMicrocodeCache(stream);
+  }
+  catch (Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to load shader microcode cache from ["
+           << this->keyedPath << "]: " << _e.what() << std::endl;
+  }
+
+  Ogre::HlmsManager *hlmsManager = _root->getHlmsManager();
+  Ogre::HlmsDiskCache diskCache(hlmsManager);
+  for (size_t i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    if (!hlms)
+      continue;
+
+    const std::string file =
+        common::joinPaths(this->keyedPath, HlmsCacheFile(i));
+    try
+    {
+      Ogre::DataStreamPtr stream = OpenCacheFile(file);
+      if (!stream)
+        continue;
+      diskCache.loadFrom(stream);
+      diskCache.applyTo(hlms);
+    }
+    catch (Ogre::Exception &_e)
+    {
+      gzwarn << "Unable to load Hlms shader cache [" << file << "]: "
+             << _e.what() << std::endl;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2ShaderCache::Save(Ogre::Root *_root)
+{
+  if (this->keyedPath.empty() || !_root || !_root->getRenderSystem() ||
+      !Ogre::GpuProgramManager::getSingletonPtr())
+  {
+    return;
+  }
+
+  if (!common::createDirectories(this->keyedPath))
+  {
+    gzwarn << "Unable to create shader cache directory ["
+           << this->keyedPath << "]" << std::endl;
+    return;
+  }
+
+  try
+  {
+    Ogre::HlmsManager *hlmsManager = _root->getHlmsManager();
+    Ogre::HlmsDiskCache diskCache(hlmsManager);
+    for (size_t i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+    {
+      Ogre::Hlms *hlms =
+          hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+      if (!hlms)
+        continue;
+
+      diskCache.copyFrom(hlms);
+      WriteCacheFile(common::joinPaths(this->keyedPath, HlmsCacheFile(i)),
+          [&diskCache](Ogre::DataStreamPtr &_stream)
+          {
+            diskCache.saveTo(_stream);
+          });
+    }
+
+    Ogre::GpuProgramManager &gpuProgramMgr =
+        Ogre::GpuProgramManager::getSingleton();
+    if (gpuProgramMgr.isCacheDirty())
+    {
+      WriteCacheFile(
+          common::joinPaths(this->keyedPath, kMicrocodeCacheFile),
+          [&gpuProgramMgr](Ogre::DataStreamPtr &_stream)
+          {
+            gpuProgramMgr.saveMicrocodeCache(_stream);
+          });
+    }
+  }
+  catch (Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to save shader cache to [" << this->keyedPath
+           << "]: " << _e.what() << std::endl;
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2SHADERCACHE_HH_
+#define GZ_RENDERING_OGRE2_OGRE2SHADERCACHE_HH_
+
+#include <cstdint>
+#include <string>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief On-disk cache of the Hlms shaders and of the compiled
+    /// microcode of all shaders, so that a new process does not compile
+    /// again the shaders a previous one already did.
+    ///
+    /// Caches are stored in a sub directory of the cache path named after
+    /// a hash of the ogre version, the render system, the GPU and driver
+    /// and the gz-rendering shader sources. A cache written by a different
+    /// build or on a different machine is therefore never loaded.
+    class Ogre2ShaderCache
+    {
+      /// \brief Constructor
+      /// \param[in] _path Directory the caches are stored in. Caching is
+      /// disabled if empty.
+      public: explicit Ogre2ShaderCache(const std::string &_path);
+
+      /// \brief Load the caches. Must be called after the Hlms are
+      /// registered and before any shader is compiled.
+      /// \param[in] _root Ogre root
+      /// \param[in] _mediaPath Path to the gz-rendering ogre2 media
+      public: void Load(Ogre::Root *_root, const std::string &_mediaPath);
+
+      /// \brief Save the caches. Must be called before the Hlms are
+      /// destroyed.
+      /// \param[in] _root Ogre root
+      public: void Save(Ogre::Root *_root);
+
+      /// \brief Hash the shader sources found in a media directory
+      /// \param[in] _mediaPath Path to the media directory
+      /// \return Hash of the file names and contents
+      public: static uint64_t HashSources(const std::string &_mediaPath);
+
+      /// \brief Directory the caches are stored in
+      private: std::string path;
+
+      /// \brief Sub directory of the current configuration, empty until
+      /// Load is called
+      private: std::string keyedPath;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,453 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Helpers.hh>
+
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+#include "gz/rendering/ogre2/Ogre2Material.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
+#include "gz/rendering/ogre2/Ogre2Text.hh"
+
+#include "Ogre2TextBatch.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Overlay/OgreFont.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Movable object without renderables that attaches a text to
+    /// the scene node of its visual. The glyphs are drawn by Ogre2TextBatch,
+    /// this object only provides the node, the visibility and the user data
+    /// of the text.
+    class Ogre2TextAnchor : public Ogre::MovableObject
+    {
+      /// \brief Constructor
+      /// \param[in] _sceneManager Scene manager to create the object in
+      public: explicit Ogre2TextAnchor(Ogre::SceneManager *_sceneManager)
+        : Ogre::MovableObject(Ogre::Id::generateNewId<Ogre::MovableObject>(),
+              &_sceneManager->_getEntityMemoryManager(Ogre::SCENE_DYNAMIC),
+              _sceneManager, 0u)
+      {
+        this->setLocalAabb(Ogre::Aabb::BOX_ZERO);
+      }
+
+      // Documentation inherited
+      public: const Ogre::String &getMovableType() const override
+      {
+        static const Ogre::String movableType = "Ogre2TextAnchor";
+        return movableType;
+      }
+    };
+    }
+  }
+}
+
+/// \brief Private data for the Ogre2Text class.
+class gz::rendering::Ogre2TextPrivate
+{
+  /// \brief Text material
+  public: Ogre2MaterialPtr material;
+
+  /// \brief Object attached to the node of the visual
+  public: std::unique_ptr<Ogre2TextAnchor> anchor;
+
+  /// \brief Batch drawing the text
+  public: std::shared_ptr<Ogre2TextBatch> batch;
+
+  /// \brief Glyphs and placement of the text, drawn by the batch
+  public: Ogre2TextInstance instance;
+
+  /// \brief Bounding box of the laid out glyphs
+  public: math::AxisAlignedBox aabb =
+      math::AxisAlignedBox(math::Vector3d::Zero, math::Vector3d::Zero);
+
+  /// \brief Visibility flags of the anchor the current batch was chosen
+  /// for. Texts with different flags are drawn by different batches so
+  /// camera visibility masks apply to them.
+  public: uint32_t visibilityFlags = 0u;
+
+  /// \brief True if the font or the show on top flag changed
+  public: bool batchDirty = true;
+
+  /// \brief True if the glyphs need to be laid out again
+  public: bool layoutDirty = true;
+
+  /// \brief True if the color changed
+  public: bool colorDirty = true;
+};
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+Ogre2Text::Ogre2Text()
+    : dataPtr(new Ogre2TextPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+Ogre2Text::~Ogre2Text()
+{
+  this->Destroy();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::Init()
+{
+  this->dataPtr->anchor = std::make_unique<Ogre2TextAnchor>(
+      this->scene->OgreSceneManager());
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::Destroy()
+{
+  if (this->dataPtr->batch)
+  {
+    this->dataPtr->batch->Remove(&this->dataPtr->instance);
+    this->dataPtr->batch.reset();
+  }
+
+  // once the scene is destroyed the memory of the anchor belongs to the
+  // destroyed scene manager
+  if (this->dataPtr->anchor &&
+      (!this->scene || !this->scene->IsInitialized()))
+  {
+    this->dataPtr->anchor.release();
+  }
+
+  if (this->dataPtr->anchor)
+  {
+    Ogre::SceneNode *node = this->dataPtr->anchor->getParentSceneNode();
+    if (node)
+      node->detachObject(this->dataPtr->anchor.get());
+    this->dataPtr->anchor.reset();
+  }
+
+  BaseText::Destroy();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::PreRender()
+{
+  BaseText::PreRender();
+
+  // the visual sets its visibility flags on the anchor
+  if (this->dataPtr->anchor &&
+      this->dataPtr->anchor->getVisibilityFlags() !=
+      this->dataPtr->visibilityFlags)
+  {
+    this->dataPtr->visibilityFlags =
+        this->dataPtr->anchor->getVisibilityFlags();
+    this->dataPtr->batchDirty = true;
+  }
+
+  if (this->dataPtr->batchDirty)
+  {
+    if (this->dataPtr->batch)
+      this->dataPtr->batch->Remove(&this->dataPtr->instance);
+    this->dataPtr->batch = Ogre2TextBatch::Get(
+        this->scene->OgreSceneManager(), this->fontName, this->onTop,
+        this->dataPtr->visibilityFlags);
+    if (this->dataPtr->batch)
+      this->dataPtr->batch->Add(&this->dataPtr->instance);
+    this->dataPtr->batchDirty = false;
+    this->dataPtr->layoutDirty = true;
+  }
+
+  auto &batch = this->dataPtr->batch;
+  if (!batch || !this->dataPtr->anchor)
+    return;
+
+  auto &instance = this->dataPtr->instance;
+  if (this->dataPtr->layoutDirty)
+  {
+    this->Layout();
+    this->dataPtr->layoutDirty = false;
+    batch->MarkDirty();
+  }
+
+  if (this->dataPtr->colorDirty)
+  {
+    const math::Color &c = this->color;
+    const float channels[4] = {c.R(), c.G(), c.B(), c.A()};
+    for (unsigned int i = 0u; i < 4u; ++i)
+    {
+      instance.color[i] = static_cast<uint8_t>(
+          std::round(math::clamp(channels[i], 0.0f, 1.0f) * 255.0f));
+    }
+    this->dataPtr->colorDirty = false;
+    batch->MarkDirty();
+  }
+
+  // only texts that moved or were shown or hidden touch the batch
+  Ogre::SceneNode *node = this->dataPtr->anchor->getParentSceneNode();
+  const bool visible = node && this->dataPtr->anchor->isVisible();
+  if (visible != instance.visible)
+  {
+    instance.visible = visible;
+    batch->MarkDirty();
+  }
+  if (!visible)
+    return;
+
+  const Ogre::Vector3 position = node->_getDerivedPositionUpdated() +
+      Ogre::Vector3::UNIT_Z * this->baseline;
+  const Ogre::Vector3 scale = node->_getDerivedScaleUpdated();
+  if (position != instance.position ||
+      scale.x != instance.scale.x || scale.y != instance.scale.y)
+  {
+    instance.position = position;
+    instance.scale = Ogre::Vector2(scale.x, scale.y);
+    batch->MarkDirty();
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::Layout()
+{
+  auto &instance = this->dataPtr->instance;
+  instance.glyphs.clear();
+  instance.radius = 0.0f;
+
+  Ogre::Font *font = this->dataPtr->batch->Font();
+
+  // fonts without explicit code points cover the ogre default range
+  Ogre::Font::CodePointRangeList ranges = font->getCodePointRangeList();
+  if (ranges.empty())
+    ranges.push_back(Ogre::Font::CodePointRange(33, 166));
+  auto hasGlyph = [&ranges](Ogre::Font::CodePoint _c)
+  {
+    for (const auto &range : ranges)
+    {
+      if (_c >= range.first && _c <= range.second)
+        return true;
+    }
+    return false;
+  };
+
+  const float height = this->charHeight;
+  const float space = this->spaceWidth > 0.0f ? this->spaceWidth :
+      font->getGlyphAspectRatio('A') * height;
+
+  // split into lines and measure them for the horizontal alignment
+  std::vector<std::string> lines;
+  std::string::size_type start = 0u;
+  while (true)
+  {
+    std::string::size_type end = this->text.find('\n', start);
+    lines.push_back(this->text.substr(start, end - start));
+    if (end == std::string::npos)
+      break;
+    start = end + 1u;
+  }
+
+  float top = 0.0f;
+  const float textHeight = static_cast<float>(lines.size()) * height;
+  if (this->verticalAlign == TextVerticalAlign::BOTTOM)
+    top = textHeight;
+  else if (this->verticalAlign == TextVerticalAlign::CENTER)
+    top = textHeight * 0.5f;
+
+  math::Vector3d minimum(math::MAX_D, math::MAX_D, 0.0);
+  math::Vector3d maximum(math::LOW_D, math::LOW_D, 0.0);
+  for (const auto &line : lines)
+  {
+    float width = 0.0f;
+    for (unsigned char c : line)
+    {
+      if (hasGlyph(c))
+        width += font->getGlyphAspectRatio(c) * height;
+      else if (c == ' ' || c == '\t')
+        width += space;
+    }
+
+    float left = 0.0f;
+    if (this->horizontalAlign == TextHorizontalAlign::CENTER)
+      left = -width * 0.5f;
+    else if (this->horizontalAlign == TextHorizontalAlign::RIGHT)
+      left = -width;
+
+    for (unsigned char c : line)
+    {
+      if (!hasGlyph(c))
+      {
+        if (c == ' ' || c == '\t')
+          left += space;
+        continue;
+      }
+
+      Ogre2TextGlyph glyph;
+      const float glyphWidth = font->getGlyphAspectRatio(c) * height;
+      glyph.rect = Ogre::FloatRect(left, top, left + glyphWidth,
+          top - height);
+      glyph.uv = font->getGlyphTexCoords(c);
+      instance.glyphs.push_back(glyph);
+      left += glyphWidth;
+
+      minimum.X(std::min<double>(minimum.X(), glyph.rect.left));
+      minimum.Y(std::min<double>(minimum.Y(), glyph.rect.bottom));
+      maximum.X(std::max<double>(maximum.X(), glyph.rect.right));
+      maximum.Y(std::max<double>(maximum.Y(), glyph.rect.top));
+    }
+    top -= height;
+  }
+
+  if (instance.glyphs.empty())
+  {
+    this->dataPtr->aabb =
+        math::AxisAlignedBox(math::Vector3d::Zero, math::Vector3d::Zero);
+    return;
+  }
+
+  this->dataPtr->aabb = math::AxisAlignedBox(minimum, maximum);
+  const double maxX = std::max(std::abs(minimum.X()), std::abs(maximum.X()));
+  const double maxY = std::max(std::abs(minimum.Y()), std::abs(maximum.Y()));
+  instance.radius = static_cast<float>(std::sqrt(maxX * maxX + maxY * maxY));
+}
+
+//////////////////////////////////////////////////
+Ogre::MovableObject *Ogre2Text::OgreObject() const
+{
+  return this->dataPtr->anchor.get();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetMaterial(MaterialPtr _material, bool _unique)
+{
+  _material = (_unique) ? _material->Clone() : _material;
+
+  Ogre2MaterialPtr derived =
+      std::dynamic_pointer_cast<Ogre2Material>(_material);
+
+  if (!derived)
+  {
+    gzerr << "Cannot assign material created by another render-engine"
+        << std::endl;
+
+    return;
+  }
+
+  this->SetMaterialImpl(derived);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetMaterialImpl(Ogre2MaterialPtr _material)
+{
+  // only colors are supported for now
+  this->SetColor(_material->Diffuse());
+  this->dataPtr->material = _material;
+}
+
+//////////////////////////////////////////////////
+MaterialPtr Ogre2Text::Material() const
+{
+  return this->dataPtr->material;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetFontName(const std::string &_font)
+{
+  if (this->fontName == _font)
+    return;
+  BaseText::SetFontName(_font);
+  this->dataPtr->batchDirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetTextString(const std::string &_text)
+{
+  if (this->text == _text)
+    return;
+  BaseText::SetTextString(_text);
+  this->dataPtr->layoutDirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetColor(const math::Color &_color)
+{
+  if (this->color == _color)
+    return;
+  BaseText::SetColor(_color);
+  this->dataPtr->colorDirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetCharHeight(const float _height)
+{
+  if (math::equal(this->charHeight, _height))
+    return;
+  BaseText::SetCharHeight(_height);
+  this->dataPtr->layoutDirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetSpaceWidth(const float _width)
+{
+  if (math::equal(this->spaceWidth, _width))
+    return;
+  BaseText::SetSpaceWidth(_width);
+  this->dataPtr->layoutDirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetTextAlignment(const TextHorizontalAlign &_horizAlign,
+                                 const TextVerticalAlign &_vertAlign)
+{
+  if (this->horizontalAlign == _horizAlign &&
+      this->verticalAlign == _vertAlign)
+  {
+    return;
+  }
+  BaseText::SetTextAlignment(_horizAlign, _vertAlign);
+  this->dataPtr->layoutDirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetBaseline(const float _baseline)
+{
+  // the baseline only moves the anchor, which is checked every frame
+  BaseText::SetBaseline(_baseline);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Text::SetShowOnTop(const bool _onTop)
+{
+  if (this->onTop == _onTop)
+    return;
+  BaseText::SetShowOnTop(_onTop);
+  this->dataPtr->batchDirty = true;
+}
+
+//////////////////////////////////////////////////
+math::AxisAlignedBox Ogre2Text::AABB() const
+{
+  return this->dataPtr->aabb;
+}
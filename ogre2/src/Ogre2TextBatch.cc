@@ -0,0 +1,476 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <tuple>
+
+#include <gz/common/Console.hh>
+
+#include "Ogre2TextBatch.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Hlms/Unlit/OgreHlmsUnlitDatablock.h>
+#include <Overlay/OgreFont.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Layout of a vertex of the batch. The position is the anchor of
+  /// the text in world space, the offset of the glyph corner from it is
+  /// applied in view space by the vertex shader.
+  struct TextVertex
+  {
+    /// \brief Anchor of the text
+    float position[3];
+
+    /// \brief Texture coordinates followed by the offset in view space
+    float uvOffset[4];
+
+    /// \brief Normalized RGBA color
+    uint8_t color[4];
+  };
+
+  /// \brief Two triangles per glyph, without an index buffer
+  const std::size_t kVerticesPerGlyph = 6u;
+
+  /// \brief Smallest capacity of the vertex buffer, in vertices
+  const std::size_t kMinCapacity = 64u * kVerticesPerGlyph;
+
+  /// \brief Render queue of texts. v2 items can be placed in groups 0-99 or
+  /// 200-224, this one is drawn after opaque and transparent geometry.
+  const uint8_t kRenderQueue = 200u;
+
+  /// \brief Render queue of texts shown on top, drawn after all other texts
+  const uint8_t kOnTopRenderQueue = 201u;
+
+  /// \brief Batches by scene manager, font name, show on top flag and
+  /// visibility flags
+  typedef std::tuple<Ogre::SceneManager *, std::string, bool, uint32_t>
+      BatchKey;
+
+  /// \brief All live batches
+  std::map<BatchKey, std::weak_ptr<Ogre2TextBatch>> &Batches()
+  {
+    static std::map<BatchKey, std::weak_ptr<Ogre2TextBatch>> batches;
+    return batches;
+  }
+}
+
+//////////////////////////////////////////////////
+Ogre2TextBatch::Ogre2TextBatch(Ogre::SceneManager *_sceneManager,
+    Ogre::Font *_font, bool _onTop, uint32_t _visibilityFlags)
+  : sceneManager(_sceneManager), font(_font), onTop(_onTop),
+    visibilityFlags(_visibilityFlags)
+{
+  static unsigned int batchId = 0u;
+  const std::string name = "gz_text_batch_" + std::to_string(batchId++);
+
+  this->mesh = Ogre::MeshManager::getSingleton().createManual(name,
+      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  this->subMesh = this->mesh->createSubMesh();
+  this->CreateBuffer(kMinCapacity);
+
+  // the material of the font only gives us the glyph atlas, texts are drawn
+  // with a low level material that turns the glyphs towards the camera
+  Ogre::MaterialPtr textMaterial =
+      Ogre::MaterialManager::getSingleton().getByName("GzText");
+  auto fontDatablock =
+      dynamic_cast<Ogre::HlmsUnlitDatablock *>(
+      this->font->getHlmsDatablock());
+  Ogre::TextureGpu *atlas =
+      fontDatablock ? fontDatablock->getTexture(0u) : nullptr;
+  if (textMaterial && atlas)
+  {
+    this->material = textMaterial->clone(name);
+    this->material->load();
+    Ogre::Pass *pass = this->material->getTechnique(0u)->getPass(0u);
+    pass->getTextureUnitState(0u)->setTexture(atlas);
+
+    // luminance alpha atlases are stored with two channels, the glyph
+    // coverage is in the second one. Other formats keep it in alpha.
+    Ogre::Vector4 coverageMask(0, 0, 0, 1);
+    if (Ogre::PixelFormatGpuUtils::getNumberOfComponents(
+        atlas->getPixelFormat()) == 2u)
+    {
+      coverageMask = Ogre::Vector4(0, 1, 0, 0);
+    }
+    pass->getFragmentProgramParameters()->setNamedConstant(
+        "coverageMask", coverageMask);
+
+    if (this->onTop)
+    {
+      Ogre::HlmsMacroblock macroblock(*pass->getMacroblock());
+      macroblock.mDepthCheck = false;
+      pass->setMacroblock(macroblock);
+    }
+  }
+  else
+  {
+    gzerr << "Unable to create the material of font "
+          << this->font->getName() << ", text will not be visible"
+          << std::endl;
+  }
+
+  this->item = this->sceneManager->createItem(this->mesh,
+      Ogre::SCENE_DYNAMIC);
+  this->item->setCastShadows(false);
+  this->item->setVisibilityFlags(this->visibilityFlags);
+  this->item->setRenderQueueGroup(
+      this->onTop ? kOnTopRenderQueue : kRenderQueue);
+  if (this->material)
+    this->item->getSubItem(0)->setMaterial(this->material);
+  this->item->setVisible(false);
+
+  this->node = this->sceneManager->getRootSceneNode()->createChildSceneNode();
+  this->node->attachObject(this->item);
+}
+
+//////////////////////////////////////////////////
+Ogre2TextBatch::~Ogre2TextBatch()
+{
+  this->Destroy();
+}
+
+//////////////////////////////////////////////////
+Ogre::Font *Ogre2TextBatch::Font() const
+{
+  return this->font;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::Add(Ogre2TextInstance *_instance)
+{
+  _instance->index = this->instances.size();
+  this->instances.push_back(_instance);
+  this->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::Remove(Ogre2TextInstance *_instance)
+{
+  const std::size_t index = _instance->index;
+  if (index >= this->instances.size() ||
+      this->instances[index] != _instance)
+  {
+    return;
+  }
+
+  this->instances[index] = this->instances.back();
+  this->instances[index]->index = index;
+  this->instances.pop_back();
+  this->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::MarkDirty()
+{
+  this->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::Update()
+{
+  if (!this->dirty || !this->item)
+    return;
+  this->dirty = false;
+
+  std::size_t glyphCount = 0u;
+  for (const auto *instance : this->instances)
+  {
+    if (instance->visible)
+      glyphCount += instance->glyphs.size();
+  }
+
+  const std::size_t vertexCount = glyphCount * kVerticesPerGlyph;
+  if (vertexCount == 0u)
+  {
+    this->hasGlyphs = false;
+    this->UpdateItemVisibility();
+    return;
+  }
+
+  // grow to the next power of two, only shrink once less than a quarter is
+  // used so labels appearing and disappearing do not reallocate every frame
+  std::size_t newCapacity = std::max(this->capacity, kMinCapacity);
+  if (vertexCount > newCapacity)
+  {
+    while (newCapacity < vertexCount)
+      newCapacity <<= 1;
+  }
+  else if (vertexCount < this->capacity / 4u)
+  {
+    newCapacity = kMinCapacity;
+    while (newCapacity < vertexCount)
+      newCapacity <<= 1;
+  }
+  if (newCapacity != this->capacity)
+    this->CreateBuffer(newCapacity);
+  if (!this->vertexBuffer)
+    return;
+
+  // dynamic buffers are multi-buffered per frame, so the whole used range
+  // is written every time the buffer is mapped
+  TextVertex * RESTRICT_ALIAS vertices =
+      reinterpret_cast<TextVertex * RESTRICT_ALIAS>(
+      this->vertexBuffer->map(0u, vertexCount));
+
+  Ogre::Vector3 minimum(std::numeric_limits<Ogre::Real>::max());
+  Ogre::Vector3 maximum(-std::numeric_limits<Ogre::Real>::max());
+  for (const auto *instance : this->instances)
+  {
+    if (!instance->visible || instance->glyphs.empty())
+      continue;
+
+    const Ogre::Vector3 &position = instance->position;
+    const Ogre::Vector2 &scale = instance->scale;
+    auto addVertex = [&](float _x, float _y, float _u, float _v)
+    {
+      vertices->position[0] = position.x;
+      vertices->position[1] = position.y;
+      vertices->position[2] = position.z;
+      vertices->uvOffset[0] = _u;
+      vertices->uvOffset[1] = _v;
+      vertices->uvOffset[2] = _x * scale.x;
+      vertices->uvOffset[3] = _y * scale.y;
+      memcpy(vertices->color, instance->color, sizeof(instance->color));
+      ++vertices;
+    };
+
+    for (const auto &glyph : instance->glyphs)
+    {
+      const Ogre::FloatRect &rect = glyph.rect;
+      const Ogre::FloatRect &uv = glyph.uv;
+      addVertex(rect.left, rect.top, uv.left, uv.top);
+      addVertex(rect.left, rect.bottom, uv.left, uv.bottom);
+      addVertex(rect.right, rect.top, uv.right, uv.top);
+      addVertex(rect.right, rect.top, uv.right, uv.top);
+      addVertex(rect.left, rect.bottom, uv.left, uv.bottom);
+      addVertex(rect.right, rect.bottom, uv.right, uv.bottom);
+    }
+
+    // the glyphs can face any direction, bound them with a sphere
+    const Ogre::Real radius = instance->radius *
+        std::max(std::abs(scale.x), std::abs(scale.y));
+    minimum.makeFloor(position - radius);
+    maximum.makeCeil(position + radius);
+  }
+
+  this->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+  this->vao->setPrimitiveRange(0u, static_cast<uint32_t>(vertexCount));
+
+  // set the bounds to get frustum culling to work correctly
+  this->item->setLocalAabb(Ogre::Aabb::newFromExtents(minimum, maximum));
+  this->hasGlyphs = true;
+  this->UpdateItemVisibility();
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::UpdateItemVisibility()
+{
+  if (this->item)
+    this->item->setVisible(this->hasGlyphs && !this->hidden);
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::CreateBuffer(std::size_t _capacity)
+{
+  Ogre::VaoManager *vaoManager =
+      this->sceneManager->getDestinationRenderSystem()->getVaoManager();
+  if (!vaoManager)
+    return;
+
+  this->DestroyBuffer();
+
+  Ogre::VertexElement2Vec vertexElements;
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_POSITION));
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_FLOAT4, Ogre::VES_TEXTURE_COORDINATES));
+  vertexElements.push_back(
+      Ogre::VertexElement2(Ogre::VET_UBYTE4_NORM, Ogre::VES_DIFFUSE));
+
+  this->vertexBuffer = vaoManager->createVertexBuffer(vertexElements,
+      _capacity, Ogre::BT_DYNAMIC_PERSISTENT, nullptr, false);
+  this->capacity = _capacity;
+
+  Ogre::VertexBufferPackedVec vertexBuffers;
+  vertexBuffers.push_back(this->vertexBuffer);
+  this->vao = vaoManager->createVertexArrayObject(vertexBuffers, nullptr,
+      Ogre::OT_TRIANGLE_LIST);
+  this->subMesh->mVao[Ogre::VpNormal].push_back(this->vao);
+  this->subMesh->mVao[Ogre::VpShadow].push_back(this->vao);
+
+  if (this->item)
+  {
+    // rebuild the sub item, it still points to the old vao. This resets the
+    // item properties so set them again.
+    this->item->_initialise(true);
+    this->item->setCastShadows(false);
+    this->item->setVisibilityFlags(this->visibilityFlags);
+    if (this->material)
+      this->item->getSubItem(0)->setMaterial(this->material);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::DestroyBuffer()
+{
+  Ogre::VaoManager *vaoManager =
+      this->sceneManager->getDestinationRenderSystem()->getVaoManager();
+  if (!vaoManager || !this->subMesh)
+    return;
+
+  if (!this->subMesh->mVao[Ogre::VpNormal].empty())
+  {
+    this->subMesh->destroyVaos(this->subMesh->mVao[Ogre::VpNormal],
+        vaoManager);
+  }
+  this->subMesh->mVao[Ogre::VpShadow].clear();
+
+  this->vertexBuffer = nullptr;
+  this->vao = nullptr;
+  this->capacity = 0u;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::Destroy()
+{
+  if (!this->item)
+    return;
+
+  this->node->detachObject(this->item);
+  this->sceneManager->destroyItem(this->item);
+  this->item = nullptr;
+  this->sceneManager->destroySceneNode(this->node);
+  this->node = nullptr;
+
+  this->DestroyBuffer();
+  this->subMesh = nullptr;
+  Ogre::MeshManager::getSingleton().remove(this->mesh->getName());
+  this->mesh.reset();
+
+  if (this->material)
+  {
+    Ogre::MaterialManager::getSingleton().remove(this->material->getName());
+    this->material.reset();
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<Ogre2TextBatch> Ogre2TextBatch::Get(
+    Ogre::SceneManager *_sceneManager, const std::string &_fontName,
+    bool _onTop, uint32_t _visibilityFlags)
+{
+  auto &batches = Batches();
+  const BatchKey key(_sceneManager, _fontName, _onTop, _visibilityFlags);
+  auto it = batches.find(key);
+  if (it != batches.end())
+  {
+    std::shared_ptr<Ogre2TextBatch> batch = it->second.lock();
+    if (batch)
+      return batch;
+  }
+
+  auto ogreFont = static_cast<Ogre::Font *>(
+      Ogre::FontManager::getSingleton().getByName(_fontName,
+      Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME).get());
+  if (!ogreFont)
+  {
+    gzerr << "Could not find font " << _fontName << std::endl;
+    return nullptr;
+  }
+
+  try
+  {
+    ogreFont->load();
+  }
+  catch (Ogre::Exception &_e)
+  {
+    gzerr << "Unable to load font " << _fontName << ": "
+          << _e.getDescription() << std::endl;
+    return nullptr;
+  }
+
+  auto batch = std::make_shared<Ogre2TextBatch>(_sceneManager, ogreFont,
+      _onTop, _visibilityFlags);
+  batches[key] = batch;
+  return batch;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::UpdateAll(Ogre::SceneManager *_sceneManager)
+{
+  auto &batches = Batches();
+  for (auto it = batches.begin(); it != batches.end();)
+  {
+    std::shared_ptr<Ogre2TextBatch> batch = it->second.lock();
+    if (!batch)
+    {
+      it = batches.erase(it);
+      continue;
+    }
+    if (std::get<0>(it->first) == _sceneManager)
+      batch->Update();
+    ++it;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::DestroyAll(Ogre::SceneManager *_sceneManager)
+{
+  auto &batches = Batches();
+  for (auto it = batches.begin(); it != batches.end();)
+  {
+    if (std::get<0>(it->first) != _sceneManager)
+    {
+      ++it;
+      continue;
+    }
+    std::shared_ptr<Ogre2TextBatch> batch = it->second.lock();
+    if (batch)
+      batch->Destroy();
+    it = batches.erase(it);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextBatch::SetHiddenAll(Ogre::SceneManager *_sceneManager,
+    bool _hidden)
+{
+  for (auto &entry : Batches())
+  {
+    if (std::get<0>(entry.first) != _sceneManager)
+      continue;
+    std::shared_ptr<Ogre2TextBatch> batch = entry.second.lock();
+    if (batch)
+    {
+      batch->hidden = _hidden;
+      batch->UpdateItemVisibility();
+    }
+  }
+}
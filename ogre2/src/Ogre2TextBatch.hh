@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2TEXTBATCH_HH_
+#define GZ_RENDERING_OGRE2_OGRE2TEXTBATCH_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Glyph quad of a laid out text, relative to the text anchor
+    struct Ogre2TextGlyph
+    {
+      /// \brief Corners of the quad in meters, before the scale of the node
+      /// the text is attached to is applied. Y points up.
+      Ogre::FloatRect rect;
+
+      /// \brief Texture coordinates of the glyph in the font atlas
+      Ogre::FloatRect uv;
+    };
+
+    /// \brief One text drawn by an Ogre2TextBatch. It is owned by the
+    /// Ogre2Text it belongs to, the batch only keeps a pointer to it.
+    struct Ogre2TextInstance
+    {
+      /// \brief Laid out glyphs, only rebuilt when the text string or
+      /// the layout properties change
+      std::vector<Ogre2TextGlyph> glyphs;
+
+      /// \brief Largest distance of a glyph corner from the anchor, before
+      /// scale
+      float radius = 0.0f;
+
+      /// \brief Anchor of the text in world space
+      Ogre::Vector3 position = Ogre::Vector3::ZERO;
+
+      /// \brief Scale of the node the text is attached to
+      Ogre::Vector2 scale = Ogre::Vector2::UNIT_SCALE;
+
+      /// \brief Text color as normalized RGBA bytes
+      uint8_t color[4] = {255u, 255u, 255u, 255u};
+
+      /// \brief Whether the text is drawn
+      bool visible = false;
+
+      /// \brief Index of the instance in the batch, managed by the batch
+      std::size_t index = 0u;
+    };
+
+    /// \brief Draws all texts of a scene that share a font, the show on
+    /// top flag and the visibility flags with a single Ogre item. The glyphs of all texts live in one
+    /// dynamic, persistently mapped vertex buffer that is textured with the
+    /// glyph atlas of the font, and the quads are turned towards the camera
+    /// in the vertex shader, so thousands of labels cost one draw call per
+    /// font. The vertex buffer is only rewritten in frames in which a text
+    /// changed, moved, or was added or removed.
+    class Ogre2TextBatch
+    {
+      /// \brief Constructor, use Get() instead
+      /// \param[in] _sceneManager Scene manager to create the item in
+      /// \param[in] _font Loaded font
+      /// \param[in] _onTop True to draw the texts on top of everything else
+      /// \param[in] _visibilityFlags Visibility flags of the item, matched
+      /// against the visibility masks of cameras
+      public: Ogre2TextBatch(Ogre::SceneManager *_sceneManager,
+                  Ogre::Font *_font, bool _onTop, uint32_t _visibilityFlags);
+
+      /// \brief Destructor
+      public: ~Ogre2TextBatch();
+
+      /// \brief Font used by the batch, for glyph metrics
+      /// \return The font
+      public: Ogre::Font *Font() const;
+
+      /// \brief Start drawing a text
+      /// \param[in] _instance Text to draw, must outlive its membership
+      public: void Add(Ogre2TextInstance *_instance);
+
+      /// \brief Stop drawing a text
+      /// \param[in] _instance Text previously added
+      public: void Remove(Ogre2TextInstance *_instance);
+
+      /// \brief Mark the vertex buffer as out of date, to be called after
+      /// changing a text that was added to the batch
+      public: void MarkDirty();
+
+      /// \brief Rewrite the vertex buffer if any text changed
+      public: void Update();
+
+      /// \brief Release the Ogre objects of the batch. Texts can still be
+      /// added and removed afterwards but nothing is drawn anymore.
+      public: void Destroy();
+
+      /// \brief Get the batch of a font in a scene, creating it the first
+      /// time. Batches are released when the last text using them goes away.
+      /// \param[in] _sceneManager Scene manager of the scene
+      /// \param[in] _fontName Name of the font
+      /// \param[in] _onTop True to draw the texts on top of everything else
+      /// \param[in] _visibilityFlags Visibility flags of the texts
+      /// \return The batch, or null if the font could not be loaded
+      public: static std::shared_ptr<Ogre2TextBatch> Get(
+                  Ogre::SceneManager *_sceneManager,
+                  const std::string &_fontName, bool _onTop,
+                  uint32_t _visibilityFlags);
+
+      /// \brief Update all batches of a scene, to be called once per frame
+      /// after the texts of the scene were pre-rendered
+      /// \param[in] _sceneManager Scene manager of the scene
+      public: static void UpdateAll(Ogre::SceneManager *_sceneManager);
+
+      /// \brief Destroy all batches of a scene, to be called before the
+      /// scene destroys its items
+      /// \param[in] _sceneManager Scene manager of the scene
+      public: static void DestroyAll(Ogre::SceneManager *_sceneManager);
+
+      /// \brief Hide or show again all batches of a scene. Passes that
+      /// replace the materials of visuals, e.g. segmentation, hide the
+      /// texts while they render since the batches belong to no visual.
+      /// \param[in] _sceneManager Scene manager of the scene
+      /// \param[in] _hidden True to hide the batches, false to show them
+      /// again
+      public: static void SetHiddenAll(Ogre::SceneManager *_sceneManager,
+                  bool _hidden);
+
+      /// \brief Show the item if it has glyphs to draw and is not hidden
+      private: void UpdateItemVisibility();
+
+      /// \brief Recreate the vertex buffer with a new capacity
+      /// \param[in] _capacity Capacity in vertices
+      private: void CreateBuffer(std::size_t _capacity);
+
+      /// \brief Destroy the vertex buffer and vertex array object
+      private: void DestroyBuffer();
+
+      /// \brief Scene manager the item lives in
+      private: Ogre::SceneManager *sceneManager = nullptr;
+
+      /// \brief Font of the batch
+      private: Ogre::Font *font = nullptr;
+
+      /// \brief True to draw the texts on top of everything else
+      private: bool onTop = false;
+
+      /// \brief Visibility flags of the item
+      private: uint32_t visibilityFlags = 0u;
+
+      /// \brief Mesh holding the vertex buffer
+      private: Ogre::MeshPtr mesh;
+
+      /// \brief Submesh holding the vertex array object
+      private: Ogre::SubMesh *subMesh = nullptr;
+
+      /// \brief Vertex buffer shared by all texts of the batch
+      private: Ogre::VertexBufferPacked *vertexBuffer = nullptr;
+
+      /// \brief Vertex array object drawing the used part of the buffer
+      private: Ogre::VertexArrayObject *vao = nullptr;
+
+      /// \brief Capacity of the vertex buffer in vertices
+      private: std::size_t capacity = 0u;
+
+      /// \brief Item drawing the batch
+      private: Ogre::Item *item = nullptr;
+
+      /// \brief Scene node the item is attached to
+      private: Ogre::SceneNode *node = nullptr;
+
+      /// \brief Low level material textured with the font atlas
+      private: Ogre::MaterialPtr material;
+
+      /// \brief Texts drawn by the batch
+      private: std::vector<Ogre2TextInstance *> instances;
+
+      /// \brief True if the vertex buffer is out of date
+      private: bool dirty = true;
+
+      /// \brief True if the vertex buffer holds glyphs to draw
+      private: bool hasGlyphs = false;
+
+      /// \brief True while a pass that must not draw texts renders
+      private: bool hidden = false;
+    };
+    }
+  }
+}
+#endif
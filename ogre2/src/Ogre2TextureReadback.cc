@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <OgreAsyncTextureTicket.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "Ogre2TextureReadback.hh"
+
+using namespace gz;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+Ogre2TextureReadback::~Ogre2TextureReadback()
+{
+  this->Reset();
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::SetLatency(unsigned int _frames)
+{
+  if (this->latency == _frames)
+    return;
+
+  this->Reset();
+  this->latency = _frames;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2TextureReadback::Read(Ogre::TextureGpu *_texture,
+    Ogre::TextureBox &_box)
+{
+  if (!_texture)
+    return false;
+
+  if (this->mapped)
+  {
+    gzerr << "Previous texture readback is still mapped" << std::endl;
+    this->Unmap();
+  }
+
+  // (re)create the staging buffers if the texture changed size or format
+  if (this->slots.empty() ||
+      this->slots[0].ticket->getWidth() != _texture->getWidth() ||
+      this->slots[0].ticket->getHeight() != _texture->getHeight() ||
+      this->slots[0].ticket->getPixelFormatFamily() !=
+      Ogre::PixelFormatGpuUtils::getFamily(_texture->getPixelFormat()))
+  {
+    this->CreateTickets(_texture);
+  }
+
+  Slot &slot = this->slots[this->writeIdx];
+  slot.ticket->download(_texture, 0u, true);
+  slot.frameId = this->nextFrameId++;
+  slot.time = std::chrono::steady_clock::now();
+  this->writeIdx = static_cast<unsigned int>(
+      (this->writeIdx + 1u) % this->slots.size());
+  ++this->pending;
+
+  if (this->pending <= this->latency)
+    return false;
+
+  // map the oldest download. This only blocks if the GPU has not finished
+  // the transfer, which is always the case for a latency of 0
+  Slot &ready = this->slots[this->readIdx];
+  this->readIdx = static_cast<unsigned int>(
+      (this->readIdx + 1u) % this->slots.size());
+  --this->pending;
+
+  _box = ready.ticket->map(0u);
+  this->mapped = &ready;
+  this->token = std::make_shared<uint64_t>(ready.frameId);
+  this->frameId = ready.frameId;
+  this->frameTime = ready.time;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::Unmap()
+{
+  if (!this->mapped)
+    return;
+
+  this->mapped->ticket->unmap();
+  this->mapped = nullptr;
+  this->token.reset();
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::Reset()
+{
+  this->Unmap();
+
+  for (auto &slot : this->slots)
+    this->textureManager->destroyAsyncTextureTicket(slot.ticket);
+
+  this->slots.clear();
+  this->textureManager = nullptr;
+  this->writeIdx = 0u;
+  this->readIdx = 0u;
+  this->pending = 0u;
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2TextureReadback::FrameId() const
+{
+  return this->frameId;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::time_point Ogre2TextureReadback::FrameTime() const
+{
+  return this->frameTime;
+}
+
+//////////////////////////////////////////////////
+std::weak_ptr<const void> Ogre2TextureReadback::Token() const
+{
+  return this->token;
+}
+
+//////////////////////////////////////////////////
+void Ogre2TextureReadback::CreateTickets(Ogre::TextureGpu *_texture)
+{
+  this->Reset();
+
+  this->textureManager = _texture->getTextureManager();
+  // one slot per frame of latency plus the one being written this frame
+  this->slots.resize(this->latency + 1u);
+  for (auto &slot : this->slots)
+  {
+    slot.ticket = this->textureManager->createAsyncTextureTicket(
+        _texture->getWidth(), _texture->getHeight(),
+        _texture->getDepthOrSlices(), _texture->getTextureType(),
+        _texture->getPixelFormat());
+  }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_RENDERING_OGRE2_OGRE2TEXTUREREADBACK_HH_
+#define GZ_RENDERING_OGRE2_OGRE2TEXTUREREADBACK_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gz/rendering/config.hh"
+#include "gz/rendering/ogre2/Ogre2Includes.hh"
+
+namespace gz
+{
+  namespace rendering
+  {
+    inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+    //
+    /// \brief Helper class for reading back sensor textures from the GPU.
+    /// Downloads are queued into a ring of async texture tickets (staging
+    /// buffers). With a latency of 0 the download is mapped right away,
+    /// which is equivalent to Ogre::Image2::convertFromTexture minus the
+    /// extra copy. With a latency of N the data of a frame is only mapped N
+    /// frames later, by which time the GPU has normally finished the
+    /// transfer and mapping does not stall.
+    class Ogre2TextureReadback
+    {
+      /// \brief Constructor
+      public: Ogre2TextureReadback() = default;
+
+      /// \brief Destructor. Releases all tickets.
+      public: ~Ogre2TextureReadback();
+
+      /// \brief Set the number of frames of latency. Readbacks in flight are
+      /// discarded if the value changes.
+      /// \param[in] _frames Number of frames of latency
+      public: void SetLatency(unsigned int _frames);
+
+      /// \brief Queue a download of the given texture and map the oldest
+      /// download that has reached the configured latency. Unmap() must be
+      /// called once the mapped data is no longer needed and before the next
+      /// call to this function.
+      /// \param[in] _texture Texture to read back
+      /// \param[out] _box Mapped data, only valid if true is returned
+      /// \return True if _box holds mapped data, false if no frame is ready
+      /// yet, i.e. while the ring is being filled.
+      public: bool Read(Ogre::TextureGpu *_texture, Ogre::TextureBox &_box);
+
+      /// \brief Unmap data previously returned by Read()
+      public: void Unmap();
+
+      /// \brief Release all tickets and discard readbacks in flight
+      public: void Reset();
+
+      /// \brief Id of the frame whose data was returned by the last
+      /// successful call to Read(). Ids start at 1.
+      /// \return Frame id
+      public: uint64_t FrameId() const;
+
+      /// \brief Time at which the frame returned by the last successful call
+      /// to Read() was queued for download.
+      /// \return Frame time
+      public: std::chrono::steady_clock::time_point FrameTime() const;
+
+      /// \brief Token that expires once the data returned by the last
+      /// successful call to Read() is unmapped. Used to let borrowers of the
+      /// mapped memory check that it is still valid.
+      /// \return Lifetime token of the mapped data
+      public: std::weak_ptr<const void> Token() const;
+
+      /// \brief Create the ring of tickets matching the given texture
+      /// \param[in] _texture Texture that will be read back
+      private: void CreateTickets(Ogre::TextureGpu *_texture);
+
+      /// \brief A staging buffer in the ring
+      private: struct Slot
+      {
+        /// \brief Ticket the texture is downloaded into
+        Ogre::AsyncTextureTicket *ticket = nullptr;
+
+        /// \brief Id of the frame downloaded into this slot
+        uint64_t frameId = 0u;
+
+        /// \brief Time the download was queued
+        std::chrono::steady_clock::time_point time;
+      };
+
+      /// \brief Ring of staging buffers
+      private: std::vector<Slot> slots;
+
+      /// \brief Texture manager that created the tickets
+      private: Ogre::TextureGpuManager *textureManager = nullptr;
+
+      /// \brief Number of frames of latency
+      private: unsigned int latency = 0u;
+
+      /// \brief Index of the slot the next download goes into
+      private: unsigned int writeIdx = 0u;
+
+      /// \brief Index of the oldest download in flight
+      private: unsigned int readIdx = 0u;
+
+      /// \brief Number of downloads in flight
+      private: unsigned int pending = 0u;
+
+      /// \brief Slot that is currently mapped, null if none
+      private: Slot *mapped = nullptr;
+
+      /// \brief Id assigned to the next download
+      private: uint64_t nextFrameId = 1u;
+
+      /// \brief Id of the frame last returned by Read()
+      private: uint64_t frameId = 0u;
+
+      /// \brief Time of the frame last returned by Read()
+      private: std::chrono::steady_clock::time_point frameTime;
+
+      /// \brief Lifetime token of the mapped data, null if nothing is mapped
+      private: std::shared_ptr<const void> token;
+    };
+    }
+  }
+}
+
+#endif
@@ -45,6 +45,7 @@
 #include <gz/math/Helpers.hh>
 #include <gz/math/Matrix4.hh>
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/RenderTypes.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2Heightmap.hh"
@@ -61,6 +62,8 @@
 
 #include <gz/common/Image.hh>
 
+#include "Ogre2TextBatch.hh"
+#include "Ogre2TextureReadback.hh"
 #include "Terra/Terra.h"
 
 namespace gz
@@ -195,6 +198,9 @@ class gz::rendering::Ogre2ThermalCameraPrivate
 
   /// \brief bit depth of each pixel
   public: unsigned int bitDepth = 16u;
+
+  /// \brief Reads back the thermal texture from the GPU
+  public: Ogre2TextureReadback readback;
 };
 
 using namespace gz;
@@ -235,6 +241,9 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
   auto engine = Ogre2RenderEngine::Instance();
   engine->SetGzOgreRenderingMode(GORM_SOLID_THERMAL_COLOR_TEXTURED);
 
+  // text batches belong to no visual and have no temperature
+  Ogre2TextBatch::SetHiddenAll(this->scene->OgreSceneManager(), true);
+
   // swap item to use v1 shader material
   // Note: keep an eye out for performance impact on switching materials
   // on the fly. We are not doing this often so should be ok.
@@ -679,6 +688,7 @@ void Ogre2ThermalCameraMaterialSwitcher::cameraPostRenderScene(
     subItem->setDatablock(it.second);
   }
 
+  Ogre2TextBatch::SetHiddenAll(this->scene->OgreSceneManager(), false);
   engine->SetGzOgreRenderingMode(GORM_NORMAL);
 }
 
@@ -723,6 +733,8 @@ void Ogre2ThermalCamera::Destroy()
   if (!this->ogreCamera)
     return;
 
+  this->dataPtr->readback.Reset();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   auto ogreCompMgr = ogreRoot->getCompositorManager2();
@@ -1089,6 +1101,7 @@ void Ogre2ThermalCamera::CreateThermalTexture()
 //////////////////////////////////////////////////
 void Ogre2ThermalCamera::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2ThermalCamera::Render");
   // Our shaders rely on clamped values so enable it for this sensor
   //
   // TODO(anyone): Matias N. Goldberg (dark_sylinc) insists this is a hack
@@ -1124,6 +1137,7 @@ void Ogre2ThermalCamera::PreRender()
 //////////////////////////////////////////////////
 void Ogre2ThermalCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2ThermalCamera::PostRender");
   if (this->dataPtr->newThermalFrame.ConnectionCount() <= 0u)
     return;
 
@@ -1132,48 +1146,25 @@ void Ogre2ThermalCamera::PostRender()
   PixelFormat format = this->ImageFormat();
 
   int len = width * height;
-  unsigned int channelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreThermalTexture, 0u, 0u);
+  this->dataPtr->readback.SetLatency(this->ReadbackLatency());
+  Ogre::TextureBox box;
+  if (!this->dataPtr->readback.Read(this->dataPtr->ogreThermalTexture, box))
+    return;
+  this->readbackFrameId = this->dataPtr->readback.FrameId();
+  this->readbackFrameTime = this->dataPtr->readback.FrameTime();
 
   if (!this->dataPtr->thermalImage)
   {
     this->dataPtr->thermalImage = new uint16_t[len];
   }
 
-  Ogre::TextureBox box = image.getData(0u);
-  if (format == PF_L8)
-  {
-    uint8_t *thermalBuffer = static_cast<uint8_t*>(box.data);
-    for (unsigned int i = 0u; i < height; ++i)
-    {
-      // the texture box step size could be larger than our image buffer step
-      // size
-      unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-      for (unsigned int j = 0u; j < width; ++j)
-      {
-        unsigned int idx = (i * width) + j;
-        this->dataPtr->thermalImage[idx] = thermalBuffer[rawDataRowIdx + j];
-      }
-    }
-  }
-  else
-  {
-    // fill thermal data
-    // copy data row by row. The texture box may not be a contiguous region of
-    // a texture
-    uint16_t * thermalBuffer = static_cast<uint16_t *>(box.data);
-    for (unsigned int i = 0; i < height; ++i)
-    {
-      unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-      unsigned int rowIdx = i * width * channelCount;
-      memcpy(&this->dataPtr->thermalImage[rowIdx],
-          &thermalBuffer[rawDataRowIdx],
-          width * channelCount * bytesPerChannel);
-    }
-  }
+  // fill thermal data. 8 bit data is widened to the 16 bit output. The
+  // texture box step size could be larger than our image buffer step size
+  PixelUtil::Convert(box.data, format,
+      static_cast<unsigned int>(box.bytesPerRow), this->dataPtr->thermalImage,
+      PF_L16, 0u, width, height);
+  this->dataPtr->readback.Unmap();
 
   this->dataPtr->newThermalFrame(
       this->dataPtr->thermalImage, width, height, 1,
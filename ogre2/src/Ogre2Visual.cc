@@ -21,6 +21,7 @@
 #include "gz/rendering/ogre2/Ogre2Geometry.hh"
 #include "gz/rendering/ogre2/Ogre2ParticleEmitter.hh"
 #include "gz/rendering/ogre2/Ogre2RenderTypes.hh"
+#include "gz/rendering/ogre2/Ogre2Scene.hh"
 #include "gz/rendering/ogre2/Ogre2Storage.hh"
 #include "gz/rendering/ogre2/Ogre2Visual.hh"
 #include "gz/rendering/Utils.hh"
@@ -29,13 +30,34 @@
   #pragma warning(push, 0)
 #endif
 #include <OgreItem.h>
+#include <OgreSceneManager.h>
 #ifdef _MSC_VER
   #pragma warning(pop)
 #endif
 
+#include "Terra/Terra.h"
+
 using namespace gz;
 using namespace rendering;
 
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Check whether an object attached to a static node can live in
+  /// SCENE_STATIC memory. Meshes and terrains only move with their node,
+  /// while animated meshes, particles and texts update themselves every
+  /// frame and stay dynamic, which Ogre allows under a static node.
+  /// \param[in] _object Attached object
+  /// \return True if the object can be made static
+  bool CanBeStatic(Ogre::MovableObject *_object)
+  {
+    Ogre::Item *item = dynamic_cast<Ogre::Item *>(_object);
+    if (item)
+      return !item->hasSkeleton();
+    return dynamic_cast<Ogre::Terra *>(_object) != nullptr;
+  }
+}
+
 /// \brief Private data for the Ogre2Visual class
 class gz::rendering::Ogre2VisualPrivate
 {
@@ -102,13 +124,35 @@ void Ogre2Visual::SetVisible(bool _visible)
   if (!this->ogreNode)
     return;
 
+  this->scene->SetShadowCasterDirty(this->ogreNode);
   this->ogreNode->setVisible(_visible);
+  this->scene->SetShadowCasterDirty(this->ogreNode);
 }
 
 //////////////////////////////////////////////////
 void Ogre2Visual::SetStatic(bool _static)
 {
-  this->ogreNode->setStatic(_static);
+  if (!this->ogreNode || this->ogreNode->isStatic() == _static)
+    return;
+
+  // a static object can't be attached to a dynamic node, so objects become
+  // static after their node and dynamic before it
+  if (_static)
+    this->ogreNode->setStatic(true);
+
+  for (size_t i = 0u; i < this->ogreNode->numAttachedObjects(); ++i)
+  {
+    Ogre::MovableObject *object = this->ogreNode->getAttachedObject(i);
+    object->setStatic(_static && CanBeStatic(object));
+  }
+
+  if (!_static)
+    this->ogreNode->setStatic(false);
+
+  // static nodes and objects only update their transforms and bounds when
+  // told to
+  if (_static)
+    this->scene->OgreSceneManager()->notifyStaticDirty(this->ogreNode);
 }
 
 //////////////////////////////////////////////////
@@ -180,7 +224,12 @@ bool Ogre2Visual::AttachGeometry(GeometryPtr _geometry)
       & ~Ogre2ParticleEmitter::kParticleVisibilityFlags);
 
   derived->SetParent(this->SharedThis());
+  if (this->ogreNode->isStatic() && CanBeStatic(ogreObj))
+    ogreObj->setStatic(true);
   this->ogreNode->attachObject(ogreObj);
+  if (this->ogreNode->isStatic())
+    this->scene->OgreSceneManager()->notifyStaticDirty(this->ogreNode);
+  this->scene->SetShadowCasterDirty(this->ogreNode);
 
   return true;
 }
@@ -206,7 +255,15 @@ bool Ogre2Visual::DetachGeometry(GeometryPtr _geometry)
   }
 
   if (nullptr != derived->OgreObject())
+  {
+    this->scene->SetShadowCasterDirty(this->ogreNode);
     this->ogreNode->detachObject(derived->OgreObject());
+
+    // the geometry may be attached to a dynamic node next
+    derived->OgreObject()->setStatic(false);
+    if (this->ogreNode->isStatic())
+      this->scene->OgreSceneManager()->notifyStaticDirty(this->ogreNode);
+  }
   derived->SetParent(nullptr);
   return true;
 }
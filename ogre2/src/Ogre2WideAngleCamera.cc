@@ -15,8 +15,13 @@
  *
  */
 
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/ogre2/Ogre2WideAngleCamera.hh"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include "gz/rendering/CameraLens.hh"
 #include "gz/rendering/ogre2/Ogre2Conversions.hh"
 #include "gz/rendering/ogre2/Ogre2RenderEngine.hh"
@@ -25,6 +30,8 @@
 
 #include "gz/common/Util.hh"
 
+#include "Ogre2TextureReadback.hh"
+
 #ifdef _MSC_VER
 #  pragma warning(push, 0)
 #endif
@@ -117,6 +124,16 @@ class gz::rendering::Ogre2WideAngleCamera::Implementation
   /// \brief Compositor workspace. Does all the work. One for each face
   public: Ogre::CompositorWorkspace *ogreCompositorWorkspace[6];
 
+  /// \brief Whether each cubemap face is rendered, see UpdateRenderedFaces
+  public: bool faceRendered[6] = {true, true, true, true, true, true};
+
+  /// \brief Whether faces the lens never samples are skipped
+  public: bool skipUnsampledFaces = true;
+
+  /// \brief Lens, field of view, image size, environment texture size and
+  /// skipUnsampledFaces faceRendered was computed for
+  public: std::array<double, 13> renderedFacesKey{};
+
   /// \brief Compositor workspace. Converts the cubemap into a "fish eye"
   public: Ogre::CompositorWorkspace *ogreCompositorFinalPass = nullptr;
 
@@ -161,6 +178,12 @@ class gz::rendering::Ogre2WideAngleCamera::Implementation
   /// changed
   public: bool backgroundMaterialDirty = false;
 
+  /// \brief Reads back the final stitched texture from the GPU
+  public: Ogre2TextureReadback readback;
+
+  /// \brief Outgoing RGB image data, used by newImageFrame event
+  public: std::vector<uint8_t> wideAngleImage;
+
   explicit Implementation(gz::rendering::Ogre2WideAngleCamera &_owner) :
     workspaceListener(_owner)
   {
@@ -227,6 +250,8 @@ void Ogre2WideAngleCamera::PreRender()
 {
   BaseCamera::PreRender();
 
+  this->UpdateRenderedFaces();
+
   if (this->dataPtr->backgroundMaterialDirty)
   {
     this->UpdateBackgroundMaterial();
@@ -290,6 +315,8 @@ void Ogre2WideAngleCamera::DestroyTextures()
   Ogre::TextureGpuManager *textureMgr =
     ogreRoot->getRenderSystem()->getTextureGpuManager();
 
+  this->dataPtr->readback.Reset();
+
   this->DestroyStitchWorkspace();
   this->DestroyFacesWorkspaces();
 
@@ -1017,6 +1044,7 @@ void Ogre2WideAngleCamera::CreateWideAngleTexture()
 //////////////////////////////////////////////////
 void Ogre2WideAngleCamera::Render()
 {
+  GZ_RENDERING_PROFILE("Ogre2WideAngleCamera::Render");
   // make sure we do not alter the reserved visibility flags
   const uint32_t currVisibilityMask = this->VisibilityMask() &
     Ogre::VisibilityFlags::RESERVED_VISIBILITY_FLAGS;
@@ -1029,8 +1057,14 @@ void Ogre2WideAngleCamera::Render()
   const Ogre::Quaternion oldCameraOrientation(
     this->dataPtr->ogreCamera->getOrientation());
 
+  uint8_t numRenderedFaces = 0u;
   for (size_t i = 0u; i < kWideAngleNumCubemapFaces; ++i)
   {
+    // the final pass never samples this face
+    if (!this->dataPtr->faceRendered[i])
+      continue;
+    ++numRenderedFaces;
+
     this->dataPtr->ogreCompositorWorkspace[i]->setEnabled(true);
 
     this->dataPtr->ogreCamera->setOrientation(oldCameraOrientation *
@@ -1064,8 +1098,7 @@ void Ogre2WideAngleCamera::Render()
     this->dataPtr->ogreCompositorFinalPass->setEnabled(false);
   }
 
-  this->scene->FlushGpuCommandsAndStartNewFrame(kWideAngleNumCubemapFaces,
-                                                false);
+  this->scene->FlushGpuCommandsAndStartNewFrame(numRenderedFaces, false);
 }
 
 //////////////////////////////////////////////////
@@ -1246,9 +1279,119 @@ Ogre::Ray Ogre2WideAngleCamera::CameraToViewportRay(
   return ray;
 }
 
+//////////////////////////////////////////////////
+bool Ogre2WideAngleCamera::IsFaceRendered(uint32_t _faceIdx) const
+{
+  return _faceIdx < kWideAngleNumCubemapFaces &&
+      this->dataPtr->faceRendered[_faceIdx];
+}
+
+//////////////////////////////////////////////////
+void Ogre2WideAngleCamera::SetSkipUnsampledFaces(bool _skip)
+{
+  this->dataPtr->skipUnsampledFaces = _skip;
+}
+
+//////////////////////////////////////////////////
+void Ogre2WideAngleCamera::UpdateRenderedFaces()
+{
+  if (this->ImageWidth() == 0u || this->ImageHeight() == 0u)
+    return;
+
+  const CameraLens &lens = this->Lens();
+  const math::Vector3d fun = lens.MappingFunctionAsVector3d();
+  const std::array<double, 13> key = {
+    lens.C1(), lens.C2(), lens.C3(), lens.F(), lens.CutOffAngle(),
+    lens.ScaleToHFOV() ? 1.0 : 0.0, fun.X(), fun.Y(), fun.Z(),
+    this->HFOV().Radian(),
+    static_cast<double>(this->ImageWidth()) / this->ImageHeight(),
+    static_cast<double>(this->dataPtr->envTextureSize),
+    this->dataPtr->skipUnsampledFaces ? 1.0 : 0.0};
+  if (key == this->dataPtr->renderedFacesKey)
+    return;
+  this->dataPtr->renderedFacesKey = key;
+
+  if (!this->dataPtr->skipUnsampledFaces)
+  {
+    for (uint32_t i = 0u; i < kWideAngleNumCubemapFaces; ++i)
+      this->dataPtr->faceRendered[i] = true;
+    return;
+  }
+
+  // Evaluate the lens the same way the final pass shader does
+  // (wide_lens_map_fp.glsl) over a grid of image positions, and collect the
+  // faces of the cubemap directions it samples.
+  const double ratio = key[10];
+  double f = lens.F();
+  if (lens.ScaleToHFOV())
+  {
+    const float param = static_cast<float>(
+        (this->HFOV().Radian() / 2) / lens.C2() + lens.C3());
+    f = 1.0 / (lens.C1() * lens.ApplyMappingFunction(param));
+  }
+  const double param2 = lens.CutOffAngle() / lens.C2() + lens.C3();
+  const double cutRadius = lens.C1() * f * (fun.X() * std::sin(param2) +
+      fun.Y() * std::tan(param2) + fun.Z() * param2);
+
+  // Cubemap sampling filters across face edges, so a face is also needed
+  // when a direction is within two texels of it
+  const double margin =
+      1.0 - 4.0 / std::max(this->dataPtr->envTextureSize, 8u);
+
+  bool rendered[6] = {false, false, false, false, false, false};
+  const unsigned int kSamples = 257u;
+  for (unsigned int i = 0u; i < kSamples; ++i)
+  {
+    const double x = -1.0 + 2.0 * i / (kSamples - 1u);
+    for (unsigned int j = 0u; j < kSamples; ++j)
+    {
+      const double y = (-1.0 + 2.0 * j / (kSamples - 1u)) / ratio;
+      const double r = std::sqrt(x * x + y * y);
+      // pixels past the cut off radius are black
+      if (r >= cutRadius)
+        continue;
+
+      math::Vector3d dir(0.0, 0.0, 1.0);
+      if (r > 1e-9)
+      {
+        const double param = r / (lens.C1() * f);
+        double theta = 0.0;
+        if (fun.X() > 0)
+        {
+          if (param > 1.0)
+            continue;
+          theta = std::asin(param);
+        }
+        else if (fun.Y() > 0)
+          theta = std::atan(param);
+        else if (fun.Z() > 0)
+          theta = param;
+        theta = (theta - lens.C3()) * lens.C2();
+        dir.Set(-std::sin(theta) * x / r, std::sin(theta) * y / r,
+            std::cos(theta));
+      }
+
+      const math::Vector3d dirAbs = dir.Abs();
+      const double maxAbs = dirAbs.Max();
+      for (unsigned int axis = 0u; axis < 3u; ++axis)
+      {
+        if (dirAbs[axis] >= maxAbs * margin)
+          rendered[axis * 2u + (dir[axis] < 0.0 ? 1u : 0u)] = true;
+      }
+    }
+  }
+
+  // With an invalid lens nothing may be sampled, keep all faces then
+  const bool any = std::any_of(std::begin(rendered), std::end(rendered),
+      [](bool _rendered) { return _rendered; });
+  for (uint32_t i = 0u; i < kWideAngleNumCubemapFaces; ++i)
+    this->dataPtr->faceRendered[i] = !any || rendered[i];
+}
+
 //////////////////////////////////////////////////
 void Ogre2WideAngleCamera::PostRender()
 {
+  GZ_RENDERING_PROFILE("Ogre2WideAngleCamera::PostRender");
   for (RenderPassPtr &pass : this->dataPtr->renderPasses)
   {
     pass->PostRender();
@@ -1265,34 +1408,32 @@ void Ogre2WideAngleCamera::PostRender()
   const unsigned int height = this->ImageHeight();
 
   // blit data from gpu to cpu
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreStitchTexture[kStichFinalTexture],
-                           0u, 0u);
-  Ogre::TextureBox box = image.getData(0u);
-
-  // Convert in-place from RGBA32 to RGB24 reusing the same memory region.
-  // The data contained will no longer be meaningful to Image2, but that
-  // class will no longer manipulate that data. We also store it contiguously
-  // (which is what gazebo expects), instead of aligning rows to 4 bytes like
-  // Ogre does. This saves RAM and lots of bandwidth.
-  uint8_t *RESTRICT_ALIAS rgb24 =
-    reinterpret_cast<uint8_t * RESTRICT_ALIAS>(box.data);
-  for (size_t y = 0; y < box.height; ++y)
+  this->dataPtr->readback.SetLatency(this->ReadbackLatency());
+  Ogre::TextureBox box;
+  if (!this->dataPtr->readback.Read(
+      this->dataPtr->ogreStitchTexture[kStichFinalTexture], box))
   {
-    uint8_t *RESTRICT_ALIAS rgba32 =
-      reinterpret_cast<uint8_t * RESTRICT_ALIAS>(box.at(0u, y, 0u));
-    for (size_t x = 0; x < box.width; ++x)
-    {
-      *rgb24++ = *rgba32++;
-      *rgb24++ = *rgba32++;
-      *rgb24++ = *rgba32++;
-      ++rgba32;
-    }
+    return;
   }
+  this->readbackFrameId = this->dataPtr->readback.FrameId();
+  this->readbackFrameTime = this->dataPtr->readback.FrameTime();
+
+  // Convert from RGBA32 to RGB24. The mapped staging memory must not be
+  // written to, so the output goes into our own buffer. We also store it
+  // contiguously (which is what gazebo expects), instead of aligning rows to
+  // 4 bytes like Ogre does. This saves RAM and lots of bandwidth.
+  this->dataPtr->wideAngleImage.resize(box.width * box.height * 3u);
+  PixelUtil::Convert(box.data, PF_R8G8B8A8,
+      static_cast<unsigned int>(box.bytesPerRow),
+      this->dataPtr->wideAngleImage.data(), PF_R8G8B8, 0u,
+      static_cast<unsigned int>(box.width),
+      static_cast<unsigned int>(box.height));
+
+  this->dataPtr->readback.Unmap();
 
   PixelFormat format = this->ImageFormat();
   unsigned int channelCount = PixelUtil::ChannelCount(format);
-  this->dataPtr->newImageFrame(reinterpret_cast<uint8_t *>(box.data), width,
+  this->dataPtr->newImageFrame(this->dataPtr->wideAngleImage.data(), width,
                                height, channelCount,
                                PixelUtil::Name(this->ImageFormat()));
 
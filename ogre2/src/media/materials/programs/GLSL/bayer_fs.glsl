@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#version ogre_glsl_ver_330
+
+// Mosaics a rendered image into a single channel Bayer image. Every output
+// pixel keeps the red, green or blue channel of the same input pixel, as
+// selected by its position in the 2x2 tile of the pattern.
+
+// The input texture, which is set up by the Ogre Compositor infrastructure.
+vulkan_layout( ogre_t0 ) uniform texture2D RT;
+vulkan( layout( ogre_s0 ) uniform sampler rtSampler );
+
+vulkan( layout( ogre_P0 ) uniform Params { )
+  // Channel sampled at each site of the tile, 0: red, 1: green, 2: blue,
+  // indexed by (row % 2) * 2 + column % 2
+  uniform vec4 tile;
+vulkan( }; )
+
+vulkan_layout( location = 0 )
+out vec4 fragColor;
+
+// Encode a linear color value to sRGB. The input is read from an sRGB
+// texture, so it is decoded when sampled, while the single channel output
+// is not an sRGB texture.
+float toSRGB(float _c)
+{
+  return (_c <= 0.0031308) ? _c * 12.92 : 1.055 * pow(_c, 1.0 / 2.4) - 0.055;
+}
+
+void main()
+{
+  // render targets have their first row at the top of the image, so the
+  // fragment coordinates are also the coordinates of the image pixel
+  ivec2 pixel = ivec2(gl_FragCoord.xy);
+  vec4 color = texelFetch(vkSampler2D(RT, rtSampler), pixel, 0);
+
+  int site = (pixel.y & 1) * 2 + (pixel.x & 1);
+  float value = color[int(tile[site])];
+
+  fragColor = vec4(toSRGB(value), 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#version ogre_glsl_ver_330
+
+// Packs the depth of the depth camera output into a single channel texture,
+// so that depth only subscribers do not have to read back the full point
+// cloud data. The output is either:
+//  - depth in meters, for 32 bit and 16 bit float textures
+//  - depth in millimeters, for a 16 bit normalized texture. Invalid depth
+//    values are 0, like in the depth images of RGB-D sensors.
+
+vulkan_layout( ogre_t0 ) uniform utexture2D inputTexture;
+
+vulkan( layout( ogre_P0 ) uniform Params { )
+  // x: 0 for depth in meters, 1 for depth in millimeters
+  uniform vec4 params;
+vulkan( }; )
+
+vulkan_layout( location = 0 )
+out vec4 fragColor;
+
+void main()
+{
+  // See depth_camera_final_fs.glsl for why the input is an uint texture
+  uvec4 p = texelFetch(inputTexture, ivec2(gl_FragCoord.xy), 0);
+  float depth = uintBitsToFloat(p.x);
+
+  if (params.x > 0.5)
+  {
+    // 65535 mm is the largest value of the normalized output
+    if (isinf(depth) || isnan(depth) || depth <= 0.0)
+      depth = 0.0;
+    else
+      depth = min(round(depth * 1000.0), 65535.0) / 65535.0;
+  }
+
+  fragColor = vec4(depth, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#version ogre_glsl_ver_330
+
+vulkan_layout( ogre_t0 ) uniform texture2D fontAtlas;
+vulkan( layout( ogre_s0 ) uniform sampler texSampler );
+
+vulkan( layout( ogre_P0 ) uniform Params { )
+  // selects the channel of the atlas that holds the glyph coverage
+  uniform vec4 coverageMask;
+vulkan( }; )
+
+vulkan_layout( location = 0 )
+in block
+{
+  vec2 uv0;
+  vec4 colour;
+} inPs;
+
+vulkan_layout( location = 0 )
+out vec4 fragColor;
+
+void main()
+{
+  float coverage = dot(texture(vkSampler2D(fontAtlas, texSampler), inPs.uv0),
+      coverageMask);
+  fragColor = vec4(inPs.colour.rgb, inPs.colour.a * coverage);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#version ogre_glsl_ver_330
+
+vulkan_layout( OGRE_POSITION ) in vec4 vertex;
+vulkan_layout( OGRE_DIFFUSE ) in vec4 colour;
+// texture coordinates in xy, offset of the glyph corner in view space in zw
+vulkan_layout( OGRE_TEXCOORD0 ) in vec4 uv0;
+
+vulkan( layout( ogre_P0 ) uniform Params { )
+  uniform mat4 worldView;
+  uniform mat4 projection;
+vulkan( }; )
+
+vulkan_layout( location = 0 )
+out block
+{
+  vec2 uv0;
+  vec4 colour;
+} outVs;
+
+out gl_PerVertex
+{
+  vec4 gl_Position;
+};
+
+void main()
+{
+  // the vertex is the anchor of the text, offset the glyph corner in view
+  // space so the text always faces the camera
+  vec4 viewPos = worldView * vertex;
+  viewPos.xy += uv0.zw;
+  gl_Position = projection * viewPos;
+
+  outVs.uv0 = uv0.xy;
+  outVs.colour = colour;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#version ogre_glsl_ver_330
+
+// Packs a rendered image into the bytes of a YUV image. The output is a
+// single channel texture, each of its pixels is one byte of the image:
+//  - NV12: the Y plane followed by a half height plane of interleaved U and
+//    V samples, the output is as wide as the image and 1.5 times as high
+//  - I420: the Y plane followed by the U then the V plane, each holding a
+//    quarter of the samples of the Y plane, with the same output size
+//  - YUYV: Y0 U Y1 V for each pair of pixels, the output is twice as wide
+//    as the image
+// Colors are encoded with the BT.601 limited range matrix. Each chroma
+// sample is computed from the average color of the 2x2 (4:2:0) or 2x1
+// (4:2:2) block of pixels sharing it, like convertRGBToYUV does.
+
+// The input texture, which is set up by the Ogre Compositor infrastructure.
+vulkan_layout( ogre_t0 ) uniform texture2D RT;
+vulkan( layout( ogre_s0 ) uniform sampler rtSampler );
+
+vulkan( layout( ogre_P0 ) uniform Params { )
+  // x: image width, y: image height, z: packing, 0: NV12, 1: I420, 2: YUYV
+  uniform vec4 params;
+vulkan( }; )
+
+vulkan_layout( location = 0 )
+out vec4 fragColor;
+
+// Encode a linear color value to sRGB. The input is read from an sRGB
+// texture, so it is decoded when sampled, while the single channel output
+// is not an sRGB texture.
+float toSRGB(float _c)
+{
+  return (_c <= 0.0031308) ? _c * 12.92 : 1.055 * pow(_c, 1.0 / 2.4) - 0.055;
+}
+
+// sRGB encoded color of a pixel of the image
+vec3 fetchColor(ivec2 _pixel)
+{
+  vec3 c = texelFetch(vkSampler2D(RT, rtSampler), _pixel, 0).rgb;
+  return vec3(toSRGB(c.r), toSRGB(c.g), toSRGB(c.b));
+}
+
+float luma(vec3 _c)
+{
+  return dot(_c, vec3(66.0, 129.0, 25.0)) / 256.0 + 16.0 / 255.0;
+}
+
+float chromaU(vec3 _c)
+{
+  return dot(_c, vec3(-38.0, -74.0, 112.0)) / 256.0 + 128.0 / 255.0;
+}
+
+float chromaV(vec3 _c)
+{
+  return dot(_c, vec3(112.0, -94.0, -18.0)) / 256.0 + 128.0 / 255.0;
+}
+
+void main()
+{
+  // render targets have their first row at the top of the image, so the
+  // fragment coordinates are also the coordinates of the output byte
+  ivec2 pixel = ivec2(gl_FragCoord.xy);
+  int width = int(params.x);
+  int height = int(params.y);
+  int packing = int(params.z);
+
+  float value;
+  if (packing == 2)
+  {
+    // YUYV: every 4 bytes hold the samples of 2 pixels
+    ivec2 first = ivec2((pixel.x >> 2) * 2, pixel.y);
+    int site = pixel.x & 3;
+    if (site == 0 || site == 2)
+    {
+      value = luma(fetchColor(first + ivec2(site >> 1, 0)));
+    }
+    else
+    {
+      vec3 c = (fetchColor(first) + fetchColor(first + ivec2(1, 0))) * 0.5;
+      value = (site == 1) ? chromaU(c) : chromaV(c);
+    }
+  }
+  else if (pixel.y < height)
+  {
+    value = luma(fetchColor(pixel));
+  }
+  else
+  {
+    // chroma planes, one sample per 2x2 block of pixels
+    ivec2 block;
+    bool isU;
+    if (packing == 0)
+    {
+      block = ivec2(pixel.x >> 1, pixel.y - height);
+      isU = (pixel.x & 1) == 0;
+    }
+    else
+    {
+      int chromaWidth = width / 2;
+      int planeSize = chromaWidth * (height / 2);
+      int index = (pixel.y - height) * width + pixel.x;
+      isU = index < planeSize;
+      if (!isU)
+        index -= planeSize;
+      block = ivec2(index % chromaWidth, index / chromaWidth);
+    }
+
+    ivec2 first = block * 2;
+    vec3 c = (fetchColor(first) + fetchColor(first + ivec2(1, 0)) +
+        fetchColor(first + ivec2(0, 1)) + fetchColor(first + ivec2(1, 1))) *
+        0.25;
+    value = isU ? chromaU(c) : chromaV(c);
+  }
+
+  fragColor = vec4(value, 0.0, 0.0, 1.0);
+}
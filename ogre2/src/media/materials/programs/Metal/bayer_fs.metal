@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// For details and documentation see: bayer_fs.glsl
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct PS_INPUT
+{
+  float2 uv0;
+};
+
+struct Params
+{
+  // Channel sampled at each site of the tile, 0: red, 1: green, 2: blue,
+  // indexed by (row % 2) * 2 + column % 2
+  float4 tile;
+};
+
+float toSRGB(float _c)
+{
+  return (_c <= 0.0031308) ? _c * 12.92 : 1.055 * pow(_c, 1.0 / 2.4) - 0.055;
+}
+
+fragment float4 main_metal
+(
+  PS_INPUT inPs [[stage_in]],
+  float4 gl_FragCoord [[position]],
+  texture2d<float> RT [[texture(0)]],
+  constant Params &p [[buffer(PARAMETER_SLOT)]]
+)
+{
+  uint2 pixel = uint2(gl_FragCoord.xy);
+  float4 color = RT.read(pixel);
+
+  uint site = (pixel.y & 1u) * 2u + (pixel.x & 1u);
+  float value = color[int(p.tile[site])];
+
+  return float4(toSRGB(value), 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// For details and documentation see: depth_camera_pack_fs.glsl
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct PS_INPUT
+{
+  float2 uv0;
+};
+
+struct Params
+{
+  // x: 0 for depth in meters, 1 for depth in millimeters
+  float4 params;
+};
+
+fragment float4 main_metal
+(
+  PS_INPUT inPs [[stage_in]],
+  float4 gl_FragCoord [[position]],
+  texture2d<uint> inputTexture [[texture(0)]],
+  constant Params &p [[buffer(PARAMETER_SLOT)]]
+)
+{
+  uint4 texel = inputTexture.read(uint2(gl_FragCoord.xy), 0);
+  float depth = as_type<float>(texel.x);
+
+  if (p.params.x > 0.5)
+  {
+    if (isinf(depth) || isnan(depth) || depth <= 0.0)
+      depth = 0.0;
+    else
+      depth = min(round(depth * 1000.0), 65535.0) / 65535.0;
+  }
+
+  return float4(depth, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct VS_INPUT
+{
+  float4 position [[attribute(VES_POSITION)]];
+  float4 colour   [[attribute(VES_DIFFUSE)]];
+  // texture coordinates in xy, offset of the glyph corner in view space in zw
+  float4 uv0      [[attribute(VES_TEXTURE_COORDINATES0)]];
+};
+
+struct PS_INPUT
+{
+  float4 gl_Position [[position]];
+  float2 uv0;
+  float4 colour;
+};
+
+struct Params
+{
+  float4x4 worldView;
+  float4x4 projection;
+};
+
+vertex PS_INPUT main_metal
+(
+  VS_INPUT input [[stage_in]],
+  constant Params &p [[buffer(PARAMETER_SLOT)]]
+)
+{
+  PS_INPUT outVs;
+
+  // the vertex is the anchor of the text, offset the glyph corner in view
+  // space so the text always faces the camera
+  float4 viewPos = p.worldView * input.position;
+  viewPos.xy += input.uv0.zw;
+  outVs.gl_Position = p.projection * viewPos;
+
+  outVs.uv0 = input.uv0.xy;
+  outVs.colour = input.colour;
+
+  return outVs;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// For details and documentation see: yuv_fs.glsl
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct PS_INPUT
+{
+  float2 uv0;
+};
+
+struct Params
+{
+  // x: image width, y: image height, z: packing, 0: NV12, 1: I420, 2: YUYV
+  float4 params;
+};
+
+float toSRGB(float _c)
+{
+  return (_c <= 0.0031308) ? _c * 12.92 : 1.055 * pow(_c, 1.0 / 2.4) - 0.055;
+}
+
+float3 fetchColor(texture2d<float> _rt, int2 _pixel)
+{
+  float3 c = _rt.read(uint2(_pixel)).rgb;
+  return float3(toSRGB(c.r), toSRGB(c.g), toSRGB(c.b));
+}
+
+float luma(float3 _c)
+{
+  return dot(_c, float3(66.0, 129.0, 25.0)) / 256.0 + 16.0 / 255.0;
+}
+
+float chromaU(float3 _c)
+{
+  return dot(_c, float3(-38.0, -74.0, 112.0)) / 256.0 + 128.0 / 255.0;
+}
+
+float chromaV(float3 _c)
+{
+  return dot(_c, float3(112.0, -94.0, -18.0)) / 256.0 + 128.0 / 255.0;
+}
+
+fragment float4 main_metal
+(
+  PS_INPUT inPs [[stage_in]],
+  float4 gl_FragCoord [[position]],
+  texture2d<float> RT [[texture(0)]],
+  constant Params &p [[buffer(PARAMETER_SLOT)]]
+)
+{
+  int2 pixel = int2(gl_FragCoord.xy);
+  int width = int(p.params.x);
+  int height = int(p.params.y);
+  int packing = int(p.params.z);
+
+  float value;
+  if (packing == 2)
+  {
+    int2 first = int2((pixel.x >> 2) * 2, pixel.y);
+    int site = pixel.x & 3;
+    if (site == 0 || site == 2)
+    {
+      value = luma(fetchColor(RT, first + int2(site >> 1, 0)));
+    }
+    else
+    {
+      float3 c = (fetchColor(RT, first) +
+          fetchColor(RT, first + int2(1, 0))) * 0.5;
+      value = (site == 1) ? chromaU(c) : chromaV(c);
+    }
+  }
+  else if (pixel.y < height)
+  {
+    value = luma(fetchColor(RT, pixel));
+  }
+  else
+  {
+    int2 block;
+    bool isU;
+    if (packing == 0)
+    {
+      block = int2(pixel.x >> 1, pixel.y - height);
+      isU = (pixel.x & 1) == 0;
+    }
+    else
+    {
+      int chromaWidth = width / 2;
+      int planeSize = chromaWidth * (height / 2);
+      int index = (pixel.y - height) * width + pixel.x;
+      isU = index < planeSize;
+      if (!isU)
+        index -= planeSize;
+      block = int2(index % chromaWidth, index / chromaWidth);
+    }
+
+    int2 first = block * 2;
+    float3 c = (fetchColor(RT, first) + fetchColor(RT, first + int2(1, 0)) +
+        fetchColor(RT, first + int2(0, 1)) +
+        fetchColor(RT, first + int2(1, 1))) * 0.25;
+    value = isU ? chromaU(c) : chromaV(c);
+  }
+
+  return float4(value, 0.0, 0.0, 1.0);
+}
@@ -62,6 +62,13 @@ void OptixVisual::PreRender()
   }
 }
 
+//////////////////////////////////////////////////
+bool OptixVisual::PreRenderEveryFrame() const
+{
+  // poses and scales are written to the device every frame
+  return true;
+}
+
 //////////////////////////////////////////////////
 GeometryStorePtr OptixVisual::Geometries() const
 {
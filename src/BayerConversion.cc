@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+  #define GZ_RENDERING_BAYER_SSSE3
+  #include <tmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define GZ_RENDERING_BAYER_NEON
+  #include <arm_neon.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
+#include "gz/rendering/Utils.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief RGB channel sampled at each site of a 2x2 Bayer tile, indexed by
+  /// [row % 2][column % 2]
+  using BayerTile = unsigned int[2][2];
+
+  //////////////////////////////////////////////////
+  /// \brief Get the 2x2 tile of a Bayer format
+  /// \param[in] _format Bayer pixel format
+  /// \param[out] _tile Channel sampled at each site of the tile
+  /// \return False if the format is not a Bayer format
+  bool BayerPattern(PixelFormat _format, BayerTile &_tile)
+  {
+    // 0: red, 1: green, 2: blue
+    switch (_format)
+    {
+      case PF_BAYER_RGGB8:
+        _tile[0][0] = 0u; _tile[0][1] = 1u;
+        _tile[1][0] = 1u; _tile[1][1] = 2u;
+        return true;
+      case PF_BAYER_BGGR8:
+        _tile[0][0] = 2u; _tile[0][1] = 1u;
+        _tile[1][0] = 1u; _tile[1][1] = 0u;
+        return true;
+      case PF_BAYER_GBRG8:
+        _tile[0][0] = 1u; _tile[0][1] = 0u;
+        _tile[1][0] = 2u; _tile[1][1] = 1u;
+        return true;
+      case PF_BAYER_GRBG8:
+        _tile[0][0] = 1u; _tile[0][1] = 2u;
+        _tile[1][0] = 0u; _tile[1][1] = 1u;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Sample one row of an R8G8B8 image into a Bayer row
+  /// \param[in] _src Source RGB row
+  /// \param[out] _dst Destination Bayer row
+  /// \param[in] _width Number of pixels in the row
+  /// \param[in] _even Channel sampled at even columns
+  /// \param[in] _odd Channel sampled at odd columns
+  void MosaicRow(const uint8_t *_src, uint8_t *_dst, unsigned int _width,
+      unsigned int _even, unsigned int _odd)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_BAYER_SSSE3)
+    // 16 pixels (48 bytes) per iteration. Each 16 byte block of the source
+    // is shuffled to the output lanes it contributes to, the rest is zeroed.
+    alignas(16) uint8_t masks[3][16];
+    for (unsigned int k = 0u; k < 16u; ++k)
+    {
+      unsigned int idx = k * 3u + ((k % 2u) ? _odd : _even);
+      for (unsigned int b = 0u; b < 3u; ++b)
+      {
+        masks[b][k] = (idx / 16u == b) ?
+            static_cast<uint8_t>(idx % 16u) : 0x80u;
+      }
+    }
+    const __m128i mask0 =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(masks[0]));
+    const __m128i mask1 =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(masks[1]));
+    const __m128i mask2 =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(masks[2]));
+    for (; x + 16u <= _width; x += 16u)
+    {
+      const __m128i *src = reinterpret_cast<const __m128i *>(_src + x * 3u);
+      __m128i out = _mm_or_si128(
+          _mm_or_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128(src), mask0),
+            _mm_shuffle_epi8(_mm_loadu_si128(src + 1), mask1)),
+          _mm_shuffle_epi8(_mm_loadu_si128(src + 2), mask2));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + x), out);
+    }
+#elif defined(GZ_RENDERING_BAYER_NEON)
+    // deinterleave 16 pixels and pick the even / odd lane channel
+    static const uint8_t evenLanes[16] = {0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF, 0,
+        0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF, 0};
+    const uint8x16_t select = vld1q_u8(evenLanes);
+    for (; x + 16u <= _width; x += 16u)
+    {
+      uint8x16x3_t rgb = vld3q_u8(_src + x * 3u);
+      vst1q_u8(_dst + x,
+          vbslq_u8(select, rgb.val[_even], rgb.val[_odd]));
+    }
+#endif
+    // x is even here, so the tail starts on an even column
+    for (; x + 1u < _width; x += 2u)
+    {
+      _dst[x] = _src[x * 3u + _even];
+      _dst[x + 1u] = _src[x * 3u + 3u + _odd];
+    }
+    if (x < _width)
+      _dst[x] = _src[x * 3u + _even];
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Interpolate one pixel of an RGB image from a Bayer image. This
+  /// handles any pixel, including the ones on the image border.
+  /// \param[in] _src Bayer image data
+  /// \param[out] _dst RGB pixel
+  /// \param[in] _width Image width
+  /// \param[in] _height Image height
+  /// \param[in] _x Column of the pixel
+  /// \param[in] _y Row of the pixel
+  /// \param[in] _tile Bayer tile of the source image
+  void DemosaicPixel(const uint8_t *_src, uint8_t *_dst, unsigned int _width,
+      unsigned int _height, unsigned int _x, unsigned int _y,
+      const BayerTile &_tile)
+  {
+    const unsigned int x0 = _x > 0u ? _x - 1u : _x;
+    const unsigned int x1 = std::min(_x + 1u, _width - 1u);
+    const unsigned int y0 = _y > 0u ? _y - 1u : _y;
+    const unsigned int y1 = std::min(_y + 1u, _height - 1u);
+
+    // Bilinear interpolation: the average of the nearest sites of the
+    // same color in the 3x3 neighborhood
+    unsigned int sum[3] = {0u, 0u, 0u};
+    unsigned int count[3] = {0u, 0u, 0u};
+    for (unsigned int j = y0; j <= y1; ++j)
+    {
+      const uint8_t *srcRow = _src + static_cast<std::size_t>(j) * _width;
+      for (unsigned int i = x0; i <= x1; ++i)
+      {
+        const unsigned int c = _tile[j % 2u][i % 2u];
+        sum[c] += srcRow[i];
+        ++count[c];
+      }
+    }
+
+    const unsigned int own = _tile[_y % 2u][_x % 2u];
+    for (unsigned int c = 0u; c < 3u; ++c)
+    {
+      if (c == own)
+      {
+        _dst[c] = _src[static_cast<std::size_t>(_y) * _width + _x];
+      }
+      else if (count[c] > 0u)
+      {
+        _dst[c] = static_cast<uint8_t>((sum[c] + count[c] / 2u) / count[c]);
+      }
+      else
+      {
+        // only happens for images that are a single pixel wide or high
+        _dst[c] = 0u;
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Interpolate one row of an RGB image from a Bayer image
+  /// \param[in] _src Bayer image data
+  /// \param[out] _dst RGB image data
+  /// \param[in] _width Image width
+  /// \param[in] _height Image height
+  /// \param[in] _y Row to interpolate
+  /// \param[in] _tile Bayer tile of the source image
+  void DemosaicRow(const uint8_t *_src, uint8_t *_dst, unsigned int _width,
+      unsigned int _height, unsigned int _y, const BayerTile &_tile)
+  {
+    uint8_t *dstRow = _dst + static_cast<std::size_t>(_y) * _width * 3u;
+    if (_y == 0u || _y + 1u >= _height || _width < 3u)
+    {
+      for (unsigned int x = 0u; x < _width; ++x)
+        DemosaicPixel(_src, dstRow + x * 3u, _width, _height, x, _y, _tile);
+      return;
+    }
+
+    const uint8_t *up = _src + static_cast<std::size_t>(_y - 1u) * _width;
+    const uint8_t *row = up + _width;
+    const uint8_t *down = row + _width;
+
+    DemosaicPixel(_src, dstRow, _width, _height, 0u, _y, _tile);
+    for (unsigned int x = 1u; x + 1u < _width; ++x)
+    {
+      uint8_t *dst = dstRow + x * 3u;
+      const unsigned int own = _tile[_y % 2u][x % 2u];
+      dst[own] = row[x];
+      if (own == 1u)
+      {
+        // green site: the other two colors are either side horizontally
+        // and vertically
+        dst[_tile[_y % 2u][(x + 1u) % 2u]] =
+            static_cast<uint8_t>((row[x - 1u] + row[x + 1u] + 1u) / 2u);
+        dst[_tile[(_y + 1u) % 2u][x % 2u]] =
+            static_cast<uint8_t>((up[x] + down[x] + 1u) / 2u);
+      }
+      else
+      {
+        // red or blue site: green is on the cross, the other color on the
+        // diagonals
+        dst[1u] = static_cast<uint8_t>((row[x - 1u] + row[x + 1u] +
+            up[x] + down[x] + 2u) / 4u);
+        dst[2u - own] = static_cast<uint8_t>((up[x - 1u] + up[x + 1u] +
+            down[x - 1u] + down[x + 1u] + 2u) / 4u);
+      }
+    }
+    DemosaicPixel(_src, dstRow + (_width - 1u) * 3u, _width, _height,
+        _width - 1u, _y, _tile);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Run a function over bands of rows, on multiple threads if
+  /// requested
+  /// \param[in] _height Number of rows
+  /// \param[in] _threadCount Number of threads, 0 to use one per core
+  /// \param[in] _func Function called with the first and one past the last
+  /// row of a band
+  void ForEachBand(unsigned int _height, unsigned int _threadCount,
+      const std::function<void(unsigned int, unsigned int)> &_func)
+  {
+    if (_threadCount == 0u)
+      _threadCount = std::max(1u, std::thread::hardware_concurrency());
+    _threadCount = std::min(_threadCount, _height);
+
+    if (_threadCount <= 1u)
+    {
+      _func(0u, _height);
+      return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(_threadCount - 1u);
+    const unsigned int band = (_height + _threadCount - 1u) / _threadCount;
+    for (unsigned int start = band; start < _height; start += band)
+    {
+      workers.emplace_back(_func, start, std::min(start + band, _height));
+    }
+    _func(0u, band);
+    for (auto &worker : workers)
+      worker.join();
+  }
+}
+
+namespace gz
+{
+namespace rendering
+{
+inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+//
+/////////////////////////////////////////////////
+bool convertRGBToBayer(const Image &_image, Image &_bayerImage,
+    unsigned int _threadCount)
+{
+  BayerTile tile;
+  if (!BayerPattern(_bayerImage.Format(), tile))
+  {
+    gzerr << "Output image format [" << PixelUtil::Name(_bayerImage.Format())
+          << "] is not a Bayer format" << std::endl;
+    return false;
+  }
+
+  if (_image.Format() != PF_R8G8B8)
+  {
+    gzerr << "Input image format [" << PixelUtil::Name(_image.Format())
+          << "] is not supported. Only R8G8B8 can be converted to Bayer"
+          << std::endl;
+    return false;
+  }
+
+  if (_image.Width() != _bayerImage.Width() ||
+      _image.Height() != _bayerImage.Height())
+  {
+    gzerr << "Input and output image dimensions do not match" << std::endl;
+    return false;
+  }
+
+  const unsigned int width = _image.Width();
+  const unsigned int height = _image.Height();
+  const uint8_t *src = _image.Data<uint8_t>();
+  uint8_t *dst = _bayerImage.Data<uint8_t>();
+  if (width == 0u || height == 0u || !src || !dst)
+    return true;
+
+  ForEachBand(height, _threadCount,
+      [&](unsigned int _start, unsigned int _end)
+      {
+        for (unsigned int y = _start; y < _end; ++y)
+        {
+          const std::size_t offset = static_cast<std::size_t>(y) * width;
+          MosaicRow(src + offset * 3u, dst + offset, width,
+              tile[y % 2u][0], tile[y % 2u][1]);
+        }
+      });
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool convertBayerToRGB(const Image &_bayerImage, Image &_image,
+    unsigned int _threadCount)
+{
+  BayerTile tile;
+  if (!BayerPattern(_bayerImage.Format(), tile))
+  {
+    gzerr << "Input image format [" << PixelUtil::Name(_bayerImage.Format())
+          << "] is not a Bayer format" << std::endl;
+    return false;
+  }
+
+  if (_image.Format() != PF_R8G8B8)
+  {
+    gzerr << "Output image format [" << PixelUtil::Name(_image.Format())
+          << "] is not supported. Bayer images can only be converted to "
+          << "R8G8B8" << std::endl;
+    return false;
+  }
+
+  if (_image.Width() != _bayerImage.Width() ||
+      _image.Height() != _bayerImage.Height())
+  {
+    gzerr << "Input and output image dimensions do not match" << std::endl;
+    return false;
+  }
+
+  const unsigned int width = _image.Width();
+  const unsigned int height = _image.Height();
+  const uint8_t *src = _bayerImage.Data<uint8_t>();
+  uint8_t *dst = _image.Data<uint8_t>();
+  if (width == 0u || height == 0u || !src || !dst)
+    return true;
+
+  ForEachBand(height, _threadCount,
+      [&](unsigned int _start, unsigned int _end)
+      {
+        for (unsigned int y = _start; y < _end; ++y)
+          DemosaicRow(src, dst, width, height, y, tile);
+      });
+  return true;
+}
+}
+}
+}
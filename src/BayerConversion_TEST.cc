@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
+#include "gz/rendering/Utils.hh"
+
+using namespace gz;
+using namespace rendering;
+
+static const PixelFormat kBayerFormats[] =
+    {PF_BAYER_RGGB8, PF_BAYER_BGGR8, PF_BAYER_GBRG8, PF_BAYER_GRBG8};
+
+/// \brief Channel sampled at the top left 2x2 tile of each bayer format,
+/// in row major order
+static const unsigned int kBayerTiles[][4] =
+    {{0, 1, 1, 2}, {2, 1, 1, 0}, {1, 0, 2, 1}, {1, 2, 0, 1}};
+
+/////////////////////////////////////////////////
+/// \brief Create an RGB image with a distinct value in each channel
+Image PatternImage(unsigned int _width, unsigned int _height)
+{
+  Image image(_width, _height, PF_R8G8B8);
+  uint8_t *data = image.Data<uint8_t>();
+  for (unsigned int i = 0; i < _width * _height * 3; ++i)
+    data[i] = static_cast<uint8_t>(i * 7 + i / 3);
+  return image;
+}
+
+/////////////////////////////////////////////////
+TEST(BayerConversionTest, Mosaic)
+{
+  // odd sizes cover the scalar tail after the SIMD loop
+  const unsigned int width = 37u;
+  const unsigned int height = 23u;
+  Image rgb = PatternImage(width, height);
+  const uint8_t *rgbData = rgb.Data<uint8_t>();
+
+  for (unsigned int f = 0; f < 4; ++f)
+  {
+    Image bayer(width, height, kBayerFormats[f]);
+    EXPECT_TRUE(convertRGBToBayer(rgb, bayer));
+    const uint8_t *bayerData = bayer.Data<uint8_t>();
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        unsigned int c = kBayerTiles[f][(y % 2) * 2 + (x % 2)];
+        EXPECT_EQ(rgbData[(y * width + x) * 3 + c], bayerData[y * width + x])
+            << PixelUtil::Name(kBayerFormats[f]) << " " << x << "," << y;
+      }
+    }
+
+    // the allocating version produces the same data
+    Image legacy = convertRGBToBayer(rgb, kBayerFormats[f]);
+    EXPECT_EQ(kBayerFormats[f], legacy.Format());
+    EXPECT_EQ(0, memcmp(legacy.Data(), bayer.Data(), bayer.MemorySize()));
+
+    // so does the multithreaded version
+    Image threaded(width, height, kBayerFormats[f]);
+    EXPECT_TRUE(convertRGBToBayer(rgb, threaded, 4u));
+    EXPECT_EQ(0, memcmp(threaded.Data(), bayer.Data(), bayer.MemorySize()));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BayerConversionTest, RoundTrip)
+{
+  const unsigned int width = 64u;
+  const unsigned int height = 48u;
+
+  for (unsigned int f = 0; f < 4; ++f)
+  {
+    // uniform color is recovered exactly
+    Image flat(width, height, PF_R8G8B8);
+    uint8_t *flatData = flat.Data<uint8_t>();
+    for (unsigned int i = 0; i < width * height; ++i)
+    {
+      flatData[i * 3] = 200u;
+      flatData[i * 3 + 1] = 100u;
+      flatData[i * 3 + 2] = 50u;
+    }
+
+    Image bayer(width, height, kBayerFormats[f]);
+    Image result(width, height, PF_R8G8B8);
+    EXPECT_TRUE(convertRGBToBayer(flat, bayer));
+    EXPECT_TRUE(convertBayerToRGB(bayer, result));
+    EXPECT_EQ(0, memcmp(flat.Data(), result.Data(), flat.MemorySize()))
+        << PixelUtil::Name(kBayerFormats[f]);
+
+    // linear gradients are recovered away from the borders, where the
+    // interpolation has to fall back to one sided neighbors
+    Image gradient(width, height, PF_R8G8B8);
+    uint8_t *gradientData = gradient.Data<uint8_t>();
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        gradientData[(y * width + x) * 3] = static_cast<uint8_t>(x * 2);
+        gradientData[(y * width + x) * 3 + 1] = static_cast<uint8_t>(y * 2);
+        gradientData[(y * width + x) * 3 + 2] = static_cast<uint8_t>(x + y);
+      }
+    }
+    EXPECT_TRUE(convertRGBToBayer(gradient, bayer));
+    EXPECT_TRUE(convertBayerToRGB(bayer, result, 3u));
+    const uint8_t *resultData = result.Data<uint8_t>();
+    for (unsigned int y = 1; y < height - 1; ++y)
+    {
+      for (unsigned int x = 1; x < width - 1; ++x)
+      {
+        for (unsigned int c = 0; c < 3; ++c)
+        {
+          unsigned int i = (y * width + x) * 3 + c;
+          EXPECT_LE(std::abs(gradientData[i] - resultData[i]), 1)
+              << PixelUtil::Name(kBayerFormats[f]) << " " << x << "," << y;
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BayerConversionTest, Invalid)
+{
+  Image rgb = PatternImage(8u, 8u);
+  Image bayer(8u, 8u, PF_BAYER_RGGB8);
+
+  // output is not a bayer format
+  Image notBayer(8u, 8u, PF_L8);
+  EXPECT_FALSE(convertRGBToBayer(rgb, notBayer));
+  EXPECT_FALSE(convertBayerToRGB(notBayer, rgb));
+
+  // input is not RGB
+  Image rgba(8u, 8u, PF_R8G8B8A8);
+  EXPECT_FALSE(convertRGBToBayer(rgba, bayer));
+  EXPECT_FALSE(convertBayerToRGB(bayer, rgba));
+
+  // dimensions do not match
+  Image small(4u, 8u, PF_BAYER_RGGB8);
+  EXPECT_FALSE(convertRGBToBayer(rgb, small));
+  EXPECT_FALSE(convertBayerToRGB(small, rgb));
+}
@@ -37,7 +37,12 @@ const char *PixelUtil::names[PF_COUNT] =
       "FLOAT32_RGBA",
       "FLOAT32_RGB",
       "L16",
-      "R8G8B8A8"
+      "R8G8B8A8",
+      "NV12",
+      "I420",
+      "YUYV",
+      "FLOAT16_R",
+      "FLOAT32_RG"
     };
 
 //////////////////////////////////////////////////
@@ -68,7 +73,17 @@ const unsigned char PixelUtil::channelCounts[PF_COUNT] =
       // PF_L16
       1,
       // PF_R8G8B8A8
-      4
+      4,
+      // PF_NV12
+      1,
+      // PF_I420
+      1,
+      // PF_YUYV
+      2,
+      // PF_FLOAT16_R
+      1,
+      // PF_FLOAT32_RG
+      2
     };
 
 //////////////////////////////////////////////////
@@ -99,7 +114,17 @@ const unsigned char PixelUtil::channelByteCounts[PF_COUNT] =
       // PF_L16
       2,
       // PF_R8G8B8A8
-      1
+      1,
+      // PF_NV12
+      1,
+      // PF_I420
+      1,
+      // PF_YUYV
+      1,
+      // PF_FLOAT16_R
+      2,
+      // PF_FLOAT32_RG
+      4
     };
 
 //////////////////////////////////////////////////
@@ -155,6 +180,21 @@ unsigned int PixelUtil::BytesPerPixel(PixelFormat _format)
 unsigned int PixelUtil::MemorySize(PixelFormat _format, unsigned int _width,
     unsigned int _height)
 {
+  // chroma is sampled once per 2x2 (4:2:0) or 2x1 (4:2:2) block of pixels,
+  // including the partial blocks of odd sized images
+  const unsigned int chromaWidth = (_width + 1u) / 2u;
+  const unsigned int chromaHeight = (_height + 1u) / 2u;
+  switch (_format)
+  {
+    case PF_NV12:
+    case PF_I420:
+      return _width * _height + 2u * chromaWidth * chromaHeight;
+    case PF_YUYV:
+      return chromaWidth * 4u * _height;
+    default:
+      break;
+  }
+
   unsigned int bytesPerPixel = PixelUtil::BytesPerPixel(_format);
   return _width * _height * bytesPerPixel;
 }
@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define GZ_RENDERING_PIXEL_SSE2
+  #include <emmintrin.h>
+  #if defined(__SSSE3__) || defined(__AVX__)
+    #define GZ_RENDERING_PIXEL_SSSE3
+    #include <tmmintrin.h>
+  #endif
+  #if defined(__AVX2__)
+    #define GZ_RENDERING_PIXEL_AVX2
+    #include <immintrin.h>
+  #endif
+  #if defined(__F16C__)
+    #define GZ_RENDERING_PIXEL_F16C
+    #include <immintrin.h>
+  #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define GZ_RENDERING_PIXEL_NEON
+  #include <arm_neon.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/PixelFormat.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Function converting one row of pixels
+  /// \param[in] _src Source row
+  /// \param[out] _dst Destination row
+  /// \param[in] _width Number of pixels in the row
+  using RowConverter = void (*)(const uint8_t *_src, uint8_t *_dst,
+      unsigned int _width);
+
+  //////////////////////////////////////////////////
+  /// \brief R8G8B8A8 to R8G8B8, dropping the alpha channel
+  void RGBA8ToRGB8(const uint8_t *_src, uint8_t *_dst, unsigned int _width)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_PIXEL_AVX2)
+    // 8 pixels per iteration. Each 128 bit lane is packed to 12 bytes, then
+    // the lanes are joined. The 32 byte store writes 8 bytes past the output
+    // of this iteration, which is fine as long as 11 pixels of room are left.
+    const __m256i shuffle256 = _mm256_setr_epi8(
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i join = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    for (; x + 11u <= _width; x += 8u)
+    {
+      __m256i rgba = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(_src + x * 4u));
+      __m256i rgb = _mm256_permutevar8x32_epi32(
+          _mm256_shuffle_epi8(rgba, shuffle256), join);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(_dst + x * 3u), rgb);
+    }
+#endif
+#if defined(GZ_RENDERING_PIXEL_SSSE3)
+    // 4 pixels per iteration, the 16 byte store overlaps the next pixels
+    const __m128i shuffle128 = _mm_setr_epi8(
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; x + 6u <= _width; x += 4u)
+    {
+      __m128i rgba = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(_src + x * 4u));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + x * 3u),
+          _mm_shuffle_epi8(rgba, shuffle128));
+    }
+#elif defined(GZ_RENDERING_PIXEL_NEON)
+    for (; x + 16u <= _width; x += 16u)
+    {
+      uint8x16x4_t rgba = vld4q_u8(_src + x * 4u);
+      uint8x16x3_t rgb;
+      rgb.val[0] = rgba.val[0];
+      rgb.val[1] = rgba.val[1];
+      rgb.val[2] = rgba.val[2];
+      vst3q_u8(_dst + x * 3u, rgb);
+    }
+#endif
+    // 4 byte copies that overlap the next pixel, except for the last one
+    for (; x + 1u < _width; ++x)
+      std::memcpy(_dst + x * 3u, _src + x * 4u, 4u);
+    for (; x < _width; ++x)
+      std::memcpy(_dst + x * 3u, _src + x * 4u, 3u);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief FLOAT32_RGBA to FLOAT32_RGB, dropping the 4th channel
+  void RGBA32FToRGB32F(const uint8_t *_src, uint8_t *_dst,
+      unsigned int _width)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_PIXEL_SSE2)
+    // one pixel per store, each store overlaps the next pixel's first channel
+    const float *src = reinterpret_cast<const float *>(_src);
+    float *dst = reinterpret_cast<float *>(_dst);
+    for (; x + 1u < _width; ++x)
+      _mm_storeu_ps(dst + x * 3u, _mm_loadu_ps(src + x * 4u));
+#elif defined(GZ_RENDERING_PIXEL_NEON)
+    const float *src = reinterpret_cast<const float *>(_src);
+    float *dst = reinterpret_cast<float *>(_dst);
+    for (; x + 4u <= _width; x += 4u)
+    {
+      float32x4x4_t rgba = vld4q_f32(src + x * 4u);
+      float32x4x3_t rgb;
+      rgb.val[0] = rgba.val[0];
+      rgb.val[1] = rgba.val[1];
+      rgb.val[2] = rgba.val[2];
+      vst3q_f32(dst + x * 3u, rgb);
+    }
+#endif
+    for (; x < _width; ++x)
+      std::memcpy(_dst + x * 12u, _src + x * 16u, 12u);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief FLOAT32_RGBA to FLOAT32_R, keeping the first channel
+  void RGBA32FToR32F(const uint8_t *_src, uint8_t *_dst, unsigned int _width)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_PIXEL_SSE2)
+    const float *src = reinterpret_cast<const float *>(_src);
+    float *dst = reinterpret_cast<float *>(_dst);
+    for (; x + 4u <= _width; x += 4u)
+    {
+      __m128 p0 = _mm_loadu_ps(src + x * 4u);
+      __m128 p1 = _mm_loadu_ps(src + x * 4u + 4u);
+      __m128 p2 = _mm_loadu_ps(src + x * 4u + 8u);
+      __m128 p3 = _mm_loadu_ps(src + x * 4u + 12u);
+      // [r0 r0 r1 r1] and [r2 r2 r3 r3]
+      __m128 r01 = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 0, 0));
+      __m128 r23 = _mm_shuffle_ps(p2, p3, _MM_SHUFFLE(0, 0, 0, 0));
+      _mm_storeu_ps(dst + x,
+          _mm_shuffle_ps(r01, r23, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#elif defined(GZ_RENDERING_PIXEL_NEON)
+    const float *src = reinterpret_cast<const float *>(_src);
+    float *dst = reinterpret_cast<float *>(_dst);
+    for (; x + 4u <= _width; x += 4u)
+      vst1q_f32(dst + x, vld4q_f32(src + x * 4u).val[0]);
+#endif
+    for (; x < _width; ++x)
+      std::memcpy(_dst + x * 4u, _src + x * 16u, 4u);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief FLOAT32_RG to FLOAT32_RGB, setting the 3rd channel to 0
+  void RG32FToRGB32F(const uint8_t *_src, uint8_t *_dst, unsigned int _width)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_PIXEL_SSE2)
+    // two pixels per iteration, [r0 g0 r1 g1] to [r0 g0 0] [r1 g1 0]. Each
+    // store overlaps the start of the next pixel.
+    const float *src = reinterpret_cast<const float *>(_src);
+    float *dst = reinterpret_cast<float *>(_dst);
+    const __m128 zeros = _mm_setzero_ps();
+    for (; x + 3u <= _width; x += 2u)
+    {
+      __m128 rg = _mm_loadu_ps(src + x * 2u);
+      _mm_storeu_ps(dst + x * 3u, _mm_movelh_ps(rg, zeros));
+      _mm_storeu_ps(dst + x * 3u + 3u, _mm_shuffle_ps(rg, zeros,
+          _MM_SHUFFLE(0, 0, 3, 2)));
+    }
+#elif defined(GZ_RENDERING_PIXEL_NEON)
+    const float *src = reinterpret_cast<const float *>(_src);
+    float *dst = reinterpret_cast<float *>(_dst);
+    for (; x + 4u <= _width; x += 4u)
+    {
+      float32x4x2_t rg = vld2q_f32(src + x * 2u);
+      float32x4x3_t rgb;
+      rgb.val[0] = rg.val[0];
+      rgb.val[1] = rg.val[1];
+      rgb.val[2] = vdupq_n_f32(0.0f);
+      vst3q_f32(dst + x * 3u, rgb);
+    }
+#endif
+    const float zero = 0.0f;
+    for (; x < _width; ++x)
+    {
+      std::memcpy(_dst + x * 12u, _src + x * 8u, 8u);
+      std::memcpy(_dst + x * 12u + 8u, &zero, 4u);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Convert a half precision float to a single precision float
+  /// \param[in] _half Bits of the half precision value
+  /// \return Single precision value
+  float HalfToFloat(uint16_t _half)
+  {
+    const uint32_t sign = static_cast<uint32_t>(_half & 0x8000u) << 16;
+    uint32_t exponent = (_half >> 10) & 0x1Fu;
+    uint32_t mantissa = _half & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0x1Fu)
+    {
+      // inf and nan
+      bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent != 0u)
+    {
+      // rebias the exponent from 15 to 127
+      bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0u)
+    {
+      bits = sign;
+    }
+    else
+    {
+      // subnormal half values are normal single precision values
+      exponent = 113u;
+      while ((mantissa & 0x400u) == 0u)
+      {
+        mantissa <<= 1;
+        --exponent;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief FLOAT16_R to FLOAT32_R
+  void R16FToR32F(const uint8_t *_src, uint8_t *_dst, unsigned int _width)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_PIXEL_F16C)
+    for (; x + 4u <= _width; x += 4u)
+    {
+      __m128i half = _mm_loadl_epi64(
+          reinterpret_cast<const __m128i *>(_src + x * 2u));
+      _mm_storeu_ps(reinterpret_cast<float *>(_dst + x * 4u),
+          _mm_cvtph_ps(half));
+    }
+#elif defined(GZ_RENDERING_PIXEL_NEON) && defined(__aarch64__)
+    for (; x + 4u <= _width; x += 4u)
+    {
+      float16x4_t half = vreinterpret_f16_u16(
+          vld1_u16(reinterpret_cast<const uint16_t *>(_src + x * 2u)));
+      vst1q_f32(reinterpret_cast<float *>(_dst + x * 4u),
+          vcvt_f32_f16(half));
+    }
+#endif
+    for (; x < _width; ++x)
+    {
+      uint16_t half;
+      std::memcpy(&half, _src + x * 2u, 2u);
+      float value = HalfToFloat(half);
+      std::memcpy(_dst + x * 4u, &value, 4u);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief L8 to L16, widening the values without scaling them
+  void L8ToL16(const uint8_t *_src, uint8_t *_dst, unsigned int _width)
+  {
+    unsigned int x = 0u;
+#if defined(GZ_RENDERING_PIXEL_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 16u <= _width; x += 16u)
+    {
+      __m128i l8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + x));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + x * 2u),
+          _mm_unpacklo_epi8(l8, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + x * 2u + 16u),
+          _mm_unpackhi_epi8(l8, zero));
+    }
+#elif defined(GZ_RENDERING_PIXEL_NEON)
+    for (; x + 8u <= _width; x += 8u)
+    {
+      vst1q_u16(reinterpret_cast<uint16_t *>(_dst + x * 2u),
+          vmovl_u8(vld1_u8(_src + x)));
+    }
+#endif
+    for (; x < _width; ++x)
+    {
+      uint16_t value = _src[x];
+      std::memcpy(_dst + x * 2u, &value, 2u);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Find the row converter for a pair of different formats
+  /// \param[in] _srcFormat Source format
+  /// \param[in] _dstFormat Destination format
+  /// \return Row converter, null if the conversion is not supported
+  RowConverter FindRowConverter(PixelFormat _srcFormat,
+      PixelFormat _dstFormat)
+  {
+    if (_srcFormat == PF_R8G8B8A8 && _dstFormat == PF_R8G8B8)
+      return &RGBA8ToRGB8;
+    if (_srcFormat == PF_FLOAT32_RGBA && _dstFormat == PF_FLOAT32_RGB)
+      return &RGBA32FToRGB32F;
+    if (_srcFormat == PF_FLOAT32_RGBA && _dstFormat == PF_FLOAT32_R)
+      return &RGBA32FToR32F;
+    if (_srcFormat == PF_FLOAT32_RG && _dstFormat == PF_FLOAT32_RGB)
+      return &RG32FToRGB32F;
+    if (_srcFormat == PF_FLOAT16_R && _dstFormat == PF_FLOAT32_R)
+      return &R16FToR32F;
+    if (_srcFormat == PF_L8 && _dstFormat == PF_L16)
+      return &L8ToL16;
+    return nullptr;
+  }
+}
+
+//////////////////////////////////////////////////
+bool PixelUtil::CanConvert(PixelFormat _srcFormat, PixelFormat _dstFormat)
+{
+  if (!PixelUtil::IsValid(_srcFormat) || !PixelUtil::IsValid(_dstFormat))
+    return false;
+
+  // chroma samples of YUV images are not stored in rows of pixels
+  for (PixelFormat format : {_srcFormat, _dstFormat})
+  {
+    if (format == PF_NV12 || format == PF_I420 || format == PF_YUYV)
+      return false;
+  }
+
+  return _srcFormat == _dstFormat ||
+      FindRowConverter(_srcFormat, _dstFormat) != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool PixelUtil::Convert(const void *_src, PixelFormat _srcFormat,
+    unsigned int _srcRowPitch, void *_dst, PixelFormat _dstFormat,
+    unsigned int _dstRowPitch, unsigned int _width, unsigned int _height)
+{
+  if (!PixelUtil::CanConvert(_srcFormat, _dstFormat))
+  {
+    gzerr << "Unsupported pixel format conversion from ["
+          << PixelUtil::Name(_srcFormat) << "] to ["
+          << PixelUtil::Name(_dstFormat) << "]" << std::endl;
+    return false;
+  }
+
+  if (!_src || !_dst)
+  {
+    gzerr << "Null pixel data" << std::endl;
+    return false;
+  }
+
+  const unsigned int srcRowSize = _width * PixelUtil::BytesPerPixel(_srcFormat);
+  const unsigned int dstRowSize = _width * PixelUtil::BytesPerPixel(_dstFormat);
+  if (_srcRowPitch == 0u)
+    _srcRowPitch = srcRowSize;
+  if (_dstRowPitch == 0u)
+    _dstRowPitch = dstRowSize;
+
+  const uint8_t *src = static_cast<const uint8_t *>(_src);
+  uint8_t *dst = static_cast<uint8_t *>(_dst);
+
+  // packed images are converted as a single row
+  if (_srcRowPitch == srcRowSize && _dstRowPitch == dstRowSize)
+  {
+    _width *= _height;
+    _height = 1u;
+  }
+
+  if (_srcFormat == _dstFormat)
+  {
+    const std::size_t rowSize =
+        static_cast<std::size_t>(_width) * PixelUtil::BytesPerPixel(_srcFormat);
+    for (unsigned int y = 0u; y < _height; ++y)
+    {
+      std::memcpy(dst + static_cast<std::size_t>(y) * _dstRowPitch,
+          src + static_cast<std::size_t>(y) * _srcRowPitch, rowSize);
+    }
+    return true;
+  }
+
+  RowConverter convert = FindRowConverter(_srcFormat, _dstFormat);
+  for (unsigned int y = 0u; y < _height; ++y)
+  {
+    convert(src + static_cast<std::size_t>(y) * _srcRowPitch,
+        dst + static_cast<std::size_t>(y) * _dstRowPitch, _width);
+  }
+  return true;
+}
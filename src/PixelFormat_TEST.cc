@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
 #include "gz/rendering/PixelFormat.hh"
 
 using namespace gz;
@@ -64,12 +69,26 @@ TEST(PixelFormatTest, PixelUtil)
   EXPECT_EQ(4u, PixelUtil::BytesPerPixel(format));
   EXPECT_EQ(1u, PixelUtil::BytesPerChannel(format));
   EXPECT_EQ(4096u, PixelUtil::MemorySize(format, 32, 32));
+
+  format = PF_FLOAT32_RG;
+  EXPECT_EQ(8u, PixelUtil::BytesPerPixel(format));
+  EXPECT_EQ(4u, PixelUtil::BytesPerChannel(format));
+  EXPECT_EQ(8192u, PixelUtil::MemorySize(format, 32, 32));
+  EXPECT_EQ("FLOAT32_RG", PixelUtil::Name(format));
+  EXPECT_EQ(format, PixelUtil::Enum("FLOAT32_RG"));
+
+  format = PF_FLOAT16_R;
+  EXPECT_EQ(2u, PixelUtil::BytesPerPixel(format));
+  EXPECT_EQ(2u, PixelUtil::BytesPerChannel(format));
+  EXPECT_EQ(2048u, PixelUtil::MemorySize(format, 32, 32));
+  EXPECT_EQ("FLOAT16_R", PixelUtil::Name(format));
+  EXPECT_EQ(format, PixelUtil::Enum("FLOAT16_R"));
 }
 
 /////////////////////////////////////////////////
 TEST(PixelFormatTest, PixelUtilInvalid)
 {
-  PixelFormat format = static_cast<PixelFormat>(16);
+  PixelFormat format = static_cast<PixelFormat>(PF_COUNT);
 
   EXPECT_EQ(PF_UNKNOWN, PixelUtil::Sanitize(format));
   EXPECT_EQ("UNKNOWN", PixelUtil::Name(format));
@@ -77,6 +96,125 @@ TEST(PixelFormatTest, PixelUtilInvalid)
   EXPECT_EQ(PF_UNKNOWN, PixelUtil::Enum("invalid"));
 }
 
+/////////////////////////////////////////////////
+TEST(PixelFormatTest, Convert)
+{
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_R8G8B8A8, PF_R8G8B8));
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_FLOAT32_RGBA, PF_FLOAT32_RGB));
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_FLOAT32_RGBA, PF_FLOAT32_R));
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_FLOAT32_RG, PF_FLOAT32_RGB));
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_FLOAT16_R, PF_FLOAT32_R));
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_L8, PF_L16));
+  EXPECT_TRUE(PixelUtil::CanConvert(PF_L16, PF_L16));
+  EXPECT_FALSE(PixelUtil::CanConvert(PF_R8G8B8, PF_R8G8B8A8));
+  EXPECT_FALSE(PixelUtil::CanConvert(PF_UNKNOWN, PF_UNKNOWN));
+
+  // odd width so that both the vectorized and scalar paths are exercised,
+  // and padded source rows like the ones read back from the GPU
+  const unsigned int width = 37u;
+  const unsigned int height = 3u;
+  const unsigned int srcPitch = 256u;
+  std::vector<uint8_t> rgba8(srcPitch * height);
+  for (std::size_t i = 0u; i < rgba8.size(); ++i)
+    rgba8[i] = static_cast<uint8_t>(i * 7u);
+
+  std::vector<uint8_t> rgb8(width * height * 3u);
+  EXPECT_TRUE(PixelUtil::Convert(rgba8.data(), PF_R8G8B8A8, srcPitch,
+      rgb8.data(), PF_R8G8B8, 0u, width, height));
+  for (unsigned int y = 0u; y < height; ++y)
+  {
+    for (unsigned int x = 0u; x < width; ++x)
+    {
+      for (unsigned int c = 0u; c < 3u; ++c)
+      {
+        EXPECT_EQ(rgba8[y * srcPitch + x * 4u + c],
+            rgb8[(y * width + x) * 3u + c]);
+      }
+    }
+  }
+
+  std::vector<float> rgba32(width * height * 4u);
+  for (std::size_t i = 0u; i < rgba32.size(); ++i)
+    rgba32[i] = static_cast<float>(i) * 0.5f;
+
+  std::vector<float> rgb32(width * height * 3u);
+  EXPECT_TRUE(PixelUtil::Convert(rgba32.data(), PF_FLOAT32_RGBA, 0u,
+      rgb32.data(), PF_FLOAT32_RGB, 0u, width, height));
+  std::vector<float> r32(width * height);
+  EXPECT_TRUE(PixelUtil::Convert(rgba32.data(), PF_FLOAT32_RGBA, 0u,
+      r32.data(), PF_FLOAT32_R, 0u, width, height));
+  for (unsigned int i = 0u; i < width * height; ++i)
+  {
+    EXPECT_FLOAT_EQ(rgba32[i * 4u], r32[i]);
+    for (unsigned int c = 0u; c < 3u; ++c)
+      EXPECT_FLOAT_EQ(rgba32[i * 4u + c], rgb32[i * 3u + c]);
+  }
+
+  // padded two channel rows, the third channel is zeroed
+  const unsigned int rgPitch = width * 8u + 24u;
+  std::vector<float> rg32(rgPitch / 4u * height, 1.0f);
+  for (std::size_t i = 0u; i < rg32.size(); ++i)
+    rg32[i] = static_cast<float>(i) + 0.25f;
+  EXPECT_TRUE(PixelUtil::Convert(rg32.data(), PF_FLOAT32_RG, rgPitch,
+      rgb32.data(), PF_FLOAT32_RGB, 0u, width, height));
+  for (unsigned int y = 0u; y < height; ++y)
+  {
+    for (unsigned int x = 0u; x < width; ++x)
+    {
+      const float *rgb = &rgb32[(y * width + x) * 3u];
+      EXPECT_FLOAT_EQ(rg32[y * rgPitch / 4u + x * 2u], rgb[0]);
+      EXPECT_FLOAT_EQ(rg32[y * rgPitch / 4u + x * 2u + 1u], rgb[1]);
+      EXPECT_FLOAT_EQ(0.0f, rgb[2]);
+    }
+  }
+
+  std::vector<uint16_t> l16(width * height);
+  EXPECT_TRUE(PixelUtil::Convert(rgba8.data(), PF_L8, srcPitch,
+      l16.data(), PF_L16, 0u, width, height));
+  for (unsigned int y = 0u; y < height; ++y)
+  {
+    for (unsigned int x = 0u; x < width; ++x)
+      EXPECT_EQ(rgba8[y * srcPitch + x], l16[y * width + x]);
+  }
+
+  // half precision values, including subnormals, infinities and nan
+  const uint16_t halfBits[] = {0x0000u, 0x8000u, 0x3C00u, 0xC000u, 0x3555u,
+      0x7BFFu, 0x0001u, 0x03FFu, 0x0400u, 0x7C00u, 0xFC00u, 0x7E00u};
+  const float halfValues[] = {0.0f, -0.0f, 1.0f, -2.0f, 0.333251953125f,
+      65504.0f, 5.9604644775390625e-8f, 6.09755516052246094e-5f,
+      6.103515625e-5f, INFINITY, -INFINITY, NAN};
+  const unsigned int halfCount = sizeof(halfBits) / sizeof(halfBits[0]);
+  std::vector<uint16_t> r16(width * height);
+  for (unsigned int i = 0u; i < r16.size(); ++i)
+    r16[i] = halfBits[i % halfCount];
+  EXPECT_TRUE(PixelUtil::Convert(r16.data(), PF_FLOAT16_R, 0u,
+      r32.data(), PF_FLOAT32_R, 0u, width, height));
+  for (unsigned int i = 0u; i < r16.size(); ++i)
+  {
+    const float expected = halfValues[i % halfCount];
+    if (std::isnan(expected))
+      EXPECT_TRUE(std::isnan(r32[i])) << i;
+    else
+      EXPECT_EQ(expected, r32[i]) << i;
+  }
+
+  // padded destination rows are left untouched past the image width
+  const unsigned int dstPitch = width * 3u + 5u;
+  std::vector<uint8_t> padded(dstPitch * height, 0xAB);
+  EXPECT_TRUE(PixelUtil::Convert(rgba8.data(), PF_R8G8B8A8, srcPitch,
+      padded.data(), PF_R8G8B8, dstPitch, width, height));
+  for (unsigned int y = 0u; y < height; ++y)
+  {
+    EXPECT_EQ(0, memcmp(&rgb8[y * width * 3u], &padded[y * dstPitch],
+        width * 3u));
+    for (unsigned int i = width * 3u; i < dstPitch; ++i)
+      EXPECT_EQ(0xAB, padded[y * dstPitch + i]);
+  }
+
+  EXPECT_FALSE(PixelUtil::Convert(rgb8.data(), PF_R8G8B8, 0u,
+      rgba8.data(), PF_R8G8B8A8, 0u, width, height));
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
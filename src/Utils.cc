@@ -255,142 +255,8 @@ gz::math::AxisAlignedBox transformAxisAlignedBox(
 /////////////////////////////////////////////////
 Image convertRGBToBayer(const Image &_image, PixelFormat _bayerFormat)
 {
-  const unsigned char *sourceImageData = _image.Data<unsigned char>();
-
-  unsigned int width = _image.Width();
-  unsigned int height = _image.Height();
-
-  Image destImage(width, height, _bayerFormat);
-  unsigned char *destImageData = destImage.Data<unsigned char>();
-
-  if (_bayerFormat == PF_BAYER_RGGB8)
-  {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-        }
-      }
-    }
-  }
-
-  else if (_bayerFormat == PF_BAYER_BGGR8)
-  {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-        }
-      }
-    }
-  }
-
-  else if (_bayerFormat == PF_BAYER_GBRG8)
-  {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-      }
-    }
-  }
-
-  else if (_bayerFormat == PF_BAYER_GRBG8)
-  {
-    for (unsigned int i=0; i < width; i++)
-    {
-      for (unsigned int j=0; j < height; j++)
-      {
-        if (j%2)
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+0];
-          }
-        }
-        else
-        {
-          if (i%2)
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+2];
-          }
-          else
-          {
-            destImageData[i+j*width] = sourceImageData[i*3+j*width*3+1];
-          }
-        }
-      }
-    }
-  }
-
+  Image destImage(_image.Width(), _image.Height(), _bayerFormat);
+  convertRGBToBayer(_image, destImage);
   return destImage;
 }
 
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
+#include "gz/rendering/Utils.hh"
+
+using namespace gz;
+using namespace rendering;
+
+namespace
+{
+  /// \brief Location of the samples of a YUV image in its data. Sample i
+  /// of a row j of the Y, U or V plane (index 0, 1 or 2) is at
+  /// offset[p] + j * pitch[p] + i * step[p].
+  struct YuvLayout
+  {
+    /// \brief Number of rows of pixels sharing a chroma sample
+    unsigned int blockRows;
+
+    /// \brief Offset of the first sample of each plane, in bytes
+    std::size_t offset[3];
+
+    /// \brief Distance between two samples of a row, in bytes
+    std::size_t step[3];
+
+    /// \brief Distance between two rows, in bytes
+    std::size_t pitch[3];
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the layout of a YUV format
+  /// \param[in] _format YUV pixel format
+  /// \param[in] _width Image width
+  /// \param[in] _height Image height
+  /// \param[out] _layout Layout of the image data
+  /// \return False if the format is not a YUV format
+  bool LayoutOf(PixelFormat _format, unsigned int _width,
+      unsigned int _height, YuvLayout &_layout)
+  {
+    // partial blocks of odd sized images have their own chroma sample
+    const std::size_t chromaWidth = (_width + 1u) / 2u;
+    const std::size_t chromaHeight = (_height + 1u) / 2u;
+    const std::size_t lumaSize = static_cast<std::size_t>(_width) * _height;
+    switch (_format)
+    {
+      case PF_NV12:
+        _layout = {2u, {0u, lumaSize, lumaSize + 1u}, {1u, 2u, 2u},
+            {_width, chromaWidth * 2u, chromaWidth * 2u}};
+        return true;
+      case PF_I420:
+        _layout = {2u,
+            {0u, lumaSize, lumaSize + chromaWidth * chromaHeight},
+            {1u, 1u, 1u}, {_width, chromaWidth, chromaWidth}};
+        return true;
+      case PF_YUYV:
+        _layout = {1u, {0u, 1u, 3u}, {2u, 4u, 4u},
+            {chromaWidth * 4u, chromaWidth * 4u, chromaWidth * 4u}};
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Clamp a value to the range of a byte
+  /// \param[in] _value Value to clamp
+  /// \return Clamped value
+  uint8_t ClampByte(int _value)
+  {
+    return static_cast<uint8_t>(std::min(255, std::max(0, _value)));
+  }
+
+  // The BT.601 limited range matrix, in the 8 bit fixed point form most
+  // encoders use. The constant terms include the 128 offset of U and V and
+  // the rounding, and keep the sums positive.
+
+  //////////////////////////////////////////////////
+  /// \brief Compute the Y value of an RGB color
+  /// \param[in] _r Red value
+  /// \param[in] _g Green value
+  /// \param[in] _b Blue value
+  /// \return Y value
+  uint8_t Luma(int _r, int _g, int _b)
+  {
+    return static_cast<uint8_t>(
+        ((66 * _r + 129 * _g + 25 * _b + 128) >> 8) + 16);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Compute the U value of an RGB color
+  /// \param[in] _r Red value
+  /// \param[in] _g Green value
+  /// \param[in] _b Blue value
+  /// \return U value
+  uint8_t ChromaU(int _r, int _g, int _b)
+  {
+    return static_cast<uint8_t>((-38 * _r - 74 * _g + 112 * _b + 32896) >> 8);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Compute the V value of an RGB color
+  /// \param[in] _r Red value
+  /// \param[in] _g Green value
+  /// \param[in] _b Blue value
+  /// \return V value
+  uint8_t ChromaV(int _r, int _g, int _b)
+  {
+    return static_cast<uint8_t>((112 * _r - 94 * _g - 18 * _b + 32896) >> 8);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check that the images given to a conversion are supported
+  /// \param[in] _rgbImage RGB image
+  /// \param[in] _yuvImage YUV image
+  /// \param[out] _layout Layout of the YUV image
+  /// \return True if the images can be converted
+  bool CheckImages(const Image &_rgbImage, const Image &_yuvImage,
+      YuvLayout &_layout)
+  {
+    if (!LayoutOf(_yuvImage.Format(), _yuvImage.Width(), _yuvImage.Height(),
+        _layout))
+    {
+      gzerr << "Image format [" << PixelUtil::Name(_yuvImage.Format())
+            << "] is not a YUV format" << std::endl;
+      return false;
+    }
+
+    if (_rgbImage.Format() != PF_R8G8B8)
+    {
+      gzerr << "Image format [" << PixelUtil::Name(_rgbImage.Format())
+            << "] is not supported. YUV images can only be converted from "
+            << "and to R8G8B8" << std::endl;
+      return false;
+    }
+
+    if (_rgbImage.Width() != _yuvImage.Width() ||
+        _rgbImage.Height() != _yuvImage.Height())
+    {
+      gzerr << "Input and output image dimensions do not match" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+namespace gz
+{
+namespace rendering
+{
+inline namespace GZ_RENDERING_VERSION_NAMESPACE {
+//
+/////////////////////////////////////////////////
+bool convertRGBToYUV(const Image &_image, Image &_yuvImage)
+{
+  YuvLayout layout;
+  if (!CheckImages(_image, _yuvImage, layout))
+    return false;
+
+  const unsigned int width = _image.Width();
+  const unsigned int height = _image.Height();
+  const uint8_t *src = _image.Data<uint8_t>();
+  uint8_t *dst = _yuvImage.Data<uint8_t>();
+  if (width == 0u || height == 0u || !src || !dst)
+    return true;
+
+  for (unsigned int y = 0u; y < height; ++y)
+  {
+    const uint8_t *srcRow = src + static_cast<std::size_t>(y) * width * 3u;
+    uint8_t *dstRow = dst + layout.offset[0] + y * layout.pitch[0];
+    for (unsigned int x = 0u; x < width; ++x)
+    {
+      const uint8_t *rgb = srcRow + x * 3u;
+      dstRow[x * layout.step[0]] = Luma(rgb[0], rgb[1], rgb[2]);
+    }
+  }
+
+  // each chroma sample is computed from the average color of the pixels
+  // sharing it
+  const unsigned int chromaWidth = (width + 1u) / 2u;
+  const unsigned int chromaHeight =
+      (height + layout.blockRows - 1u) / layout.blockRows;
+  for (unsigned int cy = 0u; cy < chromaHeight; ++cy)
+  {
+    const unsigned int y0 = cy * layout.blockRows;
+    const unsigned int y1 = std::min(y0 + layout.blockRows, height);
+    for (unsigned int cx = 0u; cx < chromaWidth; ++cx)
+    {
+      const unsigned int x0 = cx * 2u;
+      const unsigned int x1 = std::min(x0 + 2u, width);
+      int sum[3] = {0, 0, 0};
+      for (unsigned int y = y0; y < y1; ++y)
+      {
+        for (unsigned int x = x0; x < x1; ++x)
+        {
+          const uint8_t *rgb =
+              src + (static_cast<std::size_t>(y) * width + x) * 3u;
+          for (unsigned int c = 0u; c < 3u; ++c)
+            sum[c] += rgb[c];
+        }
+      }
+      const int count = static_cast<int>((x1 - x0) * (y1 - y0));
+      int avg[3];
+      for (unsigned int c = 0u; c < 3u; ++c)
+        avg[c] = (sum[c] + count / 2) / count;
+
+      dst[layout.offset[1] + cy * layout.pitch[1] + cx * layout.step[1]] =
+          ChromaU(avg[0], avg[1], avg[2]);
+      dst[layout.offset[2] + cy * layout.pitch[2] + cx * layout.step[2]] =
+          ChromaV(avg[0], avg[1], avg[2]);
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool convertYUVToRGB(const Image &_yuvImage, Image &_image)
+{
+  YuvLayout layout;
+  if (!CheckImages(_image, _yuvImage, layout))
+    return false;
+
+  const unsigned int width = _image.Width();
+  const unsigned int height = _image.Height();
+  const uint8_t *src = _yuvImage.Data<uint8_t>();
+  uint8_t *dst = _image.Data<uint8_t>();
+  if (width == 0u || height == 0u || !src || !dst)
+    return true;
+
+  for (unsigned int y = 0u; y < height; ++y)
+  {
+    const unsigned int cy = y / layout.blockRows;
+    uint8_t *dstRow = dst + static_cast<std::size_t>(y) * width * 3u;
+    for (unsigned int x = 0u; x < width; ++x)
+    {
+      const unsigned int cx = x / 2u;
+      const int c = src[layout.offset[0] + y * layout.pitch[0] +
+          x * layout.step[0]] - 16;
+      const int d = src[layout.offset[1] + cy * layout.pitch[1] +
+          cx * layout.step[1]] - 128;
+      const int e = src[layout.offset[2] + cy * layout.pitch[2] +
+          cx * layout.step[2]] - 128;
+
+      uint8_t *rgb = dstRow + x * 3u;
+      rgb[0] = ClampByte((298 * c + 409 * e + 128) / 256);
+      rgb[1] = ClampByte((298 * c - 100 * d - 208 * e + 128) / 256);
+      rgb[2] = ClampByte((298 * c + 516 * d + 128) / 256);
+    }
+  }
+  return true;
+}
+}
+}
+}
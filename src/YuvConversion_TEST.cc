@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
+#include "gz/rendering/Utils.hh"
+
+using namespace gz;
+using namespace rendering;
+
+static const PixelFormat kYuvFormats[] = {PF_NV12, PF_I420, PF_YUYV};
+
+/////////////////////////////////////////////////
+/// \brief Create an RGB image filled with a color
+Image FlatImage(unsigned int _width, unsigned int _height, uint8_t _r,
+    uint8_t _g, uint8_t _b)
+{
+  Image image(_width, _height, PF_R8G8B8);
+  uint8_t *data = image.Data<uint8_t>();
+  for (unsigned int i = 0; i < _width * _height; ++i)
+  {
+    data[i * 3] = _r;
+    data[i * 3 + 1] = _g;
+    data[i * 3 + 2] = _b;
+  }
+  return image;
+}
+
+/////////////////////////////////////////////////
+TEST(YuvConversionTest, MemorySize)
+{
+  // 1.5 bytes per pixel for 4:2:0, 2 for 4:2:2
+  EXPECT_EQ(1536u, PixelUtil::MemorySize(PF_NV12, 32, 32));
+  EXPECT_EQ(1536u, PixelUtil::MemorySize(PF_I420, 32, 32));
+  EXPECT_EQ(2048u, PixelUtil::MemorySize(PF_YUYV, 32, 32));
+
+  // odd sizes have a chroma sample for the last partial blocks
+  EXPECT_EQ(15u + 2u * 3u * 2u, PixelUtil::MemorySize(PF_NV12, 5, 3));
+  EXPECT_EQ(15u + 2u * 3u * 2u, PixelUtil::MemorySize(PF_I420, 5, 3));
+  EXPECT_EQ(3u * 4u * 3u, PixelUtil::MemorySize(PF_YUYV, 5, 3));
+
+  EXPECT_EQ(1u, PixelUtil::BytesPerPixel(PF_NV12));
+  EXPECT_EQ(1u, PixelUtil::BytesPerPixel(PF_I420));
+  EXPECT_EQ(2u, PixelUtil::BytesPerPixel(PF_YUYV));
+
+  for (auto format : kYuvFormats)
+  {
+    EXPECT_EQ(format, PixelUtil::Enum(PixelUtil::Name(format)));
+    EXPECT_FALSE(PixelUtil::CanConvert(format, format));
+    EXPECT_FALSE(PixelUtil::CanConvert(PF_R8G8B8, format));
+  }
+  EXPECT_EQ("NV12", PixelUtil::Name(PF_NV12));
+  EXPECT_EQ("I420", PixelUtil::Name(PF_I420));
+  EXPECT_EQ("YUYV", PixelUtil::Name(PF_YUYV));
+}
+
+/////////////////////////////////////////////////
+TEST(YuvConversionTest, Colors)
+{
+  // BT.601 limited range values
+  struct
+  {
+    uint8_t rgb[3];
+    uint8_t yuv[3];
+  } colors[] =
+  {
+    {{0u, 0u, 0u}, {16u, 128u, 128u}},
+    {{255u, 255u, 255u}, {235u, 128u, 128u}},
+    {{255u, 0u, 0u}, {82u, 90u, 240u}},
+    {{0u, 255u, 0u}, {144u, 54u, 34u}},
+    {{0u, 0u, 255u}, {41u, 240u, 110u}},
+  };
+
+  for (const auto &color : colors)
+  {
+    Image rgb = FlatImage(4u, 2u, color.rgb[0], color.rgb[1], color.rgb[2]);
+    for (auto format : kYuvFormats)
+    {
+      Image yuv(4u, 2u, format);
+      EXPECT_TRUE(convertRGBToYUV(rgb, yuv));
+      const uint8_t *data = yuv.Data<uint8_t>();
+      if (format == PF_YUYV)
+      {
+        for (unsigned int i = 0; i < yuv.MemorySize(); i += 4)
+        {
+          EXPECT_EQ(color.yuv[0], data[i]);
+          EXPECT_EQ(color.yuv[1], data[i + 1]);
+          EXPECT_EQ(color.yuv[0], data[i + 2]);
+          EXPECT_EQ(color.yuv[2], data[i + 3]);
+        }
+      }
+      else
+      {
+        for (unsigned int i = 0; i < 8u; ++i)
+          EXPECT_EQ(color.yuv[0], data[i]) << PixelUtil::Name(format);
+        // one chroma sample per 2x2 block, U before V in both layouts
+        EXPECT_EQ(color.yuv[1], data[8]) << PixelUtil::Name(format);
+        EXPECT_EQ(color.yuv[2], data[11]) << PixelUtil::Name(format);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(YuvConversionTest, Layout)
+{
+  // left half red, right half blue
+  Image rgb = FlatImage(4u, 2u, 0u, 0u, 255u);
+  uint8_t *rgbData = rgb.Data<uint8_t>();
+  for (unsigned int y = 0; y < 2u; ++y)
+  {
+    for (unsigned int x = 0; x < 2u; ++x)
+    {
+      uint8_t *pixel = rgbData + (y * 4u + x) * 3u;
+      pixel[0] = 255u;
+      pixel[2] = 0u;
+    }
+  }
+
+  // NV12: interleaved U V plane
+  Image nv12(4u, 2u, PF_NV12);
+  EXPECT_TRUE(convertRGBToYUV(rgb, nv12));
+  const uint8_t *data = nv12.Data<uint8_t>();
+  EXPECT_EQ(82u, data[0]);
+  EXPECT_EQ(41u, data[3]);
+  EXPECT_EQ(82u, data[4]);
+  EXPECT_EQ(90u, data[8]);
+  EXPECT_EQ(240u, data[9]);
+  EXPECT_EQ(240u, data[10]);
+  EXPECT_EQ(110u, data[11]);
+
+  // I420: U plane then V plane
+  Image i420(4u, 2u, PF_I420);
+  EXPECT_TRUE(convertRGBToYUV(rgb, i420));
+  data = i420.Data<uint8_t>();
+  EXPECT_EQ(0, memcmp(nv12.Data(), i420.Data(), 8u));
+  EXPECT_EQ(90u, data[8]);
+  EXPECT_EQ(240u, data[9]);
+  EXPECT_EQ(240u, data[10]);
+  EXPECT_EQ(110u, data[11]);
+
+  // YUYV: Y0 U Y1 V for each pair of pixels
+  Image yuyv(4u, 2u, PF_YUYV);
+  EXPECT_TRUE(convertRGBToYUV(rgb, yuyv));
+  data = yuyv.Data<uint8_t>();
+  const uint8_t row[] = {82u, 90u, 82u, 240u, 41u, 240u, 41u, 110u};
+  EXPECT_EQ(0, memcmp(row, data, 8u));
+  EXPECT_EQ(0, memcmp(row, data + 8u, 8u));
+}
+
+/////////////////////////////////////////////////
+TEST(YuvConversionTest, RoundTrip)
+{
+  // odd sizes cover the partial chroma blocks
+  for (unsigned int size : {16u, 17u})
+  {
+    const unsigned int width = size * 2u;
+    const unsigned int height = size;
+    for (auto format : kYuvFormats)
+    {
+      // uniform color is recovered up to quantization
+      Image flat = FlatImage(width, height, 200u, 100u, 50u);
+      Image yuv(width, height, format);
+      Image result(width, height, PF_R8G8B8);
+      EXPECT_TRUE(convertRGBToYUV(flat, yuv));
+      EXPECT_TRUE(convertYUVToRGB(yuv, result));
+      const uint8_t *flatData = flat.Data<uint8_t>();
+      const uint8_t *resultData = result.Data<uint8_t>();
+      for (unsigned int i = 0; i < width * height * 3u; ++i)
+      {
+        EXPECT_LE(std::abs(flatData[i] - resultData[i]), 2)
+            << PixelUtil::Name(format) << " " << i;
+      }
+
+      // smooth gradients only lose the detail averaged out of the chroma
+      // samples
+      Image gradient(width, height, PF_R8G8B8);
+      uint8_t *gradientData = gradient.Data<uint8_t>();
+      for (unsigned int y = 0; y < height; ++y)
+      {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+          gradientData[(y * width + x) * 3] = static_cast<uint8_t>(x * 4);
+          gradientData[(y * width + x) * 3 + 1] =
+              static_cast<uint8_t>(y * 8);
+          gradientData[(y * width + x) * 3 + 2] =
+              static_cast<uint8_t>(255 - x * 2 - y * 4);
+        }
+      }
+      EXPECT_TRUE(convertRGBToYUV(gradient, yuv));
+      EXPECT_TRUE(convertYUVToRGB(yuv, result));
+      for (unsigned int i = 0; i < width * height * 3u; ++i)
+      {
+        EXPECT_LE(std::abs(gradientData[i] - resultData[i]), 8)
+            << PixelUtil::Name(format) << " " << i;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(YuvConversionTest, Invalid)
+{
+  Image rgb = FlatImage(8u, 8u, 1u, 2u, 3u);
+  Image yuv(8u, 8u, PF_NV12);
+
+  // output is not a yuv format
+  Image notYuv(8u, 8u, PF_L8);
+  EXPECT_FALSE(convertRGBToYUV(rgb, notYuv));
+  EXPECT_FALSE(convertYUVToRGB(notYuv, rgb));
+
+  // input is not RGB
+  Image rgba(8u, 8u, PF_R8G8B8A8);
+  EXPECT_FALSE(convertRGBToYUV(rgba, yuv));
+  EXPECT_FALSE(convertYUVToRGB(yuv, rgba));
+
+  // dimensions do not match
+  Image small(4u, 8u, PF_NV12);
+  EXPECT_FALSE(convertRGBToYUV(rgb, small));
+  EXPECT_FALSE(convertYUVToRGB(small, rgb));
+}
@@ -38,6 +38,7 @@
 #include "gz/rendering/GpuRays.hh"
 #include "gz/rendering/Grid.hh"
 #include "gz/rendering/ParticleEmitter.hh"
+#include "gz/rendering/Profiler.hh"
 #include "gz/rendering/Projector.hh"
 #include "gz/rendering/RayQuery.hh"
 #include "gz/rendering/RenderTarget.hh"
@@ -1200,6 +1201,7 @@ MeshPtr BaseScene::CreateMesh(const common::Mesh *_mesh)
 //////////////////////////////////////////////////
 MeshPtr BaseScene::CreateMesh(const MeshDescriptor &_desc)
 {
+  GZ_RENDERING_PROFILE("BaseScene::CreateMesh");
   std::string meshName = (_desc.mesh) ?
       _desc.mesh->Name() : _desc.meshName;
 
@@ -1288,6 +1290,7 @@ TextPtr BaseScene::CreateTextImpl(const unsigned int /*_id*/,
 //////////////////////////////////////////////////
 MaterialPtr BaseScene::CreateMaterial(const std::string &_name)
 {
+  GZ_RENDERING_PROFILE("BaseScene::CreateMaterial");
   unsigned int objId = this->CreateObjectId();
 
   std::string objName = _name.empty() ?
@@ -1302,6 +1305,7 @@ MaterialPtr BaseScene::CreateMaterial(const std::string &_name)
 //////////////////////////////////////////////////
 MaterialPtr BaseScene::CreateMaterial(const common::Material &_material)
 {
+  GZ_RENDERING_PROFILE("BaseScene::CreateMaterial");
   MaterialPtr material;
   unsigned int objId = this->CreateObjectId();
   std::string objName = _material.Name().empty() ?
@@ -1498,6 +1502,38 @@ unsigned int BaseScene::ShadowTextureSize(LightType _lightType) const
   return 0;
 }
 
+//////////////////////////////////////////////////
+void BaseScene::SetShadowCachingEnabled(bool _enabled)
+{
+  if (_enabled)
+  {
+    gzerr << "Shadow caching not supported by: "
+          << this->Engine()->Name() << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::ShadowCachingEnabled() const
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetShadowMapRefreshBudget(unsigned int _budget)
+{
+  if (_budget)
+  {
+    gzerr << "Shadow map refresh budget not supported by: "
+          << this->Engine()->Name() << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int BaseScene::ShadowMapRefreshBudget() const
+{
+  return 0u;
+}
+
 //////////////////////////////////////////////////
 void BaseScene::SetActiveGlobalIllumination(GlobalIlluminationBasePtr _gi)
 {
@@ -1512,9 +1548,22 @@ void BaseScene::SetActiveGlobalIllumination(GlobalIlluminationBasePtr _gi)
 //////////////////////////////////////////////////
 void BaseScene::PreRender()
 {
+  if (this->shaderMaterialsDirty)
+  {
+    for (unsigned int i = 0; i < this->VisualCount(); ++i)
+      this->VisualByIndex(i)->SetPreRenderDirty();
+    this->shaderMaterialsDirty = false;
+  }
+
   this->RootVisual()->PreRender();
 }
 
+//////////////////////////////////////////////////
+void BaseScene::SetShaderMaterialsDirty()
+{
+  this->shaderMaterialsDirty = true;
+}
+
 //////////////////////////////////////////////////
 void BaseScene::PostRender()
 {
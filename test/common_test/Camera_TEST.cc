@@ -385,3 +385,46 @@ TEST_F(CameraTest, IntrinsicMatrix)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(CameraTest, UpdateTime)
+{
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(80);
+  camera->SetImageHeight(60);
+  scene->RootVisual()->AddChild(camera);
+
+  // no statistics before the first update
+  EXPECT_EQ(100u, camera->UpdateTimeWindowSize());
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      camera->UpdateTimeMean());
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      camera->UpdateTimeMax());
+
+  camera->SetUpdateTimeWindowSize(4u);
+  EXPECT_EQ(4u, camera->UpdateTimeWindowSize());
+  camera->SetUpdateTimeWindowSize(0u);
+  EXPECT_EQ(1u, camera->UpdateTimeWindowSize());
+  camera->SetUpdateTimeWindowSize(4u);
+
+  for (unsigned int i = 0u; i < 10u; ++i)
+    camera->Update();
+
+  EXPECT_LT(std::chrono::steady_clock::duration::zero(),
+      camera->UpdateTimeMean());
+  EXPECT_LE(camera->UpdateTimeMean(), camera->UpdateTimeMax());
+
+  // changing the window size discards the recorded times
+  camera->SetUpdateTimeWindowSize(8u);
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      camera->UpdateTimeMean());
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      camera->UpdateTimeMax());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
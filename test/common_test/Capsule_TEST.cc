@@ -86,6 +86,22 @@ TEST_F(CapsuleTest, Capsule)
   EXPECT_DOUBLE_EQ(clonedMaterial->Transparency(),
       originalMaterial->Transparency());
 
+  // resize an attached capsule a number of times
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  visual->AddGeometry(capsule);
+  scene->RootVisual()->AddChild(visual);
+  for (unsigned int i = 1u; i <= 10u; ++i)
+  {
+    capsule->SetRadius(0.1 * i);
+    capsule->SetLength(0.2 * i);
+    scene->PreRender();
+    EXPECT_EQ(1u, visual->GeometryCount());
+  }
+  EXPECT_DOUBLE_EQ(1.0, capsule->Radius());
+  EXPECT_DOUBLE_EQ(2.0, capsule->Length());
+  EXPECT_EQ(capsuleMat, capsule->Material());
+
   // Clean up
   engine->DestroyScene(scene);
 }
@@ -16,6 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/LidarVisual.hh"
@@ -104,6 +110,99 @@ TEST_F(LidarVisualTest, LidarVisual)
   lidar->ClearPoints();
   EXPECT_EQ(lidar->PointCount(), 0u);
 
+  // update every visual type, with and without non hitting rays, so that
+  // the number of points drawn grows and shrinks between updates
+  std::vector<double> scan(50u, 10.0);
+  for (unsigned int i = 0; i < scan.size(); i += 3u)
+    scan[i] = INFINITY;
+  for (auto type : {LVT_POINTS, LVT_RAY_LINES, LVT_TRIANGLE_STRIPS})
+  {
+    lidar->SetType(type);
+    for (bool displayNonHitting : {true, false, true})
+    {
+      lidar->SetDisplayNonHitting(displayNonHitting);
+      lidar->SetPoints(scan);
+      lidar->Update();
+      EXPECT_EQ(scan.size(), lidar->PointCount());
+    }
+  }
+
+  // a change of the ray configuration is taken into account
+  lidar->SetHorizontalRayCount(5);
+  lidar->SetPoints(std::vector<double>(25u, 10.0));
+  lidar->Update();
+  EXPECT_EQ(25u, lidar->PointCount());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LidarVisualTest, Bounds)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  LidarVisualPtr lidar = scene->CreateLidarVisual();
+  ASSERT_NE(nullptr, lidar);
+  scene->RootVisual()->AddChild(lidar);
+
+  // three horizontal rays pointing forward, so that everything but the dead
+  // zone is in front of the lidar
+  lidar->SetMinHorizontalAngle(-0.5);
+  lidar->SetMaxHorizontalAngle(0.5);
+  lidar->SetHorizontalRayCount(3);
+  lidar->SetMinVerticalAngle(0.0);
+  lidar->SetMaxVerticalAngle(0.0);
+  lidar->SetVerticalRayCount(1);
+  lidar->SetMinRange(0.5);
+  lidar->SetMaxRange(10.0);
+
+  // the last ray does not hit anything
+  const std::vector<double> scan{2.0, 4.0, INFINITY};
+  const double c = std::cos(0.5);
+  const double s = std::sin(0.5);
+
+  auto checkBounds = [&](LidarVisualType _type, bool _displayNonHitting,
+      const math::Vector3d &_min, const math::Vector3d &_max)
+  {
+    lidar->SetType(_type);
+    lidar->SetDisplayNonHitting(_displayNonHitting);
+    lidar->SetPoints(scan);
+    lidar->Update();
+
+    const math::AxisAlignedBox box = lidar->LocalBoundingBox();
+    const std::string msg = "type " + std::to_string(_type) +
+        " non hitting " + std::to_string(_displayNonHitting);
+    EXPECT_NEAR(_min.X(), box.Min().X(), 1e-3) << msg;
+    EXPECT_NEAR(_min.Y(), box.Min().Y(), 1e-3) << msg;
+    EXPECT_NEAR(_min.Z(), box.Min().Z(), 1e-3) << msg;
+    EXPECT_NEAR(_max.X(), box.Max().X(), 1e-3) << msg;
+    EXPECT_NEAR(_max.Y(), box.Max().Y(), 1e-3) << msg;
+    EXPECT_NEAR(_max.Z(), box.Max().Z(), 1e-3) << msg;
+  };
+
+  // points at the hit ranges, and at the max range for the non hitting ray
+  checkBounds(LVT_POINTS, true,
+      math::Vector3d(2 * c, -2 * s, 0), math::Vector3d(10 * c, 10 * s, 0));
+  checkBounds(LVT_POINTS, false,
+      math::Vector3d(2 * c, -2 * s, 0), math::Vector3d(4, 0, 0));
+
+  // rays start at the min range
+  checkBounds(LVT_RAY_LINES, true,
+      math::Vector3d(0.5 * c, -2 * s, 0), math::Vector3d(10 * c, 10 * s, 0));
+  checkBounds(LVT_RAY_LINES, false,
+      math::Vector3d(0.5 * c, -2 * s, 0), math::Vector3d(4, 0, 0));
+
+  // the dead zone fans reach the origin, and the strips go to the start of
+  // the non hitting ray when it is not displayed
+  checkBounds(LVT_TRIANGLE_STRIPS, true,
+      math::Vector3d(0, -2 * s, 0), math::Vector3d(10 * c, 10 * s, 0));
+  checkBounds(LVT_TRIANGLE_STRIPS, false,
+      math::Vector3d(0, -2 * s, 0), math::Vector3d(4, 0.5 * s, 0));
+
   // Clean up
   engine->DestroyScene(scene);
 }
@@ -16,10 +16,13 @@
 
 #include <gtest/gtest.h>
 
+#include <gz/math/AxisAlignedBox.hh>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/Marker.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 using namespace gz;
 using namespace rendering;
@@ -87,8 +90,36 @@ TEST_F(MarkerTest, Marker)
   // exercise point api
   EXPECT_NO_THROW(marker->AddPoint(math::Vector3d(0, 1, 2),
       math::Color::White));
+  EXPECT_EQ(1u, marker->PointCount());
   EXPECT_NO_THROW(marker->SetPoint(0, math::Vector3d(3, 1, 2)));
+  EXPECT_EQ(1u, marker->PointCount());
+  EXPECT_NO_THROW(marker->ClearPoints());
+  EXPECT_EQ(0u, marker->PointCount());
+
+  // exercise bulk point api
+  const float xyz[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+  const uint32_t rgba[] = {math::Color::Red.AsRGBA(),
+      math::Color::Green.AsRGBA(), math::Color::Blue.AsRGBA()};
+  EXPECT_NO_THROW(marker->SetPoints(0u, 3u, xyz, rgba));
+  EXPECT_EQ(3u, marker->PointCount());
+  // updating existing points keeps the point count
+  EXPECT_NO_THROW(marker->SetPoints(1u, 2u, xyz, nullptr));
+  EXPECT_EQ(3u, marker->PointCount());
+  EXPECT_NO_THROW(marker->SetPoints(0u, 3u, nullptr, rgba));
+  EXPECT_EQ(3u, marker->PointCount());
+  // appends points
+  EXPECT_NO_THROW(marker->SetPoints(3u, 3u, xyz, nullptr));
+  EXPECT_EQ(6u, marker->PointCount());
+  // out of bounds ranges are rejected
+  EXPECT_NO_THROW(marker->SetPoints(10u, 3u, xyz, rgba));
+  EXPECT_EQ(6u, marker->PointCount());
+  EXPECT_NO_THROW(marker->SetPoints(7u, 1u, xyz, rgba));
+  EXPECT_EQ(6u, marker->PointCount());
+  // colors only cannot add points
+  EXPECT_NO_THROW(marker->SetPoints(5u, 3u, nullptr, rgba));
+  EXPECT_EQ(6u, marker->PointCount());
   EXPECT_NO_THROW(marker->ClearPoints());
+  EXPECT_EQ(0u, marker->PointCount());
 
   EXPECT_DOUBLE_EQ(1.0, marker->Size());
   marker->SetSize(3.0);
@@ -97,3 +128,72 @@ TEST_F(MarkerTest, Marker)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(MarkerTest, SetPointsBounds)
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  VisualPtr root = scene->RootVisual();
+
+  const float xyz[] = {-1, -2, 0, 1, 2, 0, 0, 0, -3, 0, 0, 3};
+  const float farXyz[] = {-10, 0, 0, 10, 0, 0};
+
+  // points set in a single call
+  MarkerPtr marker = scene->CreateMarker();
+  marker->SetType(MarkerType::MT_LINE_LIST);
+  marker->SetPoints(0u, 4u, xyz);
+  VisualPtr visual = scene->CreateVisual();
+  visual->AddGeometry(marker);
+  root->AddChild(visual);
+
+  // same points set, moved away with a partial update, then set again
+  // with a full update
+  MarkerPtr updatedMarker = scene->CreateMarker();
+  updatedMarker->SetType(MarkerType::MT_LINE_LIST);
+  updatedMarker->SetPoints(0u, 4u, xyz);
+  VisualPtr updatedVisual = scene->CreateVisual();
+  updatedVisual->AddGeometry(updatedMarker);
+  root->AddChild(updatedVisual);
+  scene->PreRender();
+
+  updatedMarker->SetPoints(1u, 2u, farXyz);
+  EXPECT_EQ(4u, updatedMarker->PointCount());
+  scene->PreRender();
+  math::AxisAlignedBox box = updatedVisual->LocalBoundingBox();
+  EXPECT_NEAR(-10.0, box.Min().X(), 1e-3);
+  EXPECT_NEAR(10.0, box.Max().X(), 1e-3);
+
+  updatedMarker->SetPoints(0u, 4u, xyz);
+  EXPECT_EQ(4u, updatedMarker->PointCount());
+  scene->PreRender();
+
+  const math::AxisAlignedBox expectedBox = visual->LocalBoundingBox();
+  EXPECT_NEAR(-1.0, expectedBox.Min().X(), 1e-3);
+  EXPECT_NEAR(-2.0, expectedBox.Min().Y(), 1e-3);
+  EXPECT_NEAR(-3.0, expectedBox.Min().Z(), 1e-3);
+  EXPECT_NEAR(1.0, expectedBox.Max().X(), 1e-3);
+  EXPECT_NEAR(2.0, expectedBox.Max().Y(), 1e-3);
+  EXPECT_NEAR(3.0, expectedBox.Max().Z(), 1e-3);
+
+  box = updatedVisual->LocalBoundingBox();
+  EXPECT_NEAR(expectedBox.Min().X(), box.Min().X(), 1e-3);
+  EXPECT_NEAR(expectedBox.Min().Y(), box.Min().Y(), 1e-3);
+  EXPECT_NEAR(expectedBox.Min().Z(), box.Min().Z(), 1e-3);
+  EXPECT_NEAR(expectedBox.Max().X(), box.Max().X(), 1e-3);
+  EXPECT_NEAR(expectedBox.Max().Y(), box.Max().Y(), 1e-3);
+  EXPECT_NEAR(expectedBox.Max().Z(), box.Max().Z(), 1e-3);
+
+  // an out of range offset leaves the points and bounds unchanged
+  updatedMarker->SetPoints(5u, 2u, farXyz);
+  EXPECT_EQ(4u, updatedMarker->PointCount());
+  scene->PreRender();
+  box = updatedVisual->LocalBoundingBox();
+  EXPECT_NEAR(expectedBox.Min().X(), box.Min().X(), 1e-3);
+  EXPECT_NEAR(expectedBox.Max().X(), box.Max().X(), 1e-3);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
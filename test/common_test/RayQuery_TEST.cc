@@ -17,11 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/Camera.hh"
+#include "gz/rendering/Capsule.hh"
 #include "gz/rendering/RayQuery.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 using namespace gz;
 using namespace rendering;
@@ -111,3 +115,138 @@ TEST_F(RayQueryTest, RayQuery)
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryTest, ClosestPoints)
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // a row of boxes along the x axis
+  VisualPtr root = scene->RootVisual();
+  const unsigned int boxCount = 5u;
+  std::vector<unsigned int> boxIds;
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    VisualPtr box = scene->CreateVisual();
+    box->AddGeometry(scene->CreateBox());
+    box->SetLocalPosition(2.0 * i, 0.0, 0.0);
+    root->AddChild(box);
+    boxIds.push_back(box->Id());
+  }
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+  rayQuery->SetPreferGpu(false);
+  math::Vector3d userOrigin(1.0, 2.0, 3.0);
+  math::Vector3d userDirection(0.0, 0.0, 1.0);
+  rayQuery->SetOrigin(userOrigin);
+  rayQuery->SetDirection(userDirection);
+
+  // one ray straight down onto each box, plus one that misses everything
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> directions;
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    origins.push_back(math::Vector3d(2.0 * i, 0.0, 5.0));
+    directions.push_back(-math::Vector3d::UnitZ);
+  }
+  origins.push_back(math::Vector3d(1.0, 0.0, 5.0));
+  directions.push_back(-math::Vector3d::UnitZ);
+
+  std::vector<RayQueryResult> results;
+  rayQuery->ClosestPoints(origins, directions, results);
+  ASSERT_EQ(origins.size(), results.size());
+
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    EXPECT_TRUE(results[i]);
+    EXPECT_NEAR(4.5, results[i].distance, 1e-4);
+    EXPECT_TRUE(math::Vector3d(2.0 * i, 0.0, 0.5).Equal(
+        results[i].point, 1e-4)) << results[i].point;
+    EXPECT_EQ(boxIds[i], results[i].objectId);
+  }
+  EXPECT_FALSE(results[boxCount]);
+
+  // same results as querying the rays one at a time
+  for (unsigned int i = 0; i < origins.size(); ++i)
+  {
+    rayQuery->SetOrigin(origins[i]);
+    rayQuery->SetDirection(directions[i]);
+    RayQueryResult result = rayQuery->ClosestPoint();
+    EXPECT_DOUBLE_EQ(result.distance, results[i].distance);
+    EXPECT_EQ(result.objectId, results[i].objectId);
+  }
+
+  // the ray set on the query is not touched
+  rayQuery->SetOrigin(userOrigin);
+  rayQuery->SetDirection(userDirection);
+  rayQuery->ClosestPoints(origins, directions, results);
+  EXPECT_EQ(userOrigin, rayQuery->Origin());
+  EXPECT_EQ(userDirection, rayQuery->Direction());
+
+  // mismatched inputs
+  directions.pop_back();
+  rayQuery->ClosestPoints(origins, directions, results);
+  EXPECT_TRUE(results.empty());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryTest, Capsule)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  CapsulePtr capsule = scene->CreateCapsule();
+  ASSERT_NE(nullptr, capsule);
+  capsule->SetRadius(0.5);
+  capsule->SetLength(1.0);
+  VisualPtr visual = scene->CreateVisual();
+  visual->AddGeometry(capsule);
+  scene->RootVisual()->AddChild(visual);
+  scene->PreRender();
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+  rayQuery->SetPreferGpu(false);
+  rayQuery->SetOrigin(math::Vector3d(0.0, 0.0, 5.0));
+  rayQuery->SetDirection(-math::Vector3d::UnitZ);
+
+  // top of the upper hemisphere
+  RayQueryResult result = rayQuery->ClosestPoint();
+  EXPECT_TRUE(result);
+  EXPECT_NEAR(4.0, result.distance, 1e-3);
+  EXPECT_EQ(visual->Id(), result.objectId);
+
+  // the ray follows a resize
+  capsule->SetLength(3.0);
+  scene->PreRender();
+  result = rayQuery->ClosestPoint();
+  EXPECT_TRUE(result);
+  EXPECT_NEAR(3.0, result.distance, 1e-3);
+  EXPECT_EQ(visual->Id(), result.objectId);
+
+  // capsules of other scenes do not share or release the mesh of this one
+  ScenePtr otherScene = engine->CreateScene("other_scene");
+  ASSERT_NE(nullptr, otherScene);
+  CapsulePtr otherCapsule = otherScene->CreateCapsule();
+  ASSERT_NE(nullptr, otherCapsule);
+  otherCapsule->SetLength(0.5);
+  otherScene->PreRender();
+  engine->DestroyScene(otherScene);
+
+  result = rayQuery->ClosestPoint();
+  EXPECT_TRUE(result);
+  EXPECT_NEAR(3.0, result.distance, 1e-3);
+  EXPECT_EQ(visual->Id(), result.objectId);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
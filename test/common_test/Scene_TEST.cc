@@ -19,8 +19,13 @@
 
 #include "CommonRenderingTest.hh"
 
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/Light.hh"
+#include "gz/rendering/Material.hh"
 #include "gz/rendering/RenderTarget.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 using namespace gz;
 using namespace rendering;
@@ -233,21 +238,28 @@ TEST_F(SceneTest, RemoveNodes)
   EXPECT_EQ(3u, parent->ChildCount());
   EXPECT_EQ(5u, scene->VisualCount());
 
-  // Remove child by index
-  parent->RemoveChildByIndex(0u);
-  EXPECT_FALSE(parent->HasChild(child02));
+  // Remove child by index. Removal does not preserve the order of the
+  // remaining children, so look up which child is at the index first
+  NodePtr childByIndex = parent->ChildByIndex(0u);
+  ASSERT_NE(nullptr, childByIndex);
+  EXPECT_EQ(childByIndex, parent->RemoveChildByIndex(0u));
+  EXPECT_FALSE(parent->HasChild(childByIndex));
   EXPECT_EQ(2u, parent->ChildCount());
   EXPECT_EQ(5u, scene->VisualCount());
 
   // Remove child by Id
-  parent->RemoveChildById(child03->Id());
-  EXPECT_FALSE(parent->HasChild(child03));
+  NodePtr childById = parent->ChildByIndex(0u);
+  ASSERT_NE(nullptr, childById);
+  parent->RemoveChildById(childById->Id());
+  EXPECT_FALSE(parent->HasChild(childById));
   EXPECT_EQ(1u, parent->ChildCount());
   EXPECT_EQ(5u, scene->VisualCount());
 
   // Remove child by name
-  parent->RemoveChildByName(child04->Name());
-  EXPECT_FALSE(parent->HasChild(child04));
+  NodePtr childByName = parent->ChildByIndex(0u);
+  ASSERT_NE(nullptr, childByName);
+  parent->RemoveChildByName(childByName->Name());
+  EXPECT_FALSE(parent->HasChild(childByName));
   EXPECT_EQ(0u, parent->ChildCount());
   EXPECT_EQ(5u, scene->VisualCount());
 
@@ -332,24 +344,40 @@ TEST_F(SceneTest, DestroyNodes)
   EXPECT_EQ(3u, parent->ChildCount());
   EXPECT_EQ(4u, scene->VisualCount());
 
-  // Destroy a child visual by index
-  scene->DestroyVisualByIndex(1u);
-  EXPECT_FALSE(parent->HasChild(child02));
-  EXPECT_FALSE(scene->HasVisual(child02));
+  // Destroy a child visual by index. Removal does not preserve the order
+  // of the remaining visuals, so look up which child is at the index first
+  NodePtr childByIndex = parent->ChildByIndex(0u);
+  ASSERT_NE(nullptr, childByIndex);
+  VisualPtr visualByIndex = std::dynamic_pointer_cast<Visual>(childByIndex);
+  ASSERT_NE(nullptr, visualByIndex);
+  unsigned int index = scene->VisualCount();
+  for (unsigned int i = 0; i < scene->VisualCount(); ++i)
+  {
+    if (scene->VisualByIndex(i) == visualByIndex)
+      index = i;
+  }
+  ASSERT_LT(index, scene->VisualCount());
+  scene->DestroyVisualByIndex(index);
+  EXPECT_FALSE(parent->HasChild(childByIndex));
+  EXPECT_FALSE(scene->HasVisual(visualByIndex));
   EXPECT_EQ(2u, parent->ChildCount());
   EXPECT_EQ(3u, scene->VisualCount());
 
   // Destroy a child visual by id
-  scene->DestroyVisualById(child03->Id());
-  EXPECT_FALSE(parent->HasChild(child03));
-  EXPECT_FALSE(scene->HasVisual(child03));
+  NodePtr childById = parent->ChildByIndex(0u);
+  ASSERT_NE(nullptr, childById);
+  scene->DestroyVisualById(childById->Id());
+  EXPECT_FALSE(parent->HasChild(childById));
+  EXPECT_FALSE(scene->HasVisualId(childById->Id()));
   EXPECT_EQ(1u, parent->ChildCount());
   EXPECT_EQ(2u, scene->VisualCount());
 
   // Destroy a child visual by name
-  scene->DestroyVisualByName(child04->Name());
-  EXPECT_FALSE(parent->HasChild(child04));
-  EXPECT_FALSE(scene->HasVisual(child04));
+  NodePtr childByName = parent->ChildByIndex(0u);
+  ASSERT_NE(nullptr, childByName);
+  scene->DestroyVisualByName(childByName->Name());
+  EXPECT_FALSE(parent->HasChild(childByName));
+  EXPECT_FALSE(scene->HasVisualName(childByName->Name()));
   EXPECT_EQ(0u, parent->ChildCount());
   EXPECT_EQ(1u, scene->VisualCount());
 
@@ -791,3 +819,189 @@ TEST_F(SceneTest, ShadowTextureSize)
   EXPECT_FALSE(scene->SetShadowTextureSize(LightType::DIRECTIONAL, 32768u));
   EXPECT_EQ(scene->ShadowTextureSize(LightType::DIRECTIONAL), 8192u);
 }
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, ShadowCaching)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // disabled by default, without a refresh budget
+  EXPECT_FALSE(scene->ShadowCachingEnabled());
+  EXPECT_EQ(0u, scene->ShadowMapRefreshBudget());
+
+  scene->SetShadowCachingEnabled(true);
+  EXPECT_TRUE(scene->ShadowCachingEnabled());
+  scene->SetShadowMapRefreshBudget(1u);
+  EXPECT_EQ(1u, scene->ShadowMapRefreshBudget());
+
+  VisualPtr root = scene->RootVisual();
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(32);
+  camera->SetImageHeight(32);
+  camera->SetLocalPosition(-3.0, 0.0, 1.0);
+  root->AddChild(camera);
+
+  SpotLightPtr spotLight = scene->CreateSpotLight();
+  spotLight->SetCastShadows(true);
+  spotLight->SetLocalPosition(0.0, 0.0, 3.0);
+  spotLight->SetDirection(0.0, 0.0, -1.0);
+  root->AddChild(spotLight);
+
+  PointLightPtr pointLight = scene->CreatePointLight();
+  pointLight->SetCastShadows(true);
+  pointLight->SetLocalPosition(0.0, 2.0, 2.0);
+  root->AddChild(pointLight);
+
+  VisualPtr ground = scene->CreateVisual();
+  ground->AddGeometry(scene->CreatePlane());
+  ground->SetLocalScale(10.0, 10.0, 1.0);
+  ground->SetStatic(true);
+  root->AddChild(ground);
+
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(0.0, 0.0, 0.5);
+  root->AddChild(box);
+
+  // render while a caster and the lights move, the budget spreads the
+  // shadow maps to render again over the frames
+  Image image = camera->CreateImage();
+  for (unsigned int i = 0; i < 5u; ++i)
+  {
+    box->SetLocalPosition(0.1 * i, 0.0, 0.5);
+    camera->Capture(image);
+  }
+  spotLight->SetLocalPosition(1.0, 0.0, 3.0);
+  pointLight->SetLocalPosition(0.0, -2.0, 2.0);
+  camera->Capture(image);
+
+  // changing the shadow casting lights replaces the cached shadow maps
+  scene->DestroyLight(pointLight);
+  camera->Capture(image);
+
+  scene->SetShadowMapRefreshBudget(0u);
+  EXPECT_EQ(0u, scene->ShadowMapRefreshBudget());
+  scene->SetShadowCachingEnabled(false);
+  EXPECT_FALSE(scene->ShadowCachingEnabled());
+  camera->Capture(image);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneTest, ShadowCachingInvalidation)
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  scene->SetAmbientLight(0.1, 0.1, 0.1);
+
+  // a single shadow map is rendered again per frame
+  scene->SetShadowCachingEnabled(true);
+  scene->SetShadowMapRefreshBudget(1u);
+
+  VisualPtr root = scene->RootVisual();
+
+  // camera straight above, looking down. The top of the image is +x and
+  // its left is +y, a pixel covers 0.1 m on the ground.
+  const unsigned int size = 240u;
+  const math::Vector3d cameraPos(10.0, 0.0, 12.0);
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(size);
+  camera->SetImageHeight(size);
+  camera->SetHFOV(GZ_PI / 2);
+  camera->SetLocalPosition(cameraPos);
+  camera->SetLocalRotation(0.0, GZ_PI / 2, 0.0);
+  root->AddChild(camera);
+
+  MaterialPtr white = scene->CreateMaterial();
+  white->SetDiffuse(1.0, 1.0, 1.0);
+  white->SetSpecular(0.0, 0.0, 0.0);
+
+  VisualPtr ground = scene->CreateVisual();
+  ground->AddGeometry(scene->CreatePlane());
+  ground->SetLocalPosition(10.0, 0.0, 0.0);
+  ground->SetLocalScale(40.0, 40.0, 1.0);
+  ground->SetMaterial(white);
+  ground->SetStatic(true);
+  root->AddChild(ground);
+
+  // two spot lights 20 m apart, each out of the range of the other, with a
+  // box floating next to the axis of each one
+  const double lightX[2] = {0.0, 20.0};
+  VisualPtr casters[2];
+  for (unsigned int i = 0; i < 2u; ++i)
+  {
+    SpotLightPtr light = scene->CreateSpotLight();
+    light->SetCastShadows(true);
+    light->SetDiffuseColor(1.0, 1.0, 1.0);
+    light->SetAttenuationRange(5.0);
+    light->SetInnerAngle(1.5);
+    light->SetOuterAngle(2.0);
+    light->SetLocalPosition(lightX[i], 0.0, 3.0);
+    light->SetDirection(0.0, 0.0, -1.0);
+    root->AddChild(light);
+
+    casters[i] = scene->CreateVisual();
+    casters[i]->AddGeometry(scene->CreateBox());
+    casters[i]->SetLocalScale(0.5, 0.5, 0.5);
+    casters[i]->SetLocalPosition(lightX[i], 0.5, 1.5);
+    casters[i]->SetMaterial(white);
+    root->AddChild(casters[i]);
+  }
+
+  Image image = camera->CreateImage();
+  auto brightness = [&](double _x, double _y)
+  {
+    const double pixel = 2.0 * cameraPos.Z() / size;
+    const int row = static_cast<int>(size / 2 - (_x - cameraPos.X()) / pixel);
+    const int col = static_cast<int>(size / 2 - (_y - cameraPos.Y()) / pixel);
+    const unsigned char *data = image.Data<unsigned char>();
+    const unsigned int idx = (row * size + col) * 3u;
+    return static_cast<int>(data[idx]) + data[idx + 1] + data[idx + 2];
+  };
+
+  // The shadow of a box at y = +0.5 covers the ground at y = 1.2 and not
+  // the ground at y = -1.2, which is lit the same way when not shadowed.
+  auto expectShadowAt = [&](double _x, double _y)
+  {
+    EXPECT_LT(brightness(_x, _y), brightness(_x, -_y) / 2)
+        << "x: " << _x << " y: " << _y;
+  };
+
+  // with a budget of 1 the shadow maps are rendered over the first frames,
+  // after that the cached maps keep the shadows in place
+  for (unsigned int i = 0; i < 3u; ++i)
+    camera->Capture(image);
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    camera->Capture(image);
+    expectShadowAt(lightX[0], 1.2);
+    expectShadowAt(lightX[1], 1.2);
+  }
+
+  // moving a caster renders again the map of the light it is in range of,
+  // in the next frame
+  casters[0]->SetLocalPosition(lightX[0], -0.5, 1.5);
+  camera->Capture(image);
+  expectShadowAt(lightX[0], -1.2);
+  expectShadowAt(lightX[1], 1.2);
+
+  // The second caster is out of the range of the first light. If moving it
+  // marked the first map dirty as well, that map would be rendered first
+  // and use the budget, leaving the shadow of the second light behind.
+  casters[1]->SetLocalPosition(lightX[1], -0.5, 1.5);
+  camera->Capture(image);
+  expectShadowAt(lightX[0], -1.2);
+  expectShadowAt(lightX[1], -1.2);
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
@@ -20,6 +20,7 @@
 
 #include "gz/rendering/Text.hh"
 #include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
 
 using namespace gz;
 using namespace rendering;
@@ -31,7 +32,7 @@ class TextTest : public CommonRenderingTest
 /////////////////////////////////////////////////
 TEST_F(TextTest, Text)
 {
-  CHECK_SUPPORTED_ENGINE("ogre");
+  CHECK_SUPPORTED_ENGINE("ogre", "ogre2");
 
   ScenePtr scene = engine->CreateScene("scene");
 
@@ -96,10 +97,57 @@ TEST_F(TextTest, Text)
   engine->DestroyScene(scene);
 }
 
+/////////////////////////////////////////////////
+TEST_F(TextTest, Layout)
+{
+  // the ogre text does not compute a tight box
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+
+  TextPtr text = scene->CreateText();
+  ASSERT_NE(nullptr, text);
+
+  VisualPtr visual = scene->CreateVisual();
+  visual->AddGeometry(text);
+  scene->RootVisual()->AddChild(visual);
+
+  text->SetTextString("abc");
+  text->SetCharHeight(0.5f);
+  text->SetTextAlignment(TextHorizontalAlign::CENTER,
+      TextVerticalAlign::BOTTOM);
+  text->PreRender();
+
+  // one line centered horizontally, standing on the anchor
+  math::AxisAlignedBox box = text->AABB();
+  EXPECT_GT(box.Max().X(), 0.0);
+  EXPECT_NEAR(-box.Min().X(), box.Max().X(), 1e-5);
+  EXPECT_NEAR(0.0, box.Min().Y(), 1e-5);
+  EXPECT_NEAR(0.5, box.Max().Y(), 1e-5);
+
+  // two lines hanging from the anchor
+  text->SetTextString("abc\ndef");
+  text->SetTextAlignment(TextHorizontalAlign::LEFT, TextVerticalAlign::TOP);
+  text->PreRender();
+  box = text->AABB();
+  EXPECT_NEAR(0.0, box.Min().X(), 1e-5);
+  EXPECT_NEAR(-1.0, box.Min().Y(), 1e-5);
+  EXPECT_NEAR(0.0, box.Max().Y(), 1e-5);
+
+  // spaces only
+  text->SetTextString("   ");
+  text->PreRender();
+  EXPECT_EQ(math::AxisAlignedBox(math::Vector3d::Zero, math::Vector3d::Zero),
+      text->AABB());
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
 class FontTest : public TextTest, public testing::WithParamInterface<std::string> {};
 
 TEST_P(FontTest, SupportedFont){
-  CHECK_SUPPORTED_ENGINE("ogre");
+  CHECK_SUPPORTED_ENGINE("ogre", "ogre2");
 
   ScenePtr scene = engine->CreateScene("scene");
 
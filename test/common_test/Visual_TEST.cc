@@ -20,9 +20,12 @@
 
 #include "CommonRenderingTest.hh"
 
+#include <gz/common/Filesystem.hh>
 #include <gz/math/AxisAlignedBox.hh>
 
+#include "gz/rendering/Camera.hh"
 #include "gz/rendering/Geometry.hh"
+#include "gz/rendering/Mesh.hh"
 #include "gz/rendering/Scene.hh"
 #include "gz/rendering/Visual.hh"
 
@@ -31,6 +34,10 @@ using namespace rendering;
 
 class VisualTest : public CommonRenderingTest
 {
+  /// \brief Path to test shaders
+  public: const std::string TEST_MEDIA_PATH =
+        common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+        "test", "media", "materials", "programs");
 };
 
 /////////////////////////////////////////////////
@@ -631,3 +638,130 @@ TEST_F(VisualTest, Clone)
   // clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(VisualTest, PreRenderDirty)
+{
+  // optix writes all poses to the device every frame
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr root = scene->RootVisual();
+  VisualPtr parent = scene->CreateVisual();
+  ASSERT_NE(nullptr, parent);
+  root->AddChild(parent);
+  VisualPtr child = scene->CreateVisual();
+  ASSERT_NE(nullptr, child);
+  child->AddGeometry(scene->CreateBox());
+  parent->AddChild(child);
+
+  // new nodes are visited by the next PreRender
+  EXPECT_TRUE(root->PreRenderRequired());
+  EXPECT_TRUE(parent->PreRenderRequired());
+  EXPECT_TRUE(child->PreRenderRequired());
+
+  // visuals with plain meshes are skipped once up to date
+  scene->PreRender();
+  EXPECT_FALSE(parent->PreRenderRequired());
+  EXPECT_FALSE(child->PreRenderRequired());
+
+  // changes are propagated to all ancestors
+  child->SetMaterial(scene->CreateMaterial());
+  EXPECT_TRUE(child->PreRenderRequired());
+  EXPECT_TRUE(parent->PreRenderRequired());
+  EXPECT_TRUE(root->PreRenderRequired());
+  scene->PreRender();
+  EXPECT_FALSE(parent->PreRenderRequired());
+  EXPECT_FALSE(child->PreRenderRequired());
+
+  // sensors are updated every frame, and so are their ancestors
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  parent->AddChild(camera);
+  scene->PreRender();
+  scene->PreRender();
+  EXPECT_TRUE(camera->PreRenderRequired());
+  EXPECT_TRUE(parent->PreRenderRequired());
+  EXPECT_FALSE(child->PreRenderRequired());
+
+  parent->RemoveChild(camera);
+  scene->PreRender();
+  EXPECT_FALSE(parent->PreRenderRequired());
+
+  // clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(VisualTest, PreRenderShaderMaterial)
+{
+  CHECK_SUPPORTED_ENGINE("ogre", "ogre2");
+
+  std::string vertexShaderFile = "simple_color_vs.glsl";
+  std::string fragmentShaderFile = "simple_color_fs.glsl";
+  if (this->engine->Name() == "ogre2")
+  {
+    switch (this->engine->GraphicsAPI())
+    {
+      case GraphicsAPI::OPENGL:
+      case GraphicsAPI::VULKAN:
+        vertexShaderFile = "simple_color_330_vs.glsl";
+        fragmentShaderFile = "simple_color_330_fs.glsl";
+        break;
+      case GraphicsAPI::METAL:
+        vertexShaderFile = "simple_color_vs.metal";
+        fragmentShaderFile = "simple_color_fs.metal";
+        break;
+      default:
+        GTEST_SKIP() << "Unsupported graphics API for this test.";
+    }
+  }
+  const std::string vertexShaderPath =
+      common::joinPaths(TEST_MEDIA_PATH, vertexShaderFile);
+  const std::string fragmentShaderPath =
+      common::joinPaths(TEST_MEDIA_PATH, fragmentShaderFile);
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  visual->AddGeometry(scene->CreateBox());
+  visual->SetMaterial(scene->CreateMaterial());
+  scene->RootVisual()->AddChild(visual);
+  scene->PreRender();
+  EXPECT_FALSE(visual->PreRenderRequired());
+
+  // the material of an up to date visual gains shaders, the visual needs to
+  // update the shader params every frame from now on
+  MeshPtr mesh = std::dynamic_pointer_cast<Mesh>(visual->GeometryByIndex(0u));
+  ASSERT_NE(nullptr, mesh);
+  MaterialPtr material = mesh->SubMeshByIndex(0u)->Material();
+  ASSERT_NE(nullptr, material);
+  material->SetVertexShader(vertexShaderPath);
+  material->SetFragmentShader(fragmentShaderPath);
+  scene->PreRender();
+  scene->PreRender();
+  EXPECT_TRUE(visual->PreRenderRequired());
+
+  // same for a sub-mesh given a shader material directly
+  VisualPtr visual2 = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual2);
+  visual2->AddGeometry(scene->CreateBox());
+  scene->RootVisual()->AddChild(visual2);
+  scene->PreRender();
+  EXPECT_FALSE(visual2->PreRenderRequired());
+
+  MeshPtr mesh2 =
+      std::dynamic_pointer_cast<Mesh>(visual2->GeometryByIndex(0u));
+  ASSERT_NE(nullptr, mesh2);
+  mesh2->SubMeshByIndex(0u)->SetMaterial(material, false);
+  scene->PreRender();
+  scene->PreRender();
+  EXPECT_TRUE(visual2->PreRenderRequired());
+
+  // clean up
+  engine->DestroyScene(scene);
+}
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+
 #include "CommonRenderingTest.hh"
 
 #include "gz/rendering/Camera.hh"
@@ -25,6 +27,7 @@
 #include "gz/rendering/SegmentationCamera.hh"
 #include "gz/rendering/ShaderParams.hh"
 #include "gz/rendering/ThermalCamera.hh"
+#include "gz/rendering/Utils.hh"
 
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -814,3 +817,151 @@ TEST_F(CameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(AspectRatioTest))
   // Clean up
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(CameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Bayer))
+{
+  CHECK_SUPPORTED_ENGINE("ogre", "ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  scene->SetBackgroundColor(0.2, 0.4, 0.6);
+  scene->SetAmbientLight(1, 1, 1);
+
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(48);
+  camera->SetWorldPosition(-2, 0, 0);
+  root->AddChild(camera);
+
+  // boxes of different colors so that every channel varies in the image
+  const math::Color colors[] = {math::Color::Red, math::Color::Green,
+      math::Color::Blue};
+  for (int i = 0; i < 3; ++i)
+  {
+    MaterialPtr mat = scene->CreateMaterial();
+    mat->SetAmbient(colors[i]);
+    mat->SetDiffuse(colors[i]);
+    VisualPtr visual = scene->CreateVisual();
+    visual->AddGeometry(scene->CreateBox());
+    visual->SetMaterial(mat);
+    visual->SetWorldPosition(0.0, -1.0 + i, 0.0);
+    visual->SetLocalScale(0.5);
+    root->AddChild(visual);
+  }
+
+  camera->SetImageFormat(PF_R8G8B8);
+  Image rgbImage = camera->CreateImage();
+  camera->Capture(rgbImage);
+
+  // bayer images read back from the render target match the ones
+  // converted on the CPU from the color image, up to rounding
+  for (auto format : {PF_BAYER_RGGB8, PF_BAYER_BGGR8, PF_BAYER_GBRG8,
+      PF_BAYER_GRBG8})
+  {
+    camera->SetImageFormat(format);
+    Image bayerImage = camera->CreateImage();
+    ASSERT_EQ(format, bayerImage.Format());
+    camera->Capture(bayerImage);
+
+    Image expected = convertRGBToBayer(rgbImage, format);
+    const unsigned char *data = bayerImage.Data<unsigned char>();
+    const unsigned char *expectedData = expected.Data<unsigned char>();
+    const unsigned int size =
+        camera->ImageWidth() * camera->ImageHeight();
+    unsigned int mismatches = 0u;
+    for (unsigned int i = 0u; i < size; ++i)
+    {
+      if (std::abs(static_cast<int>(data[i]) - expectedData[i]) > 1)
+        ++mismatches;
+    }
+    EXPECT_EQ(0u, mismatches) << PixelUtil::Name(format);
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Yuv))
+{
+  CHECK_SUPPORTED_ENGINE("ogre", "ogre2");
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  scene->SetBackgroundColor(0.2, 0.4, 0.6);
+  scene->SetAmbientLight(1, 1, 1);
+
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(48);
+  camera->SetWorldPosition(-2, 0, 0);
+  root->AddChild(camera);
+
+  // boxes of different colors so that every channel varies in the image
+  const math::Color colors[] = {math::Color::Red, math::Color::Green,
+      math::Color::Blue};
+  for (int i = 0; i < 3; ++i)
+  {
+    MaterialPtr mat = scene->CreateMaterial();
+    mat->SetAmbient(colors[i]);
+    mat->SetDiffuse(colors[i]);
+    VisualPtr visual = scene->CreateVisual();
+    visual->AddGeometry(scene->CreateBox());
+    visual->SetMaterial(mat);
+    visual->SetWorldPosition(0.0, -1.0 + i, 0.0);
+    visual->SetLocalScale(0.5);
+    root->AddChild(visual);
+  }
+
+  camera->SetImageFormat(PF_R8G8B8);
+  Image rgbImage = camera->CreateImage();
+  camera->Capture(rgbImage);
+
+  // yuv images read back from the render target match the ones converted
+  // on the CPU from the color image, up to rounding
+  for (auto format : {PF_NV12, PF_I420, PF_YUYV})
+  {
+    camera->SetImageFormat(format);
+    Image yuvImage = camera->CreateImage();
+    ASSERT_EQ(format, yuvImage.Format());
+    EXPECT_EQ(camera->ImageMemorySize(), yuvImage.MemorySize());
+    camera->Capture(yuvImage);
+
+    Image expected(camera->ImageWidth(), camera->ImageHeight(), format);
+    EXPECT_TRUE(convertRGBToYUV(rgbImage, expected));
+    const unsigned char *data = yuvImage.Data<unsigned char>();
+    const unsigned char *expectedData = expected.Data<unsigned char>();
+    unsigned int mismatches = 0u;
+    for (unsigned int i = 0u; i < expected.MemorySize(); ++i)
+    {
+      if (std::abs(static_cast<int>(data[i]) - expectedData[i]) > 2)
+        ++mismatches;
+    }
+    EXPECT_EQ(0u, mismatches) << PixelUtil::Name(format);
+
+    // and convert back to the color image, up to the detail lost by
+    // subsampling the chroma at the edges of the boxes
+    Image rgbResult(camera->ImageWidth(), camera->ImageHeight(), PF_R8G8B8);
+    EXPECT_TRUE(convertYUVToRGB(yuvImage, rgbResult));
+    const unsigned char *rgbData = rgbImage.Data<unsigned char>();
+    const unsigned char *resultData = rgbResult.Data<unsigned char>();
+    unsigned int close = 0u;
+    for (unsigned int i = 0u; i < rgbImage.MemorySize(); ++i)
+    {
+      if (std::abs(static_cast<int>(resultData[i]) - rgbData[i]) <= 4)
+        ++close;
+    }
+    EXPECT_GT(close, rgbImage.MemorySize() * 9u / 10u)
+        << PixelUtil::Name(format);
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
@@ -16,7 +16,11 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "CommonRenderingTest.hh"
 
@@ -856,3 +860,315 @@ TEST_F(DepthCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(DepthCameraProjection))
 
   engine->DestroyScene(scene);
 }
+
+/////////////////////////////////////////////////
+TEST_F(DepthCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReadbackLatency))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  unsigned int imgWidth = 64u;
+  unsigned int imgHeight = 64u;
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  gz::rendering::VisualPtr root = scene->RootVisual();
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(1.8, 0.0, 0.0);
+  root->AddChild(box);
+  {
+    auto depthCamera = scene->CreateDepthCamera("DepthCamera");
+    ASSERT_NE(depthCamera, nullptr);
+    depthCamera->SetImageWidth(imgWidth);
+    depthCamera->SetImageHeight(imgHeight);
+    depthCamera->SetFarClipPlane(10.0);
+    depthCamera->SetNearClipPlane(0.1);
+    depthCamera->SetAspectRatio(1.0);
+    depthCamera->SetHFOV(1.05);
+    depthCamera->CreateDepthTexture();
+    root->AddChild(depthCamera);
+
+    EXPECT_EQ(0u, depthCamera->ReadbackLatency());
+    const unsigned int latency = 2u;
+    depthCamera->SetReadbackLatency(latency);
+    EXPECT_EQ(latency, depthCamera->ReadbackLatency());
+
+    float *scan = new float[imgHeight * imgWidth];
+    std::vector<uint64_t> frameIds;
+    gz::common::ConnectionPtr connection =
+      depthCamera->ConnectNewDepthFrame(
+          [&](const float *_scan, unsigned int _width, unsigned int _height,
+              unsigned int _channels, const std::string &_format)
+          {
+            OnNewDepthFrame(scan, _scan, _width, _height, _channels,
+                _format);
+            frameIds.push_back(depthCamera->ReadbackFrameId());
+          });
+
+    // no data is delivered until the readback ring is full
+    g_depthCounter = 0u;
+    for (unsigned int i = 0u; i < latency; ++i)
+    {
+      depthCamera->Update();
+      EXPECT_EQ(0u, g_depthCounter);
+    }
+
+    // from then on there is one frame per update, lagging by the latency
+    const unsigned int updates = 5u;
+    for (unsigned int i = 0u; i < updates; ++i)
+      depthCamera->Update();
+    EXPECT_EQ(updates, g_depthCounter);
+    ASSERT_EQ(updates, frameIds.size());
+    for (unsigned int i = 0u; i < updates; ++i)
+      EXPECT_EQ(i + 1u, frameIds[i]);
+
+    // delayed data is the same as synchronous data for a static scene
+    float expectedRange = 1.8f - 0.5f;
+    unsigned int mid = imgHeight / 2u * imgWidth + imgWidth / 2u;
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+
+    connection.reset();
+    delete [] scan;
+    scan = nullptr;
+  }
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(DepthCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(DepthFrameView))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  unsigned int imgWidth = 64u;
+  unsigned int imgHeight = 64u;
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  gz::rendering::VisualPtr root = scene->RootVisual();
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(1.8, 0.0, 0.0);
+  root->AddChild(box);
+  {
+    auto depthCamera = scene->CreateDepthCamera("DepthCamera");
+    ASSERT_NE(depthCamera, nullptr);
+    depthCamera->SetImageWidth(imgWidth);
+    depthCamera->SetImageHeight(imgHeight);
+    depthCamera->SetFarClipPlane(10.0);
+    depthCamera->SetNearClipPlane(0.1);
+    depthCamera->SetAspectRatio(1.0);
+    depthCamera->SetHFOV(1.05);
+    depthCamera->CreateDepthTexture();
+    root->AddChild(depthCamera);
+
+    // copy the depth channel out of the view
+    std::vector<float> viewDepth;
+    unsigned int viewCount = 0u;
+    gz::rendering::SensorFrameView lastView;
+    gz::common::ConnectionPtr viewConnection =
+      depthCamera->ConnectNewDepthFrameView(
+          [&](const gz::rendering::SensorFrameView &_view)
+          {
+            EXPECT_TRUE(_view.Valid());
+            EXPECT_EQ(imgWidth, _view.width);
+            EXPECT_EQ(imgHeight, _view.height);
+            EXPECT_EQ(4u, _view.channels);
+            EXPECT_EQ(gz::rendering::PF_FLOAT32_RGBA, _view.format);
+            EXPECT_GE(_view.pixelStride, 4u * sizeof(float));
+            EXPECT_GE(_view.rowPitch, _view.width * _view.pixelStride);
+            viewDepth.resize(_view.width * _view.height);
+            for (unsigned int r = 0u; r < _view.height; ++r)
+            {
+              for (unsigned int c = 0u; c < _view.width; ++c)
+                viewDepth[r * _view.width + c] = _view.Pixel<float>(r, c)[0];
+            }
+            lastView = _view;
+            ++viewCount;
+          });
+    ASSERT_NE(nullptr, viewConnection);
+
+    // view only subscribers do not need the packed buffers
+    depthCamera->Update();
+    EXPECT_EQ(1u, viewCount);
+    EXPECT_FALSE(lastView.Valid());
+    float expectedRange = 1.8f - 0.5f;
+    unsigned int mid = imgHeight / 2u * imgWidth + imgWidth / 2u;
+    EXPECT_NEAR(expectedRange, viewDepth[mid], DEPTH_TOL);
+
+    // the packed data matches the view
+    float *scan = new float[imgHeight * imgWidth];
+    gz::common::ConnectionPtr connection =
+      depthCamera->ConnectNewDepthFrame(
+          [&](const float *_scan, unsigned int _width, unsigned int _height,
+              unsigned int _channels, const std::string &_format)
+          {
+            OnNewDepthFrame(scan, _scan, _width, _height, _channels,
+                _format);
+          });
+    g_depthCounter = 0u;
+    depthCamera->Update();
+    EXPECT_EQ(2u, viewCount);
+    EXPECT_EQ(1u, g_depthCounter);
+    EXPECT_EQ(0, memcmp(scan, viewDepth.data(),
+        imgWidth * imgHeight * sizeof(float)));
+
+    connection.reset();
+    viewConnection.reset();
+    delete [] scan;
+    scan = nullptr;
+  }
+
+  engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(DepthCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(DepthFormats))
+{
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  unsigned int imgWidth = 64u;
+  unsigned int imgHeight = 64u;
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  gz::rendering::VisualPtr root = scene->RootVisual();
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(1.8, 0.0, 0.0);
+  root->AddChild(box);
+  {
+    auto depthCamera = scene->CreateDepthCamera("DepthCamera");
+    ASSERT_NE(depthCamera, nullptr);
+    depthCamera->SetImageWidth(imgWidth);
+    depthCamera->SetImageHeight(imgHeight);
+    depthCamera->SetFarClipPlane(10.0);
+    depthCamera->SetNearClipPlane(0.1);
+    depthCamera->SetAspectRatio(1.0);
+    depthCamera->SetHFOV(1.05);
+    depthCamera->CreateDepthTexture();
+    root->AddChild(depthCamera);
+
+    EXPECT_EQ(gz::rendering::PF_FLOAT32_RGBA, depthCamera->DepthFormat());
+
+    // unsupported formats are ignored
+    depthCamera->SetDepthFormat(gz::rendering::PF_R8G8B8);
+    EXPECT_EQ(gz::rendering::PF_FLOAT32_RGBA, depthCamera->DepthFormat());
+
+    // view data converted to depth in meters
+    std::vector<float> viewDepth(imgWidth * imgHeight);
+    gz::rendering::PixelFormat viewFormat = gz::rendering::PF_UNKNOWN;
+    unsigned int viewCount = 0u;
+    gz::common::ConnectionPtr viewConnection =
+      depthCamera->ConnectNewDepthFrameView(
+          [&](const gz::rendering::SensorFrameView &_view)
+          {
+            EXPECT_EQ(imgWidth, _view.width);
+            EXPECT_EQ(imgHeight, _view.height);
+            EXPECT_EQ(gz::rendering::PixelUtil::ChannelCount(_view.format),
+                _view.channels);
+            EXPECT_GE(_view.pixelStride,
+                gz::rendering::PixelUtil::BytesPerPixel(_view.format));
+            viewFormat = _view.format;
+            for (unsigned int r = 0u; r < _view.height; ++r)
+            {
+              float *depthRow = &viewDepth[r * _view.width];
+              if (_view.format == gz::rendering::PF_L16)
+              {
+                const uint16_t *row = _view.Row<uint16_t>(r);
+                for (unsigned int c = 0u; c < _view.width; ++c)
+                  depthRow[c] = row[c] * 0.001f;
+              }
+              else if (_view.format == gz::rendering::PF_FLOAT32_RGBA)
+              {
+                for (unsigned int c = 0u; c < _view.width; ++c)
+                  depthRow[c] = _view.Pixel<float>(r, c)[0];
+              }
+              else
+              {
+                EXPECT_TRUE(gz::rendering::PixelUtil::Convert(
+                    _view.Row<uint8_t>(r), _view.format, 0u, depthRow,
+                    gz::rendering::PF_FLOAT32_R, 0u, _view.width, 1u));
+              }
+            }
+            ++viewCount;
+          });
+    ASSERT_NE(nullptr, viewConnection);
+
+    float *scan = new float[imgHeight * imgWidth];
+    gz::common::ConnectionPtr connection =
+      depthCamera->ConnectNewDepthFrame(
+          [&](const float *_scan, unsigned int _width, unsigned int _height,
+              unsigned int _channels, const std::string &_format)
+          {
+            OnNewDepthFrame(scan, _scan, _width, _height, _channels,
+                _format);
+          });
+
+    float expectedRange = 1.8f - 0.5f;
+    unsigned int mid = imgHeight / 2u * imgWidth + imgWidth / 2u;
+    for (auto format : {gz::rendering::PF_FLOAT32_R,
+        gz::rendering::PF_FLOAT16_R, gz::rendering::PF_L16})
+    {
+      depthCamera->SetDepthFormat(format);
+      EXPECT_EQ(format, depthCamera->DepthFormat());
+
+      // only the single channel depth is read back
+      g_depthCounter = 0u;
+      viewCount = 0u;
+      depthCamera->Update();
+      EXPECT_EQ(1u, viewCount);
+      EXPECT_EQ(1u, g_depthCounter);
+      EXPECT_EQ(format, viewFormat);
+
+      // half floats and millimeters lose some precision
+      double tol = format == gz::rendering::PF_FLOAT32_R ? DEPTH_TOL : 1e-3;
+      EXPECT_NEAR(expectedRange, viewDepth[mid], tol);
+      EXPECT_NEAR(expectedRange, scan[mid], tol);
+
+      // the corners do not see the box. Depth out of range is inf, or 0 in
+      // millimeters, which is NaN in meters
+      if (format == gz::rendering::PF_L16)
+      {
+        EXPECT_FLOAT_EQ(0.0f, viewDepth[0]);
+        EXPECT_TRUE(std::isnan(scan[0]));
+      }
+      else
+      {
+        EXPECT_TRUE(std::isinf(viewDepth[0]));
+        EXPECT_TRUE(std::isinf(scan[0]));
+      }
+    }
+
+    // point cloud subscribers need the full data
+    float *pointCloud = new float[imgHeight * imgWidth * 4u];
+    gz::common::ConnectionPtr pointCloudConnection =
+      depthCamera->ConnectNewRgbPointCloud(
+          [&](const float *_scan, unsigned int _width, unsigned int _height,
+              unsigned int _channels, const std::string &_format)
+          {
+            OnNewRgbPointCloud(pointCloud, _scan, _width, _height,
+                _channels, _format);
+          });
+    g_pointCloudCounter = 0u;
+    g_depthCounter = 0u;
+    depthCamera->Update();
+    EXPECT_EQ(1u, g_pointCloudCounter);
+    EXPECT_EQ(1u, g_depthCounter);
+    EXPECT_EQ(gz::rendering::PF_FLOAT32_RGBA, viewFormat);
+    EXPECT_NEAR(expectedRange, viewDepth[mid], DEPTH_TOL);
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+    EXPECT_NEAR(expectedRange, pointCloud[mid * 4u], DEPTH_TOL);
+
+    pointCloudConnection.reset();
+    connection.reset();
+    viewConnection.reset();
+    delete [] pointCloud;
+    delete [] scan;
+  }
+
+  engine->DestroyScene(scene);
+}
@@ -767,6 +767,35 @@ TEST_F(GpuRaysTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SingleRay))
       (std::abs(newBox01Pose.Pos().Z()) + unitBoxSize / 2);
   EXPECT_NEAR(scan[mid], expectedRangeAtMidPointBox, LASER_TOL);
 
+  // frame views hold each reading in an RGBA pixel with 3 channels of data
+  PixelFormat viewFormat = PF_UNKNOWN;
+  unsigned int viewChannels = 0u;
+  unsigned int viewPixelStride = 0u;
+  float viewRange = 0.0f;
+  float viewUnused = -1.0f;
+  common::ConnectionPtr viewConnection =
+    gpuRays->ConnectNewGpuRaysFrameView(
+        [&](const SensorFrameView &_view)
+        {
+          viewFormat = _view.format;
+          viewChannels = _view.channels;
+          viewPixelStride = _view.pixelStride;
+          viewRange = _view.Row<float>(0u)[0];
+          viewUnused = _view.Row<float>(0u)[2];
+        });
+  if (viewConnection)
+  {
+    gpuRays->Update();
+    EXPECT_EQ(PF_FLOAT32_RGBA, viewFormat);
+    EXPECT_EQ(3u, viewChannels);
+    EXPECT_EQ(4u * sizeof(float), viewPixelStride);
+    EXPECT_NEAR(viewRange, expectedRangeAtMidPointBox, LASER_TOL);
+    EXPECT_FLOAT_EQ(0.0f, viewUnused);
+    // packed subscribers are still served
+    EXPECT_NEAR(scan[mid], expectedRangeAtMidPointBox, LASER_TOL);
+    viewConnection.reset();
+  }
+
   c.reset();
 
   delete [] scan;
@@ -363,8 +363,6 @@ TEST_F(RenderPassTest, GZ_UTILS_TEST_DISABLED_ON_MAC(DepthGaussianNoise))
 TEST_F(RenderPassTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Distortion))
 {
   CHECK_RENDERPASS_SUPPORTED();
-  // Distortion isn't supported in ogre2
-  CHECK_UNSUPPORTED_ENGINE("ogre2");
 
   // add resources in build dir
   this->engine->AddResourcePath(
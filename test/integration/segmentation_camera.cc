@@ -212,6 +212,23 @@ TEST_F(SegmentationCameraTest, SegmentationCameraBoxes)
   EXPECT_EQ(1, rightCount);
   EXPECT_EQ(2, leftCount);
 
+  // Instances are kept between frames, changing the label of a visual only
+  // gives that visual a new instance
+  rendering::VisualPtr middleBox = scene->VisualByName("box_mid");
+  ASSERT_NE(nullptr, middleBox);
+  middleBox->SetUserData("label", 1);
+
+  g_counter = 0;
+  camera->Update();
+  EXPECT_EQ(1, g_counter);
+
+  EXPECT_EQ(1, g_buffer[leftIndex + 2]);
+  EXPECT_EQ(1, g_buffer[middleIndex + 2]);
+  EXPECT_EQ(1, g_buffer[rightIndex + 2]);
+  EXPECT_EQ(2, g_buffer[leftIndex]);
+  EXPECT_EQ(3, g_buffer[middleIndex]);
+  EXPECT_EQ(1, g_buffer[rightIndex]);
+
   // Clean up
   engine->DestroyScene(scene);
 }
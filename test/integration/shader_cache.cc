@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/RenderEngine.hh"
+#include "gz/rendering/RenderingIface.hh"
+#include "gz/rendering/Scene.hh"
+
+using namespace gz;
+using namespace rendering;
+
+class ShaderCacheTest : public testing::Test
+{
+  /// \brief Set up the test case
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(4);
+
+    auto [envEngine, envBackend, envHeadless] = GetTestParams();
+    if (envEngine.empty())
+      GTEST_SKIP() << kEngineToTestEnv << " environment not set";
+    if (envEngine != "ogre2")
+      GTEST_SKIP() << "Shader cache is only supported by ogre2";
+
+    this->engineName = envEngine;
+    this->engineParams =
+        GetEngineParams(envEngine, envBackend, envHeadless);
+
+    this->cachePath = common::createTempDirectory("shader_cache",
+        common::tempDirectoryPath());
+    ASSERT_FALSE(this->cachePath.empty());
+    this->engineParams["shaderCachePath"] = this->cachePath;
+  }
+
+  /// \brief Remove the cache directory
+  public: void TearDown() override
+  {
+    if (!this->cachePath.empty())
+      common::removeAll(this->cachePath);
+  }
+
+  /// \brief Load the engine, render one frame then unload the engine so
+  /// that the shader cache is saved
+  /// \return True if the engine was loaded
+  public: bool RenderOnce()
+  {
+    RenderEngine *engine =
+        rendering::engine(this->engineName, this->engineParams);
+    if (!engine)
+      return false;
+
+    ScenePtr scene = engine->CreateScene("scene");
+    EXPECT_NE(nullptr, scene);
+    scene->SetAmbientLight(0.3, 0.3, 0.3);
+
+    DirectionalLightPtr light = scene->CreateDirectionalLight();
+    light->SetDirection(0.5, 0.5, -1);
+    scene->RootVisual()->AddChild(light);
+
+    VisualPtr box = scene->CreateVisual();
+    box->AddGeometry(scene->CreateBox());
+    box->SetLocalPosition(3, 0, 0);
+    box->SetMaterial("Default/TransRed");
+    scene->RootVisual()->AddChild(box);
+
+    CameraPtr camera = scene->CreateCamera();
+    camera->SetImageWidth(32);
+    camera->SetImageHeight(32);
+    scene->RootVisual()->AddChild(camera);
+
+    Image image = camera->CreateImage();
+    camera->Capture(image);
+
+    engine->DestroyScene(scene);
+    EXPECT_TRUE(rendering::unloadEngine(this->engineName));
+    return true;
+  }
+
+  /// \brief Get the cache directories written by the engine
+  /// \return Paths of the directories
+  public: std::vector<std::string> CacheDirs() const
+  {
+    std::vector<std::string> dirs;
+    common::DirIter endIter;
+    for (common::DirIter it(this->cachePath); it != endIter; ++it)
+    {
+      if (common::isDirectory(*it))
+        dirs.push_back(*it);
+    }
+    return dirs;
+  }
+
+  /// \brief Name of the engine to test
+  public: std::string engineName;
+
+  /// \brief Parameters used to load the engine
+  public: std::map<std::string, std::string> engineParams;
+
+  /// \brief Temporary directory holding the shader cache
+  public: std::string cachePath;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ShaderCacheTest, GZ_UTILS_TEST_DISABLED_ON_MAC(SaveAndLoad))
+{
+  // first load compiles the shaders and writes them to the cache
+  if (!this->RenderOnce())
+    GTEST_SKIP() << "Engine '" << this->engineName << "' could not be loaded";
+
+  // the cache is written in a single directory keyed by the driver and
+  // the shader sources
+  std::vector<std::string> dirs = this->CacheDirs();
+  ASSERT_EQ(1u, dirs.size());
+  const std::string keyedPath = dirs[0];
+  EXPECT_EQ(16u, common::basename(keyedPath).size());
+
+  const std::string microcodeFile =
+      common::joinPaths(keyedPath, "microcodeCache.cache");
+  EXPECT_TRUE(common::isFile(microcodeFile));
+
+  unsigned int hlmsFileCount = 0u;
+  common::DirIter endIter;
+  for (common::DirIter it(keyedPath); it != endIter; ++it)
+  {
+    const std::string name = common::basename(*it);
+    if (name.find("hlmsDiskCache") == 0u &&
+        name.size() > 4u && name.substr(name.size() - 4u) == ".bin")
+    {
+      ++hlmsFileCount;
+    }
+    // temporary files are renamed once written
+    EXPECT_EQ(std::string::npos, name.find(".tmp")) << name;
+  }
+  // pbs and unlit at least
+  EXPECT_GE(hlmsFileCount, 2u);
+
+  // Set the microcode file in the past. The microcode cache is only saved
+  // again when a shader had to be compiled, so the file is left untouched
+  // if the second load read it back.
+  const auto past = std::filesystem::last_write_time(microcodeFile) -
+      std::chrono::hours(1);
+  std::filesystem::last_write_time(microcodeFile, past);
+
+  ASSERT_TRUE(this->RenderOnce());
+  dirs = this->CacheDirs();
+  ASSERT_EQ(1u, dirs.size());
+  EXPECT_EQ(keyedPath, dirs[0]);
+  EXPECT_EQ(past, std::filesystem::last_write_time(microcodeFile));
+
+  // A cache written for different drivers or shader sources is stored
+  // under a different hash and must not be read. Move the cache under a
+  // different hash: the engine has to compile the shaders again and write
+  // a new cache in its own directory.
+  const std::string stalePath =
+      common::joinPaths(this->cachePath, "0123456789abcdef");
+  ASSERT_NE(keyedPath, stalePath);
+  ASSERT_TRUE(common::moveFile(keyedPath, stalePath));
+
+  ASSERT_TRUE(this->RenderOnce());
+  EXPECT_TRUE(common::isFile(microcodeFile));
+  EXPECT_EQ(2u, this->CacheDirs().size());
+  EXPECT_EQ(past, std::filesystem::last_write_time(
+      common::joinPaths(stalePath, "microcodeCache.cache")));
+}
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "CommonRenderingTest.hh"
 
 #include <gz/common/Filesystem.hh>
@@ -26,6 +29,10 @@
 
 #include "gz/rendering/Scene.hh"
 #include "gz/rendering/WideAngleCamera.hh"
+#include "gz/rendering/config.hh"
+#if GZ_RENDERING_HAVE_OGRE2
+#include "gz/rendering/ogre2/Ogre2WideAngleCamera.hh"
+#endif
 
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -460,3 +467,135 @@ TEST_F(WideAngleCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Projection))
 
   ASSERT_EQ(1u, camera.use_count());
 }
+
+//////////////////////////////////////////////////
+TEST_F(WideAngleCameraTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SideFaces))
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  scene->SetAmbientLight(1.0, 1.0, 1.0);
+  scene->SetBackgroundColor(0.2, 0.2, 0.2);
+
+  rendering::VisualPtr root = scene->RootVisual();
+
+  unsigned int width = 320u;
+  unsigned int height = 240u;
+
+  // A fisheye that sees the sides but not the back of the camera. Only the
+  // cubemap faces the lens samples need to be rendered.
+  auto camera = scene->CreateWideAngleCamera("WideAngleCamera");
+  ASSERT_NE(camera, nullptr);
+
+  CameraLens lens;
+  lens.SetType(MFT_EQUIDISTANT);
+  lens.SetCutOffAngle(GZ_PI * 0.5);
+
+  camera->SetLens(lens);
+  camera->SetHFOV(2.6);
+  camera->SetImageWidth(width);
+  camera->SetImageHeight(height);
+  camera->SetAspectRatio(1.333);
+  root->AddChild(camera);
+
+  // red box on the left of the camera, only seen by the left cubemap face
+  MaterialPtr red = scene->CreateMaterial();
+  red->SetAmbient(0.3, 0.0, 0.0);
+  red->SetDiffuse(0.8, 0.0, 0.0);
+  VisualPtr leftBox = scene->CreateVisual();
+  leftBox->AddGeometry(scene->CreateBox());
+  leftBox->SetLocalPosition(1.27, 2.72, 0);
+  leftBox->SetMaterial(red);
+  root->AddChild(leftBox);
+
+  // green box behind the camera, outside of the lens cut off angle
+  MaterialPtr green = scene->CreateMaterial();
+  green->SetAmbient(0.0, 0.3, 0.0);
+  green->SetDiffuse(0.0, 0.8, 0.0);
+  VisualPtr backBox = scene->CreateVisual();
+  backBox->AddGeometry(scene->CreateBox());
+  backBox->SetLocalPosition(-3.0, 0, 0);
+  backBox->SetMaterial(green);
+  root->AddChild(backBox);
+
+  Image image = camera->CreateImage();
+  camera->Capture(image);
+  unsigned char *data = image.Data<unsigned char>();
+
+  unsigned int redLeft = 0u;
+  unsigned int redRight = 0u;
+  unsigned int greenCount = 0u;
+  for (unsigned int i = 0; i < height; ++i)
+  {
+    for (unsigned int j = 0; j < width; ++j)
+    {
+      unsigned int idx = (i * width + j) * 3u;
+      unsigned int r = data[idx];
+      unsigned int g = data[idx + 1];
+      unsigned int b = data[idx + 2];
+      if (r > g + 50u && r > b + 50u)
+      {
+        if (j < width / 2u)
+          ++redLeft;
+        else
+          ++redRight;
+      }
+      if (g > r + 50u && g > b + 50u)
+        ++greenCount;
+    }
+  }
+
+  EXPECT_GT(redLeft, 0u);
+  EXPECT_EQ(0u, redRight);
+  EXPECT_EQ(0u, greenCount);
+
+#if GZ_RENDERING_HAVE_OGRE2
+  auto ogreCamera =
+      std::dynamic_pointer_cast<Ogre2WideAngleCamera>(camera);
+  if (ogreCamera)
+  {
+    // faces are ordered +X, -X, +Y, -Y, +Z, -Z in cubemap space where the
+    // camera looks towards +Z. The lens sees the sides but not the back.
+    for (uint32_t i = 0u; i < 4u; ++i)
+      EXPECT_TRUE(ogreCamera->IsFaceRendered(i)) << i;
+    EXPECT_TRUE(ogreCamera->IsFaceRendered(4u));
+    EXPECT_FALSE(ogreCamera->IsFaceRendered(5u));
+    EXPECT_FALSE(ogreCamera->IsFaceRendered(6u));
+
+    // Rendering all the faces must give the same image, otherwise the lens
+    // samples a face that was skipped
+    ogreCamera->SetSkipUnsampledFaces(false);
+    Image fullImage = camera->CreateImage();
+    camera->Capture(fullImage);
+    for (uint32_t i = 0u; i < 6u; ++i)
+      EXPECT_TRUE(ogreCamera->IsFaceRendered(i)) << i;
+
+    unsigned char *fullData = fullImage.Data<unsigned char>();
+    unsigned int maxDiff = 0u;
+    unsigned int diffCount = 0u;
+    for (unsigned int i = 0; i < width * height * 3u; ++i)
+    {
+      unsigned int diff = static_cast<unsigned int>(
+          std::abs(static_cast<int>(data[i]) - fullData[i]));
+      maxDiff = std::max(maxDiff, diff);
+      if (diff > 2u)
+        ++diffCount;
+    }
+    EXPECT_LE(maxDiff, 10u);
+    EXPECT_LE(diffCount, width * height * 3u / 1000u);
+
+    // a narrow field of view only samples the front face
+    ogreCamera->SetSkipUnsampledFaces(true);
+    camera->SetHFOV(1.0);
+    camera->Capture(image);
+    for (uint32_t i = 0u; i < 4u; ++i)
+      EXPECT_FALSE(ogreCamera->IsFaceRendered(i)) << i;
+    EXPECT_TRUE(ogreCamera->IsFaceRendered(4u));
+    EXPECT_FALSE(ogreCamera->IsFaceRendered(5u));
+  }
+#endif
+
+  // Clean up
+  engine->DestroyScene(scene);
+}
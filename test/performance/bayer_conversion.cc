@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/Image.hh"
+#include "gz/rendering/PixelFormat.hh"
+#include "gz/rendering/Utils.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Frame sizes to benchmark
+struct FrameSize
+{
+  /// \brief Width in pixels
+  unsigned int width;
+
+  /// \brief Height in pixels
+  unsigned int height;
+};
+
+/// \brief 1080p and a 5MP machine vision sensor
+static const FrameSize kFrameSizes[] = {{1920u, 1080u}, {2448u, 2048u}};
+
+/// \brief Number of conversions timed per frame size
+static const unsigned int kIterations = 10u;
+
+/// \brief Column major RGGB mosaicing, like convertRGBToBayer used to do
+/// \param[in] _src RGB image data
+/// \param[out] _dst Bayer image data
+/// \param[in] _width Image width
+/// \param[in] _height Image height
+static void ColumnMajorRGGB(const uint8_t *_src, uint8_t *_dst,
+    unsigned int _width, unsigned int _height)
+{
+  for (unsigned int i = 0; i < _width; ++i)
+  {
+    for (unsigned int j = 0; j < _height; ++j)
+    {
+      unsigned int c = (j % 2) ? ((i % 2) ? 2 : 1) : ((i % 2) ? 1 : 0);
+      _dst[i + j * _width] = _src[i * 3 + j * _width * 3 + c];
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BayerConversionTest, RGBToBayer)
+{
+  common::Console::SetVerbosity(4);
+
+  for (const auto &size : kFrameSizes)
+  {
+    Image rgb(size.width, size.height, PF_R8G8B8);
+    uint8_t *rgbData = rgb.Data<uint8_t>();
+    for (unsigned int i = 0; i < rgb.MemorySize(); ++i)
+      rgbData[i] = static_cast<uint8_t>(i);
+    Image ref(size.width, size.height, PF_BAYER_RGGB8);
+    Image bayer(size.width, size.height, PF_BAYER_RGGB8);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0; n < kIterations; ++n)
+    {
+      ColumnMajorRGGB(rgbData, ref.Data<uint8_t>(), size.width,
+          size.height);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double columnMajor =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0; n < kIterations; ++n)
+      EXPECT_TRUE(convertRGBToBayer(rgb, bayer));
+    end = std::chrono::steady_clock::now();
+    double singleThread =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+    EXPECT_EQ(0, memcmp(ref.Data(), bayer.Data(), bayer.MemorySize()));
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0; n < kIterations; ++n)
+      EXPECT_TRUE(convertRGBToBayer(rgb, bayer, 0u));
+    end = std::chrono::steady_clock::now();
+    double allCores =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+    EXPECT_EQ(0, memcmp(ref.Data(), bayer.Data(), bayer.MemorySize()));
+
+    gzdbg << "RGB -> BAYER_RGGB8 " << size.width << "x" << size.height
+          << " [ms]: column major[" << columnMajor << "] "
+          << "single thread[" << singleThread << "] "
+          << "all cores[" << allCores << "]" << std::endl;
+
+    // generous bound to only catch gross regressions on noisy machines
+    EXPECT_LT(singleThread, columnMajor * 2.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BayerConversionTest, BayerToRGB)
+{
+  common::Console::SetVerbosity(4);
+
+  for (const auto &size : kFrameSizes)
+  {
+    Image bayer(size.width, size.height, PF_BAYER_RGGB8);
+    uint8_t *bayerData = bayer.Data<uint8_t>();
+    for (unsigned int i = 0; i < bayer.MemorySize(); ++i)
+      bayerData[i] = static_cast<uint8_t>(i);
+    Image rgb(size.width, size.height, PF_R8G8B8);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0; n < kIterations; ++n)
+      EXPECT_TRUE(convertBayerToRGB(bayer, rgb));
+    auto end = std::chrono::steady_clock::now();
+    double singleThread =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0; n < kIterations; ++n)
+      EXPECT_TRUE(convertBayerToRGB(bayer, rgb, 0u));
+    end = std::chrono::steady_clock::now();
+    double allCores =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+
+    gzdbg << "BAYER_RGGB8 -> RGB " << size.width << "x" << size.height
+          << " [ms]: single thread[" << singleThread << "] "
+          << "all cores[" << allCores << "]" << std::endl;
+  }
+}
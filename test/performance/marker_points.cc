@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Marker.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Measure the cost of updating the points of a marker as the
+/// number of points grows
+class MarkerPointsTest: public CommonRenderingTest
+{
+  /// \brief Time a function followed by a Scene::PreRender, which is when
+  /// the points are uploaded
+  /// \param[in] _scene Scene to update
+  /// \param[in] _fn Function modifying the points
+  /// \return Time in microseconds
+  public: template <typename Fn>
+          double Time(ScenePtr _scene, Fn _fn);
+};
+
+/////////////////////////////////////////////////
+template <typename Fn>
+double MarkerPointsTest::Time(ScenePtr _scene, Fn _fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  _fn();
+  _scene->PreRender();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerPointsTest, UpdateCost)
+{
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  const std::size_t pointCounts[] = {1000u, 10000u, 100000u, 500000u};
+
+  for (auto count : pointCounts)
+  {
+    std::vector<float> xyz(count * 3u);
+    std::vector<uint32_t> rgba(count);
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+      xyz[i*3] = static_cast<float>(i % 100u);
+      xyz[i*3+1] = static_cast<float>((i / 100u) % 100u);
+      xyz[i*3+2] = static_cast<float>(i / 10000u);
+      rgba[i] = 0xFF0000FFu;
+    }
+
+    MarkerPtr marker = scene->CreateMarker();
+    marker->SetType(MT_POINTS);
+    VisualPtr visual = scene->CreateVisual();
+    visual->AddGeometry(marker);
+    scene->RootVisual()->AddChild(visual);
+
+    // one call and one color conversion per point
+    double perPoint = this->Time(scene, [&]()
+    {
+      marker->ClearPoints();
+      for (std::size_t i = 0u; i < count; ++i)
+      {
+        marker->AddPoint(xyz[i*3], xyz[i*3+1], xyz[i*3+2],
+            math::Color(1, 0, 0, 1));
+      }
+    });
+
+    // all points in a single call
+    double bulk = this->Time(scene, [&]()
+    {
+      marker->ClearPoints();
+      marker->SetPoints(0u, count, xyz.data(), rgba.data());
+    });
+
+    // rewrite all points without changing their number
+    double full = this->Time(scene, [&]()
+    {
+      marker->SetPoints(0u, count, xyz.data(), rgba.data());
+    });
+
+    // move 1% of the points, only that range is uploaded
+    const std::size_t partialCount = count / 100u;
+    double partial = this->Time(scene, [&]()
+    {
+      marker->SetPoints(count / 2u, partialCount, xyz.data(), rgba.data());
+    });
+
+    gzdbg << "Marker update [us]: " << count << " points: "
+          << "per point[" << perPoint << "] bulk[" << bulk << "] "
+          << "full[" << full << "] partial[" << partial << "]" << std::endl;
+
+    if (count >= 100000u)
+    {
+      EXPECT_LT(bulk, perPoint);
+      EXPECT_LT(partial, full);
+    }
+
+    scene->DestroyVisual(visual, true);
+  }
+
+  this->engine->DestroyScene(scene);
+}
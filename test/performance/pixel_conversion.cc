@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/rendering/PixelFormat.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Frame sizes to benchmark
+struct FrameSize
+{
+  /// \brief Width in pixels
+  unsigned int width;
+
+  /// \brief Height in pixels
+  unsigned int height;
+};
+
+static const FrameSize kFrameSizes[] =
+    {{640u, 480u}, {1280u, 720u}, {1920u, 1080u}, {3840u, 2160u}};
+
+/// \brief Number of conversions timed per frame size
+static const unsigned int kIterations = 20u;
+
+/// \brief Row pitch of the source data, padded to 256 bytes like GPU
+/// readbacks usually are
+/// \param[in] _format Source format
+/// \param[in] _width Image width
+/// \return Row pitch in bytes
+static unsigned int PaddedPitch(PixelFormat _format, unsigned int _width)
+{
+  unsigned int pitch = _width * PixelUtil::BytesPerPixel(_format);
+  return (pitch + 255u) & ~255u;
+}
+
+/// \brief Time PixelUtil::Convert against a per-channel scalar loop like the
+/// one the sensors used to have
+/// \param[in] _srcFormat Source format
+/// \param[in] _dstFormat Destination format
+template <typename T>
+void Benchmark(PixelFormat _srcFormat, PixelFormat _dstFormat)
+{
+  const unsigned int srcChannels = PixelUtil::ChannelCount(_srcFormat);
+  const unsigned int dstChannels = PixelUtil::ChannelCount(_dstFormat);
+
+  for (const auto &size : kFrameSizes)
+  {
+    const unsigned int pitch = PaddedPitch(_srcFormat, size.width);
+    std::vector<uint8_t> src(static_cast<std::size_t>(pitch) * size.height);
+    for (std::size_t i = 0u; i < src.size(); ++i)
+      src[i] = static_cast<uint8_t>(i);
+    std::vector<T> dst(
+        static_cast<std::size_t>(size.width) * size.height * dstChannels);
+    std::vector<T> ref(dst.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0u; n < kIterations; ++n)
+    {
+      for (unsigned int row = 0u; row < size.height; ++row)
+      {
+        const T *srcRow = reinterpret_cast<const T *>(&src[row * pitch]);
+        for (unsigned int column = 0u; column < size.width; ++column)
+        {
+          for (unsigned int c = 0u; c < dstChannels; ++c)
+          {
+            ref[(row * size.width + column) * dstChannels + c] =
+                srcRow[column * srcChannels + c];
+          }
+        }
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double scalar =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0u; n < kIterations; ++n)
+    {
+      EXPECT_TRUE(PixelUtil::Convert(src.data(), _srcFormat, pitch,
+          dst.data(), _dstFormat, 0u, size.width, size.height));
+    }
+    end = std::chrono::steady_clock::now();
+    double convert =
+        std::chrono::duration<double, std::milli>(end - start).count() /
+        kIterations;
+
+    EXPECT_EQ(0, memcmp(ref.data(), dst.data(), dst.size() * sizeof(T)));
+
+    gzdbg << PixelUtil::Name(_srcFormat) << " -> "
+          << PixelUtil::Name(_dstFormat) << " " << size.width << "x"
+          << size.height << " [ms]: scalar[" << scalar << "] "
+          << "convert[" << convert << "]" << std::endl;
+
+    // generous bound to only catch gross regressions on noisy machines
+    EXPECT_LT(convert, scalar * 2.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConversionTest, RGBA8ToRGB8)
+{
+  common::Console::SetVerbosity(4);
+  Benchmark<uint8_t>(PF_R8G8B8A8, PF_R8G8B8);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConversionTest, RGBA32FToRGB32F)
+{
+  common::Console::SetVerbosity(4);
+  Benchmark<float>(PF_FLOAT32_RGBA, PF_FLOAT32_RGB);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConversionTest, RGBA32FToR32F)
+{
+  common::Console::SetVerbosity(4);
+  Benchmark<float>(PF_FLOAT32_RGBA, PF_FLOAT32_R);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConversionTest, L16Copy)
+{
+  common::Console::SetVerbosity(4);
+  Benchmark<uint16_t>(PF_L16, PF_L16);
+}
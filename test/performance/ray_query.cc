@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/math/Helpers.hh>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/MeshDescriptor.hh"
+#include "gz/rendering/RayQuery.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Measure the cost of CPU ray queries against a dense mesh
+class RayQueryPerformanceTest: public CommonRenderingTest
+{
+  /// \brief Intersect a ray with every triangle of a mesh, which is what
+  /// the CPU ray query used to do for each mesh hit by the broadphase
+  /// \param[in] _mesh Mesh to test
+  /// \param[in] _origin Ray origin in mesh space
+  /// \param[in] _dir Normalized ray direction in mesh space
+  /// \return Distance to the closest front facing triangle, or -1
+  public: static double BruteForce(const common::Mesh &_mesh,
+      const math::Vector3d &_origin, const math::Vector3d &_dir);
+};
+
+/////////////////////////////////////////////////
+double RayQueryPerformanceTest::BruteForce(const common::Mesh &_mesh,
+    const math::Vector3d &_origin, const math::Vector3d &_dir)
+{
+  double best = std::numeric_limits<double>::max();
+  for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto submesh = _mesh.SubMeshByIndex(i).lock();
+    const math::Vector3d *vertices = submesh->VertexPtr();
+    const unsigned int *indices = submesh->IndexPtr();
+    for (unsigned int k = 0; k + 2 < submesh->IndexCount(); k += 3)
+    {
+      math::Vector3d v0 = vertices[indices[k]];
+      math::Vector3d e1 = vertices[indices[k + 1]] - v0;
+      math::Vector3d e2 = vertices[indices[k + 2]] - v0;
+      math::Vector3d p = _dir.Cross(e2);
+      double det = e1.Dot(p);
+      if (det <= 1e-12)
+        continue;
+      math::Vector3d s = _origin - v0;
+      double u = s.Dot(p) / det;
+      if (u < 0.0 || u > 1.0)
+        continue;
+      math::Vector3d q = s.Cross(e1);
+      double v = _dir.Dot(q) / det;
+      if (v < 0.0 || u + v > 1.0)
+        continue;
+      double t = e2.Dot(q) / det;
+      if (t >= 0.0 && t < best)
+        best = t;
+    }
+  }
+  return best < std::numeric_limits<double>::max() ? best : -1.0;
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryPerformanceTest, DenseMesh)
+{
+  // the bounding volume hierarchy is only used by ogre2
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // 2M triangles, the size of a detailed CAD model
+  const std::string meshName = "ray_query_performance_sphere";
+  common::MeshManager::Instance()->CreateSphere(meshName, 1.0f, 1000, 1000);
+  const common::Mesh *commonMesh =
+      common::MeshManager::Instance()->MeshByName(meshName);
+  ASSERT_NE(nullptr, commonMesh);
+
+  VisualPtr visual = scene->CreateVisual();
+  visual->AddGeometry(scene->CreateMesh(MeshDescriptor(meshName)));
+  scene->RootVisual()->AddChild(visual);
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+  rayQuery->SetPreferGpu(false);
+
+  // rays from all around the sphere towards points near its center
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> directions;
+  const unsigned int rayCount = 100u;
+  for (unsigned int i = 0; i < rayCount; ++i)
+  {
+    double angle = 2.0 * GZ_PI * i / rayCount;
+    math::Vector3d origin(3.0 * cos(angle), 3.0 * sin(angle),
+        -1.5 + 3.0 * i / rayCount);
+    math::Vector3d target(0.1 * sin(3.0 * angle), 0.1 * cos(5.0 * angle),
+        0.0);
+    origins.push_back(origin);
+    directions.push_back((target - origin).Normalized());
+  }
+
+  // the first query builds the hierarchy
+  rayQuery->SetOrigin(origins[0]);
+  rayQuery->SetDirection(directions[0]);
+  auto start = std::chrono::steady_clock::now();
+  RayQueryResult result = rayQuery->ClosestPoint();
+  auto end = std::chrono::steady_clock::now();
+  double firstQuery =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  EXPECT_TRUE(result);
+
+  start = std::chrono::steady_clock::now();
+  std::vector<double> distances;
+  for (unsigned int i = 0; i < rayCount; ++i)
+  {
+    rayQuery->SetOrigin(origins[i]);
+    rayQuery->SetDirection(directions[i]);
+    distances.push_back(rayQuery->ClosestPoint(false).distance);
+  }
+  end = std::chrono::steady_clock::now();
+  double query =
+      std::chrono::duration<double, std::milli>(end - start).count() /
+      rayCount;
+
+  // the brute force loop is slow, only run it on a few rays
+  const unsigned int bruteForceCount = 5u;
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < bruteForceCount; ++i)
+  {
+    double distance = BruteForce(*commonMesh, origins[i], directions[i]);
+    EXPECT_NEAR(distance, distances[i], 1e-3);
+  }
+  end = std::chrono::steady_clock::now();
+  double bruteForce =
+      std::chrono::duration<double, std::milli>(end - start).count() /
+      bruteForceCount;
+
+  gzdbg << "ClosestPoint [ms]: 2M triangles, first query[" << firstQuery
+        << "] query[" << query << "] brute force[" << bruteForce << "]"
+        << std::endl;
+
+  EXPECT_LT(query, bruteForce);
+
+  this->engine->DestroyScene(scene);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayQueryPerformanceTest, Batch)
+{
+  // the batch API has a dedicated implementation in ogre2 only
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // a mid-size scene: a ground plane and a grid of spheres and boxes
+  VisualPtr root = scene->RootVisual();
+  VisualPtr ground = scene->CreateVisual();
+  ground->AddGeometry(scene->CreateBox());
+  ground->SetLocalScale(100.0, 100.0, 1.0);
+  ground->SetLocalPosition(0.0, 0.0, -0.5);
+  root->AddChild(ground);
+  const int gridSize = 20;
+  for (int x = 0; x < gridSize; ++x)
+  {
+    for (int y = 0; y < gridSize; ++y)
+    {
+      VisualPtr visual = scene->CreateVisual();
+      if ((x + y) % 2)
+        visual->AddGeometry(scene->CreateSphere());
+      else
+        visual->AddGeometry(scene->CreateBox());
+      visual->SetLocalPosition(4.0 * (x - gridSize / 2),
+          4.0 * (y - gridSize / 2), 1.0);
+      root->AddChild(visual);
+    }
+  }
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+  rayQuery->SetPreferGpu(false);
+
+  // terrain following style rays, straight down from a regular grid
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> directions;
+  const int raysPerSide = 400;
+  for (int x = 0; x < raysPerSide; ++x)
+  {
+    for (int y = 0; y < raysPerSide; ++y)
+    {
+      origins.push_back(math::Vector3d(
+          80.0 * x / raysPerSide - 40.0, 80.0 * y / raysPerSide - 40.0, 10.0));
+      directions.push_back(-math::Vector3d::UnitZ);
+    }
+  }
+
+  // warm up, builds the mesh hierarchies
+  std::vector<RayQueryResult> results;
+  rayQuery->ClosestPoints(origins, directions, results);
+  ASSERT_EQ(origins.size(), results.size());
+
+  auto start = std::chrono::steady_clock::now();
+  rayQuery->ClosestPoints(origins, directions, results, false);
+  auto end = std::chrono::steady_clock::now();
+  double batch = std::chrono::duration<double>(end - start).count() /
+      origins.size();
+
+  // only a subset of the rays one by one, it is much slower
+  const unsigned int singleCount = 2000u;
+  unsigned int mismatches = 0u;
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < singleCount; ++i)
+  {
+    rayQuery->SetOrigin(origins[i * 37u]);
+    rayQuery->SetDirection(directions[i * 37u]);
+    RayQueryResult result = rayQuery->ClosestPoint(false);
+    if (result.objectId != results[i * 37u].objectId)
+      ++mismatches;
+  }
+  end = std::chrono::steady_clock::now();
+  double single = std::chrono::duration<double>(end - start).count() /
+      singleCount;
+  EXPECT_EQ(0u, mismatches);
+
+  gzdbg << "Rays per second: " << origins.size() << " rays, "
+        << gridSize * gridSize + 1 << " objects, batch[" << 1.0 / batch
+        << "] one by one[" << 1.0 / single << "]" << std::endl;
+
+  EXPECT_LT(batch, single);
+
+  this->engine->DestroyScene(scene);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Camera.hh"
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Measure the cost of Scene::PreRender as the number of nodes and
+/// cameras in the scene grows
+class ScenePrerenderTest: public CommonRenderingTest
+{
+  /// \brief Populate a scene with model, link and visual nodes, similar to
+  /// what simulators create, plus a number of cameras
+  /// \param[in] _scene Scene to populate
+  /// \param[in] _models Number of models to create
+  /// \param[in] _cameras Number of cameras to create
+  /// \return Parent visual of all created nodes
+  public: VisualPtr Populate(ScenePtr _scene, unsigned int _models,
+      unsigned int _cameras);
+
+  /// \brief Time a number of frames in which Scene::PreRender is called
+  /// once per camera, as done by Camera::Update.
+  /// \param[in] _scene Scene to update
+  /// \param[in] _cameras Number of PreRender calls per frame
+  /// \return Average time per frame in microseconds
+  public: double FrameTime(ScenePtr _scene, unsigned int _cameras);
+};
+
+/////////////////////////////////////////////////
+VisualPtr ScenePrerenderTest::Populate(ScenePtr _scene, unsigned int _models,
+    unsigned int _cameras)
+{
+  VisualPtr world = _scene->CreateVisual();
+  _scene->RootVisual()->AddChild(world);
+  for (unsigned int i = 0; i < _models; ++i)
+  {
+    VisualPtr model = _scene->CreateVisual();
+    world->AddChild(model);
+    VisualPtr link = _scene->CreateVisual();
+    model->AddChild(link);
+    VisualPtr visual = _scene->CreateVisual();
+    visual->AddGeometry(_scene->CreateBox());
+    link->AddChild(visual);
+  }
+
+  for (unsigned int i = 0; i < _cameras; ++i)
+  {
+    CameraPtr camera = _scene->CreateCamera();
+    camera->SetImageWidth(32u);
+    camera->SetImageHeight(32u);
+    world->AddChild(camera);
+  }
+  return world;
+}
+
+/////////////////////////////////////////////////
+double ScenePrerenderTest::FrameTime(ScenePtr _scene, unsigned int _cameras)
+{
+  const unsigned int numFrames = 50u;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < numFrames; ++i)
+  {
+    for (unsigned int j = 0; j < _cameras; ++j)
+      _scene->PreRender();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      numFrames;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ScenePrerenderTest, SceneSizeAndCameraCount)
+{
+  // optix writes all poses to the device every frame
+  CHECK_UNSUPPORTED_ENGINE("optix");
+
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  const unsigned int modelCounts[] = {1000u, 10000u};
+  const unsigned int cameraCounts[] = {1u, 12u};
+
+  for (auto models : modelCounts)
+  {
+    for (auto cameras : cameraCounts)
+    {
+      VisualPtr world = this->Populate(scene, models, cameras);
+
+      // first walk visits every new node
+      auto start = std::chrono::steady_clock::now();
+      scene->PreRender();
+      auto end = std::chrono::steady_clock::now();
+      double fullWalk =
+          std::chrono::duration<double, std::micro>(end - start).count();
+
+      // subsequent frames only visit cameras and their ancestors, plus the
+      // direct children of nodes on that path
+      double frame = this->FrameTime(scene, cameras);
+
+      gzdbg << "PreRender [us]: " << models * 3u << " nodes, "
+            << cameras << " cameras: full walk[" << fullWalk << "] "
+            << "frame[" << frame << "]" << std::endl;
+
+      EXPECT_LT(frame, fullWalk * cameras);
+
+      scene->DestroyVisual(world, true);
+    }
+  }
+
+  this->engine->DestroyScene(scene);
+}
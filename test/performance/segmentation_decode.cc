@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/SegmentationCamera.hh"
+#include "gz/rendering/Visual.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Measure the cost of decoding colored segmentation maps into
+/// label maps
+class SegmentationDecodeTest: public CommonRenderingTest
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(SegmentationDecodeTest, Panoptic1080p)
+{
+  // Currently, only ogre2 supports segmentation cameras
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // a wall of 5000 boxes in front of the camera, 200 labels with 25
+  // instances each
+  const int columns = 100;
+  const int rows = 50;
+  VisualPtr root = scene->RootVisual();
+  for (int i = 0; i < columns; ++i)
+  {
+    for (int j = 0; j < rows; ++j)
+    {
+      VisualPtr box = scene->CreateVisual();
+      box->AddGeometry(scene->CreateBox());
+      box->SetLocalScale(0.15, 0.15, 0.15);
+      box->SetLocalPosition(10.0, 0.19 * (i - columns / 2),
+          0.2 * (j - rows / 2));
+      box->SetUserData("label", 1 + (i * rows + j) % 200);
+      root->AddChild(box);
+    }
+  }
+
+  const unsigned int width = 1920u;
+  const unsigned int height = 1080u;
+  auto camera = scene->CreateSegmentationCamera("SegmentationCamera");
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(width);
+  camera->SetImageHeight(height);
+  camera->SetAspectRatio(static_cast<double>(width) / height);
+  camera->SetHFOV(GZ_PI / 2);
+  camera->SetBackgroundLabel(0);
+  camera->SetSegmentationType(SegmentationType::ST_PANOPTIC);
+  camera->EnableColoredMap(true);
+  root->AddChild(camera);
+
+  std::vector<uint8_t> colored(width * height * 3);
+  common::ConnectionPtr connection = camera->ConnectNewSegmentationFrame(
+      [&](const uint8_t *_data, unsigned int, unsigned int, unsigned int,
+          const std::string &)
+      {
+        memcpy(colored.data(), _data, colored.size());
+      });
+  ASSERT_NE(nullptr, connection);
+  camera->Update();
+
+  // the first decode builds the lookup table
+  std::vector<uint8_t> labels(width * height * 3);
+  camera->LabelMapFromColoredBuffer(labels.data());
+
+  const unsigned int iterations = 20u;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int n = 0; n < iterations; ++n)
+    camera->LabelMapFromColoredBuffer(labels.data());
+  auto end = std::chrono::steady_clock::now();
+  double decode =
+      std::chrono::duration<double, std::milli>(end - start).count() /
+      iterations;
+
+  // Every color must decode to a single label and instance, different
+  // colors to different ones, and the background to the background label
+  std::map<uint32_t, uint32_t> colorToPixel;
+  std::set<uint32_t> decodedPixels;
+  unsigned int mismatches = 0u;
+  for (size_t i = 0; i < labels.size(); i += 3)
+  {
+    uint32_t color = (colored[i] << 16) | (colored[i + 1] << 8) |
+        colored[i + 2];
+    uint32_t pixel = labels[i] | (labels[i + 1] << 8) | (labels[i + 2] << 16);
+    auto it = colorToPixel.find(color);
+    if (it == colorToPixel.end())
+    {
+      if (pixel != 0u && !decodedPixels.insert(pixel).second)
+        ++mismatches;
+      colorToPixel[color] = pixel;
+    }
+    else if (it->second != pixel)
+    {
+      ++mismatches;
+    }
+  }
+  EXPECT_EQ(0u, mismatches);
+  EXPECT_EQ(0u, colorToPixel[0u]);
+
+  // most of the wall is in view
+  EXPECT_GT(decodedPixels.size(), 4000u);
+
+  gzdbg << "LabelMapFromColoredBuffer [ms]: " << width << "x" << height
+        << ", " << decodedPixels.size() << " instances in view, decode["
+        << decode << "]" << std::endl;
+
+  this->engine->DestroyScene(scene);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Measure the cost of updating the scene graph, done by
+/// Scene::PreRender, when most of the scene is made of static visuals
+class StaticVisualsTest: public CommonRenderingTest
+{
+  /// \brief Time a number of frames
+  /// \param[in] _scene Scene to update
+  /// \return Average time per frame in microseconds
+  public: double FrameTime(ScenePtr _scene);
+};
+
+/////////////////////////////////////////////////
+double StaticVisualsTest::FrameTime(ScenePtr _scene)
+{
+  const unsigned int numFrames = 20u;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < numFrames; ++i)
+  {
+    _scene->PreRender();
+    _scene->PostRender();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      numFrames;
+}
+
+/////////////////////////////////////////////////
+TEST_F(StaticVisualsTest, UpdateSceneGraph)
+{
+  // other engines ignore Visual::SetStatic
+  CHECK_SUPPORTED_ENGINE("ogre2");
+
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  const unsigned int count = 100000u;
+  VisualPtr world = scene->CreateVisual();
+  scene->RootVisual()->AddChild(world);
+  std::vector<VisualPtr> visuals;
+  visuals.reserve(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    VisualPtr visual = scene->CreateVisual();
+    visual->AddGeometry(scene->CreateBox());
+    visual->SetLocalPosition((i % 316u) * 2.0, (i / 316u) * 2.0, 0.0);
+    world->AddChild(visual);
+    visuals.push_back(visual);
+  }
+
+  // every frame derives the transforms and bounds of all dynamic items
+  scene->PreRender();
+  scene->PostRender();
+  double dynamicFrame = this->FrameTime(scene);
+
+  for (auto &visual : visuals)
+  {
+    visual->SetStatic(true);
+    EXPECT_TRUE(visual->Static());
+  }
+
+  // the first frame updates the static items once, then they are skipped
+  auto start = std::chrono::steady_clock::now();
+  scene->PreRender();
+  scene->PostRender();
+  auto end = std::chrono::steady_clock::now();
+  double staticUpdate =
+      std::chrono::duration<double, std::micro>(end - start).count();
+  double staticFrame = this->FrameTime(scene);
+
+  // setting the same pose again is not a change
+  visuals[0]->SetLocalPosition(visuals[0]->LocalPosition());
+  double samePoseFrame = this->FrameTime(scene);
+
+  // moving a static visual updates the static items again for a frame
+  visuals[0]->SetLocalPosition(-2.0, 0.0, 0.0);
+  start = std::chrono::steady_clock::now();
+  scene->PreRender();
+  scene->PostRender();
+  end = std::chrono::steady_clock::now();
+  double movedFrame =
+      std::chrono::duration<double, std::micro>(end - start).count();
+
+  gzdbg << "PreRender [us]: " << count << " items: dynamic[" << dynamicFrame
+        << "] static: first[" << staticUpdate << "] frame[" << staticFrame
+        << "] same pose[" << samePoseFrame << "] moved[" << movedFrame << "]"
+        << std::endl;
+
+  EXPECT_LT(staticFrame, dynamicFrame);
+  EXPECT_LT(samePoseFrame, dynamicFrame);
+
+  // items are dynamic again when their visual is
+  for (auto &visual : visuals)
+  {
+    visual->SetStatic(false);
+    EXPECT_FALSE(visual->Static());
+  }
+  scene->PreRender();
+  scene->PostRender();
+
+  scene->DestroyVisual(world, true);
+  this->engine->DestroyScene(scene);
+}
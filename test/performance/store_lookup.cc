@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "CommonRenderingTest.hh"
+
+#include "gz/rendering/Scene.hh"
+#include "gz/rendering/Visual.hh"
+
+using namespace gz;
+using namespace rendering;
+
+/// \brief Measure the cost of looking up and removing objects in a store
+/// as the number of objects in the store grows
+class StoreLookupTest: public CommonRenderingTest
+{
+  /// \brief Populate a scene with visuals parented to a single visual
+  /// \param[in] _scene Scene to populate
+  /// \param[in] _count Number of visuals to create
+  /// \param[out] _ids Ids of the created visuals
+  /// \return Parent visual of all created visuals
+  public: VisualPtr Populate(ScenePtr _scene, unsigned int _count,
+      std::vector<unsigned int> &_ids);
+
+  /// \brief Time random id lookups against the scene's visual store
+  /// \param[in] _scene Scene to query
+  /// \param[in] _ids Ids to pick from
+  /// \return Average time per lookup in nanoseconds
+  public: double LookupTime(ScenePtr _scene,
+      const std::vector<unsigned int> &_ids);
+
+  /// \brief Time removing children of a visual from the front, from
+  /// random positions and from the back of its child store
+  /// \param[in] _parent Parent visual
+  /// \param[in] _ids Ids of the children
+  /// \return Average time per removal in nanoseconds
+  public: double RemoveTime(VisualPtr _parent,
+      const std::vector<unsigned int> &_ids);
+};
+
+/////////////////////////////////////////////////
+VisualPtr StoreLookupTest::Populate(ScenePtr _scene, unsigned int _count,
+    std::vector<unsigned int> &_ids)
+{
+  VisualPtr parent = _scene->CreateVisual();
+  _scene->RootVisual()->AddChild(parent);
+  _ids.clear();
+  _ids.reserve(_count);
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    VisualPtr visual = _scene->CreateVisual();
+    parent->AddChild(visual);
+    _ids.push_back(visual->Id());
+  }
+  return parent;
+}
+
+/////////////////////////////////////////////////
+double StoreLookupTest::LookupTime(ScenePtr _scene,
+    const std::vector<unsigned int> &_ids)
+{
+  const unsigned int numLookups = 100000u;
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<std::size_t> dist(0u, _ids.size() - 1u);
+  std::vector<unsigned int> queries(numLookups);
+  for (auto &q : queries)
+    q = _ids[dist(rng)];
+
+  unsigned int found = 0u;
+  auto start = std::chrono::steady_clock::now();
+  for (auto id : queries)
+  {
+    if (_scene->VisualById(id) && _scene->HasVisualId(id))
+      ++found;
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(numLookups, found);
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+      numLookups;
+}
+
+/////////////////////////////////////////////////
+double StoreLookupTest::RemoveTime(VisualPtr _parent,
+    const std::vector<unsigned int> &_ids)
+{
+  // a third of the removals each from the front, from random positions and
+  // from the back
+  const unsigned int numRemovals = 999u;
+  const unsigned int numFront = numRemovals / 3u;
+  const unsigned int numRandom = numRemovals / 3u;
+
+  std::mt19937 rng(0);
+  std::vector<unsigned int> randomIndices(numRandom);
+  unsigned int count = _parent->ChildCount() - numFront;
+  for (auto &index : randomIndices)
+    index = static_cast<unsigned int>(rng() % count--);
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < numFront; ++i)
+  {
+    EXPECT_NE(nullptr, _parent->RemoveChildByIndex(0u));
+  }
+  for (auto index : randomIndices)
+  {
+    EXPECT_NE(nullptr, _parent->RemoveChildByIndex(index));
+  }
+  for (unsigned int i = numFront + numRandom; i < numRemovals; ++i)
+  {
+    NodePtr child = _parent->ChildByIndex(_parent->ChildCount() - 1u);
+    EXPECT_NE(nullptr, _parent->RemoveChildById(child->Id()));
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(_ids.size() - numRemovals, _parent->ChildCount());
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+      numRemovals;
+}
+
+/////////////////////////////////////////////////
+TEST_F(StoreLookupTest, LookupAndRemoveIndependentOfSize)
+{
+  ScenePtr scene = this->engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  std::vector<unsigned int> smallIds;
+  VisualPtr smallParent = this->Populate(scene, 1000u, smallIds);
+  double smallLookup = this->LookupTime(scene, smallIds);
+  double smallRemove = this->RemoveTime(smallParent, smallIds);
+  scene->DestroyVisual(smallParent, true);
+
+  std::vector<unsigned int> largeIds;
+  VisualPtr largeParent = this->Populate(scene, 20000u, largeIds);
+  double largeLookup = this->LookupTime(scene, largeIds);
+  double largeRemove = this->RemoveTime(largeParent, largeIds);
+  scene->DestroyVisual(largeParent, true);
+
+  gzdbg << "Lookup [ns]: 1k visuals[" << smallLookup << "] "
+        << "20k visuals[" << largeLookup << "]" << std::endl;
+  gzdbg << "Remove [ns]: 1k visuals[" << smallRemove << "] "
+        << "20k visuals[" << largeRemove << "]" << std::endl;
+
+  // A linear scan would be ~20x slower on the larger store. Leave generous
+  // headroom for cache effects and timer noise.
+  EXPECT_LT(largeLookup, smallLookup * 10.0);
+  EXPECT_LT(largeRemove, smallRemove * 10.0);
+
+  this->engine->DestroyScene(scene);
+}